@@ -0,0 +1,87 @@
+#include <time_shield/BarAggregator.hpp>
+#include <time_shield/time_conversions.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Synthetic tick stream: 1M ticks 1..100 ms apart starting in March 2024.
+    struct TickStream {
+        std::vector<time_shield::ts_ms_t> ts;
+        std::vector<double> prices;
+        std::vector<double> volumes;
+    };
+
+    const TickStream& ticks() {
+        static const TickStream s_stream = []() {
+            TickStream stream;
+            const std::size_t count = std::size_t(1) << 20;
+            stream.ts.resize(count);
+            stream.prices.resize(count);
+            stream.volumes.resize(count);
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+            time_shield::ts_ms_t ts = time_shield::to_timestamp_ms(2024, 3, 8);
+            double price = 100.0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::uint64_t bits = rng();
+                ts += 1 + static_cast<time_shield::ts_ms_t>((bits >> 33) % 100);
+                price += (static_cast<double>((bits >> 20) % 201) - 100.0) * 0.0001;
+                stream.ts[i] = ts;
+                stream.prices[i] = price;
+                stream.volumes[i] = static_cast<double>(1 + (bits >> 50) % 10);
+            }
+            return stream;
+        }();
+        return s_stream;
+    }
+
+    std::vector<time_shield::BarTimeframe> timeframes() {
+        std::vector<time_shield::BarTimeframe> result;
+        result.push_back(time_shield::BarTimeframe("M1"));
+        result.push_back(time_shield::BarTimeframe("M15"));
+        result.push_back(time_shield::BarTimeframe("H1"));
+        result.push_back(time_shield::BarTimeframe("D1", time_shield::ET, 17 * time_shield::MS_PER_HOUR));
+        return result;
+    }
+
+    /// \brief Pushes the whole stream into M1, M15, H1 and a New York D1; Arg is the tolerance in ms.
+    void BM_BarAggregator_push(benchmark::State& state) {
+        const TickStream& stream = ticks();
+        const std::vector<time_shield::BarTimeframe> frames = timeframes();
+        std::vector<time_shield::Bar> bars;
+        for (auto _ : state) {
+            time_shield::BarAggregator aggregator(frames, state.range(0));
+            for (std::size_t i = 0; i < stream.ts.size(); ++i) {
+                aggregator.push(stream.ts[i], stream.prices[i], stream.volumes[i]);
+            }
+            aggregator.flush();
+            bars.clear();
+            aggregator.drain(bars);
+            benchmark::DoNotOptimize(bars.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(stream.ts.size()));
+    }
+    BENCHMARK(BM_BarAggregator_push)->Arg(0)->Arg(1000);
+
+    void BM_BarAggregator_push_batch(benchmark::State& state) {
+        const TickStream& stream = ticks();
+        const std::vector<time_shield::BarTimeframe> frames = timeframes();
+        std::vector<time_shield::Bar> bars;
+        for (auto _ : state) {
+            time_shield::BarAggregator aggregator(frames);
+            aggregator.push(stream.ts.data(), stream.prices.data(), stream.volumes.data(), stream.ts.size());
+            aggregator.flush();
+            bars.clear();
+            aggregator.drain(bars);
+            benchmark::DoNotOptimize(bars.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(stream.ts.size()));
+    }
+    BENCHMARK(BM_BarAggregator_push_batch);
+
+} // namespace
@@ -0,0 +1,104 @@
+#include <time_shield/BusinessCalendar.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Calendar for 2000..2049 with ten holidays per year.
+    const time_shield::BusinessCalendar& calendar() {
+        static const time_shield::BusinessCalendar s_calendar = []() {
+            const time_shield::dse_t first = time_shield::date_to_unix_day(2000, 1, 1);
+            const time_shield::dse_t last = time_shield::date_to_unix_day(2049, 12, 31);
+            time_shield::BusinessCalendar result(first, last, time_shield::ET);
+            for (time_shield::dse_t day = first; day <= last; day += 37) {
+                result.set_business_day(day, false);
+            }
+            return result;
+        }();
+        return s_calendar;
+    }
+
+    /// \brief Pseudo-random day pairs inside the calendar range.
+    const std::vector<time_shield::dse_t>& days() {
+        static const std::vector<time_shield::dse_t> s_days = []() {
+            std::vector<time_shield::dse_t> values(4096);
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+            const time_shield::dse_t first = time_shield::date_to_unix_day(2000, 1, 1);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const std::uint64_t bits = rng();
+                values[i] = first + static_cast<time_shield::dse_t>((bits >> 33) % 18000);
+            }
+            return values;
+        }();
+        return s_days;
+    }
+
+    void BM_BusinessCalendar_is_business_day(benchmark::State& state) {
+        const time_shield::BusinessCalendar& cal = calendar();
+        const std::vector<time_shield::dse_t>& values = days();
+        for (auto _ : state) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                count += cal.is_business_day(values[i]) ? 1u : 0u;
+            }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_BusinessCalendar_is_business_day);
+
+    void BM_BusinessCalendar_between(benchmark::State& state) {
+        const time_shield::BusinessCalendar& cal = calendar();
+        const std::vector<time_shield::dse_t>& values = days();
+        for (auto _ : state) {
+            std::int64_t total = 0;
+            for (std::size_t i = 0; i + 1 < values.size(); i += 2) {
+                total += cal.business_days_between(values[i], values[i + 1]);
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size() / 2));
+    }
+    BENCHMARK(BM_BusinessCalendar_between);
+
+    /// \brief Day-by-day counting over the same pairs, for comparison with the rank lookup.
+    void BM_BusinessCalendar_between_loop(benchmark::State& state) {
+        const time_shield::BusinessCalendar& cal = calendar();
+        const std::vector<time_shield::dse_t>& values = days();
+        for (auto _ : state) {
+            std::int64_t total = 0;
+            for (std::size_t i = 0; i + 1 < values.size(); i += 2) {
+                const time_shield::dse_t from = values[i] < values[i + 1] ? values[i] : values[i + 1];
+                const time_shield::dse_t to = values[i] < values[i + 1] ? values[i + 1] : values[i];
+                for (time_shield::dse_t day = from; day < to; ++day) {
+                    total += cal.is_business_day(day) ? 1 : 0;
+                }
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size() / 2));
+    }
+    BENCHMARK(BM_BusinessCalendar_between_loop);
+
+    /// \brief Arg is the business-day offset.
+    void BM_BusinessCalendar_add(benchmark::State& state) {
+        const time_shield::BusinessCalendar& cal = calendar();
+        const std::vector<time_shield::dse_t>& values = days();
+        const std::int64_t offset = state.range(0);
+        for (auto _ : state) {
+            time_shield::dse_t total = 0;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                total += cal.add_business_days(values[i], offset);
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_BusinessCalendar_add)->Arg(1)->Arg(2)->Arg(250);
+
+} // namespace
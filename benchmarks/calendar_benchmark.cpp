@@ -0,0 +1,90 @@
+#define TIME_SHIELD_ENABLE_CALENDAR_TABLES 1
+#include <time_shield/date_time_conversions.hpp>
+#include <time_shield/iso_week_conversions.hpp>
+#include <time_shield/workday_conversions.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+namespace {
+
+    /// \brief First benchmarked year: 0 selects the table range, 1 a range served by arithmetic.
+    time_shield::year_t first_year(const benchmark::State& state) {
+        return state.range(0) == 0 ? 1980 : 2200;
+    }
+
+    void BM_first_workday_day(benchmark::State& state) {
+        const time_shield::year_t base = first_year(state);
+        std::uint32_t i = 0;
+        for (auto _ : state) {
+            const int day = time_shield::first_workday_day(base + (i >> 4) % 100, static_cast<int>(i % 12) + 1);
+            benchmark::DoNotOptimize(day);
+            ++i;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_first_workday_day)->Arg(0)->Arg(1);
+
+    void BM_last_workday_day(benchmark::State& state) {
+        const time_shield::year_t base = first_year(state);
+        std::uint32_t i = 0;
+        for (auto _ : state) {
+            const int day = time_shield::last_workday_day(base + (i >> 4) % 100, static_cast<int>(i % 12) + 1);
+            benchmark::DoNotOptimize(day);
+            ++i;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_last_workday_day)->Arg(0)->Arg(1);
+
+    void BM_last_sunday_month_day(benchmark::State& state) {
+        const time_shield::year_t base = first_year(state);
+        std::uint32_t i = 0;
+        for (auto _ : state) {
+            const int day = time_shield::last_sunday_month_day(base + (i >> 4) % 100, static_cast<int>(i % 12) + 1);
+            benchmark::DoNotOptimize(day);
+            ++i;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_last_sunday_month_day)->Arg(0)->Arg(1);
+
+    void BM_iso_weeks_in_year(benchmark::State& state) {
+        const time_shield::year_t base = first_year(state);
+        std::uint32_t i = 0;
+        for (auto _ : state) {
+            const int weeks = time_shield::iso_weeks_in_year(base + i % 100);
+            benchmark::DoNotOptimize(weeks);
+            ++i;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_iso_weeks_in_year)->Arg(0)->Arg(1);
+
+    void BM_to_iso_week_date(benchmark::State& state) {
+        const time_shield::year_t base = first_year(state);
+        std::uint32_t i = 0;
+        for (auto _ : state) {
+            const time_shield::IsoWeekDateStruct iso = time_shield::to_iso_week_date(
+                base + (i >> 8) % 100, static_cast<int>(i % 12) + 1, static_cast<int>((i >> 4) % 28) + 1);
+            benchmark::DoNotOptimize(iso);
+            ++i;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_iso_week_date)->Arg(0)->Arg(1);
+
+    void BM_start_of_year_date(benchmark::State& state) {
+        const time_shield::year_t base = first_year(state);
+        std::uint32_t i = 0;
+        for (auto _ : state) {
+            const time_shield::ts_t ts = time_shield::start_of_year_date(base + i % 100);
+            benchmark::DoNotOptimize(ts);
+            ++i;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_start_of_year_date)->Arg(0)->Arg(1);
+
+} // namespace
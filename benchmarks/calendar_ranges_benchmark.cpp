@@ -0,0 +1,109 @@
+#include <time_shield/calendar_ranges.hpp>
+#include <time_shield/date_time_conversions.hpp>
+#include <time_shield/time_zone_conversions.hpp>
+#include <time_shield/validation.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+namespace {
+
+    // Ten years of days starting 2020-01-01.
+    const time_shield::ts_ms_t k_from_ms = 1577836800000LL;
+    const time_shield::ts_ms_t k_to_ms = k_from_ms + 3653 * time_shield::MS_PER_DAY;
+
+    void BM_CalendarRanges_days_stepping(benchmark::State& state) {
+        std::int64_t steps = 0;
+        for (auto _ : state) {
+            std::int64_t sum = 0;
+            for (time_shield::ts_ms_t t = k_from_ms; t < k_to_ms; t = time_shield::start_of_next_day_ms(t)) {
+                const time_shield::DateTimeStruct dt = time_shield::to_date_time_ms<time_shield::DateTimeStruct>(t);
+                sum += dt.year + dt.mon + dt.day;
+                ++steps;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(steps);
+    }
+    BENCHMARK(BM_CalendarRanges_days_stepping);
+
+    void BM_CalendarRanges_days_range(benchmark::State& state) {
+        std::int64_t steps = 0;
+        for (auto _ : state) {
+            std::int64_t sum = 0;
+            for (const time_shield::CalendarPeriod& day : time_shield::days(k_from_ms, k_to_ms)) {
+                sum += day.year + day.mon + day.day;
+                ++steps;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(steps);
+    }
+    BENCHMARK(BM_CalendarRanges_days_range);
+
+    void BM_CalendarRanges_local_days_stepping_cet(benchmark::State& state) {
+        std::int64_t steps = 0;
+        for (auto _ : state) {
+            std::int64_t sum = 0;
+            for (time_shield::ts_ms_t t = k_from_ms; t < k_to_ms;) {
+                const time_shield::ts_ms_t local = time_shield::gmt_to_zone_ms(t, time_shield::CET);
+                const time_shield::DateTimeStruct dt = time_shield::to_date_time_ms<time_shield::DateTimeStruct>(local);
+                t = time_shield::zone_to_gmt_ms(time_shield::start_of_next_day_ms(local), time_shield::CET);
+                sum += dt.year + dt.mon + dt.day;
+                ++steps;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(steps);
+    }
+    BENCHMARK(BM_CalendarRanges_local_days_stepping_cet);
+
+    void BM_CalendarRanges_local_days_range_cet(benchmark::State& state) {
+        std::int64_t steps = 0;
+        for (auto _ : state) {
+            std::int64_t sum = 0;
+            for (const time_shield::CalendarPeriod& day : time_shield::local_days(k_from_ms, k_to_ms, time_shield::CET)) {
+                sum += day.year + day.mon + day.day + day.end_ms;
+                ++steps;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(steps);
+    }
+    BENCHMARK(BM_CalendarRanges_local_days_range_cet);
+
+    void BM_CalendarRanges_workdays_stepping(benchmark::State& state) {
+        std::int64_t steps = 0;
+        for (auto _ : state) {
+            std::int64_t sum = 0;
+            for (time_shield::ts_ms_t t = k_from_ms; t < k_to_ms; t = time_shield::start_of_next_day_ms(t)) {
+                const time_shield::DateTimeStruct dt = time_shield::to_date_time_ms<time_shield::DateTimeStruct>(t);
+                if (time_shield::is_workday(dt.year, dt.mon, dt.day)) {
+                    sum += dt.day;
+                    ++steps;
+                }
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(steps);
+    }
+    BENCHMARK(BM_CalendarRanges_workdays_stepping);
+
+    void BM_CalendarRanges_workdays_range(benchmark::State& state) {
+        std::int64_t steps = 0;
+        for (auto _ : state) {
+            std::int64_t sum = 0;
+            for (const time_shield::CalendarPeriod& day : time_shield::workdays(k_from_ms, k_to_ms)) {
+                sum += day.day;
+                ++steps;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(steps);
+    }
+    BENCHMARK(BM_CalendarRanges_workdays_range);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+#include <time_shield/config.hpp>
+
+#if TIME_SHIELD_ENABLE_NTP_CLIENT
+#   define TIME_SHIELD_TEST_FAKE_NTP
+#endif
+#include <time_shield/CoarseClock.hpp>
+#include <time_shield/TscClock.hpp>
+#include <time_shield/ZonedClock.hpp>
+#include <time_shield/time_utils.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+namespace {
+
+    void BM_now_realtime_us(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(time_shield::now_realtime_us());
+        }
+    }
+    BENCHMARK(BM_now_realtime_us);
+
+    void BM_ts_ms(benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(time_shield::ts_ms());
+        }
+    }
+    BENCHMARK(BM_ts_ms);
+
+    void BM_TscClock_utc_time_us(benchmark::State& state) {
+        time_shield::TscClock& clock = time_shield::TscClock::instance();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(clock.utc_time_us());
+        }
+    }
+    BENCHMARK(BM_TscClock_utc_time_us);
+
+    void BM_CoarseClock_utc_ms(benchmark::State& state) {
+        time_shield::CoarseClock& clock = time_shield::CoarseClock::instance();
+        if (state.range(0) != 0) {
+            clock.start();
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(clock.utc_ms());
+        }
+        clock.stop();
+    }
+    BENCHMARK(BM_CoarseClock_utc_ms)->ArgName("ticker")->Arg(0)->Arg(1);
+
+    void BM_ZonedClock_local_time_ms(benchmark::State& state) {
+        const time_shield::ZonedClock clock(static_cast<time_shield::TimeZone>(state.range(0)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(clock.local_time_ms());
+        }
+    }
+    BENCHMARK(BM_ZonedClock_local_time_ms)
+        ->Arg(time_shield::UTC)
+        ->Arg(time_shield::CET)
+        ->Arg(time_shield::ET);
+
+    void BM_ZonedClock_fixed_offset_local_time_ms(benchmark::State& state) {
+        const time_shield::ZonedClock clock(static_cast<time_shield::tz_t>(3 * time_shield::SEC_PER_HOUR));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(clock.local_time_ms());
+        }
+    }
+    BENCHMARK(BM_ZonedClock_fixed_offset_local_time_ms);
+
+#if TIME_SHIELD_ENABLE_NTP_CLIENT
+    void BM_NtpTimeService_utc_time_us(benchmark::State& state) {
+        if (state.thread_index() == 0) {
+            (void)time_shield::ntp::init(std::chrono::milliseconds(100), true);
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(time_shield::NtpTimeService::instance().utc_time_us());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_NtpTimeService_utc_time_us)->ThreadRange(1, 8)->UseRealTime();
+#endif
+
+} // namespace
@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""Compare Google Benchmark JSON reports against the committed baseline.
+
+The comparator reads every ``*.json`` report in a results directory, takes the
+per-repetition ``real_time`` samples of each benchmark and compares them with
+the samples stored in the baseline file. A benchmark regresses when
+
+* its median time grew by more than ``max_slowdown`` (a fraction), and
+* a one-sided Mann-Whitney U test says the new samples are slower with a
+  p-value below ``alpha``.
+
+Thresholds come from ``thresholds.json``: a default entry plus overrides
+selected by ``fnmatch`` patterns on the benchmark name. Only the Python
+standard library is used.
+
+The baseline stores the machine context of the run that produced it (host
+name, CPU count and frequency). Timings from another machine say nothing
+about regressions, so when the contexts differ the comparison is printed and
+the check fails with status 2; regenerate the baseline locally with
+``--update`` (the ``update_benchmark_baseline`` target) first.
+
+Usage:
+    compare.py RESULTS_DIR BASELINE [--thresholds FILE]
+    compare.py RESULTS_DIR BASELINE --update
+    compare.py --self-test
+
+Exit status is 1 when at least one benchmark regressed, 2 on usage errors and
+when the baseline was recorded on another machine.
+"""
+
+import argparse
+import fnmatch
+import glob
+import json
+import math
+import os
+import statistics
+import sys
+
+TIME_UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+DEFAULT_THRESHOLDS = {"alpha": 0.05, "max_slowdown": 0.10, "min_repetitions": 3}
+CONTEXT_KEYS = ("host_name", "num_cpus", "mhz_per_cpu")
+
+
+def load_samples(results_dir):
+    """Return {benchmark name: [real_time in ns, ...]} from all reports."""
+    samples = {}
+    paths = sorted(glob.glob(os.path.join(results_dir, "*.json")))
+    for path in paths:
+        with open(path, "r", encoding="utf-8") as handle:
+            report = json.load(handle)
+        for entry in report.get("benchmarks", []):
+            if entry.get("run_type", "iteration") != "iteration":
+                continue
+            if "error_occurred" in entry and entry["error_occurred"]:
+                continue
+            name = entry.get("run_name", entry["name"])
+            scale = TIME_UNIT_TO_NS[entry.get("time_unit", "ns")]
+            samples.setdefault(name, []).append(float(entry["real_time"]) * scale)
+    return samples
+
+
+def load_context(results_dir):
+    """Return the machine context of the first report, limited to CONTEXT_KEYS."""
+    for path in sorted(glob.glob(os.path.join(results_dir, "*.json"))):
+        with open(path, "r", encoding="utf-8") as handle:
+            context = json.load(handle).get("context", {})
+        return {key: context[key] for key in CONTEXT_KEYS if key in context}
+    return {}
+
+
+def same_machine(current, baseline):
+    """True when both contexts are known and agree on every recorded key."""
+    if not current or not baseline:
+        return False
+    return all(current.get(key) == baseline.get(key) for key in CONTEXT_KEYS)
+
+
+def normal_sf(z):
+    """Survival function of the standard normal distribution."""
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def mann_whitney_greater(current, baseline):
+    """One-sided p-value for the hypothesis that current values are greater.
+
+    Uses the normal approximation with tie and continuity corrections.
+    """
+    n1 = len(current)
+    n2 = len(baseline)
+    combined = sorted([(value, 0) for value in current] + [(value, 1) for value in baseline])
+    ranks = [0.0] * len(combined)
+    tie_term = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        rank = (i + j) / 2.0 + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        ties = j - i + 1
+        tie_term += ties ** 3 - ties
+        i = j + 1
+    rank_sum = sum(rank for rank, (_, group) in zip(ranks, combined) if group == 0)
+    u_stat = rank_sum - n1 * (n1 + 1) / 2.0
+    mean_u = n1 * n2 / 2.0
+    total = n1 + n2
+    variance = n1 * n2 / 12.0 * ((total + 1) - tie_term / (total * (total - 1)))
+    if variance <= 0.0:
+        return 1.0
+    z = (u_stat - mean_u - 0.5) / math.sqrt(variance)
+    return normal_sf(z)
+
+
+def thresholds_for(name, config):
+    """Merge default thresholds with every override matching the name."""
+    result = dict(DEFAULT_THRESHOLDS)
+    result.update(config.get("default", {}))
+    for override in config.get("overrides", []):
+        if fnmatch.fnmatchcase(name, override["pattern"]):
+            result.update({key: value for key, value in override.items() if key != "pattern"})
+    return result
+
+
+def compare(current, baseline, config):
+    """Return (rows, regression count) for benchmarks present in both sets."""
+    rows = []
+    regressions = 0
+    for name in sorted(current):
+        if name not in baseline:
+            rows.append((name, None, statistics.median(current[name]), None, None, "new"))
+            continue
+        limits = thresholds_for(name, config)
+        new_samples = current[name]
+        old_samples = baseline[name]
+        old_median = statistics.median(old_samples)
+        new_median = statistics.median(new_samples)
+        change = (new_median - old_median) / old_median if old_median > 0 else 0.0
+        enough = min(len(new_samples), len(old_samples)) >= limits["min_repetitions"]
+        p_value = mann_whitney_greater(new_samples, old_samples) if enough else None
+        status = "ok"
+        if change > limits["max_slowdown"]:
+            if p_value is None:
+                status = "slower?"
+            elif p_value < limits["alpha"]:
+                status = "REGRESSION"
+                regressions += 1
+            else:
+                status = "noisy"
+        elif change < -limits["max_slowdown"] and p_value is not None \
+                and mann_whitney_greater(old_samples, new_samples) < limits["alpha"]:
+            status = "faster"
+        rows.append((name, old_median, new_median, change, p_value, status))
+    for name in sorted(set(baseline) - set(current)):
+        rows.append((name, statistics.median(baseline[name]), None, None, None, "missing"))
+    return rows, regressions
+
+
+def print_rows(rows):
+    width = max([len(row[0]) for row in rows] + [9])
+    print("%-*s %12s %12s %9s %8s  %s" % (width, "Benchmark", "base ns", "new ns", "change", "p", "status"))
+    for name, old, new, change, p_value, status in rows:
+        print("%-*s %12s %12s %9s %8s  %s" % (
+            width, name,
+            "-" if old is None else "%.2f" % old,
+            "-" if new is None else "%.2f" % new,
+            "-" if change is None else "%+.1f%%" % (change * 100.0),
+            "-" if p_value is None else "%.4f" % p_value,
+            status))
+
+
+def write_baseline(path, samples, context=None):
+    data = {
+        "time_unit": "ns",
+        "metric": "real_time",
+        "context": context or {},
+        "benchmarks": {name: [round(value, 3) for value in values] for name, values in sorted(samples.items())},
+    }
+    with open(path, "w", encoding="utf-8") as handle:
+        json.dump(data, handle, indent=1, sort_keys=True)
+        handle.write("\n")
+
+
+def read_baseline(path):
+    with open(path, "r", encoding="utf-8") as handle:
+        return json.load(handle)["benchmarks"]
+
+
+def read_baseline_context(path):
+    with open(path, "r", encoding="utf-8") as handle:
+        return json.load(handle).get("context", {})
+
+
+def self_test():
+    """Check the statistics against known cases."""
+    same = [10.0, 10.5, 9.8, 10.2, 10.1, 9.9, 10.3]
+    slower = [value * 1.3 for value in same]
+    assert mann_whitney_greater(slower, same) < 0.01
+    assert mann_whitney_greater(same, slower) > 0.99
+    assert 0.3 < mann_whitney_greater(same, list(same)) <= 0.6
+    assert mann_whitney_greater([1.0] * 5, [1.0] * 5) == 1.0
+
+    config = {"default": {"max_slowdown": 0.2},
+              "overrides": [{"pattern": "BM_noisy*", "max_slowdown": 0.5}]}
+    assert thresholds_for("BM_x", config)["max_slowdown"] == 0.2
+    assert thresholds_for("BM_noisy/8", config)["max_slowdown"] == 0.5
+    assert thresholds_for("BM_x", config)["alpha"] == DEFAULT_THRESHOLDS["alpha"]
+
+    rows, regressions = compare({"BM_a": slower, "BM_noisy": slower, "BM_new": same},
+                                {"BM_a": same, "BM_noisy": same, "BM_gone": same}, config)
+    statuses = {row[0]: row[5] for row in rows}
+    assert regressions == 1
+    assert statuses == {"BM_a": "REGRESSION", "BM_noisy": "ok", "BM_new": "new", "BM_gone": "missing"}
+    rows, regressions = compare({"BM_a": same}, {"BM_a": slower}, config)
+    assert regressions == 0 and rows[0][5] == "faster"
+
+    machine = {"host_name": "a", "num_cpus": 8, "mhz_per_cpu": 3000}
+    assert same_machine(machine, dict(machine))
+    assert not same_machine(machine, dict(machine, num_cpus=1))
+    assert not same_machine(machine, {})
+    print("compare.py self-test passed")
+    return 0
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description="Compare benchmark results with a baseline.")
+    parser.add_argument("results_dir", nargs="?", help="directory with Google Benchmark JSON reports")
+    parser.add_argument("baseline", nargs="?", help="baseline file")
+    parser.add_argument("--thresholds", help="thresholds file (default: thresholds.json next to this script)")
+    parser.add_argument("--update", action="store_true", help="rewrite the baseline from the results")
+    parser.add_argument("--self-test", action="store_true", help="run internal checks and exit")
+    args = parser.parse_args(argv)
+
+    if args.self_test:
+        return self_test()
+    if not args.results_dir or not args.baseline:
+        parser.print_usage(sys.stderr)
+        return 2
+
+    current = load_samples(args.results_dir)
+    if not current:
+        print("no benchmark results in %s" % args.results_dir, file=sys.stderr)
+        return 2
+    context = load_context(args.results_dir)
+    if args.update:
+        write_baseline(args.baseline, current, context)
+        print("baseline %s updated with %d benchmarks" % (args.baseline, len(current)))
+        return 0
+
+    thresholds_path = args.thresholds or os.path.join(os.path.dirname(os.path.abspath(__file__)), "thresholds.json")
+    config = {}
+    if os.path.exists(thresholds_path):
+        with open(thresholds_path, "r", encoding="utf-8") as handle:
+            config = json.load(handle)
+    if not os.path.exists(args.baseline):
+        print("baseline %s does not exist; run the update target first" % args.baseline, file=sys.stderr)
+        return 2
+
+    rows, regressions = compare(current, read_baseline(args.baseline), config)
+    print_rows(rows)
+    baseline_context = read_baseline_context(args.baseline)
+    if not same_machine(context, baseline_context):
+        print("no baseline for this machine (baseline: %s, this run: %s); run update_benchmark_baseline first"
+              % (baseline_context or "unknown", context or "unknown"), file=sys.stderr)
+        return 2
+    if regressions:
+        print("%d benchmark(s) regressed" % regressions)
+        return 1
+    print("no regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,194 @@
+#include <time_shield/date_time_conversions.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Pseudo-random timestamps spread over 1900..2100.
+    std::vector<time_shield::ts_t> make_timestamps() {
+        std::vector<time_shield::ts_t> values(4096);
+        std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+        const std::int64_t first = -2208988800LL;
+        const std::int64_t span = 4102444800LL - first;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const std::uint64_t bits = rng();
+            values[i] = static_cast<time_shield::ts_t>(first + static_cast<std::int64_t>((bits >> 11) % static_cast<std::uint64_t>(span)));
+        }
+        return values;
+    }
+
+    const std::vector<time_shield::ts_t>& timestamps() {
+        static const std::vector<time_shield::ts_t> s_values = make_timestamps();
+        return s_values;
+    }
+
+    void BM_to_date_time(benchmark::State& state) {
+        const std::vector<time_shield::ts_t>& values = timestamps();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::DateTimeStruct dt = time_shield::to_date_time(values[index]);
+            benchmark::DoNotOptimize(dt);
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_date_time);
+
+    void BM_to_date_time_ms(benchmark::State& state) {
+        const std::vector<time_shield::ts_t>& values = timestamps();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::DateTimeStruct dt = time_shield::to_date_time_ms<time_shield::DateTimeStruct>(
+                static_cast<time_shield::ts_ms_t>(values[index]) * time_shield::MS_PER_SEC + 123);
+            benchmark::DoNotOptimize(dt);
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_date_time_ms);
+
+    void BM_to_timestamp(benchmark::State& state) {
+        const std::vector<time_shield::ts_t>& values = timestamps();
+        std::vector<time_shield::DateTimeStruct> dates(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            dates[i] = time_shield::to_date_time(values[i]);
+        }
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::DateTimeStruct& dt = dates[index];
+            const time_shield::ts_t ts = time_shield::to_timestamp(dt.year, dt.mon, dt.day, dt.hour, dt.min, dt.sec);
+            benchmark::DoNotOptimize(ts);
+            index = (index + 1) & (dates.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_timestamp);
+
+    void BM_to_timestamp_ms(benchmark::State& state) {
+        const std::vector<time_shield::ts_t>& values = timestamps();
+        std::vector<time_shield::DateTimeStruct> dates(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            dates[i] = time_shield::to_date_time(values[i]);
+            dates[i].ms = static_cast<int>(i % 1000);
+        }
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::ts_ms_t ts = time_shield::dt_to_timestamp_ms(dates[index]);
+            benchmark::DoNotOptimize(ts);
+            index = (index + 1) & (dates.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_timestamp_ms);
+
+    /// \brief The timestamps as DateTimeStruct rows with varying milliseconds.
+    const std::vector<time_shield::DateTimeStruct>& date_rows() {
+        static const std::vector<time_shield::DateTimeStruct> s_rows = []() {
+            const std::vector<time_shield::ts_t>& values = timestamps();
+            std::vector<time_shield::DateTimeStruct> rows(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                rows[i] = time_shield::to_date_time(values[i]);
+                rows[i].ms = static_cast<int>(i % 1000);
+            }
+            return rows;
+        }();
+        return s_rows;
+    }
+
+    /// \brief Column copies of date_rows() for the SoA batch overloads.
+    struct DateColumnsData {
+        std::vector<std::int64_t> year;
+        std::vector<int> mon;
+        std::vector<int> day;
+        std::vector<int> hour;
+        std::vector<int> min;
+        std::vector<int> sec;
+        std::vector<int> ms;
+        time_shield::DateTimeColumns columns;
+    };
+
+    const DateColumnsData& date_columns() {
+        static const DateColumnsData s_data = []() {
+            DateColumnsData data;
+            for (const time_shield::DateTimeStruct& row : date_rows()) {
+                data.year.push_back(row.year);
+                data.mon.push_back(row.mon);
+                data.day.push_back(row.day);
+                data.hour.push_back(row.hour);
+                data.min.push_back(row.min);
+                data.sec.push_back(row.sec);
+                data.ms.push_back(row.ms);
+            }
+            data.columns.year = data.year.data();
+            data.columns.mon = data.mon.data();
+            data.columns.day = data.day.data();
+            data.columns.hour = data.hour.data();
+            data.columns.min = data.min.data();
+            data.columns.sec = data.sec.data();
+            data.columns.ms = data.ms.data();
+            return data;
+        }();
+        return s_data;
+    }
+
+    /// \brief dt_to_timestamp_ms() over a whole array, for comparison with the batch kernels.
+    void BM_to_timestamp_ms_loop(benchmark::State& state) {
+        const std::vector<time_shield::DateTimeStruct>& rows = date_rows();
+        std::vector<time_shield::ts_ms_t> out(rows.size());
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < rows.size(); ++i) {
+                out[i] = time_shield::dt_to_timestamp_ms(rows[i]);
+            }
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(rows.size()));
+    }
+    BENCHMARK(BM_to_timestamp_ms_loop);
+
+    void BM_to_timestamp_ms_batch_columns(benchmark::State& state) {
+        const DateColumnsData& data = date_columns();
+        std::vector<time_shield::ts_ms_t> out(data.year.size());
+        for (auto _ : state) {
+            time_shield::to_timestamp_ms_batch(data.columns, out.data(), out.size());
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(out.size()));
+    }
+    BENCHMARK(BM_to_timestamp_ms_batch_columns);
+
+    void BM_to_timestamp_ms_batch_columns_validated(benchmark::State& state) {
+        const DateColumnsData& data = date_columns();
+        std::vector<time_shield::ts_ms_t> out(data.year.size());
+        std::vector<std::uint64_t> bad_rows((out.size() + 63) / 64);
+        for (auto _ : state) {
+            const std::size_t bad = time_shield::to_timestamp_ms_batch(data.columns, out.data(), out.size(), bad_rows.data());
+            benchmark::DoNotOptimize(bad);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(out.size()));
+    }
+    BENCHMARK(BM_to_timestamp_ms_batch_columns_validated);
+
+    void BM_to_timestamp_ms_batch_structs_validated(benchmark::State& state) {
+        const std::vector<time_shield::DateTimeStruct>& rows = date_rows();
+        std::vector<time_shield::ts_ms_t> out(rows.size());
+        std::vector<std::uint64_t> bad_rows((out.size() + 63) / 64);
+        for (auto _ : state) {
+            const std::size_t bad = time_shield::to_timestamp_ms_batch(rows.data(), out.data(), out.size(), bad_rows.data());
+            benchmark::DoNotOptimize(bad);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(out.size()));
+    }
+    BENCHMARK(BM_to_timestamp_ms_batch_structs_validated);
+
+} // namespace
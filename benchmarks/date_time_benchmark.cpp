@@ -0,0 +1,84 @@
+#include <time_shield/DateTime.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Pseudo-random DateTime values over 1900..2100 with a +03:00 offset.
+    std::vector<time_shield::DateTime> make_values() {
+        std::vector<time_shield::DateTime> values(4096);
+        std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+        const std::int64_t first = -2208988800000LL;
+        const std::int64_t span = 4102444800000LL - first;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const std::uint64_t bits = rng();
+            values[i] = time_shield::DateTime::from_unix_ms(
+                static_cast<time_shield::ts_ms_t>(first + static_cast<std::int64_t>((bits >> 11) % static_cast<std::uint64_t>(span))),
+                3 * 3600);
+        }
+        return values;
+    }
+
+    const std::vector<time_shield::DateTime>& values() {
+        static const std::vector<time_shield::DateTime> s_values = make_values();
+        return s_values;
+    }
+
+    void BM_DateTime_field_accessors(benchmark::State& state) {
+        const std::vector<time_shield::DateTime>& dates = values();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::DateTime& dt = dates[index];
+            std::int64_t sum = dt.year() + dt.month() + dt.day() + dt.hour() + dt.minute() + dt.second() + dt.millisecond();
+            benchmark::DoNotOptimize(sum);
+            index = (index + 1) & (dates.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_DateTime_field_accessors);
+
+    void BM_DateTime_date_accessors(benchmark::State& state) {
+        const std::vector<time_shield::DateTime>& dates = values();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::DateTime& dt = dates[index];
+            std::int64_t sum = dt.year() + dt.month() + dt.day();
+            benchmark::DoNotOptimize(sum);
+            index = (index + 1) & (dates.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_DateTime_date_accessors);
+
+    void BM_DateTime_time_accessors(benchmark::State& state) {
+        const std::vector<time_shield::DateTime>& dates = values();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::DateTime& dt = dates[index];
+            std::int64_t sum = dt.hour() + dt.minute() + dt.second() + dt.millisecond();
+            benchmark::DoNotOptimize(sum);
+            index = (index + 1) & (dates.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_DateTime_time_accessors);
+
+    void BM_DateTimeView_field_accessors(benchmark::State& state) {
+        const std::vector<time_shield::DateTime>& dates = values();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::DateTimeView view = dates[index].view();
+            std::int64_t sum = view.year() + view.month() + view.day() + view.hour() + view.minute() + view.second() + view.millisecond();
+            benchmark::DoNotOptimize(sum);
+            index = (index + 1) & (dates.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_DateTimeView_field_accessors);
+
+} // namespace
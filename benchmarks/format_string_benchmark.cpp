@@ -0,0 +1,84 @@
+#include <time_shield/FormatString.hpp>
+#include <time_shield/time_formatting.hpp>
+#include <time_shield/time_literals.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(TIME_SHIELD_CPP17)
+
+namespace {
+
+    using namespace time_shield::literals;
+
+    /// \brief Pseudo-random millisecond timestamps spread over 1970..2100.
+    const std::vector<time_shield::ts_ms_t>& timestamps_ms() {
+        static const std::vector<time_shield::ts_ms_t> s_values = []() {
+            std::vector<time_shield::ts_ms_t> values(4096);
+            std::mt19937_64 rng(0x2545F4914F6CDD1DULL);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const std::uint64_t bits = rng();
+                values[i] = static_cast<time_shield::ts_ms_t>((bits >> 11) % 4102444800000ULL);
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    void BM_FormatString_runtime_pattern(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps_ms();
+        const std::string format = "%YYYY-%MM-%DD %hh:%mm:%ss.%sss";
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const std::string text = time_shield::to_string_ms(format, values[index]);
+            benchmark::DoNotOptimize(text.data());
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_FormatString_runtime_pattern);
+
+    void BM_FormatString_compiled_pattern(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps_ms();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const std::string text = time_shield::to_string_ms("%YYYY-%MM-%DD %hh:%mm:%ss.%sss"_fmt, values[index]);
+            benchmark::DoNotOptimize(text.data());
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_FormatString_compiled_pattern);
+
+    void BM_FormatString_runtime_literal(benchmark::State& state) {
+        static const char k_text[] = "2024-03-31T01:00:00.250Z";
+        time_shield::ts_ms_t sum = 0;
+        for (auto _ : state) {
+            time_shield::ts_ms_t value = 0;
+            time_shield::str_to_ts_ms(k_text, sizeof(k_text) - 1, value);
+            sum += value;
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_FormatString_runtime_literal);
+
+    void BM_FormatString_compile_time_literal(benchmark::State& state) {
+        time_shield::ts_ms_t sum = 0;
+        for (auto _ : state) {
+            constexpr time_shield::ts_ms_t value = "2024-03-31T01:00:00.250Z"_ts_ms;
+            sum += value;
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_FormatString_compile_time_literal);
+
+} // namespace
+
+#endif // defined(TIME_SHIELD_CPP17)
@@ -0,0 +1,77 @@
+#include <time_shield/time_formatting.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /// \brief Pseudo-random millisecond timestamps spread over 1970..2100.
+    const std::vector<time_shield::ts_ms_t>& timestamps_ms() {
+        static const std::vector<time_shield::ts_ms_t> s_values = []() {
+            std::vector<time_shield::ts_ms_t> values(4096);
+            std::mt19937_64 rng(0x2545F4914F6CDD1DULL);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const std::uint64_t bits = rng();
+                values[i] = static_cast<time_shield::ts_ms_t>((bits >> 11) % 4102444800000ULL);
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    void BM_to_iso8601(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps_ms();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const std::string text = time_shield::to_iso8601(values[index] / time_shield::MS_PER_SEC);
+            benchmark::DoNotOptimize(text.data());
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_iso8601);
+
+    void BM_to_iso8601_utc_ms(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps_ms();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const std::string text = time_shield::to_iso8601_utc_ms(values[index]);
+            benchmark::DoNotOptimize(text.data());
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_iso8601_utc_ms);
+
+    void BM_to_iso8601_ms_offset(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps_ms();
+        const time_shield::tz_t offset = static_cast<time_shield::tz_t>(3 * time_shield::SEC_PER_HOUR);
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const std::string text = time_shield::to_iso8601_ms(values[index], offset);
+            benchmark::DoNotOptimize(text.data());
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_iso8601_ms_offset);
+
+    void BM_to_string_ms(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps_ms();
+        const std::string format = "%Y-%m-%d %H:%M:%S.%sss";
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const std::string text = time_shield::to_string_ms(format, values[index]);
+            benchmark::DoNotOptimize(text.data());
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_to_string_ms);
+
+} // namespace
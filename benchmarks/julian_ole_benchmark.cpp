@@ -0,0 +1,177 @@
+#include <time_shield/julian_conversions.hpp>
+#include <time_shield/ole_automation_conversions.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Pseudo-random Unix timestamps (seconds) over 1900..2100, the range Excel serials cover.
+    const std::vector<time_shield::ts_t>& random_ts() {
+        static const std::vector<time_shield::ts_t> s_values = []() {
+            std::vector<time_shield::ts_t> values(4096);
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                values[i] = -2208988800LL + static_cast<time_shield::ts_t>(rng() % 6311433600ULL);
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    /// \brief The same instants as floating seconds.
+    const std::vector<time_shield::fts_t>& random_fts() {
+        static const std::vector<time_shield::fts_t> s_values = []() {
+            const std::vector<time_shield::ts_t>& ts = random_ts();
+            std::vector<time_shield::fts_t> values(ts.size());
+            for (std::size_t i = 0; i < ts.size(); ++i) {
+                values[i] = static_cast<time_shield::fts_t>(ts[i]) + 0.25;
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    /// \brief The same instants as OA dates.
+    const std::vector<time_shield::oadate_t>& random_oadates() {
+        static const std::vector<time_shield::oadate_t> s_values = []() {
+            const std::vector<time_shield::ts_t>& ts = random_ts();
+            std::vector<time_shield::oadate_t> values(ts.size());
+            for (std::size_t i = 0; i < ts.size(); ++i) {
+                values[i] = time_shield::ts_to_oadate(ts[i]);
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    template<class T>
+    void keep(std::vector<T>& out) {
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    void BM_TsToOadate_scalar(benchmark::State& state) {
+        const std::vector<time_shield::ts_t>& values = random_ts();
+        std::vector<time_shield::oadate_t> out(values.size());
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                out[i] = time_shield::ts_to_oadate(values[i]);
+            }
+            keep(out);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_TsToOadate_scalar);
+
+    void BM_TsToOadate_batch(benchmark::State& state) {
+        const std::vector<time_shield::ts_t>& values = random_ts();
+        std::vector<time_shield::oadate_t> out(values.size());
+        for (auto _ : state) {
+            time_shield::ts_to_oadate(values.data(), out.data(), values.size());
+            keep(out);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_TsToOadate_batch);
+
+    void BM_OadateToTs_scalar(benchmark::State& state) {
+        const std::vector<time_shield::oadate_t>& values = random_oadates();
+        std::vector<time_shield::ts_t> out(values.size());
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                out[i] = time_shield::oadate_to_ts(values[i]);
+            }
+            keep(out);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_OadateToTs_scalar);
+
+    void BM_OadateToTs_batch(benchmark::State& state) {
+        const std::vector<time_shield::oadate_t>& values = random_oadates();
+        std::vector<time_shield::ts_t> out(values.size());
+        for (auto _ : state) {
+            time_shield::oadate_to_ts(values.data(), out.data(), values.size());
+            keep(out);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_OadateToTs_batch);
+
+    void BM_FtsToJd_scalar(benchmark::State& state) {
+        const std::vector<time_shield::fts_t>& values = random_fts();
+        std::vector<time_shield::jd_t> out(values.size());
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                out[i] = time_shield::fts_to_jd(values[i]);
+            }
+            keep(out);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_FtsToJd_scalar);
+
+    void BM_FtsToJd_batch(benchmark::State& state) {
+        const std::vector<time_shield::fts_t>& values = random_fts();
+        std::vector<time_shield::jd_t> out(values.size());
+        for (auto _ : state) {
+            time_shield::fts_to_jd(values.data(), out.data(), values.size());
+            keep(out);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_FtsToJd_batch);
+
+    struct YmdColumns {
+        std::vector<time_shield::year_t> year;
+        std::vector<int> month;
+        std::vector<int> day;
+    };
+
+    const YmdColumns& random_ymd() {
+        static const YmdColumns s_columns = []() {
+            YmdColumns columns;
+            std::mt19937_64 rng(0x243F6A8885A308D3ULL);
+            for (std::size_t i = 0; i < 4096; ++i) {
+                columns.year.push_back(1900 + static_cast<time_shield::year_t>(rng() % 200));
+                columns.month.push_back(1 + static_cast<int>(rng() % 12));
+                columns.day.push_back(1 + static_cast<int>(rng() % 28));
+            }
+            return columns;
+        }();
+        return s_columns;
+    }
+
+    void BM_GregorianYmdToJdn_scalar(benchmark::State& state) {
+        const YmdColumns& columns = random_ymd();
+        std::vector<time_shield::jdn_t> out(columns.year.size());
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                out[i] = time_shield::gregorian_ymd_to_jdn(columns.year[i], columns.month[i], columns.day[i]);
+            }
+            keep(out);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(out.size()));
+    }
+    BENCHMARK(BM_GregorianYmdToJdn_scalar);
+
+    void BM_GregorianYmdToJdn_batch(benchmark::State& state) {
+        const YmdColumns& columns = random_ymd();
+        std::vector<time_shield::jdn_t> out(columns.year.size());
+        for (auto _ : state) {
+            time_shield::gregorian_ymd_to_jdn(
+                    columns.year.data(), columns.month.data(), columns.day.data(), out.data(), out.size());
+            keep(out);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(out.size()));
+    }
+    BENCHMARK(BM_GregorianYmdToJdn_batch);
+
+} // namespace
+
+BENCHMARK_MAIN();
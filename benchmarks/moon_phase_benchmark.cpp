@@ -0,0 +1,160 @@
+#include <time_shield/LunationTable.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Hourly bar timestamps over 2000..2040 (Unix seconds).
+    const std::vector<double>& hourly_bars() {
+        static const std::vector<double> s_values = []() {
+            std::vector<double> values;
+            for (double ts = 946684800.0; ts < 2208988800.0; ts += 3600.0) {
+                values.push_back(ts);
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    /// \brief Pseudo-random timestamps over 2000..2040 (Unix seconds).
+    const std::vector<double>& random_times() {
+        static const std::vector<double> s_values = []() {
+            std::vector<double> values(4096);
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const std::uint64_t bits = rng();
+                values[i] = 946684800.0 + static_cast<double>(bits >> 33) / 4294967296.0 * 1262304000.0;
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    const time_shield::astronomy::LunationTable& table() {
+        static const time_shield::astronomy::LunationTable s_table(946684800.0, 2208988800.0);
+        return s_table;
+    }
+
+    /// \brief Scalar compute() per timestamp, keeping phase and illumination.
+    void BM_MoonPhase_compute_scalar(benchmark::State& state) {
+        const time_shield::astronomy::MoonPhase calculator{};
+        const std::vector<double>& values = random_times();
+        std::vector<double> phase(values.size());
+        std::vector<double> illumination(values.size());
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const time_shield::astronomy::MoonPhaseResult result = calculator.compute(values[i]);
+                phase[i] = result.phase;
+                illumination[i] = result.illumination;
+            }
+            benchmark::DoNotOptimize(phase.data());
+            benchmark::DoNotOptimize(illumination.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_MoonPhase_compute_scalar);
+
+    /// \brief compute_batch() writing phase and illumination only.
+    void BM_MoonPhase_compute_batch(benchmark::State& state) {
+        const time_shield::astronomy::MoonPhase calculator{};
+        const std::vector<double>& values = random_times();
+        std::vector<double> phase(values.size());
+        std::vector<double> illumination(values.size());
+        time_shield::astronomy::MoonPhaseColumns columns;
+        columns.phase = phase.data();
+        columns.illumination = illumination.data();
+        const std::uint32_t fields = time_shield::astronomy::MOON_FIELD_PHASE
+            | time_shield::astronomy::MOON_FIELD_ILLUMINATION;
+        for (auto _ : state) {
+            calculator.compute_batch(values.data(), values.size(), fields, columns);
+            benchmark::DoNotOptimize(phase.data());
+            benchmark::DoNotOptimize(illumination.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_MoonPhase_compute_batch);
+
+    /// \brief compute_batch() writing every field, including the distance terms.
+    void BM_MoonPhase_compute_batch_all(benchmark::State& state) {
+        const time_shield::astronomy::MoonPhase calculator{};
+        const std::vector<double>& values = random_times();
+        std::vector<std::vector<double> > storage(11, std::vector<double>(values.size()));
+        time_shield::astronomy::MoonPhaseColumns columns;
+        columns.phase = storage[0].data();
+        columns.illumination = storage[1].data();
+        columns.age_days = storage[2].data();
+        columns.distance_km = storage[3].data();
+        columns.diameter_deg = storage[4].data();
+        columns.age_deg = storage[5].data();
+        columns.phase_angle_rad = storage[6].data();
+        columns.phase_sin = storage[7].data();
+        columns.phase_cos = storage[8].data();
+        columns.sun_distance_km = storage[9].data();
+        columns.sun_diameter_deg = storage[10].data();
+        for (auto _ : state) {
+            calculator.compute_batch(values.data(), values.size(), time_shield::astronomy::MOON_FIELD_ALL, columns);
+            benchmark::DoNotOptimize(columns.phase);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_MoonPhase_compute_batch_all);
+
+    void BM_MoonPhase_is_full_moon_window(benchmark::State& state) {
+        const time_shield::astronomy::MoonPhase calculator{};
+        const std::vector<double>& values = random_times();
+        for (auto _ : state) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                count += calculator.is_full_moon_window(values[i]) ? 1u : 0u;
+            }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_MoonPhase_is_full_moon_window);
+
+    void BM_LunationTable_is_full_moon_window(benchmark::State& state) {
+        const time_shield::astronomy::LunationTable& lunations = table();
+        const std::vector<double>& values = random_times();
+        for (auto _ : state) {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                count += lunations.is_full_moon_window(values[i]) ? 1u : 0u;
+            }
+            benchmark::DoNotOptimize(count);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_LunationTable_is_full_moon_window);
+
+    /// \brief All four predicates over 40 years of hourly bars.
+    void BM_LunationTable_window_flags(benchmark::State& state) {
+        const time_shield::astronomy::LunationTable& lunations = table();
+        const std::vector<double>& values = hourly_bars();
+        std::vector<std::uint8_t> flags(values.size());
+        for (auto _ : state) {
+            lunations.window_flags(values.data(), flags.data(), values.size());
+            benchmark::DoNotOptimize(flags.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_LunationTable_window_flags);
+
+    void BM_LunationTable_build(benchmark::State& state) {
+        for (auto _ : state) {
+            time_shield::astronomy::LunationTable lunations(946684800.0, 2208988800.0);
+            benchmark::DoNotOptimize(lunations.lunation_count());
+        }
+    }
+    BENCHMARK(BM_LunationTable_build);
+
+} // namespace
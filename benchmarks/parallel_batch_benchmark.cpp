@@ -0,0 +1,123 @@
+#include <time_shield/parallel_batch.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Strong scaling: the same batch is split over 1, 2, 4, ... threads up to the
+// hardware concurrency, so items per second against the thread argument is
+// the speed-up curve.
+
+namespace {
+
+    const std::size_t k_count = std::size_t(1) << 22;
+
+    /// \brief Random timestamps from 1970 to about 2100, sorted per 4096-element block like tick data.
+    const std::vector<time_shield::ts_ms_t>& timestamps() {
+        static const std::vector<time_shield::ts_ms_t> s_data = [] {
+            std::vector<time_shield::ts_ms_t> data(k_count);
+            std::mt19937_64 rng(0x243f6a8885a308d3ULL);
+            time_shield::ts_ms_t ts = 0;
+            for (std::size_t i = 0; i < data.size(); ++i) {
+                if (i % 4096 == 0) {
+                    ts = static_cast<time_shield::ts_ms_t>(rng() % 4102444800000ULL);
+                }
+                ts += static_cast<time_shield::ts_ms_t>(rng() % 2000);
+                data[i] = ts;
+            }
+            return data;
+        }();
+        return s_data;
+    }
+
+    const std::vector<std::string>& iso_strings() {
+        static const std::vector<std::string> s_data = [] {
+            const std::vector<time_shield::ts_ms_t>& ts = timestamps();
+            std::vector<std::string> data(ts.size());
+            for (std::size_t i = 0; i < ts.size(); ++i) {
+                data[i] = time_shield::to_iso8601_utc_ms(ts[i]);
+            }
+            return data;
+        }();
+        return s_data;
+    }
+
+    /// \brief Pool for the thread argument, created once outside the timed loop.
+    time_shield::WorkStealingPool& pool_for(const benchmark::State& state) {
+        static std::vector<std::unique_ptr<time_shield::WorkStealingPool>> s_pools(65);
+        const std::size_t threads = static_cast<std::size_t>(state.range(0));
+        if (!s_pools[threads]) {
+            s_pools[threads].reset(new time_shield::WorkStealingPool(threads));
+        }
+        return *s_pools[threads];
+    }
+
+    void thread_counts(benchmark::internal::Benchmark* bench) {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        const int max_threads = hardware == 0 ? 1 : static_cast<int>(hardware < 64 ? hardware : 64);
+        int threads = 1;
+        for (; threads < max_threads; threads *= 2) {
+            bench->Arg(threads);
+        }
+        bench->Arg(max_threads);
+    }
+
+    void BM_parallel_to_date_time_ms(benchmark::State& state) {
+        time_shield::WorkStealingPool& pool = pool_for(state);
+        const std::vector<time_shield::ts_ms_t>& input = timestamps();
+        std::vector<time_shield::DateTimeStruct> out(input.size());
+        for (auto _ : state) {
+            time_shield::parallel_to_date_time_ms(input.data(), out.data(), input.size(), pool);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(input.size()));
+    }
+    BENCHMARK(BM_parallel_to_date_time_ms)->ArgName("threads")->Apply(thread_counts)->UseRealTime();
+
+    void BM_parallel_gmt_to_zone_ms_cet(benchmark::State& state) {
+        time_shield::WorkStealingPool& pool = pool_for(state);
+        const std::vector<time_shield::ts_ms_t>& input = timestamps();
+        std::vector<time_shield::ts_ms_t> out(input.size());
+        for (auto _ : state) {
+            time_shield::parallel_gmt_to_zone_ms(input.data(), out.data(), input.size(), time_shield::CET, pool);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(input.size()));
+    }
+    BENCHMARK(BM_parallel_gmt_to_zone_ms_cet)->ArgName("threads")->Apply(thread_counts)->UseRealTime();
+
+    void BM_parallel_to_iso8601_utc_ms(benchmark::State& state) {
+        time_shield::WorkStealingPool& pool = pool_for(state);
+        const std::vector<time_shield::ts_ms_t>& input = timestamps();
+        for (auto _ : state) {
+            const time_shield::FormattedColumn column =
+                    time_shield::parallel_to_iso8601_utc_ms(input.data(), input.size(), pool);
+            benchmark::DoNotOptimize(column.chunk_count());
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(input.size()));
+    }
+    BENCHMARK(BM_parallel_to_iso8601_utc_ms)->ArgName("threads")->Apply(thread_counts)->UseRealTime();
+
+    void BM_parallel_parse_iso8601_ms(benchmark::State& state) {
+        time_shield::WorkStealingPool& pool = pool_for(state);
+        const std::vector<std::string>& input = iso_strings();
+        std::vector<time_shield::ts_ms_t> out(input.size());
+        for (auto _ : state) {
+            const std::size_t failures =
+                    time_shield::parallel_parse_iso8601_ms(input.data(), out.data(), input.size(), pool);
+            benchmark::DoNotOptimize(failures);
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(input.size()));
+    }
+    BENCHMARK(BM_parallel_parse_iso8601_ms)->ArgName("threads")->Apply(thread_counts)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,102 @@
+#include <time_shield/time_format_parser.hpp>
+#include <time_shield/time_formatting.hpp>
+#include <time_shield/time_parser.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /// \brief Builds formatted inputs for pseudo-random timestamps.
+    template<class F>
+    std::vector<std::string> make_inputs(F format) {
+        std::vector<std::string> values(1024);
+        std::mt19937_64 rng(0x853C49E6748FEA9BULL);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const std::uint64_t bits = rng();
+            values[i] = format(static_cast<time_shield::ts_ms_t>((bits >> 11) % 4102444800000ULL));
+        }
+        return values;
+    }
+
+    void BM_parse_iso8601_utc(benchmark::State& state) {
+        const std::vector<std::string> inputs = make_inputs([](time_shield::ts_ms_t ts) {
+            return time_shield::to_iso8601_utc_ms(ts);
+        });
+        std::size_t index = 0;
+        time_shield::DateTimeStruct dt;
+        time_shield::TimeZoneStruct tz;
+        for (auto _ : state) {
+            const std::string& input = inputs[index];
+            const bool is_ok = time_shield::parse_iso8601(input.data(), input.size(), dt, tz);
+            benchmark::DoNotOptimize(is_ok);
+            benchmark::DoNotOptimize(dt);
+            index = (index + 1) & (inputs.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_parse_iso8601_utc);
+
+    void BM_parse_iso8601_offset(benchmark::State& state) {
+        const std::vector<std::string> inputs = make_inputs([](time_shield::ts_ms_t ts) {
+            return time_shield::to_iso8601_ms(ts, static_cast<time_shield::tz_t>(-5 * time_shield::SEC_PER_HOUR));
+        });
+        std::size_t index = 0;
+        time_shield::DateTimeStruct dt;
+        time_shield::TimeZoneStruct tz;
+        for (auto _ : state) {
+            const std::string& input = inputs[index];
+            const bool is_ok = time_shield::parse_iso8601(input.data(), input.size(), dt, tz);
+            benchmark::DoNotOptimize(is_ok);
+            benchmark::DoNotOptimize(dt);
+            index = (index + 1) & (inputs.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_parse_iso8601_offset);
+
+    void BM_try_parse_format(benchmark::State& state) {
+        const std::string format = "%Y-%m-%d %H:%M:%S.%sss";
+        const std::vector<std::string> inputs = make_inputs([&format](time_shield::ts_ms_t ts) {
+            return time_shield::to_string_ms(format, ts);
+        });
+        std::size_t index = 0;
+        time_shield::DateTimeStruct dt;
+        time_shield::TimeZoneStruct tz;
+        for (auto _ : state) {
+            const std::string& input = inputs[index];
+            const bool is_ok = time_shield::try_parse_format(
+                input.data(), input.size(), format.data(), format.size(), dt, tz);
+            benchmark::DoNotOptimize(is_ok);
+            benchmark::DoNotOptimize(dt);
+            index = (index + 1) & (inputs.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_try_parse_format);
+
+    void BM_try_parse_format_ts_ms(benchmark::State& state) {
+        const std::string format = "%d.%m.%Y %H:%M:%S";
+        const std::vector<std::string> inputs = make_inputs([&format](time_shield::ts_ms_t ts) {
+            return time_shield::to_string_ms(format, ts);
+        });
+        std::size_t index = 0;
+        time_shield::ts_ms_t ts = 0;
+        for (auto _ : state) {
+            const std::string& input = inputs[index];
+            const bool is_ok = time_shield::try_parse_format_ts_ms(
+                input.data(), input.size(), format.data(), format.size(), ts);
+            benchmark::DoNotOptimize(is_ok);
+            benchmark::DoNotOptimize(ts);
+            index = (index + 1) & (inputs.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_try_parse_format_ts_ms);
+
+} // namespace
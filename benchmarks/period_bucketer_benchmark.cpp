@@ -0,0 +1,73 @@
+#include <time_shield/PeriodBucketer.hpp>
+#include <time_shield/date_time_conversions.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Pseudo-random millisecond timestamps spread over 1900..2100.
+    const std::vector<time_shield::ts_ms_t>& timestamps() {
+        static const std::vector<time_shield::ts_ms_t> s_values = []() {
+            std::vector<time_shield::ts_ms_t> values(4096);
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+            const std::int64_t first = -2208988800000LL;
+            const std::int64_t span = 4102444800000LL - first;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const std::uint64_t bits = rng();
+                values[i] = first + static_cast<std::int64_t>((bits >> 11) % static_cast<std::uint64_t>(span));
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    void BM_start_of_period_ms(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps();
+        std::vector<time_shield::ts_ms_t> out(values.size());
+        time_shield::ts_ms_t period = state.range(0);
+        benchmark::DoNotOptimize(period);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                out[i] = time_shield::start_of_period_ms(period, values[i]);
+            }
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_start_of_period_ms)->Arg(1000)->Arg(5000)->Arg(60000)->Arg(900000);
+
+    void BM_PeriodBucketer_scalar(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps();
+        std::vector<time_shield::ts_ms_t> out(values.size());
+        const time_shield::PeriodBucketer bucketer(state.range(0));
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                out[i] = bucketer.bucket(values[i]);
+            }
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_PeriodBucketer_scalar)->Arg(1000)->Arg(5000)->Arg(60000)->Arg(900000);
+
+    void BM_PeriodBucketer_batch(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& values = timestamps();
+        std::vector<time_shield::ts_ms_t> out(values.size());
+        const time_shield::PeriodBucketer bucketer(state.range(0));
+        for (auto _ : state) {
+            bucketer.bucket(values.data(), out.data(), values.size());
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    }
+    BENCHMARK(BM_PeriodBucketer_batch)->Arg(1000)->Arg(5000)->Arg(60000)->Arg(900000);
+
+} // namespace
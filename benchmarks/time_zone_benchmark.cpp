@@ -0,0 +1,59 @@
+#include <time_shield/time_zone_conversions.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Pseudo-random timestamps spread over 2000..2040.
+    const std::vector<time_shield::ts_t>& timestamps() {
+        static const std::vector<time_shield::ts_t> s_values = []() {
+            std::vector<time_shield::ts_t> values(4096);
+            std::mt19937_64 rng(0xDA942042E4DD58B5ULL);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                const std::uint64_t bits = rng();
+                values[i] = static_cast<time_shield::ts_t>(946684800LL
+                    + static_cast<std::int64_t>((bits >> 11) % 1262304000ULL));
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    void BM_zone_to_gmt(benchmark::State& state) {
+        const time_shield::TimeZone zone = static_cast<time_shield::TimeZone>(state.range(0));
+        const std::vector<time_shield::ts_t>& values = timestamps();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::ts_t gmt = time_shield::zone_to_gmt(values[index], zone);
+            benchmark::DoNotOptimize(gmt);
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_zone_to_gmt)
+        ->Arg(time_shield::CET)
+        ->Arg(time_shield::ET)
+        ->Arg(time_shield::SGT);
+
+    void BM_gmt_to_zone(benchmark::State& state) {
+        const time_shield::TimeZone zone = static_cast<time_shield::TimeZone>(state.range(0));
+        const std::vector<time_shield::ts_t>& values = timestamps();
+        std::size_t index = 0;
+        for (auto _ : state) {
+            const time_shield::ts_t local = time_shield::gmt_to_zone(values[index], zone);
+            benchmark::DoNotOptimize(local);
+            index = (index + 1) & (values.size() - 1);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_gmt_to_zone)
+        ->Arg(time_shield::CET)
+        ->Arg(time_shield::ET)
+        ->Arg(time_shield::SGT);
+
+} // namespace
@@ -0,0 +1,147 @@
+#include <time_shield/DeadlineTimer.hpp>
+#include <time_shield/TimerScheduler.hpp>
+#include <time_shield/wait_strategy.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using steady = std::chrono::steady_clock;
+
+    /// \brief Wait policy selected by the benchmark argument.
+    time_shield::WaitPolicy policy_for(const benchmark::State& state) {
+        switch (state.range(0)) {
+        case 1:  return time_shield::WaitPolicy::block_then_spin(std::chrono::microseconds(200));
+        case 2:  return time_shield::WaitPolicy::busy_spin();
+        default: return time_shield::WaitPolicy::block();
+        }
+    }
+
+    /// \brief Report p50/p90/p99 of the lateness samples in microseconds.
+    void set_lateness_counters(benchmark::State& state, std::vector<std::int64_t>& lateness_ns) {
+        if (lateness_ns.empty()) {
+            return;
+        }
+        std::sort(lateness_ns.begin(), lateness_ns.end());
+        const std::size_t last = lateness_ns.size() - 1;
+        state.counters["p50_us"] = static_cast<double>(lateness_ns[last * 50 / 100]) / 1000.0;
+        state.counters["p90_us"] = static_cast<double>(lateness_ns[last * 90 / 100]) / 1000.0;
+        state.counters["p99_us"] = static_cast<double>(lateness_ns[last * 99 / 100]) / 1000.0;
+    }
+
+    /// \brief Arms and cancels one timer repeatedly while the worker thread runs.
+    void BM_Timer_arm_cancel(benchmark::State& state) {
+        time_shield::TimerScheduler scheduler;
+        scheduler.run();
+        time_shield::Timer timer(scheduler);
+        timer.set_callback([]() {});
+        for (auto _ : state) {
+            timer.start(std::chrono::seconds(60));
+            timer.stop();
+        }
+        state.SetItemsProcessed(state.iterations());
+        scheduler.stop();
+    }
+    BENCHMARK(BM_Timer_arm_cancel);
+
+    /// \brief Re-arms timers while N other timers are pending in the queue.
+    void BM_Timer_rearm_with_pending(benchmark::State& state) {
+        time_shield::TimerScheduler scheduler;
+        const std::size_t pending_count = static_cast<std::size_t>(state.range(0));
+        std::vector<std::unique_ptr<time_shield::Timer>> pending;
+        pending.reserve(pending_count);
+        for (std::size_t i = 0; i < pending_count; ++i) {
+            pending.emplace_back(new time_shield::Timer(scheduler));
+            pending.back()->set_callback([]() {});
+            pending.back()->start(std::chrono::seconds(60) + std::chrono::milliseconds(static_cast<int>(i)));
+        }
+        time_shield::Timer timer(scheduler);
+        timer.set_callback([]() {});
+        for (auto _ : state) {
+            timer.start(std::chrono::seconds(30));
+        }
+        state.SetItemsProcessed(state.iterations());
+        timer.stop();
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            pending[i]->stop();
+        }
+    }
+    BENCHMARK(BM_Timer_rearm_with_pending)->Arg(16)->Arg(1024)->Arg(16384);
+
+    /// \brief Fires due single-shot timers through process().
+    void BM_TimerScheduler_process_due(benchmark::State& state) {
+        time_shield::TimerScheduler scheduler;
+        time_shield::Timer timer(scheduler);
+        timer.set_single_shot(true);
+        timer.set_callback([]() {});
+        for (auto _ : state) {
+            timer.start(std::chrono::milliseconds(0));
+            scheduler.process();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_TimerScheduler_process_due);
+
+    /// \brief Fire lateness of a 2 ms single-shot timer per worker wait policy.
+    ///
+    /// The iteration time is the lateness itself, so the reported time is the
+    /// mean lateness and the counters give its distribution.
+    void BM_TimerScheduler_fire_lateness(benchmark::State& state) {
+        time_shield::TimerScheduler scheduler;
+        scheduler.set_wait_policy(policy_for(state));
+        scheduler.run();
+        time_shield::Timer timer(scheduler);
+        timer.set_single_shot(true);
+        std::atomic<std::int64_t> fired_ns{0};
+        timer.set_callback([&fired_ns]() {
+            fired_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                steady::now().time_since_epoch()).count());
+        });
+
+        std::vector<std::int64_t> lateness_ns;
+        for (auto _ : state) {
+            fired_ns.store(0);
+            const steady::time_point expected = steady::now() + std::chrono::milliseconds(2);
+            timer.start(std::chrono::milliseconds(2));
+            while (fired_ns.load() == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            const std::int64_t late_ns = fired_ns.load() - std::chrono::duration_cast<std::chrono::nanoseconds>(
+                expected.time_since_epoch()).count();
+            lateness_ns.push_back(late_ns);
+            state.SetIterationTime(static_cast<double>(std::max<std::int64_t>(late_ns, 0)) * 1e-9);
+            timer.stop_and_wait();
+        }
+        scheduler.stop();
+        set_lateness_counters(state, lateness_ns);
+    }
+    BENCHMARK(BM_TimerScheduler_fire_lateness)
+        ->ArgName("policy")->Arg(0)->Arg(1)->Arg(2)->Iterations(200)->UseManualTime();
+
+    /// \brief Wake-up lateness of DeadlineTimer::wait() on a 500 us deadline per wait policy.
+    void BM_DeadlineTimer_wait_lateness(benchmark::State& state) {
+        const time_shield::WaitPolicy policy = policy_for(state);
+        std::vector<std::int64_t> lateness_ns;
+        for (auto _ : state) {
+            time_shield::DeadlineTimer deadline_timer(std::chrono::microseconds(500));
+            deadline_timer.wait(policy);
+            const std::int64_t late_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                steady::now() - deadline_timer.deadline()).count();
+            lateness_ns.push_back(late_ns);
+            state.SetIterationTime(static_cast<double>(late_ns) * 1e-9);
+        }
+        set_lateness_counters(state, lateness_ns);
+    }
+    BENCHMARK(BM_DeadlineTimer_wait_lateness)
+        ->ArgName("policy")->Arg(0)->Arg(1)->Arg(2)->Iterations(500)->UseManualTime();
+
+} // namespace
@@ -0,0 +1,86 @@
+#include <time_shield/TimestampCodec.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Sorted tick timestamps with 0..1023 ms gaps.
+    const std::vector<time_shield::ts_ms_t>& ticks() {
+        static const std::vector<time_shield::ts_ms_t> s_values = []() {
+            std::vector<time_shield::ts_ms_t> values(65536);
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+            time_shield::ts_ms_t t = 1700000000000LL;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                t += static_cast<time_shield::ts_ms_t>(rng() % 1024);
+                values[i] = t;
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    /// \brief One-minute bars.
+    const std::vector<time_shield::ts_ms_t>& minutes() {
+        static const std::vector<time_shield::ts_ms_t> s_values = []() {
+            std::vector<time_shield::ts_ms_t> values(65536);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                values[i] = 1700000000000LL + static_cast<time_shield::ts_ms_t>(i) * 60000;
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    std::vector<std::uint8_t> encode(const std::vector<time_shield::ts_ms_t>& values) {
+        time_shield::TimestampColumnEncoder encoder;
+        encoder.append(values.data(), values.size());
+        encoder.finish();
+        return encoder.bytes();
+    }
+
+    void encode_benchmark(benchmark::State& state, const std::vector<time_shield::ts_ms_t>& values) {
+        for (auto _ : state) {
+            time_shield::TimestampColumnEncoder encoder;
+            encoder.append(values.data(), values.size());
+            encoder.finish();
+            benchmark::DoNotOptimize(encoder.bytes().data());
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(values.size() * sizeof(time_shield::ts_ms_t)));
+    }
+
+    void decode_benchmark(benchmark::State& state, const std::vector<time_shield::ts_ms_t>& values) {
+        const std::vector<std::uint8_t> bytes = encode(values);
+        std::vector<time_shield::ts_ms_t> out(values.size());
+        for (auto _ : state) {
+            time_shield::TimestampColumnDecoder decoder(bytes.data(), bytes.size());
+            decoder.read(out.data(), out.size());
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(values.size() * sizeof(time_shield::ts_ms_t)));
+        state.counters["bits_per_value"] = static_cast<double>(bytes.size() * 8) / static_cast<double>(values.size());
+    }
+
+    void BM_TimestampCodec_encode_ticks(benchmark::State& state) {
+        encode_benchmark(state, ticks());
+    }
+    BENCHMARK(BM_TimestampCodec_encode_ticks);
+
+    void BM_TimestampCodec_decode_ticks(benchmark::State& state) {
+        decode_benchmark(state, ticks());
+    }
+    BENCHMARK(BM_TimestampCodec_decode_ticks);
+
+    void BM_TimestampCodec_decode_minutes(benchmark::State& state) {
+        decode_benchmark(state, minutes());
+    }
+    BENCHMARK(BM_TimestampCodec_decode_minutes);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,101 @@
+#include <time_shield/TimestampIndex.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief About two million sorted ticks over one year (mean gap 15 s).
+    const std::vector<time_shield::ts_ms_t>& ticks() {
+        static const std::vector<time_shield::ts_ms_t> s_values = []() {
+            std::vector<time_shield::ts_ms_t> values;
+            std::mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+            time_shield::ts_ms_t t = 1704067200000LL; // 2024-01-01
+            const time_shield::ts_ms_t stop = t + 366 * time_shield::MS_PER_DAY;
+            while (t < stop) {
+                values.push_back(t);
+                t += static_cast<time_shield::ts_ms_t>(rng() % 30000);
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    const std::vector<time_shield::ts_ms_t>& probes() {
+        static const std::vector<time_shield::ts_ms_t> s_values = []() {
+            const std::vector<time_shield::ts_ms_t>& data = ticks();
+            std::vector<time_shield::ts_ms_t> values(4096);
+            std::mt19937_64 rng(0x243F6A8885A308D3ULL);
+            const std::uint64_t span = static_cast<std::uint64_t>(data.back() - data.front());
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                values[i] = data.front() + static_cast<time_shield::ts_ms_t>(rng() % span);
+            }
+            return values;
+        }();
+        return s_values;
+    }
+
+    void BM_TimestampIndex_std_lower_bound(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& data = ticks();
+        const std::vector<time_shield::ts_ms_t>& queries = probes();
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (std::size_t i = 0; i < queries.size(); ++i) {
+                sum += static_cast<std::size_t>(std::lower_bound(data.begin(), data.end(), queries[i]) - data.begin());
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+    }
+    BENCHMARK(BM_TimestampIndex_std_lower_bound);
+
+    void BM_TimestampIndex_lower_bound(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& data = ticks();
+        const std::vector<time_shield::ts_ms_t>& queries = probes();
+        const time_shield::TimestampIndex index(data.data(), data.size());
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (std::size_t i = 0; i < queries.size(); ++i) {
+                sum += index.lower_bound(queries[i]);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(queries.size()));
+    }
+    BENCHMARK(BM_TimestampIndex_lower_bound);
+
+    void BM_TimestampIndex_day_cet(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& data = ticks();
+        const time_shield::TimestampIndex index(data.data(), data.size());
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            for (int day = 0; day < 366; ++day) {
+                sum += index.unix_day(19723 + day, time_shield::CET).size();
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * 366);
+    }
+    BENCHMARK(BM_TimestampIndex_day_cet);
+
+    void BM_TimestampIndex_for_each_day_cet(benchmark::State& state) {
+        const std::vector<time_shield::ts_ms_t>& data = ticks();
+        const time_shield::TimestampIndex index(data.data(), data.size());
+        for (auto _ : state) {
+            std::size_t sum = 0;
+            index.for_each_day([&sum](time_shield::ts_ms_t, time_shield::TimestampRange rows) { sum += rows.size(); },
+                               time_shield::CET);
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(data.size()));
+    }
+    BENCHMARK(BM_TimestampIndex_for_each_day_cet);
+
+} // namespace
+
+BENCHMARK_MAIN();
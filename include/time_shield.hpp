@@ -20,6 +20,7 @@
 #include "time_shield/date_struct.hpp"             ///< Structures representing date components.
 #include "time_shield/time_zone_struct.hpp"        ///< Structure representing a time zone.
 #include "time_shield/date_time_struct.hpp"        ///< Structure representing date and time components.
+#include "time_shield/packed_date_time.hpp"        ///< Compact packed date-time types for in-memory columns.
 #include "time_shield/DateTime.hpp"                ///< Value-type wrapper for timestamp with fixed UTC offset.
 #include "time_shield/ZonedClock.hpp"              ///< Clock wrapper for local time in named zones or fixed offsets.
 #include "time_shield/iso_week_struct.hpp"         ///< Structure representing ISO week date components.
@@ -28,18 +29,34 @@
 #include "time_shield/time_conversions.hpp"        ///< Functions for converting between different time representations.
 #include "time_shield/iso_week_conversions.hpp"    ///< Functions for ISO week date conversions and formatting.
 #include "time_shield/time_conversion_aliases.hpp" ///< Convenient conversion aliases.
+#include "time_shield/TimestampCodec.hpp"          ///< Block frame-of-reference codec for timestamp columns.
+#include "time_shield/PeriodBucketer.hpp"          ///< Floor bucketing by a fixed period with a precomputed reciprocal.
+#include "time_shield/BarAggregator.hpp"           ///< Streaming multi-timeframe OHLCV bar aggregation.
+#include "time_shield/BusinessCalendar.hpp"        ///< Holiday and trading-session calendar with a day bitset.
+#include "time_shield/TimestampIndex.hpp"          ///< Bucket directory over sorted timestamps for calendar range queries.
+#include "time_shield/calendar_ranges.hpp"         ///< Lazy day, workday, ISO week, month and year ranges.
 #include "time_shield/MoonPhase.hpp"               ///< Geocentric lunar phase calculator.
+#include "time_shield/LunationTable.hpp"           ///< Precomputed lunar quarter instants.
 #include "time_shield/time_zone_conversions.hpp"   ///< Functions for converting between time zones.
 #include "time_shield/time_zone_offset.hpp"        ///< UTC offset arithmetic helpers (UTC <-> local) and offset extraction.
 #include "time_shield/time_formatting.hpp"         ///< Functions for formatting time in various standard formats.
 #include "time_shield/time_parser.hpp"             ///< Functions for parsing time in various standard formats.
+#include "time_shield/time_literals.hpp"           ///< Compile-time ISO 8601 timestamp literals (C++17).
+#include "time_shield/FormatString.hpp"            ///< Compile-time checked format patterns for to_string (C++17).
 #if TIME_SHIELD_ENABLE_NTP_CLIENT
 #   include "time_shield/ntp_client.hpp"           ///< NTP client for time offset queries.
 #endif
 #include "time_shield/initialization.hpp"          ///< Library initialization helpers.
 #include "time_shield/TimerScheduler.hpp"          ///< Timer scheduler utilities.
+#include "time_shield/WorkStealingPool.hpp"        ///< Fork-join work-stealing pool for batch conversions.
+#include "time_shield/parallel_batch.hpp"          ///< Chunked parallel conversion, formatting and parsing of timestamp arrays.
 #include "time_shield/DeadlineTimer.hpp"           ///< Monotonic deadline timer helper.
 #include "time_shield/ElapsedTimer.hpp"            ///< Monotonic elapsed time measurement helper.
+#include "time_shield/LatencyHistogram.hpp"        ///< Concurrent log-linear latency histogram.
+#include "time_shield/CpuProfiler.hpp"             ///< Lock-free per-stage CPU time profiler for thread pools.
+#include "time_shield/tracing.hpp"                 ///< Compile-time gated scope probes with Chrome trace export.
+#include "time_shield/TscClock.hpp"                ///< Calibrated CPU counter clock.
+#include "time_shield/CoarseClock.hpp"             ///< Cheap millisecond clock with optional background ticker.
 
 /// \namespace tsh
 /// \brief Alias for the namespace time_shield.
@@ -0,0 +1,437 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_BAR_AGGREGATOR_HPP_INCLUDED
+#define _TIME_SHIELD_BAR_AGGREGATOR_HPP_INCLUDED
+
+/// \file BarAggregator.hpp
+/// \brief Streaming aggregation of ticks into OHLCV bars for several timeframes.
+///
+/// Each timeframe keeps its newest bar in structure-of-arrays state shared by
+/// all timeframes, so a tick that falls into the current bars touches a few
+/// contiguous arrays and performs no calendar arithmetic. Bucket boundaries are
+/// computed only when a tick leaves the current bar: fixed-offset zones use a
+/// PeriodBucketer directly, named zones with DST (for example ET) bucket the
+/// local time and convert the local boundaries back to UTC, so a New York daily
+/// bar spans 23 or 25 hours across transitions.
+///
+/// Ticks may arrive out of order by up to a configured tolerance. A bar is
+/// completed once the newest tick timestamp minus the tolerance reaches its end;
+/// ticks for bars that were already completed are dropped and counted. Buckets
+/// without ticks produce no bars.
+
+#include "config.hpp"
+#include "enums.hpp"
+#include "PeriodBucketer.hpp"
+#include "time_parser.hpp"
+#include "time_zone_conversions.hpp"
+#include "types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace time_shield {
+
+    /// \ingroup time_conversions
+    /// \brief Completed OHLCV bar.
+    struct Bar {
+        std::size_t   timeframe;    ///< Index of the timeframe in the aggregator.
+        ts_ms_t       start_ms;     ///< First UTC millisecond of the bar.
+        ts_ms_t       end_ms;       ///< UTC millisecond after the bar (exclusive).
+        double        open;         ///< Price of the earliest tick.
+        double        high;         ///< Highest price.
+        double        low;          ///< Lowest price.
+        double        close;        ///< Price of the latest tick.
+        double        volume;       ///< Sum of tick volumes.
+        std::uint64_t tick_count;   ///< Number of ticks.
+    };
+
+    /// \ingroup time_conversions
+    /// \brief Bucket definition of one aggregated timeframe.
+    struct BarTimeframe {
+        ts_ms_t  period_ms;         ///< Bar length in local milliseconds.
+        TimeZone zone;              ///< Zone whose local time aligns the buckets.
+        ts_ms_t  session_offset_ms; ///< Local time of a bucket boundary, e.g. 17 h for FX days.
+
+        /// \brief Construct timeframe from a period in milliseconds.
+        /// \param period Bar length in milliseconds.
+        /// \param align_zone Zone whose local time aligns the buckets.
+        /// \param session_offset Local time of a bucket boundary in milliseconds.
+        explicit BarTimeframe(ts_ms_t period, TimeZone align_zone = UTC, ts_ms_t session_offset = 0) noexcept
+            : period_ms(period)
+            , zone(align_zone)
+            , session_offset_ms(session_offset) {}
+
+        /// \brief Construct timeframe from a string accepted by str_to_timeframe_ms().
+        /// \param timeframe Timeframe string such as "M15", "H1" or "D1".
+        /// \param align_zone Zone whose local time aligns the buckets.
+        /// \param session_offset Local time of a bucket boundary in milliseconds.
+        /// \throws std::invalid_argument if the string is not a timeframe.
+        explicit BarTimeframe(const std::string& timeframe, TimeZone align_zone = UTC, ts_ms_t session_offset = 0)
+            : period_ms(0)
+            , zone(align_zone)
+            , session_offset_ms(session_offset) {
+            if (!str_to_timeframe_ms(timeframe, period_ms)) {
+                throw std::invalid_argument("Invalid bar timeframe");
+            }
+        }
+    };
+
+    /// \ingroup time_conversions
+    /// \brief Streaming tick-to-bar aggregator for several timeframes.
+    ///
+    /// Not thread-safe; use one instance per tick stream.
+    class BarAggregator {
+    public:
+        /// \brief Construct aggregator.
+        /// \param timeframes Timeframes to aggregate, addressed by index in emitted bars.
+        /// \param out_of_order_tolerance_ms How far behind the newest tick a tick may arrive.
+        /// \throws std::invalid_argument for empty timeframes, non-positive periods,
+        /// unsupported zones or a negative tolerance.
+        explicit BarAggregator(const std::vector<BarTimeframe>& timeframes, ts_ms_t out_of_order_tolerance_ms = 0)
+            : m_tolerance_ms(out_of_order_tolerance_ms) {
+            if (timeframes.empty()) {
+                throw std::invalid_argument("BarAggregator requires at least one timeframe");
+            }
+            if (out_of_order_tolerance_ms < 0) {
+                throw std::invalid_argument("BarAggregator tolerance must not be negative");
+            }
+            m_frames.reserve(timeframes.size());
+            for (std::size_t i = 0; i < timeframes.size(); ++i) {
+                m_frames.push_back(make_frame(timeframes[i]));
+            }
+            const std::size_t count = timeframes.size();
+            m_start.assign(count, 0);
+            m_end.assign(count, (std::numeric_limits<ts_ms_t>::min)());
+            m_open.assign(count, 0.0);
+            m_high.assign(count, 0.0);
+            m_low.assign(count, 0.0);
+            m_close.assign(count, 0.0);
+            m_volume.assign(count, 0.0);
+            m_open_ts.assign(count, 0);
+            m_close_ts.assign(count, 0);
+            m_ticks.assign(count, 0);
+            m_pending.resize(count);
+        }
+
+        /// \brief Return number of timeframes.
+        std::size_t timeframe_count() const noexcept {
+            return m_frames.size();
+        }
+
+        /// \brief Return out-of-order tolerance in milliseconds.
+        ts_ms_t out_of_order_tolerance_ms() const noexcept {
+            return m_tolerance_ms;
+        }
+
+        /// \brief Add one tick.
+        /// \param ts_ms Tick UTC timestamp in milliseconds.
+        /// \param price Tick price.
+        /// \param volume Tick volume.
+        void push(ts_ms_t ts_ms, double price, double volume) {
+            if (ts_ms > m_newest_ms) {
+                m_newest_ms = ts_ms;
+            }
+            bool is_rolled = false;
+            for (std::size_t tf = 0; tf < m_frames.size(); ++tf) {
+                if (ts_ms >= m_start[tf] && ts_ms < m_end[tf]) {
+                    update_head(tf, ts_ms, price, volume);
+                } else if (ts_ms >= m_end[tf]) {
+                    roll_head(tf, ts_ms, price, volume);
+                    is_rolled = true;
+                } else {
+                    push_late(tf, ts_ms, price, volume);
+                }
+            }
+            if (is_rolled || m_tolerance_ms > 0) {
+                complete_pending();
+            }
+        }
+
+        /// \brief Add ticks stored as separate arrays.
+        /// \param ts_ms Tick UTC timestamps in milliseconds.
+        /// \param prices Tick prices.
+        /// \param volumes Tick volumes.
+        /// \param count Number of ticks.
+        void push(const ts_ms_t* ts_ms, const double* prices, const double* volumes, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                push(ts_ms[i], prices[i], volumes[i]);
+            }
+        }
+
+        /// \brief Complete all open bars regardless of the tolerance.
+        ///
+        /// Ticks that arrive later for the same buckets open new bars.
+        void flush() {
+            for (std::size_t tf = 0; tf < m_frames.size(); ++tf) {
+                std::vector<PendingBar>& pending = m_pending[tf];
+                for (std::size_t i = 0; i < pending.size(); ++i) {
+                    m_completed.push_back(pending[i].bar);
+                }
+                pending.clear();
+                if (m_ticks[tf] != 0) {
+                    m_completed.push_back(head_bar(tf));
+                    m_ticks[tf] = 0;
+                    m_end[tf] = (std::numeric_limits<ts_ms_t>::min)();
+                }
+            }
+        }
+
+        /// \brief Move completed bars to the output vector.
+        /// \param out Vector receiving bars in completion order.
+        /// \return Number of appended bars.
+        std::size_t drain(std::vector<Bar>& out) {
+            const std::size_t count = m_completed.size();
+            if (out.empty()) {
+                out.swap(m_completed);
+            } else {
+                out.insert(out.end(), m_completed.begin(), m_completed.end());
+            }
+            m_completed.clear();
+            return count;
+        }
+
+        /// \brief Return number of completed bars waiting for drain().
+        std::size_t completed_count() const noexcept {
+            return m_completed.size();
+        }
+
+        /// \brief Copy the newest open bar of a timeframe.
+        /// \param timeframe Timeframe index.
+        /// \param out Receives the bar.
+        /// \return False when the timeframe has no open bar.
+        bool current_bar(std::size_t timeframe, Bar& out) const {
+            if (timeframe >= m_frames.size() || m_ticks[timeframe] == 0) {
+                return false;
+            }
+            out = head_bar(timeframe);
+            return true;
+        }
+
+        /// \brief Return number of ticks that arrived after their bar was completed.
+        std::uint64_t dropped_tick_count() const noexcept {
+            return m_dropped;
+        }
+
+        /// \brief Return bucket bounds of a timestamp for a timeframe.
+        /// \param timeframe Timeframe index.
+        /// \param ts_ms UTC timestamp in milliseconds.
+        /// \return Pair of UTC start and exclusive end.
+        std::pair<ts_ms_t, ts_ms_t> bucket_bounds(std::size_t timeframe, ts_ms_t ts_ms) const {
+            ts_ms_t start = 0;
+            ts_ms_t end = 0;
+            bounds(m_frames.at(timeframe), ts_ms, start, end);
+            return std::make_pair(start, end);
+        }
+
+    private:
+        struct Frame {
+            PeriodBucketer bucketer;
+            TimeZone       zone;
+            bool           is_fixed;
+        };
+
+        /// \brief Completed-in-time bar still accepting late ticks.
+        struct PendingBar {
+            Bar     bar;
+            ts_ms_t open_ts;
+            ts_ms_t close_ts;
+        };
+
+        static Frame make_frame(const BarTimeframe& timeframe) {
+            if (timeframe.period_ms <= 0) {
+                throw std::invalid_argument("BarAggregator period must be positive");
+            }
+            tz_t fixed_offset = 0;
+            bool is_fixed = true;
+            switch (timeframe.zone) {
+                case GMT:
+                case UTC:
+                    break;
+                case WET:
+                case CET:
+                case EET:
+                case ET:
+                case CT:
+                    is_fixed = false;
+                    break;
+                default:
+                    if (!detail::fixed_zone_offset(timeframe.zone, fixed_offset)) {
+                        throw std::invalid_argument("BarAggregator zone is not supported");
+                    }
+                    break;
+            }
+            // Fixed zones fold the UTC offset into the bucket phase and bucket UTC directly.
+            const ts_ms_t phase = is_fixed
+                ? timeframe.session_offset_ms - static_cast<ts_ms_t>(fixed_offset) * MS_PER_SEC
+                : timeframe.session_offset_ms;
+            Frame frame = {PeriodBucketer(timeframe.period_ms, phase), timeframe.zone, is_fixed};
+            return frame;
+        }
+
+        static void bounds(const Frame& frame, ts_ms_t ts_ms, ts_ms_t& start, ts_ms_t& end) {
+            if (frame.is_fixed) {
+                start = frame.bucketer.bucket(ts_ms);
+                end = start + frame.bucketer.period_ms();
+                return;
+            }
+            const ts_ms_t local_ms = gmt_to_zone_ms(ts_ms, frame.zone);
+            const ts_ms_t local_start = frame.bucketer.bucket(local_ms);
+            const ts_ms_t period = frame.bucketer.period_ms();
+            const ts_ms_t offset = local_ms - ts_ms;
+            start = local_start - offset;
+            end = start + period;
+            if (gmt_to_zone_ms(start, frame.zone) == local_start &&
+                gmt_to_zone_ms(end, frame.zone) == local_start + period) {
+                return;
+            }
+            // The offset changes inside the bucket. Boundaries are the UTC instants whose
+            // local time is on the bucket grid; try both grid points with the offsets one
+            // hour either side and keep the nearest ones around the tick.
+            const ts_ms_t grid[2] = {local_start, local_start + period};
+            const ts_ms_t shifts[3] = {0, -MS_PER_HOUR, MS_PER_HOUR};
+            bool has_start = false;
+            bool has_end = false;
+            for (int g = 0; g < 2; ++g) {
+                for (int k = 0; k < 3; ++k) {
+                    const ts_ms_t candidate = grid[g] - (offset + shifts[k]);
+                    if (gmt_to_zone_ms(candidate, frame.zone) != grid[g]) {
+                        continue;
+                    }
+                    if (candidate <= ts_ms) {
+                        if (!has_start || candidate > start) {
+                            start = candidate;
+                            has_start = true;
+                        }
+                    } else if (!has_end || candidate < end) {
+                        end = candidate;
+                        has_end = true;
+                    }
+                }
+            }
+            if (!has_start) {
+                start = local_start - offset;
+            }
+            if (!has_end) {
+                // Grid point skipped by a spring-forward gap.
+                end = start + period;
+            }
+        }
+
+        Bar head_bar(std::size_t tf) const {
+            Bar bar = {tf, m_start[tf], m_end[tf], m_open[tf], m_high[tf], m_low[tf],
+                       m_close[tf], m_volume[tf], m_ticks[tf]};
+            return bar;
+        }
+
+        void update_head(std::size_t tf, ts_ms_t ts_ms, double price, double volume) {
+            m_high[tf] = price > m_high[tf] ? price : m_high[tf];
+            m_low[tf] = price < m_low[tf] ? price : m_low[tf];
+            if (ts_ms >= m_close_ts[tf]) {
+                m_close[tf] = price;
+                m_close_ts[tf] = ts_ms;
+            }
+            if (ts_ms < m_open_ts[tf]) {
+                m_open[tf] = price;
+                m_open_ts[tf] = ts_ms;
+            }
+            m_volume[tf] += volume;
+            ++m_ticks[tf];
+        }
+
+        void roll_head(std::size_t tf, ts_ms_t ts_ms, double price, double volume) {
+            if (m_ticks[tf] != 0) {
+                PendingBar pending = {head_bar(tf), m_open_ts[tf], m_close_ts[tf]};
+                m_pending[tf].push_back(pending);
+            }
+            bounds(m_frames[tf], ts_ms, m_start[tf], m_end[tf]);
+            m_open[tf] = price;
+            m_high[tf] = price;
+            m_low[tf] = price;
+            m_close[tf] = price;
+            m_volume[tf] = volume;
+            m_open_ts[tf] = ts_ms;
+            m_close_ts[tf] = ts_ms;
+            m_ticks[tf] = 1;
+        }
+
+        /// \brief Route a tick older than the newest bar to an open bar or drop it.
+        void push_late(std::size_t tf, ts_ms_t ts_ms, double price, double volume) {
+            std::vector<PendingBar>& pending = m_pending[tf];
+            std::size_t pos = pending.size();
+            while (pos > 0 && ts_ms < pending[pos - 1].bar.start_ms) {
+                --pos;
+            }
+            if (pos > 0 && ts_ms < pending[pos - 1].bar.end_ms) {
+                update_pending(pending[pos - 1], ts_ms, price, volume);
+                return;
+            }
+            ts_ms_t start = 0;
+            ts_ms_t end = 0;
+            bounds(m_frames[tf], ts_ms, start, end);
+            if (end <= m_newest_ms - m_tolerance_ms) {
+                ++m_dropped;
+                return;
+            }
+            // First tick of a bucket that lies between open bars.
+            PendingBar bar = {{tf, start, end, price, price, price, price, volume, 1}, ts_ms, ts_ms};
+            pending.insert(pending.begin() + static_cast<std::ptrdiff_t>(pos), bar);
+        }
+
+        static void update_pending(PendingBar& pending, ts_ms_t ts_ms, double price, double volume) {
+            Bar& bar = pending.bar;
+            bar.high = price > bar.high ? price : bar.high;
+            bar.low = price < bar.low ? price : bar.low;
+            if (ts_ms >= pending.close_ts) {
+                bar.close = price;
+                pending.close_ts = ts_ms;
+            }
+            if (ts_ms < pending.open_ts) {
+                bar.open = price;
+                pending.open_ts = ts_ms;
+            }
+            bar.volume += volume;
+            ++bar.tick_count;
+        }
+
+        void complete_pending() {
+            const ts_ms_t watermark = m_newest_ms - m_tolerance_ms;
+            for (std::size_t tf = 0; tf < m_pending.size(); ++tf) {
+                std::vector<PendingBar>& pending = m_pending[tf];
+                std::size_t done = 0;
+                while (done < pending.size() && pending[done].bar.end_ms <= watermark) {
+                    m_completed.push_back(pending[done].bar);
+                    ++done;
+                }
+                if (done != 0) {
+                    pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(done));
+                }
+            }
+        }
+
+        std::vector<Frame>         m_frames;
+        // Newest bar of every timeframe, one array per field.
+        std::vector<ts_ms_t>       m_start;
+        std::vector<ts_ms_t>       m_end;
+        std::vector<double>        m_open;
+        std::vector<double>        m_high;
+        std::vector<double>        m_low;
+        std::vector<double>        m_close;
+        std::vector<double>        m_volume;
+        std::vector<ts_ms_t>       m_open_ts;
+        std::vector<ts_ms_t>       m_close_ts;
+        std::vector<std::uint64_t> m_ticks;
+        std::vector<std::vector<PendingBar>> m_pending; ///< Older bars inside the tolerance, by start.
+        std::vector<Bar>           m_completed;
+        ts_ms_t                    m_tolerance_ms;
+        ts_ms_t                    m_newest_ms{(std::numeric_limits<ts_ms_t>::min)()};
+        std::uint64_t              m_dropped{0};
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_BAR_AGGREGATOR_HPP_INCLUDED
@@ -0,0 +1,734 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_BUSINESS_CALENDAR_HPP_INCLUDED
+#define _TIME_SHIELD_BUSINESS_CALENDAR_HPP_INCLUDED
+
+/// \file BusinessCalendar.hpp
+/// \brief Exchange holiday and trading-session calendar backed by a day bitset.
+///
+/// Business days of a loaded range are stored one bit per unix day, with a
+/// running count of business days before every 64-bit word. is_business_day()
+/// reads one bit, business_days_between() is two rank lookups with a popcount
+/// each, and add_business_days() guesses the target word by interpolating over
+/// the word ranks, walks linearly to the exact word (usually a step or two) and
+/// selects the bit inside it. Days outside the range follow the weekly weekend
+/// rule, so queries never fail at the range edges.
+///
+/// Calendars are built in code or loaded from a line-based text file:
+/// \code
+/// # NYSE 2024
+/// zone ET
+/// range 2024-01-01 2024-12-31
+/// weekend SAT SUN
+/// session 09:30 16:00
+/// holiday 2024-01-01 New Year's Day
+/// session 2024-11-29 09:30 13:00
+/// business 2024-03-02
+/// \endcode
+/// `session DATE OPEN CLOSE` sets a special session such as a half-day (at
+/// most one per day) and `business DATE` turns a weekend day into a business
+/// day. save_binary() and load_binary() store the same data in a compact
+/// little-endian format.
+
+#include "config.hpp"
+#include "enums.hpp"
+#include "constants.hpp"
+#include "time_parser.hpp"
+#include "time_zone_conversions.hpp"
+#include "types.hpp"
+#include "validation.hpp"
+#include "detail/bit_ops.hpp"
+#include "detail/floor_math.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace time_shield {
+
+    namespace detail {
+
+        constexpr std::uint8_t BUSINESS_WEEKEND_MASK = (1u << SAT) | (1u << SUN); ///< Default weekend.
+        constexpr std::uint8_t BUSINESS_ALL_DAYS_MASK = 0x7F;
+        constexpr uint64_t BUSINESS_BINARY_VERSION = 1;
+        constexpr int64_t BUSINESS_MAX_BINARY_DAYS = 3660000;   ///< About 10000 years.
+        /// Largest |first day| accepted by load_binary(); keeps every day of the range and its millisecond timestamp in range.
+        constexpr int64_t BUSINESS_MAX_BINARY_FIRST_DAY = INT64_MAX / MS_PER_DAY - BUSINESS_MAX_BINARY_DAYS;
+
+    } // namespace detail
+
+    /// \ingroup time_conversions
+    /// \brief Session hours of one day in milliseconds after local midnight.
+    struct SessionHours {
+        ts_ms_t open_ms;    ///< Session open, in `[0, MS_PER_DAY)`.
+        ts_ms_t close_ms;   ///< Session close (exclusive), in `(open_ms, MS_PER_DAY]`.
+    };
+
+    /// \ingroup time_conversions
+    /// \brief Business-day and trading-session calendar indexed by unix day.
+    ///
+    /// Day numbers are local calendar dates of the calendar zone. Queries are
+    /// const and may run concurrently; modifications are not synchronized.
+    class BusinessCalendar {
+    public:
+        /// \brief Bit of a weekday in a weekend mask.
+        static TIME_SHIELD_CONSTEXPR std::uint8_t weekday_bit(Weekday day) noexcept {
+            return static_cast<std::uint8_t>(1u << static_cast<unsigned>(day));
+        }
+
+        /// \brief Construct a calendar without a day range; only the weekend rule applies.
+        BusinessCalendar()
+            : BusinessCalendar(0, -1) {}
+
+        /// \brief Construct a calendar for an inclusive day range.
+        ///
+        /// Every day of the range starts as a business day unless it is a weekend day.
+        /// \param first_day First unix day of the range.
+        /// \param last_day Last unix day of the range; `first_day - 1` gives an empty range.
+        /// \param zone Zone of the session hours.
+        /// \param weekend_mask Weekend days as weekday_bit() flags.
+        /// \throws std::invalid_argument for a reversed range, an unknown zone or a
+        /// weekend covering the whole week.
+        BusinessCalendar(dse_t first_day,
+                         dse_t last_day,
+                         TimeZone zone = UTC,
+                         std::uint8_t weekend_mask = detail::BUSINESS_WEEKEND_MASK)
+            : m_first_day(first_day)
+            , m_zone(zone)
+            , m_weekend_mask(weekend_mask)
+            , m_default_session(SessionHours{0, MS_PER_DAY}) {
+            if (last_day < first_day - 1) {
+                throw std::invalid_argument("BusinessCalendar range is reversed");
+            }
+            if (zone == UNKNOWN) {
+                throw std::invalid_argument("BusinessCalendar zone is unknown");
+            }
+            if ((weekend_mask & detail::BUSINESS_ALL_DAYS_MASK) == detail::BUSINESS_ALL_DAYS_MASK) {
+                throw std::invalid_argument("BusinessCalendar weekend covers the whole week");
+            }
+            m_weekend_mask = static_cast<std::uint8_t>(weekend_mask & detail::BUSINESS_ALL_DAYS_MASK);
+            m_pattern_mask = static_cast<std::uint8_t>(~m_weekend_mask & detail::BUSINESS_ALL_DAYS_MASK);
+            m_pattern_count = static_cast<int64_t>(detail::popcount_u64(m_pattern_mask));
+            m_day_count = last_day - first_day + 1;
+            m_bits.assign(static_cast<std::size_t>((m_day_count + 63) / 64), 0);
+            for (int64_t offset = 0; offset < m_day_count; ++offset) {
+                if (is_pattern_day(first_day + offset)) {
+                    m_bits[static_cast<std::size_t>(offset / 64)] |= UINT64_C(1) << (offset % 64);
+                }
+            }
+            rebuild_ranks(0);
+        }
+
+        /// \brief First unix day of the range.
+        dse_t first_day() const noexcept {
+            return m_first_day;
+        }
+
+        /// \brief Last unix day of the range.
+        dse_t last_day() const noexcept {
+            return m_first_day + m_day_count - 1;
+        }
+
+        /// \brief Zone of the session hours.
+        TimeZone zone() const noexcept {
+            return m_zone;
+        }
+
+        /// \brief Weekend days as weekday_bit() flags.
+        std::uint8_t weekend_mask() const noexcept {
+            return m_weekend_mask;
+        }
+
+        /// \brief Check whether a unix day is a business day.
+        bool is_business_day(dse_t day) const noexcept {
+            const int64_t offset = day - m_first_day;
+            if (offset < 0 || offset >= m_day_count) {
+                return is_pattern_day(day);
+            }
+            return ((m_bits[static_cast<std::size_t>(offset / 64)] >> (offset % 64)) & 1u) != 0;
+        }
+
+        /// \brief Check whether a UTC timestamp falls on a business day of the calendar zone.
+        bool is_business_day_ms(ts_ms_t ts_ms) const {
+            return is_business_day(local_day(ts_ms));
+        }
+
+        /// \brief Count business days in `[from, to)`; negative when `to < from`.
+        int64_t business_days_between(dse_t from, dse_t to) const noexcept {
+            return rank(to) - rank(from);
+        }
+
+        /// \brief Move by a number of business days.
+        ///
+        /// Positive counts return the n-th business day after `day`, negative counts
+        /// the n-th business day before it; zero returns `day` unchanged.
+        dse_t add_business_days(dse_t day, int64_t count) const noexcept {
+            if (count > 0) {
+                return select(rank(day + 1) + count - 1);
+            }
+            if (count < 0) {
+                return select(rank(day) + count);
+            }
+            return day;
+        }
+
+        /// \brief Return the first business day after `day`.
+        dse_t next_business_day(dse_t day) const noexcept {
+            return add_business_days(day, 1);
+        }
+
+        /// \brief Return the last business day before `day`.
+        dse_t prev_business_day(dse_t day) const noexcept {
+            return add_business_days(day, -1);
+        }
+
+        /// \brief Return `day` if it is a business day, otherwise the next one.
+        dse_t roll_forward(dse_t day) const noexcept {
+            return is_business_day(day) ? day : next_business_day(day);
+        }
+
+        /// \brief Return the session hours of a day (special session or the default).
+        SessionHours session_hours(dse_t day) const noexcept {
+            const std::vector<SessionEntry>::const_iterator it = find_session(day);
+            return it != m_sessions.end() && it->day == day ? it->hours : m_default_session;
+        }
+
+        /// \brief Return the default session hours.
+        SessionHours default_session() const noexcept {
+            return m_default_session;
+        }
+
+        /// \brief Return UTC bounds of the session of a day.
+        /// \param day Unix day in the calendar zone.
+        /// \param open_ms Receives the UTC open.
+        /// \param close_ms Receives the UTC close (exclusive).
+        /// \return False when the day is not a business day.
+        bool session(dse_t day, ts_ms_t& open_ms, ts_ms_t& close_ms) const {
+            if (!is_business_day(day)) {
+                return false;
+            }
+            const SessionHours hours = session_hours(day);
+            const ts_ms_t midnight = day * MS_PER_DAY;
+            open_ms = zone_to_gmt_ms(midnight + hours.open_ms, m_zone);
+            close_ms = zone_to_gmt_ms(midnight + hours.close_ms, m_zone);
+            return true;
+        }
+
+        /// \brief Check whether a UTC timestamp lies inside the session of its local day.
+        bool is_in_session(ts_ms_t ts_ms) const {
+            const ts_ms_t local_ms = gmt_to_zone_ms(ts_ms, m_zone);
+            const dse_t day = detail::floor_div<ts_ms_t>(local_ms, MS_PER_DAY);
+            if (!is_business_day(day)) {
+                return false;
+            }
+            const SessionHours hours = session_hours(day);
+            const ts_ms_t time_of_day = local_ms - day * MS_PER_DAY;
+            return time_of_day >= hours.open_ms && time_of_day < hours.close_ms;
+        }
+
+        /// \brief Mark a day of the range as business day or holiday.
+        /// \throws std::out_of_range if the day is outside the range.
+        void set_business_day(dse_t day, bool is_business) {
+            const int64_t offset = day - m_first_day;
+            if (offset < 0 || offset >= m_day_count) {
+                throw std::out_of_range("BusinessCalendar day is outside the range");
+            }
+            const std::size_t word = static_cast<std::size_t>(offset / 64);
+            const uint64_t bit = UINT64_C(1) << (offset % 64);
+            const uint64_t updated = is_business ? (m_bits[word] | bit) : (m_bits[word] & ~bit);
+            if (updated != m_bits[word]) {
+                m_bits[word] = updated;
+                rebuild_ranks(word);
+            }
+        }
+
+        /// \brief Set the session hours used by days without a special session.
+        /// \throws std::invalid_argument for hours outside one local day.
+        void set_default_session(SessionHours hours) {
+            check_hours(hours);
+            m_default_session = hours;
+        }
+
+        /// \brief Set a special session for one day, e.g. a half-day.
+        /// \throws std::invalid_argument for hours outside one local day.
+        void set_session(dse_t day, SessionHours hours) {
+            check_hours(hours);
+            const std::vector<SessionEntry>::iterator it = find_session(day);
+            if (it != m_sessions.end() && it->day == day) {
+                it->hours = hours;
+                return;
+            }
+            const SessionEntry entry = {day, hours};
+            m_sessions.insert(it, entry);
+        }
+
+        /// \brief Replace the calendar with one parsed from the text format.
+        /// \return False on a syntax error or two sessions for one day; the calendar is left unchanged.
+        bool load_text(std::istream& input) {
+            TextDefinition definition;
+            std::string line;
+            while (std::getline(input, line)) {
+                if (!parse_text_line(line, definition)) {
+                    return false;
+                }
+            }
+            if (!definition.has_range) {
+                return false;
+            }
+            BusinessCalendar calendar(definition.first_day, definition.last_day, definition.zone,
+                                      definition.weekend_mask);
+            calendar.m_default_session = definition.default_session;
+            for (std::size_t i = 0; i < definition.holidays.size(); ++i) {
+                if (!calendar.contains(definition.holidays[i])) {
+                    return false;
+                }
+                calendar.m_bits[calendar.word_of(definition.holidays[i])] &= ~calendar.bit_of(definition.holidays[i]);
+            }
+            for (std::size_t i = 0; i < definition.business_days.size(); ++i) {
+                if (!calendar.contains(definition.business_days[i])) {
+                    return false;
+                }
+                calendar.m_bits[calendar.word_of(definition.business_days[i])] |=
+                    calendar.bit_of(definition.business_days[i]);
+            }
+            calendar.rebuild_ranks(0);
+            std::sort(definition.sessions.begin(), definition.sessions.end(), session_less);
+            for (std::size_t i = 1; i < definition.sessions.size(); ++i) {
+                if (definition.sessions[i - 1].day == definition.sessions[i].day) {
+                    return false;
+                }
+            }
+            calendar.m_sessions.swap(definition.sessions);
+            swap(calendar);
+            return true;
+        }
+
+        /// \brief Replace the calendar with one parsed from a text file.
+        bool load_text_file(const std::string& path) {
+            std::ifstream file(path.c_str());
+            return file && load_text(file);
+        }
+
+        /// \brief Write the calendar in the binary format.
+        /// \return False when the stream fails.
+        bool save_binary(std::ostream& output) const {
+            output.write("TSBC", 4);
+            write_u64(output, detail::BUSINESS_BINARY_VERSION);
+            write_u64(output, static_cast<uint64_t>(m_first_day));
+            write_u64(output, static_cast<uint64_t>(m_day_count));
+            write_u64(output, static_cast<uint64_t>(m_zone));
+            write_u64(output, m_weekend_mask);
+            write_u64(output, static_cast<uint64_t>(m_default_session.open_ms));
+            write_u64(output, static_cast<uint64_t>(m_default_session.close_ms));
+            write_u64(output, static_cast<uint64_t>(m_sessions.size()));
+            for (std::size_t i = 0; i < m_bits.size(); ++i) {
+                write_u64(output, m_bits[i]);
+            }
+            for (std::size_t i = 0; i < m_sessions.size(); ++i) {
+                write_u64(output, static_cast<uint64_t>(m_sessions[i].day));
+                write_u64(output, static_cast<uint64_t>(m_sessions[i].hours.open_ms));
+                write_u64(output, static_cast<uint64_t>(m_sessions[i].hours.close_ms));
+            }
+            return static_cast<bool>(output);
+        }
+
+        /// \brief Replace the calendar with one read from the binary format.
+        /// \return False for malformed data; the calendar is left unchanged.
+        bool load_binary(std::istream& input) {
+            char magic[4] = {};
+            if (!input.read(magic, 4) || std::string(magic, 4) != "TSBC") {
+                return false;
+            }
+            uint64_t fields[8] = {};
+            for (std::size_t i = 0; i < 8; ++i) {
+                if (!read_u64(input, fields[i])) {
+                    return false;
+                }
+            }
+            const int64_t day_count = static_cast<int64_t>(fields[2]);
+            const uint64_t session_count = fields[7];
+            if (fields[0] != detail::BUSINESS_BINARY_VERSION || day_count < 0 || day_count > detail::BUSINESS_MAX_BINARY_DAYS ||
+                fields[3] >= static_cast<uint64_t>(UNKNOWN) || fields[4] >= detail::BUSINESS_ALL_DAYS_MASK ||
+                session_count > static_cast<uint64_t>(day_count)) {
+                return false;
+            }
+            const SessionHours default_session = {static_cast<ts_ms_t>(fields[5]), static_cast<ts_ms_t>(fields[6])};
+            if (!is_valid_hours(default_session)) {
+                return false;
+            }
+            const dse_t first_day = static_cast<dse_t>(fields[1]);
+            if (first_day > detail::BUSINESS_MAX_BINARY_FIRST_DAY || first_day < -detail::BUSINESS_MAX_BINARY_FIRST_DAY) {
+                return false;
+            }
+            BusinessCalendar calendar(first_day, first_day + day_count - 1, static_cast<TimeZone>(fields[3]),
+                                      static_cast<std::uint8_t>(fields[4]));
+            calendar.m_default_session = default_session;
+            for (std::size_t i = 0; i < calendar.m_bits.size(); ++i) {
+                if (!read_u64(input, calendar.m_bits[i])) {
+                    return false;
+                }
+            }
+            if (day_count % 64 != 0 && !calendar.m_bits.empty()) {
+                calendar.m_bits.back() &= (UINT64_C(1) << (day_count % 64)) - 1;
+            }
+            calendar.rebuild_ranks(0);
+            calendar.m_sessions.reserve(static_cast<std::size_t>(session_count));
+            for (uint64_t i = 0; i < session_count; ++i) {
+                uint64_t values[3] = {};
+                for (std::size_t k = 0; k < 3; ++k) {
+                    if (!read_u64(input, values[k])) {
+                        return false;
+                    }
+                }
+                const SessionEntry entry = {static_cast<dse_t>(values[0]),
+                                            {static_cast<ts_ms_t>(values[1]), static_cast<ts_ms_t>(values[2])}};
+                if (!is_valid_hours(entry.hours) ||
+                    (!calendar.m_sessions.empty() && calendar.m_sessions.back().day >= entry.day)) {
+                    return false;
+                }
+                calendar.m_sessions.push_back(entry);
+            }
+            swap(calendar);
+            return true;
+        }
+
+        /// \brief Write the calendar to a binary file.
+        bool save_binary_file(const std::string& path) const {
+            std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            return file && save_binary(file);
+        }
+
+        /// \brief Replace the calendar with one read from a binary file.
+        bool load_binary_file(const std::string& path) {
+            std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+            return file && load_binary(file);
+        }
+
+        /// \brief Exchange contents with another calendar.
+        void swap(BusinessCalendar& other) noexcept {
+            std::swap(m_first_day, other.m_first_day);
+            std::swap(m_day_count, other.m_day_count);
+            std::swap(m_zone, other.m_zone);
+            std::swap(m_weekend_mask, other.m_weekend_mask);
+            std::swap(m_pattern_mask, other.m_pattern_mask);
+            std::swap(m_pattern_count, other.m_pattern_count);
+            std::swap(m_default_session, other.m_default_session);
+            m_bits.swap(other.m_bits);
+            m_ranks.swap(other.m_ranks);
+            std::swap(m_words_per_rank, other.m_words_per_rank);
+            m_sessions.swap(other.m_sessions);
+        }
+
+    private:
+        struct SessionEntry {
+            dse_t        day;
+            SessionHours hours;
+        };
+
+        struct TextDefinition {
+            bool                      has_range = false;
+            dse_t                     first_day = 0;
+            dse_t                     last_day = 0;
+            TimeZone                  zone = UTC;
+            std::uint8_t              weekend_mask = detail::BUSINESS_WEEKEND_MASK;
+            SessionHours              default_session = SessionHours{0, MS_PER_DAY};
+            std::vector<dse_t>        holidays;
+            std::vector<dse_t>        business_days;
+            std::vector<SessionEntry> sessions;
+        };
+
+        static bool session_less(const SessionEntry& a, const SessionEntry& b) noexcept {
+            return a.day < b.day;
+        }
+
+        static int weekday(dse_t day) noexcept {
+            return static_cast<int>(detail::floor_mod<int64_t>(day + THU, DAYS_PER_WEEK));
+        }
+
+        bool is_pattern_day(dse_t day) const noexcept {
+            return ((m_pattern_mask >> weekday(day)) & 1u) != 0;
+        }
+
+        bool contains(dse_t day) const noexcept {
+            return day >= m_first_day && day - m_first_day < m_day_count;
+        }
+
+        std::size_t word_of(dse_t day) const noexcept {
+            return static_cast<std::size_t>((day - m_first_day) / 64);
+        }
+
+        uint64_t bit_of(dse_t day) const noexcept {
+            return UINT64_C(1) << ((day - m_first_day) % 64);
+        }
+
+        dse_t local_day(ts_ms_t ts_ms) const {
+            return detail::floor_div<ts_ms_t>(gmt_to_zone_ms(ts_ms, m_zone), MS_PER_DAY);
+        }
+
+        static bool is_valid_hours(SessionHours hours) noexcept {
+            return hours.open_ms >= 0 && hours.open_ms < hours.close_ms && hours.close_ms <= MS_PER_DAY;
+        }
+
+        static void check_hours(SessionHours hours) {
+            if (!is_valid_hours(hours)) {
+                throw std::invalid_argument("BusinessCalendar session must lie within one day");
+            }
+        }
+
+        std::vector<SessionEntry>::const_iterator find_session(dse_t day) const noexcept {
+            const SessionEntry key = {day, m_default_session};
+            return std::lower_bound(m_sessions.begin(), m_sessions.end(), key, session_less);
+        }
+
+        std::vector<SessionEntry>::iterator find_session(dse_t day) noexcept {
+            const SessionEntry key = {day, m_default_session};
+            return std::lower_bound(m_sessions.begin(), m_sessions.end(), key, session_less);
+        }
+
+        /// \brief Recompute running business-day counts from a word onwards.
+        void rebuild_ranks(std::size_t first_word) {
+            m_ranks.resize(m_bits.size() + 1);
+            if (first_word == 0) {
+                m_ranks[0] = 0;
+            }
+            for (std::size_t w = first_word; w < m_bits.size(); ++w) {
+                m_ranks[w + 1] = m_ranks[w] + static_cast<int64_t>(detail::popcount_u64(m_bits[w]));
+            }
+            m_words_per_rank = m_ranks.back() > 0
+                ? static_cast<double>(m_bits.size()) / static_cast<double>(m_ranks.back())
+                : 0.0;
+        }
+
+        /// \brief Count weekly-pattern business days in `[from, to)` for `from <= to`.
+        int64_t pattern_count(dse_t from, dse_t to) const noexcept {
+            const int64_t days = to - from;
+            const unsigned rest = static_cast<unsigned>(days % DAYS_PER_WEEK);
+            const unsigned doubled = static_cast<unsigned>(m_pattern_mask) | (static_cast<unsigned>(m_pattern_mask) << 7);
+            const unsigned window = (doubled >> weekday(from)) & ((1u << rest) - 1u);
+            return days / DAYS_PER_WEEK * m_pattern_count + static_cast<int64_t>(detail::popcount_u64(window));
+        }
+
+        /// \brief Return the number of business days in `[first_day(), day)`, negated before the range.
+        int64_t rank(dse_t day) const noexcept {
+            if (day <= m_first_day) {
+                return -pattern_count(day, m_first_day);
+            }
+            const int64_t offset = day - m_first_day;
+            if (offset >= m_day_count) {
+                return m_ranks.back() + pattern_count(m_first_day + m_day_count, day);
+            }
+            const std::size_t word = static_cast<std::size_t>(offset / 64);
+            const uint64_t below = m_bits[word] & ((UINT64_C(1) << (offset % 64)) - 1);
+            return m_ranks[word] + static_cast<int64_t>(detail::popcount_u64(below));
+        }
+
+        /// \brief Return the business day whose rank() equals the given value.
+        dse_t select(int64_t target) const noexcept {
+            if (target < 0) {
+                return pattern_nth_before(m_first_day, -target);
+            }
+            const int64_t total = m_ranks.back();
+            if (target >= total) {
+                return pattern_nth_from(m_first_day + m_day_count, target - total + 1);
+            }
+            // Business days are spread almost evenly, so interpolation lands within a word or two.
+            std::size_t word = static_cast<std::size_t>(static_cast<double>(target) * m_words_per_rank);
+            word = word < m_bits.size() ? word : m_bits.size() - 1;
+            while (m_ranks[word] > target) {
+                --word;
+            }
+            while (m_ranks[word + 1] <= target) {
+                ++word;
+            }
+            const unsigned bit = detail::select_bit_u64(m_bits[word], static_cast<unsigned>(target - m_ranks[word]));
+            return m_first_day + static_cast<int64_t>(word) * 64 + bit;
+        }
+
+        /// \brief Return the n-th (1-based) weekly-pattern business day on or after a day.
+        dse_t pattern_nth_from(dse_t from, int64_t n) const noexcept {
+            const int64_t weeks = (n - 1) / m_pattern_count;
+            dse_t day = from + weeks * DAYS_PER_WEEK;
+            int64_t left = n - weeks * m_pattern_count;
+            for (;; ++day) {
+                if (is_pattern_day(day) && --left == 0) {
+                    return day;
+                }
+            }
+        }
+
+        /// \brief Return the n-th (1-based) weekly-pattern business day before a day.
+        dse_t pattern_nth_before(dse_t before, int64_t n) const noexcept {
+            const int64_t weeks = (n - 1) / m_pattern_count;
+            dse_t day = before - weeks * DAYS_PER_WEEK;
+            int64_t left = n - weeks * m_pattern_count;
+            for (;;) {
+                --day;
+                if (is_pattern_day(day) && --left == 0) {
+                    return day;
+                }
+            }
+        }
+
+        static void write_u64(std::ostream& output, uint64_t value) {
+            char bytes[8];
+            for (int i = 0; i < 8; ++i) {
+                bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFFu);
+            }
+            output.write(bytes, 8);
+        }
+
+        static bool read_u64(std::istream& input, uint64_t& value) {
+            char bytes[8];
+            if (!input.read(bytes, 8)) {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < 8; ++i) {
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+            }
+            return true;
+        }
+
+        static bool parse_date_token(const std::string& token, dse_t& day) {
+            int year = 0;
+            int month = 0;
+            int mday = 0;
+            if (token.size() != 10 || token[4] != '-' || token[7] != '-' ||
+                !parse_digits(token, 0, 4, year) || !parse_digits(token, 5, 2, month) ||
+                !parse_digits(token, 8, 2, mday) || !is_valid_date(year, month, mday)) {
+                return false;
+            }
+            day = date_to_unix_day(year, month, mday);
+            return true;
+        }
+
+        /// \brief Parse `HH:MM` or `HH:MM:SS` as milliseconds; 24:00 is accepted as a close.
+        static bool parse_time_token(const std::string& token, ts_ms_t& ms) {
+            int hour = 0;
+            int minute = 0;
+            int second = 0;
+            if ((token.size() != 5 && token.size() != 8) || token[2] != ':' ||
+                !parse_digits(token, 0, 2, hour) || !parse_digits(token, 3, 2, minute)) {
+                return false;
+            }
+            if (token.size() == 8 && (token[5] != ':' || !parse_digits(token, 6, 2, second))) {
+                return false;
+            }
+            if (minute > 59 || second > 59 || hour > 24 || (hour == 24 && (minute != 0 || second != 0))) {
+                return false;
+            }
+            ms = static_cast<ts_ms_t>(hour) * MS_PER_HOUR + static_cast<ts_ms_t>(minute) * MS_PER_MIN +
+                 static_cast<ts_ms_t>(second) * MS_PER_SEC;
+            return true;
+        }
+
+        static bool parse_digits(const std::string& token, std::size_t pos, std::size_t count, int& value) {
+            value = 0;
+            for (std::size_t i = pos; i < pos + count; ++i) {
+                if (token[i] < '0' || token[i] > '9') {
+                    return false;
+                }
+                value = value * 10 + (token[i] - '0');
+            }
+            return true;
+        }
+
+        static bool parse_weekday_token(std::string token, Weekday& day) {
+            for (std::size_t i = 0; i < token.size(); ++i) {
+                token[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(token[i])));
+            }
+            for (int wd = SUN; wd <= SAT; ++wd) {
+                if (token == to_str(static_cast<Weekday>(wd))) {
+                    day = static_cast<Weekday>(wd);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static bool parse_text_line(const std::string& line, TextDefinition& definition) {
+            std::istringstream stream(line.substr(0, line.find('#')));
+            std::string keyword;
+            if (!(stream >> keyword)) {
+                return true;
+            }
+            std::string first;
+            std::string second;
+            std::string third;
+            if (keyword == "zone") {
+                return (stream >> first) && parse_time_zone_name(first, definition.zone) && definition.zone != UNKNOWN;
+            }
+            if (keyword == "range") {
+                definition.has_range = (stream >> first >> second) &&
+                    parse_date_token(first, definition.first_day) &&
+                    parse_date_token(second, definition.last_day) &&
+                    definition.first_day <= definition.last_day;
+                return definition.has_range;
+            }
+            if (keyword == "weekend") {
+                definition.weekend_mask = 0;
+                while (stream >> first) {
+                    Weekday day = SUN;
+                    if (!parse_weekday_token(first, day)) {
+                        return false;
+                    }
+                    definition.weekend_mask = static_cast<std::uint8_t>(definition.weekend_mask | weekday_bit(day));
+                }
+                return definition.weekend_mask != detail::BUSINESS_ALL_DAYS_MASK;
+            }
+            if (keyword == "holiday" || keyword == "business") {
+                dse_t day = 0;
+                if (!(stream >> first) || !parse_date_token(first, day)) {
+                    return false;
+                }
+                (keyword == "holiday" ? definition.holidays : definition.business_days).push_back(day);
+                return true;
+            }
+            if (keyword == "session") {
+                SessionHours hours = {0, 0};
+                if (!(stream >> first >> second)) {
+                    return false;
+                }
+                if (stream >> third) {
+                    SessionEntry entry = {0, hours};
+                    if (!parse_date_token(first, entry.day) || !parse_time_token(second, entry.hours.open_ms) ||
+                        !parse_time_token(third, entry.hours.close_ms) || !is_valid_hours(entry.hours)) {
+                        return false;
+                    }
+                    definition.sessions.push_back(entry);
+                    return true;
+                }
+                if (!parse_time_token(first, hours.open_ms) || !parse_time_token(second, hours.close_ms) ||
+                    !is_valid_hours(hours)) {
+                    return false;
+                }
+                definition.default_session = hours;
+                return true;
+            }
+            return false;
+        }
+
+        dse_t                     m_first_day;
+        int64_t                   m_day_count{0};
+        TimeZone                  m_zone;
+        std::uint8_t              m_weekend_mask;
+        std::uint8_t              m_pattern_mask{0};    ///< Business weekdays outside the range.
+        int64_t                   m_pattern_count{0};   ///< Number of business weekdays per week.
+        SessionHours              m_default_session;
+        std::vector<uint64_t>     m_bits;               ///< Bit per day of the range, set for business days.
+        std::vector<int64_t>      m_ranks;              ///< Business days before each word; back() is the total.
+        double                    m_words_per_rank{0.0}; ///< Interpolation factor for select().
+        std::vector<SessionEntry> m_sessions;           ///< Special sessions sorted by day.
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_BUSINESS_CALENDAR_HPP_INCLUDED
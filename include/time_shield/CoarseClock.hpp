@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_COARSE_CLOCK_HPP_INCLUDED
+#define _TIME_SHIELD_COARSE_CLOCK_HPP_INCLUDED
+
+/// \file CoarseClock.hpp
+/// \brief Cheap millisecond clock for event stamping.
+///
+/// CoarseClock serves millisecond and second timestamps for code that does
+/// not need sub-millisecond precision. Without a ticker, reads use the kernel
+/// coarse clocks (`CLOCK_REALTIME_COARSE`/`CLOCK_MONOTONIC_COARSE` on Linux,
+/// `GetSystemTimeAsFileTime`/`GetTickCount64` on Windows), which avoid the
+/// high-resolution counter but still cost a vDSO or system call. When the
+/// opt-in background ticker runs, it publishes the current values into a
+/// cache-line-aligned block and a read is a relaxed load of the ticking flag
+/// and of the value, both from the same cache line.
+
+#include "config.hpp"
+#include "constants.hpp"
+#include "time_utils.hpp"
+#include "types.hpp"
+
+#if TIME_SHIELD_ENABLE_NTP_CLIENT
+#   include "ntp_time_service.hpp"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace time_shield {
+
+    /// \ingroup time_utils
+    /// \brief Millisecond clock backed by kernel coarse clocks or a background ticker.
+    ///
+    /// Reads are lock-free and safe from any thread. Ticker values lag the
+    /// precise clocks by at most one tick resolution plus the wake-up latency.
+    class CoarseClock final {
+    public:
+        /// \brief Return the process-wide clock instance.
+        ///
+        /// The instance is never destroyed, so a running ticker stays valid during static teardown.
+        static CoarseClock& instance() noexcept {
+            alignas(CoarseClock) static unsigned char s_storage[sizeof(CoarseClock)];
+            static CoarseClock* p_instance = new (s_storage) CoarseClock();
+            return *p_instance;
+        }
+
+        /// \brief Construct clock without a running ticker.
+        CoarseClock() noexcept = default;
+
+        CoarseClock(const CoarseClock&) = delete;
+        CoarseClock& operator=(const CoarseClock&) = delete;
+
+        /// \brief Stop the ticker thread if it runs.
+        ~CoarseClock() {
+            stop();
+        }
+
+        /// \brief Read CLOCK_REALTIME_COARSE or the platform equivalent.
+        /// \return UTC timestamp in milliseconds with kernel tick granularity.
+        static ts_ms_t kernel_realtime_ms() noexcept {
+#       if TIME_SHIELD_PLATFORM_WINDOWS
+            FILETIME ft;
+            ::GetSystemTimeAsFileTime(&ft);
+            ULARGE_INTEGER value;
+            value.LowPart = ft.dwLowDateTime;
+            value.HighPart = ft.dwHighDateTime;
+            // FILETIME counts 100 ns intervals since 1601-01-01.
+            return static_cast<ts_ms_t>((static_cast<int64_t>(value.QuadPart) - 116444736000000000LL) / 10000);
+#       elif defined(CLOCK_REALTIME_COARSE)
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+            return static_cast<ts_ms_t>(MS_PER_SEC * ts.tv_sec + ts.tv_nsec / NS_PER_MS);
+#       else
+            return ts_ms();
+#       endif
+        }
+
+        /// \brief Read CLOCK_MONOTONIC_COARSE or the platform equivalent.
+        /// \return Monotonic milliseconds with kernel tick granularity.
+        static ts_ms_t kernel_monotonic_ms() noexcept {
+#       if TIME_SHIELD_PLATFORM_WINDOWS
+            return static_cast<ts_ms_t>(::GetTickCount64());
+#       elif defined(CLOCK_MONOTONIC_COARSE)
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+            return static_cast<ts_ms_t>(MS_PER_SEC * ts.tv_sec + ts.tv_nsec / NS_PER_MS);
+#       else
+            return time_shield::monotonic_ms();
+#       endif
+        }
+
+        /// \brief Start the background ticker.
+        /// \param resolution Publishing period, clamped to at least one millisecond.
+        /// \return True when the ticker was started, false when it already runs or the thread failed to start.
+        template<class Rep, class Period>
+        bool start(std::chrono::duration<Rep, Period> resolution) {
+            std::chrono::milliseconds period = std::chrono::duration_cast<std::chrono::milliseconds>(resolution);
+            if (period < std::chrono::milliseconds(1)) {
+                period = std::chrono::milliseconds(1);
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_thread.joinable()) {
+                return false;
+            }
+            m_resolution = period;
+            m_is_stop_requested = false;
+            publish();
+            try {
+                m_thread = std::thread(&CoarseClock::ticker_loop, this);
+            } catch (...) {
+                return false;
+            }
+            m_published.is_ticking.store(true, std::memory_order_release);
+            return true;
+        }
+
+        /// \brief Start the background ticker with one millisecond resolution.
+        bool start() {
+            return start(std::chrono::milliseconds(1));
+        }
+
+        /// \brief Stop the background ticker and return to kernel coarse reads.
+        void stop() {
+            std::thread worker;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_thread.joinable()) {
+                    return;
+                }
+                m_published.is_ticking.store(false, std::memory_order_release);
+                m_is_stop_requested = true;
+                worker = std::move(m_thread);
+            }
+            m_cv.notify_all();
+            worker.join();
+        }
+
+        /// \brief Return true while the background ticker publishes values.
+        bool running() const noexcept {
+            return m_published.is_ticking.load(std::memory_order_acquire);
+        }
+
+        /// \brief Add the NtpTimeService offset to UTC values.
+        ///
+        /// The service is not started implicitly; its offset is zero until it runs.
+        /// Has no effect when the NTP client is disabled.
+        /// \param use_ntp Apply the NTP offset when true.
+        void set_use_ntp(bool use_ntp) {
+            m_use_ntp.store(use_ntp, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_thread.joinable()) {
+                publish();
+            }
+        }
+
+        /// \brief Return true when UTC values include the NTP offset.
+        bool use_ntp() const noexcept {
+            return m_use_ntp.load(std::memory_order_relaxed);
+        }
+
+        /// \brief Return current UTC time in milliseconds.
+        ts_ms_t utc_ms() const noexcept {
+            if (m_published.is_ticking.load(std::memory_order_acquire)) {
+                return m_published.utc_ms.load(std::memory_order_relaxed);
+            }
+            return kernel_realtime_ms() + ntp_offset_ms();
+        }
+
+        /// \brief Return current UTC time in seconds.
+        ts_t utc_sec() const noexcept {
+            return static_cast<ts_t>(utc_ms() / MS_PER_SEC);
+        }
+
+        /// \brief Return monotonic milliseconds.
+        ts_ms_t monotonic_ms() const noexcept {
+            if (m_published.is_ticking.load(std::memory_order_acquire)) {
+                return m_published.monotonic_ms.load(std::memory_order_relaxed);
+            }
+            return kernel_monotonic_ms();
+        }
+
+        /// \brief Return the ticker publishing period.
+        std::chrono::milliseconds resolution() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_resolution;
+        }
+
+    private:
+        /// \brief Values read by every caller, kept apart from writer-side state.
+        struct alignas(TIME_SHIELD_CACHE_LINE_SIZE) Published {
+            std::atomic<ts_ms_t> utc_ms{0};
+            std::atomic<ts_ms_t> monotonic_ms{0};
+            std::atomic<bool>    is_ticking{false};
+        };
+
+        ts_ms_t ntp_offset_ms() const noexcept {
+#       if TIME_SHIELD_ENABLE_NTP_CLIENT
+            if (m_use_ntp.load(std::memory_order_relaxed)) {
+                return static_cast<ts_ms_t>(NtpTimeService::instance().offset_us() / US_PER_MS);
+            }
+#       endif
+            return 0;
+        }
+
+        void publish() noexcept {
+            const ts_ms_t utc = static_cast<ts_ms_t>(ts_us() / US_PER_MS) + ntp_offset_ms();
+            const ts_ms_t monotonic = time_shield::monotonic_ms();
+            m_published.utc_ms.store(utc, std::memory_order_relaxed);
+            m_published.monotonic_ms.store(monotonic, std::memory_order_relaxed);
+        }
+
+        void ticker_loop() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto next_tick = std::chrono::steady_clock::now();
+            while (!m_is_stop_requested) {
+                next_tick += m_resolution;
+                const auto now = std::chrono::steady_clock::now();
+                if (next_tick < now) {
+                    next_tick = now;
+                }
+                m_cv.wait_until(lock, next_tick, [this]() { return m_is_stop_requested; });
+                if (m_is_stop_requested) {
+                    break;
+                }
+                publish();
+            }
+        }
+
+        Published                 m_published;
+        std::atomic<bool>         m_use_ntp{false};
+        mutable std::mutex        m_mutex;
+        std::condition_variable   m_cv;
+        std::thread               m_thread;
+        std::chrono::milliseconds m_resolution{1};
+        bool                      m_is_stop_requested{false};
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_COARSE_CLOCK_HPP_INCLUDED
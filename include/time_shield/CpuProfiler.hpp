@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_CPU_PROFILER_HPP_INCLUDED
+#define _TIME_SHIELD_CPU_PROFILER_HPP_INCLUDED
+
+/// \file CpuProfiler.hpp
+/// \brief Per-stage CPU time profiler aggregating samples from many threads.
+///
+/// Each sample is measured on one thread with the per-thread CPU clock
+/// (get_thread_cpu_time()), so work done by other threads of a pool does not
+/// leak into it. Samples are added to per-thread shards with relaxed atomic
+/// operations and report() sums the shards into one table, so recording never
+/// takes a lock. The optional user/system split reads
+/// get_thread_cpu_usage() (getrusage(RUSAGE_THREAD) on Linux), which costs a
+/// system call per scope boundary.
+
+#include "config.hpp"
+#include "time_utils.hpp"
+#include "detail/thread_shards.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace time_shield {
+
+    /// \ingroup time_utils
+    /// \brief Aggregated CPU statistics of one profiler stage.
+    struct CpuStageReport {
+        std::string   name;           ///< Stage name.
+        std::uint64_t sample_count;   ///< Number of recorded samples.
+        double        cpu_sec;        ///< Total thread CPU time.
+        double        max_cpu_sec;    ///< Largest CPU time of a single sample.
+        double        user_sec;       ///< Total user-mode time; zero without the usage split.
+        double        system_sec;     ///< Total kernel-mode time; zero without the usage split.
+        double        wall_sec;       ///< Total wall time of the samples.
+
+        /// \brief Return average CPU time per sample, or NaN without samples.
+        double average_cpu_sec() const noexcept {
+            if (sample_count == 0) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            return cpu_sec / static_cast<double>(sample_count);
+        }
+
+        /// \brief Return CPU time divided by wall time, or NaN without wall time.
+        ///
+        /// Values below one mean the stage waited (blocking I/O, locks, preemption).
+        double cpu_utilization() const noexcept {
+            if (wall_sec <= 0.0) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            return cpu_sec / wall_sec;
+        }
+    };
+
+    /// \ingroup time_utils
+    /// \brief Lock-free aggregator of per-thread CPU time samples by stage.
+    ///
+    /// Stages are fixed at construction and addressed by index. record() and
+    /// ScopedCpuProfile may be used from any number of threads; report() may
+    /// run concurrently and includes samples completed before the call.
+    class CpuProfiler {
+    public:
+        /// \brief Construct profiler for the given stages.
+        /// \param stage_names Names of the stages, addressed by their index.
+        /// \param is_usage_split Collect user/system time through get_thread_cpu_usage().
+        /// \param shard_count Number of per-thread shards, at least one.
+        explicit CpuProfiler(std::vector<std::string> stage_names,
+                             bool is_usage_split = false,
+                             std::size_t shard_count = 8)
+            : m_stage_names(std::move(stage_names))
+            , m_shard_count(shard_count == 0 ? 1 : shard_count)
+            , m_is_usage_split(is_usage_split)
+            , m_shard_stride(detail::padded_shard_cells(m_stage_names.size() * CELL_COUNT))
+            , m_cells(m_shard_count * m_shard_stride) {}
+
+        CpuProfiler(const CpuProfiler&) = delete;
+        CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+        /// \brief Return number of stages.
+        std::size_t stage_count() const noexcept {
+            return m_stage_names.size();
+        }
+
+        /// \brief Return stage name by index.
+        const std::string& stage_name(std::size_t stage) const {
+            return m_stage_names.at(stage);
+        }
+
+        /// \brief Return true when samples carry the user/system split.
+        bool is_usage_split() const noexcept {
+            return m_is_usage_split;
+        }
+
+        /// \brief Add one sample to a stage; out-of-range stages are ignored.
+        /// \param stage Stage index.
+        /// \param cpu_ns Thread CPU time of the sample.
+        /// \param wall_ns Wall time of the sample.
+        /// \param user_ns User-mode part of the CPU time.
+        /// \param system_ns Kernel-mode part of the CPU time.
+        void record(std::size_t stage,
+                    std::int64_t cpu_ns,
+                    std::int64_t wall_ns,
+                    std::int64_t user_ns = 0,
+                    std::int64_t system_ns = 0) noexcept {
+            if (stage >= m_stage_names.size()) {
+                return;
+            }
+            std::atomic<std::uint64_t>* cells = &m_cells[detail::current_thread_shard(m_shard_count) * m_shard_stride + stage * CELL_COUNT];
+            const std::uint64_t cpu = clamp(cpu_ns);
+            cells[COUNT_CELL].fetch_add(1, std::memory_order_relaxed);
+            cells[CPU_CELL].fetch_add(cpu, std::memory_order_relaxed);
+            cells[USER_CELL].fetch_add(clamp(user_ns), std::memory_order_relaxed);
+            cells[SYSTEM_CELL].fetch_add(clamp(system_ns), std::memory_order_relaxed);
+            cells[WALL_CELL].fetch_add(clamp(wall_ns), std::memory_order_relaxed);
+            std::uint64_t max_cpu = cells[MAX_CPU_CELL].load(std::memory_order_relaxed);
+            while (cpu > max_cpu &&
+                   !cells[MAX_CPU_CELL].compare_exchange_weak(max_cpu, cpu, std::memory_order_relaxed)) {
+            }
+        }
+
+        /// \brief Return aggregated statistics of all stages.
+        std::vector<CpuStageReport> report() const {
+            std::vector<CpuStageReport> result;
+            result.reserve(m_stage_names.size());
+            for (std::size_t stage = 0; stage < m_stage_names.size(); ++stage) {
+                std::uint64_t totals[CELL_COUNT] = {};
+                for (std::size_t shard = 0; shard < m_shard_count; ++shard) {
+                    const std::atomic<std::uint64_t>* cells = &m_cells[shard * m_shard_stride + stage * CELL_COUNT];
+                    for (std::size_t i = 0; i < CELL_COUNT; ++i) {
+                        const std::uint64_t value = cells[i].load(std::memory_order_relaxed);
+                        if (i == MAX_CPU_CELL) {
+                            totals[i] = value > totals[i] ? value : totals[i];
+                        } else {
+                            totals[i] += value;
+                        }
+                    }
+                }
+                CpuStageReport stage_report;
+                stage_report.name = m_stage_names[stage];
+                stage_report.sample_count = totals[COUNT_CELL];
+                stage_report.cpu_sec = to_sec(totals[CPU_CELL]);
+                stage_report.max_cpu_sec = to_sec(totals[MAX_CPU_CELL]);
+                stage_report.user_sec = to_sec(totals[USER_CELL]);
+                stage_report.system_sec = to_sec(totals[SYSTEM_CELL]);
+                stage_report.wall_sec = to_sec(totals[WALL_CELL]);
+                result.push_back(stage_report);
+            }
+            return result;
+        }
+
+        /// \brief Clear all samples.
+        ///
+        /// Samples recorded concurrently with reset() may be partially kept.
+        void reset() noexcept {
+            for (std::size_t i = 0; i < m_cells.size(); ++i) {
+                m_cells[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        enum : std::size_t {
+            COUNT_CELL,
+            CPU_CELL,
+            MAX_CPU_CELL,
+            USER_CELL,
+            SYSTEM_CELL,
+            WALL_CELL,
+            CELL_COUNT
+        };
+
+        static std::uint64_t clamp(std::int64_t value_ns) noexcept {
+            return value_ns > 0 ? static_cast<std::uint64_t>(value_ns) : 0;
+        }
+
+        static double to_sec(std::uint64_t value_ns) noexcept {
+            return static_cast<double>(value_ns) / static_cast<double>(NS_PER_SEC);
+        }
+
+        std::vector<std::string> m_stage_names;
+        std::size_t m_shard_count;
+        bool m_is_usage_split;
+        std::size_t m_shard_stride;
+        std::vector<std::atomic<std::uint64_t>> m_cells;
+    };
+
+    /// \ingroup time_utils
+    /// \brief Records the CPU time of a scope into a CpuProfiler stage.
+    ///
+    /// Must be created and destroyed on the same thread. The sample is
+    /// recorded on destruction unless dismiss() was called.
+    class ScopedCpuProfile {
+    public:
+        /// \brief Start measuring the enclosing scope.
+        /// \param profiler Target profiler.
+        /// \param stage Stage index.
+        ScopedCpuProfile(CpuProfiler& profiler, std::size_t stage) noexcept
+            : m_profiler(&profiler)
+            , m_stage(stage)
+            , m_usage(profiler.is_usage_split() ? get_thread_cpu_usage() : CpuUsage{0.0, 0.0})
+            , m_wall_start(std::chrono::steady_clock::now())
+            , m_cpu_start(get_thread_cpu_time()) {}
+
+        ScopedCpuProfile(const ScopedCpuProfile&) = delete;
+        ScopedCpuProfile& operator=(const ScopedCpuProfile&) = delete;
+
+        /// \brief Record the sample unless dismissed.
+        ~ScopedCpuProfile() {
+            if (m_profiler == nullptr) {
+                return;
+            }
+            const double cpu_end = get_thread_cpu_time();
+            const std::chrono::steady_clock::time_point wall_end = std::chrono::steady_clock::now();
+            std::int64_t user_ns = 0;
+            std::int64_t system_ns = 0;
+            if (m_profiler->is_usage_split()) {
+                const CpuUsage usage = get_thread_cpu_usage();
+                user_ns = to_ns(usage.user_sec - m_usage.user_sec);
+                system_ns = to_ns(usage.system_sec - m_usage.system_sec);
+            }
+            m_profiler->record(
+                m_stage,
+                to_ns(cpu_end - m_cpu_start),
+                static_cast<std::int64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - m_wall_start).count()),
+                user_ns,
+                system_ns);
+        }
+
+        /// \brief Skip recording on destruction.
+        void dismiss() noexcept {
+            m_profiler = nullptr;
+        }
+
+    private:
+        static std::int64_t to_ns(double sec) noexcept {
+            if (!(sec > 0.0)) {
+                return 0;
+            }
+            return static_cast<std::int64_t>(std::llround(sec * static_cast<double>(NS_PER_SEC)));
+        }
+
+        CpuProfiler* m_profiler;
+        std::size_t m_stage;
+        CpuUsage m_usage;
+        std::chrono::steady_clock::time_point m_wall_start;
+        double m_cpu_start;
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_CPU_PROFILER_HPP_INCLUDED
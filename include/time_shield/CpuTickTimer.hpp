@@ -4,29 +4,42 @@
 #define _TIME_SHIELD_CPU_TICK_TIMER_HPP_INCLUDED
 
 /// \file CpuTickTimer.hpp
-/// \brief Helper class for measuring CPU time using get_cpu_time().
+/// \brief Helper class for measuring CPU time using process or thread CPU clocks.
 
 #include "time_utils.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 
 namespace time_shield {
 
+    /// \brief CPU clock read by CpuTickTimer.
+    enum class CpuClockScope : std::uint8_t {
+        Process,    ///< get_cpu_time(): CPU time of the whole process.
+        Thread      ///< get_thread_cpu_time(): CPU time of the calling thread.
+    };
+
     /// \ingroup time_utils
-    /// \brief Timer that measures CPU time ticks using get_cpu_time().
+    /// \brief Timer that measures CPU time ticks using get_cpu_time() or get_thread_cpu_time().
     /// \details Class is intended for single-threaded use and assumes that
-    /// get_cpu_time() is monotonic within the current process or thread. For
+    /// the selected clock is monotonic within the current process or thread.
+    /// With CpuClockScope::Thread the timer must be started, sampled and
+    /// stopped on the same thread; CpuProfiler aggregates such per-thread
+    /// measurements across threads. For
     /// long-running measurements (for example, durations longer than a day) it
     /// is recommended to periodically call record_sample() or restart() to
     /// limit floating-point precision loss.
     /// \note All reported durations are expressed in CPU tick units provided
-    /// by get_cpu_time().
+    /// by the selected clock (seconds).
     class CpuTickTimer {
     public:
         /// \brief Construct timer and optionally start it immediately.
         /// \param is_start_immediately Indicates whether the timer should start right away.
-        explicit CpuTickTimer(bool is_start_immediately = true) noexcept {
+        /// \param scope CPU clock to read.
+        explicit CpuTickTimer(bool is_start_immediately = true,
+                              CpuClockScope scope = CpuClockScope::Process) noexcept
+            : m_scope(scope) {
             if (is_start_immediately) {
                 start();
             }
@@ -34,7 +47,7 @@ namespace time_shield {
 
         /// \brief Start measuring CPU time.
         void start() noexcept {
-            m_start_ticks = get_cpu_time();
+            m_start_ticks = read_clock();
             m_end_ticks = m_start_ticks;
             m_is_running = true;
         }
@@ -48,15 +61,15 @@ namespace time_shield {
         /// \brief Stop measuring CPU time and freeze elapsed ticks.
         void stop() noexcept {
             if (m_is_running) {
-                m_end_ticks = get_cpu_time();
+                m_end_ticks = read_clock();
                 m_is_running = false;
             }
         }
 
         /// \brief Get elapsed CPU ticks since the last start.
-        /// \return Elapsed CPU tick units produced by get_cpu_time().
+        /// \return Elapsed CPU tick units produced by the selected clock.
         TIME_SHIELD_NODISCARD double elapsed() const noexcept {
-            const double final_ticks = m_is_running ? get_cpu_time() : m_end_ticks;
+            const double final_ticks = m_is_running ? read_clock() : m_end_ticks;
             return final_ticks - m_start_ticks;
         }
 
@@ -70,7 +83,7 @@ namespace time_shield {
                 return 0.0;
             }
 
-            const double now_ticks = get_cpu_time();
+            const double now_ticks = read_clock();
             m_last_sample_ticks = now_ticks - m_start_ticks;
             m_start_ticks = now_ticks;
 
@@ -115,7 +128,16 @@ namespace time_shield {
             return m_last_sample_ticks;
         }
 
+        /// \brief Get the CPU clock read by the timer.
+        TIME_SHIELD_NODISCARD CpuClockScope scope() const noexcept {
+            return m_scope;
+        }
+
     private:
+        double read_clock() const noexcept {
+            return m_scope == CpuClockScope::Thread ? get_thread_cpu_time() : get_cpu_time();
+        }
+
         void accumulate_ticks(double sample_ticks) noexcept {
             const double compensated = sample_ticks - m_total_compensation;
             const double updated_total = m_total_ticks + compensated;
@@ -130,6 +152,7 @@ namespace time_shield {
         double m_last_sample_ticks { 0.0 };
         std::size_t m_sample_count { 0 };
         bool m_is_running { false };
+        CpuClockScope m_scope { CpuClockScope::Process };
     };
 
 } // namespace time_shield
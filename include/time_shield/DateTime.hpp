@@ -11,6 +11,7 @@
 #include "date_conversions.hpp"
 #include "date_time_conversions.hpp"
 #include "date_time_struct.hpp"
+#include "detail/floor_math.hpp"
 #include "iso_week_conversions.hpp"
 #include "time_formatting.hpp"
 #include "time_parser.hpp"
@@ -31,9 +32,12 @@
 
 namespace time_shield {
 
+    class DateTimeView;
+
     /// \brief Represents a moment in time with optional fixed UTC offset.
     ///
     /// Equality and ordering compare the UTC instant only and ignore the stored offset.
+    /// Calendar accessors convert on every call; use view() to convert once.
     class DateTime {
     public:
         /// \brief Default constructor sets epoch with zero offset.
@@ -148,6 +152,14 @@ namespace time_shield {
             return to_date_time_ms<DateTimeStruct>(m_utc_ms);
         }
 
+        /// \brief Convert once to a view with cached local fields.
+        ///
+        /// Prefer the view when reading several calendar fields of the same value.
+        DateTimeView view() const;
+
+        /// \brief Convert once to a view with cached UTC fields.
+        DateTimeView utc_view() const;
+
         /// \brief Build instance from ISO week date interpreted in provided offset.
         static DateTime from_iso_week_date(
                 const IsoWeekDateStruct& iso,
@@ -315,23 +327,23 @@ namespace time_shield {
         }
 
         /// \brief Local hour component.
-        int hour() const {
-            return to_date_time_struct_local().hour;
+        int hour() const noexcept {
+            return time_field(local_ms(), MS_PER_HOUR, MS_PER_DAY);
         }
 
         /// \brief Local minute component.
-        int minute() const {
-            return to_date_time_struct_local().min;
+        int minute() const noexcept {
+            return time_field(local_ms(), MS_PER_MIN, MS_PER_HOUR);
         }
 
         /// \brief Local second component.
-        int second() const {
-            return to_date_time_struct_local().sec;
+        int second() const noexcept {
+            return time_field(local_ms(), MS_PER_SEC, MS_PER_MIN);
         }
 
         /// \brief Local millisecond component.
-        int millisecond() const {
-            return to_date_time_struct_local().ms;
+        int millisecond() const noexcept {
+            return time_field(local_ms(), 1, MS_PER_SEC);
         }
 
         /// \brief Local date components.
@@ -382,23 +394,23 @@ namespace time_shield {
         }
 
         /// \brief UTC hour component.
-        int utc_hour() const {
-            return to_date_time_struct_utc().hour;
+        int utc_hour() const noexcept {
+            return time_field(m_utc_ms, MS_PER_HOUR, MS_PER_DAY);
         }
 
         /// \brief UTC minute component.
-        int utc_minute() const {
-            return to_date_time_struct_utc().min;
+        int utc_minute() const noexcept {
+            return time_field(m_utc_ms, MS_PER_MIN, MS_PER_HOUR);
         }
 
         /// \brief UTC second component.
-        int utc_second() const {
-            return to_date_time_struct_utc().sec;
+        int utc_second() const noexcept {
+            return time_field(m_utc_ms, MS_PER_SEC, MS_PER_MIN);
         }
 
         /// \brief UTC millisecond component.
-        int utc_millisecond() const {
-            return to_date_time_struct_utc().ms;
+        int utc_millisecond() const noexcept {
+            return time_field(m_utc_ms, 1, MS_PER_SEC);
         }
 
         /// \brief Local weekday.
@@ -705,10 +717,135 @@ namespace time_shield {
             return m_utc_ms + offset_to_ms(m_offset);
         }
 
+        static int time_field(ts_ms_t ms, ts_ms_t unit, ts_ms_t range) noexcept {
+            return static_cast<int>(detail::floor_mod<ts_ms_t>(ms, range) / unit);
+        }
+
         ts_ms_t m_utc_ms;
         tz_t m_offset;
     };
 
+    /// \brief DateTime with calendar fields converted once.
+    ///
+    /// DateTime stores only the instant and offset, so each calendar accessor
+    /// converts again. DateTimeView performs the conversion in its constructor
+    /// and serves every field from the cached structure. Views are snapshots:
+    /// they do not follow later changes of the DateTime they were built from.
+    class DateTimeView {
+    public:
+        /// \brief Build view with fields in the stored offset.
+        static DateTimeView local(const DateTime& value) {
+            return DateTimeView(value, value.to_date_time_struct_local(), false);
+        }
+
+        /// \brief Build view with fields in UTC.
+        static DateTimeView utc(const DateTime& value) {
+            return DateTimeView(value, value.to_date_time_struct_utc(), true);
+        }
+
+        /// \brief Source value.
+        const DateTime& date_time() const noexcept {
+            return m_value;
+        }
+
+        /// \brief Cached calendar fields.
+        const DateTimeStruct& fields() const noexcept {
+            return m_fields;
+        }
+
+        /// \brief Check if fields are in UTC instead of the stored offset.
+        bool is_utc() const noexcept {
+            return m_is_utc;
+        }
+
+        /// \brief Year component.
+        year_t year() const noexcept {
+            return m_fields.year;
+        }
+
+        /// \brief Month component.
+        int month() const noexcept {
+            return m_fields.mon;
+        }
+
+        /// \brief Day component.
+        int day() const noexcept {
+            return m_fields.day;
+        }
+
+        /// \brief Hour component.
+        int hour() const noexcept {
+            return m_fields.hour;
+        }
+
+        /// \brief Minute component.
+        int minute() const noexcept {
+            return m_fields.min;
+        }
+
+        /// \brief Second component.
+        int second() const noexcept {
+            return m_fields.sec;
+        }
+
+        /// \brief Millisecond component.
+        int millisecond() const noexcept {
+            return m_fields.ms;
+        }
+
+        /// \brief Date components.
+        DateStruct date() const {
+            return create_date_struct(m_fields.year, m_fields.mon, m_fields.day);
+        }
+
+        /// \brief Time-of-day components.
+        TimeStruct time_of_day() const {
+            return create_time_struct(
+                    static_cast<int16_t>(m_fields.hour),
+                    static_cast<int16_t>(m_fields.min),
+                    static_cast<int16_t>(m_fields.sec),
+                    static_cast<int16_t>(m_fields.ms));
+        }
+
+        /// \brief Weekday.
+        Weekday weekday() const {
+            return weekday_of_date<Weekday>(date());
+        }
+
+        /// \brief ISO weekday number (1..7).
+        int iso_weekday() const {
+            return iso_weekday_of_date(m_fields.year, m_fields.mon, m_fields.day);
+        }
+
+        /// \brief ISO week date.
+        IsoWeekDateStruct iso_week_date() const {
+            return to_iso_week_date(m_fields.year, m_fields.mon, m_fields.day);
+        }
+
+        /// \brief Check if the date is a workday.
+        bool is_workday() const {
+            return time_shield::is_workday(m_fields.year, m_fields.mon, m_fields.day);
+        }
+
+    private:
+        DateTimeView(const DateTime& value, const DateTimeStruct& fields, bool is_utc) noexcept
+            : m_value(value)
+            , m_fields(fields)
+            , m_is_utc(is_utc) {}
+
+        DateTime m_value;
+        DateTimeStruct m_fields;
+        bool m_is_utc;
+    };
+
+    inline DateTimeView DateTime::view() const {
+        return DateTimeView::local(*this);
+    }
+
+    inline DateTimeView DateTime::utc_view() const {
+        return DateTimeView::utc(*this);
+    }
+
 } // namespace time_shield
 
 #endif // _TIME_SHIELD_DATE_TIME_HPP_INCLUDED
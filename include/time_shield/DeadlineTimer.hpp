@@ -12,6 +12,7 @@
 
 #include "config.hpp"
 #include "types.hpp"
+#include "wait_strategy.hpp"
 
 #include <chrono>
 
@@ -205,6 +206,20 @@ namespace time_shield {
             return m_deadline - now;
         }
 
+        /// \brief Blocks the calling thread until the deadline expires.
+        ///
+        /// The wait never returns before the deadline. Use WaitPolicy::block_then_spin()
+        /// or WaitPolicy::busy_spin() for sub-100 microsecond wake-up precision.
+        /// \param policy Wait policy.
+        /// \return False without waiting when the timer is not running or waits forever.
+        bool wait(const WaitPolicy& policy = WaitPolicy()) const {
+            if (!m_is_running || m_deadline == (time_point::max)()) {
+                return false;
+            }
+            wait_until(m_deadline, policy);
+            return true;
+        }
+
         /// \brief Extends deadline by the specified duration while preventing overflow.
         void add(duration extend_by) noexcept {
             if (!m_is_running || extend_by <= duration::zero()) {
@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_FORMAT_STRING_HPP_INCLUDED
+#define _TIME_SHIELD_FORMAT_STRING_HPP_INCLUDED
+
+/// \file FormatString.hpp
+/// \brief Format pattern for to_string() checked and tokenized at compile time (C++17 and newer).
+///
+/// to_string(const std::string&, ...) scans the pattern on every call and
+/// silently drops unknown specifiers. FormatString splits the pattern into
+/// literal runs and specifiers once, in a constant expression, and rejects
+/// specifiers that would print nothing. The common numeric fields (`%YYYY`,
+/// `%MM`, `%DD`, `%hh`, `%mm`, `%ss`, `%sss` and their strftime spellings)
+/// are written directly; the rest go through the shared specifier table.
+/// \code
+/// using namespace time_shield::literals;
+/// const std::string s = to_string_ms("%YYYY-%MM-%DD %hh:%mm:%ss"_fmt, ts_ms);
+/// \endcode
+/// Under C++20 the constructor and `_fmt` are consteval, so a bad pattern is a
+/// compile error; under C++17 declare the FormatString `constexpr` to get the
+/// same check, otherwise a bad pattern throws std::invalid_argument.
+
+#include "config.hpp"
+
+#if defined(TIME_SHIELD_CPP17)
+
+#include "types.hpp"
+#include "date_time_struct.hpp"
+#include "time_conversions.hpp"
+#include "time_formatting.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace time_shield {
+
+namespace detail {
+
+    constexpr std::size_t FORMAT_STRING_MAX_TOKENS = 64; ///< Token capacity of a FormatString.
+
+    /// \brief Output operation of a format token.
+    enum class FormatOp : uint8_t {
+        Literal,    ///< Copy a run of the pattern.
+        Year4,      ///< Four-digit year (%YYYY).
+        Month2,     ///< Two-digit month (%m, %MM).
+        Day2,       ///< Two-digit day (%d, %DD).
+        Hour2,      ///< Two-digit hour (%H, %HH, %hh).
+        Minute2,    ///< Two-digit minute (%M, %mm).
+        Second2,    ///< Two-digit second (%S, %SS, %ss).
+        Millis,     ///< Milliseconds without padding (%sss, %SSS).
+        Generic     ///< Any other specifier, rendered by process_format_impl().
+    };
+
+    /// \brief One step of a compiled format pattern.
+    struct FormatToken {
+        FormatOp    op;         ///< Output operation.
+        char        command;    ///< Specifier letter for FormatOp::Generic.
+        uint8_t     repeat;     ///< Specifier repeat count for FormatOp::Generic.
+        uint16_t    offset;     ///< Literal start within the pattern.
+        uint16_t    length;     ///< Literal length.
+    };
+
+    /// \brief Map a specifier to its output operation.
+    /// \return False if the specifier prints nothing in process_format_impl().
+    constexpr bool classify_format_specifier(char command, std::size_t repeat, FormatOp& op) noexcept {
+        op = FormatOp::Generic;
+        switch (command) {
+        case 'Y':
+            if (repeat == 4) op = FormatOp::Year4;
+            return repeat == 1 || repeat == 2 || repeat == 4 || repeat == 6;
+        case 'm':
+            op = repeat == 1 ? FormatOp::Month2 : FormatOp::Minute2;
+            return repeat <= 2;
+        case 'M':
+            if (repeat <= 2) op = repeat == 1 ? FormatOp::Minute2 : FormatOp::Month2;
+            return repeat <= 3;
+        case 'd':
+            op = FormatOp::Day2;
+            return repeat == 1;
+        case 'D':
+            if (repeat == 2) op = FormatOp::Day2;
+            return repeat <= 2;
+        case 'H':
+            op = FormatOp::Hour2;
+            return repeat <= 2;
+        case 'h':
+            if (repeat == 2) op = FormatOp::Hour2;
+            return repeat <= 2;
+        case 'S':
+        case 's':
+            if (repeat == 3) op = FormatOp::Millis;
+            else if (repeat == 2 || command == 'S') op = FormatOp::Second2;
+            return repeat <= 3;
+        case 'w':
+            return repeat == 1 || repeat == 3;
+        case 'W':
+            return repeat == 3;
+        case 'a': case 'A': case 'b': case 'B': case 'c': case 'C': case 'e': case 'F':
+        case 'g': case 'G': case 'I': case 'j': case 'k': case 'l': case 'n': case 'p':
+        case 'P': case 'r': case 'R': case 't': case 'T': case 'u': case 'V': case 'y':
+        case 'z': case 'Z':
+            return repeat == 1;
+        default:
+            return false;
+        }
+    }
+
+    inline void append_2digits(std::string& out, int value) {
+        const char digits[2] = {static_cast<char>('0' + value / 10), static_cast<char>('0' + value % 10)};
+        out.append(digits, 2);
+    }
+
+} // namespace detail
+
+    /// \ingroup time_formatting
+    /// \brief to_string() pattern validated and tokenized at compile time.
+    ///
+    /// The object refers to the pattern, which must outlive it; string
+    /// literals always do. Patterns are limited to 64 tokens (literal runs and
+    /// specifiers) and 65535 characters. Unlike the std::string overload,
+    /// unknown specifiers, unsupported repeat counts (e.g. `%YYY`) and a
+    /// trailing `%` are rejected.
+    class FormatString {
+    public:
+        /// \brief Tokenize a null-terminated pattern.
+        /// \throws std::invalid_argument if the pattern is invalid (a compile error when constant-evaluated).
+        TIME_SHIELD_CONSTEVAL explicit FormatString(const char* pattern)
+            : FormatString(pattern, length_of(pattern)) {}
+
+        /// \brief Tokenize a pattern of \p length characters.
+        /// \throws std::invalid_argument if the pattern is invalid (a compile error when constant-evaluated).
+        TIME_SHIELD_CONSTEVAL FormatString(const char* pattern, std::size_t length)
+            : m_pattern(pattern)
+            , m_length(length)
+            , m_tokens{}
+            , m_count(0) {
+            if (length > 0xFFFF) {
+                throw std::invalid_argument("FormatString pattern is too long");
+            }
+            std::size_t literal = 0;
+            std::size_t i = 0;
+            while (i < length) {
+                if (pattern[i] != '%') {
+                    ++i;
+                    continue;
+                }
+                add_literal(literal, i - literal);
+                if (i + 1 >= length) {
+                    throw std::invalid_argument("FormatString pattern ends with '%'");
+                }
+                if (pattern[i + 1] == '%') {
+                    add_literal(i + 1, 1);
+                    i += 2;
+                    literal = i;
+                    continue;
+                }
+                const char command = pattern[i + 1];
+                std::size_t next = i + 2;
+                while (next < length && pattern[next] == command) {
+                    ++next;
+                }
+                const std::size_t repeat = next - i - 1;
+                detail::FormatOp op = detail::FormatOp::Generic;
+                if (!detail::classify_format_specifier(command, repeat, op)) {
+                    throw std::invalid_argument("FormatString pattern has an unsupported specifier");
+                }
+                add_token(detail::FormatToken{op, command, static_cast<uint8_t>(repeat), 0, 0});
+                i = next;
+                literal = i;
+            }
+            add_literal(literal, length - literal);
+        }
+
+        /// \brief Pattern characters.
+        constexpr const char* data() const noexcept {
+            return m_pattern;
+        }
+
+        /// \brief Pattern length.
+        constexpr std::size_t length() const noexcept {
+            return m_length;
+        }
+
+        /// \brief Number of tokens.
+        constexpr std::size_t token_count() const noexcept {
+            return m_count;
+        }
+
+        /// \brief Token at \p index.
+        constexpr const detail::FormatToken& token(std::size_t index) const noexcept {
+            return m_tokens[index];
+        }
+
+        /// \brief Append the formatted date-time to \p out.
+        /// \param ts Timestamp passed to specifiers that need it (%s, %j).
+        /// \param utc_offset UTC offset in seconds for %z.
+        /// \param dt Local date-time fields.
+        /// \param out Output string.
+        void render(ts_t ts, tz_t utc_offset, const DateTimeStruct& dt, std::string& out) const {
+            for (std::size_t i = 0; i < m_count; ++i) {
+                const detail::FormatToken& token = m_tokens[i];
+                switch (token.op) {
+                case detail::FormatOp::Literal:
+                    out.append(m_pattern + token.offset, token.length);
+                    break;
+                case detail::FormatOp::Year4:
+                    if (dt.year < 0 || dt.year > 9999) {
+                        process_format_impl(token.command, token.repeat, ts, utc_offset, dt, out);
+                        break;
+                    }
+                    detail::append_2digits(out, static_cast<int>(dt.year / 100));
+                    detail::append_2digits(out, static_cast<int>(dt.year % 100));
+                    break;
+                case detail::FormatOp::Month2:
+                    detail::append_2digits(out, dt.mon);
+                    break;
+                case detail::FormatOp::Day2:
+                    detail::append_2digits(out, dt.day);
+                    break;
+                case detail::FormatOp::Hour2:
+                    detail::append_2digits(out, dt.hour);
+                    break;
+                case detail::FormatOp::Minute2:
+                    detail::append_2digits(out, dt.min);
+                    break;
+                case detail::FormatOp::Second2:
+                    detail::append_2digits(out, dt.sec);
+                    break;
+                case detail::FormatOp::Millis:
+                    if (dt.ms >= 100) {
+                        out += static_cast<char>('0' + dt.ms / 100);
+                        detail::append_2digits(out, dt.ms % 100);
+                    } else if (dt.ms >= 10) {
+                        detail::append_2digits(out, dt.ms);
+                    } else {
+                        out += static_cast<char>('0' + dt.ms);
+                    }
+                    break;
+                case detail::FormatOp::Generic:
+                    process_format_impl(token.command, token.repeat, ts, utc_offset, dt, out);
+                    break;
+                }
+            }
+        }
+
+    private:
+        static constexpr std::size_t length_of(const char* pattern) {
+            if (pattern == nullptr) {
+                throw std::invalid_argument("FormatString pattern is null");
+            }
+            std::size_t length = 0;
+            while (pattern[length] != '\0') {
+                ++length;
+            }
+            return length;
+        }
+
+        constexpr void add_token(const detail::FormatToken& token) {
+            if (m_count == detail::FORMAT_STRING_MAX_TOKENS) {
+                throw std::invalid_argument("FormatString pattern has too many tokens");
+            }
+            m_tokens[m_count++] = token;
+        }
+
+        constexpr void add_literal(std::size_t offset, std::size_t length) {
+            if (length != 0) {
+                add_token(detail::FormatToken{detail::FormatOp::Literal, '\0', 0,
+                                              static_cast<uint16_t>(offset), static_cast<uint16_t>(length)});
+            }
+        }
+
+        const char*         m_pattern;  ///< Pattern characters (not owned).
+        std::size_t         m_length;   ///< Pattern length.
+        detail::FormatToken m_tokens[detail::FORMAT_STRING_MAX_TOKENS]; ///< Compiled tokens.
+        std::size_t         m_count;    ///< Number of used tokens.
+    };
+
+    /// \ingroup time_formatting
+    /// \brief Convert a timestamp to a string with a compiled pattern.
+    /// \param format Compiled pattern.
+    /// \param timestamp Timestamp in seconds.
+    /// \param utc_offset UTC offset in seconds (default is 0).
+    /// \return Formatted string; same output as the std::string overload for every pattern FormatString accepts.
+    template<class T = ts_t>
+    const std::string to_string(const FormatString& format, T timestamp, tz_t utc_offset = 0) {
+        const T local_timestamp = static_cast<T>(timestamp + static_cast<T>(utc_offset));
+        const DateTimeStruct dt = to_date_time<DateTimeStruct>(local_timestamp);
+        std::string result;
+        result.reserve(format.length() + 16);
+        format.render(static_cast<ts_t>(timestamp), utc_offset, dt, result);
+        return result;
+    }
+
+    /// \ingroup time_formatting
+    /// \brief Convert a timestamp in milliseconds to a string with a compiled pattern.
+    /// \param format Compiled pattern.
+    /// \param timestamp Timestamp in milliseconds.
+    /// \param utc_offset UTC offset in seconds (default is 0).
+    /// \return Formatted string; same output as the std::string overload for every pattern FormatString accepts.
+    template<class T = ts_ms_t>
+    const std::string to_string_ms(const FormatString& format, T timestamp, tz_t utc_offset = 0) {
+        const T local_timestamp = static_cast<T>(timestamp + sec_to_ms<T, tz_t>(utc_offset));
+        const DateTimeStruct dt = to_date_time_ms<DateTimeStruct>(local_timestamp);
+        std::string result;
+        result.reserve(format.length() + 16);
+        format.render(static_cast<ts_t>(timestamp), utc_offset, dt, result);
+        return result;
+    }
+
+    inline namespace literals {
+
+        /// \brief Compiled to_string() pattern from a string literal.
+        /// \throws std::invalid_argument if the pattern is invalid (a compile error when constant-evaluated).
+        TIME_SHIELD_CONSTEVAL FormatString operator""_fmt(const char* pattern, std::size_t length) {
+            return FormatString(pattern, length);
+        }
+
+    } // inline namespace literals
+
+} // namespace time_shield
+
+#endif // defined(TIME_SHIELD_CPP17)
+
+#endif // _TIME_SHIELD_FORMAT_STRING_HPP_INCLUDED
@@ -0,0 +1,296 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_LATENCY_HISTOGRAM_HPP_INCLUDED
+#define _TIME_SHIELD_LATENCY_HISTOGRAM_HPP_INCLUDED
+
+/// \file LatencyHistogram.hpp
+/// \brief Log-linear latency histogram with wait-free concurrent recording.
+///
+/// Values are grouped HDR-style: below 128 ns every nanosecond has its own
+/// bucket, above that each power of two is split into 64 linear buckets, so a
+/// reported value is within 1/64 (about 1.6%) of the recorded one. Values above
+/// max_trackable_ns() are clamped. Memory is allocated once in the constructor.
+/// Recording threads are spread over per-thread shards and only perform
+/// relaxed atomic increments, so record() is wait-free on platforms with
+/// native 64-bit fetch-and-add.
+
+#include "config.hpp"
+#include "ElapsedTimer.hpp"
+#include "detail/bit_ops.hpp"
+#include "detail/thread_shards.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace time_shield {
+
+    /// \ingroup time_utils
+    /// \brief Immutable view of histogram counts that can be merged and queried.
+    class LatencySnapshot {
+    public:
+        static constexpr unsigned      SUB_BUCKET_BITS = 7;                           ///< Linear resolution bits.
+        static constexpr unsigned      MAX_VALUE_BITS  = 44;                          ///< Tracked values fit in 44 bits.
+        static constexpr std::size_t   SUB_BUCKET_COUNT = std::size_t(1) << SUB_BUCKET_BITS;
+        static constexpr std::size_t   BUCKET_COUNT =
+            (MAX_VALUE_BITS - SUB_BUCKET_BITS) * (SUB_BUCKET_COUNT / 2) + SUB_BUCKET_COUNT;
+
+        /// \brief Construct empty snapshot.
+        LatencySnapshot()
+            : m_counts(BUCKET_COUNT, 0) {}
+
+        /// \brief Return the largest value that is not clamped, in nanoseconds.
+        static constexpr std::int64_t max_trackable_ns() noexcept {
+            return static_cast<std::int64_t>((std::uint64_t(1) << MAX_VALUE_BITS) - 1);
+        }
+
+        /// \brief Return the bucket holding a value; negative values map to zero.
+        static std::size_t bucket_index(std::int64_t value_ns) noexcept {
+            if (value_ns <= 0) {
+                return 0;
+            }
+            std::uint64_t value = static_cast<std::uint64_t>(value_ns);
+            if (value > static_cast<std::uint64_t>(max_trackable_ns())) {
+                value = static_cast<std::uint64_t>(max_trackable_ns());
+            }
+            if (value < SUB_BUCKET_COUNT) {
+                return static_cast<std::size_t>(value);
+            }
+            const unsigned exponent = detail::highest_bit_u64(value) - SUB_BUCKET_BITS + 1;
+            const std::size_t mantissa = static_cast<std::size_t>(value >> exponent);
+            return static_cast<std::size_t>(exponent) * (SUB_BUCKET_COUNT / 2) + mantissa;
+        }
+
+        /// \brief Return the smallest value that maps to the bucket.
+        static std::int64_t bucket_lowest_ns(std::size_t index) noexcept {
+            if (index < SUB_BUCKET_COUNT) {
+                return static_cast<std::int64_t>(index);
+            }
+            const std::size_t half = SUB_BUCKET_COUNT / 2;
+            const std::size_t exponent = index / half - 1;
+            const std::size_t mantissa = index - exponent * half;
+            return static_cast<std::int64_t>(static_cast<std::uint64_t>(mantissa) << exponent);
+        }
+
+        /// \brief Return the largest value that maps to the bucket.
+        static std::int64_t bucket_highest_ns(std::size_t index) noexcept {
+            if (index < SUB_BUCKET_COUNT) {
+                return static_cast<std::int64_t>(index);
+            }
+            const std::size_t half = SUB_BUCKET_COUNT / 2;
+            const std::size_t exponent = index / half - 1;
+            return bucket_lowest_ns(index) + static_cast<std::int64_t>((std::uint64_t(1) << exponent) - 1);
+        }
+
+        /// \brief Add one value, mainly for building snapshots without a histogram.
+        void add(std::int64_t value_ns, std::uint64_t count = 1) noexcept {
+            m_counts[bucket_index(value_ns)] += count;
+            m_count += count;
+            m_sum_ns += static_cast<std::uint64_t>(clamp(value_ns)) * count;
+        }
+
+        /// \brief Merge counts of another snapshot into this one.
+        void merge(const LatencySnapshot& other) noexcept {
+            for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+                m_counts[i] += other.m_counts[i];
+            }
+            m_count += other.m_count;
+            m_sum_ns += other.m_sum_ns;
+        }
+
+        /// \brief Return number of recorded values.
+        std::uint64_t count() const noexcept {
+            return m_count;
+        }
+
+        /// \brief Return count stored in one bucket.
+        std::uint64_t bucket_count(std::size_t index) const noexcept {
+            return index < BUCKET_COUNT ? m_counts[index] : 0;
+        }
+
+        /// \brief Return mean of the recorded (clamped) values in nanoseconds.
+        double mean_ns() const noexcept {
+            return m_count == 0 ? 0.0 : static_cast<double>(m_sum_ns) / static_cast<double>(m_count);
+        }
+
+        /// \brief Return the lowest equivalent value of the smallest recorded value.
+        std::int64_t min_ns() const noexcept {
+            for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+                if (m_counts[i] != 0) {
+                    return bucket_lowest_ns(i);
+                }
+            }
+            return 0;
+        }
+
+        /// \brief Return the highest equivalent value of the largest recorded value.
+        std::int64_t max_ns() const noexcept {
+            for (std::size_t i = BUCKET_COUNT; i > 0; --i) {
+                if (m_counts[i - 1] != 0) {
+                    return bucket_highest_ns(i - 1);
+                }
+            }
+            return 0;
+        }
+
+        /// \brief Return the value at or below which the given share of values falls.
+        /// \param percentile Percentile in the range [0, 100].
+        /// \return Highest equivalent value of the bucket, or zero for an empty snapshot.
+        std::int64_t percentile_ns(double percentile) const noexcept {
+            if (m_count == 0) {
+                return 0;
+            }
+            if (!(percentile > 0.0)) {
+                return min_ns();
+            }
+            if (percentile >= 100.0) {
+                return max_ns();
+            }
+            std::uint64_t target = static_cast<std::uint64_t>(
+                std::ceil(percentile / 100.0 * static_cast<double>(m_count)));
+            if (target == 0) {
+                target = 1;
+            }
+            std::uint64_t cumulative = 0;
+            for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+                cumulative += m_counts[i];
+                if (cumulative >= target) {
+                    return bucket_highest_ns(i);
+                }
+            }
+            return max_ns();
+        }
+
+    private:
+        friend class LatencyHistogram;
+
+        static std::int64_t clamp(std::int64_t value_ns) noexcept {
+            if (value_ns < 0) {
+                return 0;
+            }
+            return value_ns > max_trackable_ns() ? max_trackable_ns() : value_ns;
+        }
+
+        std::vector<std::uint64_t> m_counts;
+        std::uint64_t m_count{0};
+        std::uint64_t m_sum_ns{0};
+    };
+
+    /// \ingroup time_utils
+    /// \brief Concurrent log-linear histogram of latencies in nanoseconds.
+    ///
+    /// record() may be called from any number of threads. Threads are assigned
+    /// to shards round-robin on first use, so contention is limited to threads
+    /// that share a shard. snapshot() sums the shards without stopping writers;
+    /// values recorded concurrently may or may not be included.
+    class LatencyHistogram {
+    public:
+        /// \brief Construct histogram with a fixed number of shards.
+        /// \param shard_count Number of shards, at least one.
+        explicit LatencyHistogram(std::size_t shard_count = 8)
+            : m_shard_count(shard_count == 0 ? 1 : shard_count)
+            , m_cells(m_shard_count * SHARD_STRIDE) {}
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        /// \brief Return the largest value that is not clamped, in nanoseconds.
+        static constexpr std::int64_t max_trackable_ns() noexcept {
+            return LatencySnapshot::max_trackable_ns();
+        }
+
+        /// \brief Return number of shards.
+        std::size_t shard_count() const noexcept {
+            return m_shard_count;
+        }
+
+        /// \brief Record one latency in nanoseconds; negative values count as zero.
+        void record(std::int64_t value_ns) noexcept {
+            std::atomic<std::uint64_t>* shard = &m_cells[detail::current_thread_shard(m_shard_count) * SHARD_STRIDE];
+            shard[LatencySnapshot::bucket_index(value_ns)].fetch_add(1, std::memory_order_relaxed);
+            shard[SUM_CELL].fetch_add(static_cast<std::uint64_t>(LatencySnapshot::clamp(value_ns)),
+                                      std::memory_order_relaxed);
+        }
+
+        /// \brief Record one latency given as a chrono duration.
+        template<class Rep, class Period>
+        void record(std::chrono::duration<Rep, Period> value) noexcept {
+            record(static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(value).count()));
+        }
+
+        /// \brief Return merged counts of all shards.
+        LatencySnapshot snapshot() const {
+            LatencySnapshot result;
+            for (std::size_t shard = 0; shard < m_shard_count; ++shard) {
+                const std::atomic<std::uint64_t>* cells = &m_cells[shard * SHARD_STRIDE];
+                for (std::size_t i = 0; i < LatencySnapshot::BUCKET_COUNT; ++i) {
+                    const std::uint64_t value = cells[i].load(std::memory_order_relaxed);
+                    result.m_counts[i] += value;
+                    result.m_count += value;
+                }
+                result.m_sum_ns += cells[SUM_CELL].load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+
+        /// \brief Clear all counts.
+        ///
+        /// Values recorded concurrently with reset() may be partially kept.
+        void reset() noexcept {
+            for (std::size_t i = 0; i < m_cells.size(); ++i) {
+                m_cells[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        static constexpr std::size_t SUM_CELL = LatencySnapshot::BUCKET_COUNT;
+        /// Buckets plus the sum cell, padded so shards start on separate cache lines.
+        static constexpr std::size_t SHARD_STRIDE = detail::padded_shard_cells(LatencySnapshot::BUCKET_COUNT + 1);
+
+        std::size_t m_shard_count;
+        std::vector<std::atomic<std::uint64_t>> m_cells;
+    };
+
+    /// \ingroup time_utils
+    /// \brief Records the lifetime of a scope into a LatencyHistogram.
+    ///
+    /// The elapsed time of the owned ElapsedTimer is recorded on destruction
+    /// unless dismiss() was called.
+    class ScopedLatencyTimer {
+    public:
+        /// \brief Start timing the enclosing scope.
+        explicit ScopedLatencyTimer(LatencyHistogram& histogram) noexcept
+            : m_histogram(&histogram)
+            , m_timer(true) {}
+
+        ScopedLatencyTimer(const ScopedLatencyTimer&) = delete;
+        ScopedLatencyTimer& operator=(const ScopedLatencyTimer&) = delete;
+
+        /// \brief Record elapsed time unless dismissed.
+        ~ScopedLatencyTimer() {
+            if (m_histogram != nullptr) {
+                m_histogram->record(m_timer.elapsed_ns());
+            }
+        }
+
+        /// \brief Skip recording on destruction.
+        void dismiss() noexcept {
+            m_histogram = nullptr;
+        }
+
+        /// \brief Return the timer measuring the scope.
+        const ElapsedTimer& timer() const noexcept {
+            return m_timer;
+        }
+
+    private:
+        LatencyHistogram* m_histogram;
+        ElapsedTimer m_timer;
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_LATENCY_HISTOGRAM_HPP_INCLUDED
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_LUNATION_TABLE_HPP_INCLUDED
+#define _TIME_SHIELD_LUNATION_TABLE_HPP_INCLUDED
+
+/// \file LunationTable.hpp
+/// \brief Precomputed Moon quarter instants for fast phase-event queries.
+/// \ingroup time_conversions
+///
+/// MoonPhase::quarter_times_unix() searches for the surrounding lunation and
+/// evaluates the corrected phase series eight times on every call. The table
+/// evaluates the series once per quarter for a time range; a query then finds
+/// the lunation by direct index (time since the first new moon divided by the
+/// synodic month, corrected by at most a step) and copies the stored values.
+/// Results are bit-identical to MoonPhase because the same series is used.
+/// Timestamps outside the range fall back to the MoonPhase calculator.
+
+#include "MoonPhase.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace time_shield {
+
+namespace astronomy {
+
+    /// \brief Flags returned by LunationTable::window_flags().
+    enum MoonWindowFlag : std::uint8_t {
+        MOON_NEW_WINDOW           = 1u << 0, ///< Within the window of a new moon.
+        MOON_FIRST_QUARTER_WINDOW = 1u << 1, ///< Within the window of a first quarter.
+        MOON_FULL_WINDOW          = 1u << 2, ///< Within the window of a full moon.
+        MOON_LAST_QUARTER_WINDOW  = 1u << 3  ///< Within the window of a last quarter.
+    };
+
+    /// \brief Table of true new moon, quarter and full moon instants for a time range.
+    ///
+    /// Immutable after construction; queries may run concurrently.
+    /// \code
+    /// LunationTable table(946684800.0, 4102444800.0); // 2000..2100
+    /// bool near_full = table.is_full_moon_window(ts, 3600.0);
+    /// \endcode
+    class LunationTable {
+    public:
+        using quarters_unix_s_t = MoonPhase::quarters_unix_s_t; ///< Same layout as MoonPhase::quarter_times_unix().
+
+        /// \brief Precompute quarter instants covering a time range.
+        /// \param from_unix_s First covered timestamp in Unix UTC seconds.
+        /// \param to_unix_s Last covered timestamp in Unix UTC seconds.
+        /// \param calculator Calculator providing the phase series and the out-of-range fallback.
+        /// \throws std::invalid_argument if the range is reversed or not finite.
+        LunationTable(double from_unix_s, double to_unix_s, const MoonPhase& calculator = MoonPhase())
+            : m_calculator(calculator) {
+            if (!(from_unix_s <= to_unix_s) || !std::isfinite(from_unix_s) || !std::isfinite(to_unix_s)) {
+                throw std::invalid_argument("LunationTable range is invalid");
+            }
+            // Two spare lunations on each side absorb the error of the index estimate.
+            m_first_index = calculator.lunation_index(from_unix_s) - 2.0;
+            const double last_index = calculator.lunation_index(to_unix_s) + 2.0;
+            const std::size_t count = static_cast<std::size_t>(last_index - m_first_index) + 1;
+            m_new_moons.resize(count);
+            m_quarters.resize(count * 4);
+            for (std::size_t i = 0; i < count; ++i) {
+                const double k = m_first_index + static_cast<double>(i);
+                for (std::size_t q = 0; q < 4; ++q) {
+                    m_quarters[i * 4 + q] = calculator.phase_instant_unix(k, 0.25 * static_cast<double>(q));
+                }
+                m_new_moons[i] = m_quarters[i * 4];
+            }
+            m_inv_span = static_cast<double>(count - 1) / (m_new_moons.back() - m_new_moons.front());
+        }
+
+        /// \brief First timestamp answered from the table.
+        double first_unix_s() const noexcept {
+            return m_new_moons.front();
+        }
+
+        /// \brief Timestamp after the last one answered from the table.
+        double end_unix_s() const noexcept {
+            return m_new_moons.back();
+        }
+
+        /// \brief Number of stored lunations.
+        std::size_t lunation_count() const noexcept {
+            return m_new_moons.size();
+        }
+
+        /// \brief Check whether a timestamp is answered from the table.
+        bool contains(double unix_utc_s) const noexcept {
+            return unix_utc_s >= m_new_moons.front() && unix_utc_s < m_new_moons.back();
+        }
+
+        /// \brief Quarter instants around a timestamp; same result as MoonPhase::quarter_times_unix().
+        /// \param unix_utc_s Timestamp in Unix UTC seconds (can be fractional).
+        /// \return {prev new, prev firstQ, prev full, prev lastQ, next new, next firstQ, next full, next lastQ}.
+        quarters_unix_s_t quarter_times_unix(double unix_utc_s) const noexcept {
+            if (!contains(unix_utc_s)) {
+                return m_calculator.quarter_times_unix(unix_utc_s);
+            }
+            const double* values = &m_quarters[lunation_slot(unix_utc_s) * 4];
+            quarters_unix_s_t out{};
+            for (std::size_t i = 0; i < 8; ++i) {
+                out[i] = values[i];
+            }
+            return out;
+        }
+
+        /// \brief Quarter instants around a timestamp as a structured result.
+        MoonQuarterInstants quarter_instants_unix(double unix_utc_s) const noexcept {
+            const quarters_unix_s_t quarters = quarter_times_unix(unix_utc_s);
+            MoonQuarterInstants out{};
+            out.previous_new_unix_s = quarters[0];
+            out.previous_first_quarter_unix_s = quarters[1];
+            out.previous_full_unix_s = quarters[2];
+            out.previous_last_quarter_unix_s = quarters[3];
+            out.next_new_unix_s = quarters[4];
+            out.next_first_quarter_unix_s = quarters[5];
+            out.next_full_unix_s = quarters[6];
+            out.next_last_quarter_unix_s = quarters[7];
+            return out;
+        }
+
+        /// \brief Check whether timestamp is inside a window around new moon.
+        bool is_new_moon_window(double unix_utc_s, double window_seconds = MoonPhase::kDefaultQuarterWindow_s) const noexcept {
+            return is_event_window(unix_utc_s, 0, window_seconds);
+        }
+
+        /// \brief Check whether timestamp is inside a window around first quarter.
+        bool is_first_quarter_window(double unix_utc_s, double window_seconds = MoonPhase::kDefaultQuarterWindow_s) const noexcept {
+            return is_event_window(unix_utc_s, 1, window_seconds);
+        }
+
+        /// \brief Check whether timestamp is inside a window around full moon.
+        bool is_full_moon_window(double unix_utc_s, double window_seconds = MoonPhase::kDefaultQuarterWindow_s) const noexcept {
+            return is_event_window(unix_utc_s, 2, window_seconds);
+        }
+
+        /// \brief Check whether timestamp is inside a window around last quarter.
+        bool is_last_quarter_window(double unix_utc_s, double window_seconds = MoonPhase::kDefaultQuarterWindow_s) const noexcept {
+            return is_event_window(unix_utc_s, 3, window_seconds);
+        }
+
+        /// \brief Evaluate all four window predicates for an array of timestamps.
+        /// \param unix_utc_s Timestamps in Unix UTC seconds; sorted input is fastest.
+        /// \param flags Output MoonWindowFlag combinations.
+        /// \param count Number of timestamps.
+        /// \param window_seconds Symmetric window size in seconds around each event.
+        void window_flags(const double* unix_utc_s,
+                          std::uint8_t* flags,
+                          std::size_t count,
+                          double window_seconds = MoonPhase::kDefaultQuarterWindow_s) const noexcept {
+            std::size_t slot = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const double ts = unix_utc_s[i];
+                quarters_unix_s_t fallback;
+                const double* values = nullptr;
+                if (contains(ts)) {
+                    // Consecutive bars usually stay in the same lunation.
+                    if (!(m_new_moons[slot] <= ts && ts < m_new_moons[slot + 1])) {
+                        slot = lunation_slot(ts);
+                    }
+                    values = &m_quarters[slot * 4];
+                } else {
+                    fallback = m_calculator.quarter_times_unix(ts);
+                    values = fallback.data();
+                }
+                std::uint8_t out = 0;
+                for (std::size_t q = 0; q < 4; ++q) {
+                    if (is_within_window(ts, values[q], values[q + 4], window_seconds)) {
+                        out = static_cast<std::uint8_t>(out | (1u << q));
+                    }
+                }
+                flags[i] = out;
+            }
+        }
+
+    private:
+        /// \brief Return the index of the lunation whose new moon starts the cycle containing a covered timestamp.
+        std::size_t lunation_slot(double unix_utc_s) const noexcept {
+            const std::size_t last = m_new_moons.size() - 2;
+            std::size_t slot = static_cast<std::size_t>((unix_utc_s - m_new_moons.front()) * m_inv_span);
+            slot = slot < last ? slot : last;
+            while (m_new_moons[slot] > unix_utc_s) {
+                --slot;
+            }
+            while (m_new_moons[slot + 1] <= unix_utc_s) {
+                ++slot;
+            }
+            return slot;
+        }
+
+        bool is_event_window(double unix_utc_s, std::size_t quarter, double window_seconds) const noexcept {
+            if (!contains(unix_utc_s)) {
+                const quarters_unix_s_t quarters = m_calculator.quarter_times_unix(unix_utc_s);
+                return is_within_window(unix_utc_s, quarters[quarter], quarters[quarter + 4], window_seconds);
+            }
+            const double* values = &m_quarters[lunation_slot(unix_utc_s) * 4];
+            return is_within_window(unix_utc_s, values[quarter], values[quarter + 4], window_seconds);
+        }
+
+        static bool is_within_window(double unix_utc_s, double previous_instant, double next_instant, double window_seconds) noexcept {
+            return std::abs(unix_utc_s - previous_instant) <= window_seconds
+                || std::abs(unix_utc_s - next_instant) <= window_seconds;
+        }
+
+        MoonPhase           m_calculator;
+        double              m_first_index = 0.0;  ///< Lunation number of the first stored cycle.
+        double              m_inv_span = 0.0;     ///< Stored cycles per second, for the direct index.
+        std::vector<double> m_new_moons;          ///< New moon instant of every stored cycle.
+        std::vector<double> m_quarters;           ///< New, first quarter, full, last quarter per cycle.
+    };
+
+} // namespace astronomy
+
+    /// \brief Convenience alias for the precomputed lunation table.
+    using MoonLunationTable = astronomy::LunationTable;
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_LUNATION_TABLE_HPP_INCLUDED
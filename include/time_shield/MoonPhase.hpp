@@ -9,10 +9,12 @@
 
 #include "date_time_conversions.hpp"
 #include "types.hpp"
+#include "detail/fast_trig.hpp"
 
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 
 namespace time_shield {
 
@@ -33,6 +35,39 @@ namespace astronomy {
         double sun_diameter_deg = 0.0;
     };
 
+    /// \brief Field selection bits for MoonPhase::compute_batch().
+    enum MoonPhaseField : std::uint32_t {
+        MOON_FIELD_PHASE            = 1u << 0,  ///< MoonPhaseResult::phase.
+        MOON_FIELD_ILLUMINATION     = 1u << 1,  ///< MoonPhaseResult::illumination.
+        MOON_FIELD_AGE_DAYS         = 1u << 2,  ///< MoonPhaseResult::age_days.
+        MOON_FIELD_DISTANCE_KM      = 1u << 3,  ///< MoonPhaseResult::distance_km.
+        MOON_FIELD_DIAMETER_DEG     = 1u << 4,  ///< MoonPhaseResult::diameter_deg.
+        MOON_FIELD_AGE_DEG          = 1u << 5,  ///< MoonPhaseResult::age_deg.
+        MOON_FIELD_PHASE_ANGLE_RAD  = 1u << 6,  ///< MoonPhaseResult::phase_angle_rad.
+        MOON_FIELD_PHASE_SIN        = 1u << 7,  ///< MoonPhaseResult::phase_sin.
+        MOON_FIELD_PHASE_COS        = 1u << 8,  ///< MoonPhaseResult::phase_cos.
+        MOON_FIELD_SUN_DISTANCE_KM  = 1u << 9,  ///< MoonPhaseResult::sun_distance_km.
+        MOON_FIELD_SUN_DIAMETER_DEG = 1u << 10, ///< MoonPhaseResult::sun_diameter_deg.
+        MOON_FIELD_ALL              = (1u << 11) - 1u ///< Every field.
+    };
+
+    /// \brief Output columns for MoonPhase::compute_batch(), one array per MoonPhaseResult field.
+    ///
+    /// Only the columns selected by the field mask are written; the others may be null.
+    struct MoonPhaseColumns {
+        double* phase = nullptr;            ///< Phase fraction in [0..1).
+        double* illumination = nullptr;     ///< Illuminated fraction in [0..1].
+        double* age_days = nullptr;         ///< Age of the Moon in days.
+        double* distance_km = nullptr;      ///< Distance to Moon in km.
+        double* diameter_deg = nullptr;     ///< Angular diameter of Moon in degrees.
+        double* age_deg = nullptr;          ///< Phase angle in degrees.
+        double* phase_angle_rad = nullptr;  ///< Phase angle in radians.
+        double* phase_sin = nullptr;        ///< sin(phase_angle_rad).
+        double* phase_cos = nullptr;        ///< cos(phase_angle_rad).
+        double* sun_distance_km = nullptr;  ///< Distance to Sun in km.
+        double* sun_diameter_deg = nullptr; ///< Angular diameter of Sun in degrees.
+    };
+
     /// \brief Lunar quarter instants (Unix UTC seconds, floating).
     struct MoonQuarterInstants {
         double previous_new_unix_s = 0.0; ///< Previous new moon instant (Unix UTC seconds, double).
@@ -132,6 +167,147 @@ namespace astronomy {
             return out;
         }
 
+        /// \brief Compute selected Moon phase fields for an array of UTC timestamps.
+        ///
+        /// Evaluates the same model as compute() in blocks with vectorizable
+        /// loops: angles are wrapped without fmod, sine and cosine use the
+        /// polynomials of detail::sin_cos_degrees() (absolute error < 1e-15), and
+        /// the Kepler iteration for the Sun is replaced by the equation of the
+        /// centre expanded to e^5 (truncation < 3e-11 rad). Results differ from
+        /// compute() by less than 1e-8 degrees in angles and 1e-10 in phase and
+        /// illumination, far below the arc-minute accuracy of the model itself.
+        /// Distance terms are only evaluated when requested.
+        /// \param unix_utc_s Timestamps in Unix UTC seconds (finite, within +/-1e6 years).
+        /// \param count Number of timestamps.
+        /// \param fields Combination of MoonPhaseField bits selecting the columns to write.
+        /// \param out Output columns; every selected column must hold count values.
+        void compute_batch(const double* unix_utc_s,
+                           std::size_t count,
+                           std::uint32_t fields,
+                           const MoonPhaseColumns& out) const noexcept {
+            // Equation of the centre: true minus mean anomaly as a sine series in M.
+            const double e = kEccent;
+            const double e2 = e * e;
+            const double e3 = e2 * e;
+            const double e4 = e3 * e;
+            const double e5 = e4 * e;
+            const double c1 = 2.0 * e - e3 / 4.0 + 5.0 / 96.0 * e5;
+            const double c2 = 5.0 / 4.0 * e2 - 11.0 / 24.0 * e4;
+            const double c3 = 13.0 / 12.0 * e3 - 43.0 / 64.0 * e5;
+            const double c4 = 103.0 / 96.0 * e4;
+            const double c5 = 1097.0 / 960.0 * e5;
+
+            double sun_anomaly[kBatchBlock];
+            double age_deg[kBatchBlock];
+            double age_sin[kBatchBlock];
+            double age_cos[kBatchBlock];
+            double moon_anomaly[kBatchBlock];
+            double scratch[kBatchBlock];
+
+            for (std::size_t base = 0; base < count; base += kBatchBlock) {
+                std::size_t n = count - base;
+                if (n > kBatchBlock) n = kBatchBlock;
+                const double* ts = unix_utc_s + base;
+
+                for (std::size_t i = 0; i < n; ++i) {
+                    // --- Sun position ---
+                    const double day = julian_day_from_unix_seconds(ts[i]) - kEpochJd;
+                    const double N = detail::wrap_degrees((360.0 / 365.2422) * day);
+                    const double M = detail::wrap_degrees(N + kElonge - kElongp);
+                    double sin_m = 0.0;
+                    double cos_m = 0.0;
+                    detail::sin_cos_degrees(M, sin_m, cos_m);
+                    // sin(kM) by the Chebyshev recurrence.
+                    const double sin_2m = 2.0 * cos_m * sin_m;
+                    const double sin_3m = 2.0 * cos_m * sin_2m - sin_m;
+                    const double sin_4m = 2.0 * cos_m * sin_3m - sin_2m;
+                    const double sin_5m = 2.0 * cos_m * sin_4m - sin_3m;
+                    const double Ec = M + rad2deg(c1 * sin_m + c2 * sin_2m + c3 * sin_3m + c4 * sin_4m + c5 * sin_5m);
+                    const double lambda_sun = detail::wrap_degrees(Ec + kElongp);
+                    sun_anomaly[i] = Ec;
+
+                    // --- Moon position ---
+                    const double ml = detail::wrap_degrees(13.1763966 * day + kMmLong);
+                    const double MM = detail::wrap_degrees(ml - 0.1114041 * day - kMmLongp);
+                    double sin_ev = 0.0;
+                    double cos_ev = 0.0;
+                    detail::sin_cos_degrees(2.0 * (ml - lambda_sun) - MM, sin_ev, cos_ev);
+                    const double Ev = 1.2739 * sin_ev;
+                    const double Ae = 0.1858 * sin_m;
+                    const double A3 = 0.37 * sin_m;
+                    const double MmP = MM + Ev - Ae - A3;
+
+                    double sin_mmp = 0.0;
+                    double cos_mmp = 0.0;
+                    detail::sin_cos_degrees(MmP, sin_mmp, cos_mmp);
+                    const double mEc = 6.2886 * sin_mmp;
+                    const double A4 = 0.214 * (2.0 * sin_mmp * cos_mmp);
+                    const double lP = ml + Ev + mEc - Ae + A4;
+
+                    double sin_v = 0.0;
+                    double cos_v = 0.0;
+                    detail::sin_cos_degrees(2.0 * (lP - lambda_sun), sin_v, cos_v);
+                    const double lPP = lP + 0.6583 * sin_v;
+
+                    // --- Phase ---
+                    const double age = detail::wrap_degrees(lPP - lambda_sun);
+                    age_deg[i] = age;
+                    detail::sin_cos_degrees(age, age_sin[i], age_cos[i]);
+                    moon_anomaly[i] = MmP + mEc;
+                }
+
+                if ((fields & MOON_FIELD_PHASE) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) out.phase[base + i] = age_deg[i] / 360.0;
+                }
+                if ((fields & MOON_FIELD_ILLUMINATION) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) out.illumination[base + i] = (1.0 - age_cos[i]) / 2.0;
+                }
+                if ((fields & MOON_FIELD_AGE_DAYS) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) out.age_days[base + i] = kSynMonth * (age_deg[i] / 360.0);
+                }
+                if ((fields & MOON_FIELD_AGE_DEG) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) out.age_deg[base + i] = age_deg[i];
+                }
+                if ((fields & MOON_FIELD_PHASE_ANGLE_RAD) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) out.phase_angle_rad[base + i] = deg2rad(age_deg[i]);
+                }
+                if ((fields & MOON_FIELD_PHASE_SIN) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) out.phase_sin[base + i] = age_sin[i];
+                }
+                if ((fields & MOON_FIELD_PHASE_COS) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) out.phase_cos[base + i] = age_cos[i];
+                }
+
+                if ((fields & (MOON_FIELD_DISTANCE_KM | MOON_FIELD_DIAMETER_DEG)) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        double cos_anomaly = 0.0;
+                        detail::sin_cos_degrees(moon_anomaly[i], scratch[i], cos_anomaly);
+                        moon_anomaly[i] = (kMsMax * (1.0 - kMecc * kMecc)) / (1.0 + kMecc * cos_anomaly);
+                    }
+                    if ((fields & MOON_FIELD_DISTANCE_KM) != 0) {
+                        for (std::size_t i = 0; i < n; ++i) out.distance_km[base + i] = moon_anomaly[i];
+                    }
+                    if ((fields & MOON_FIELD_DIAMETER_DEG) != 0) {
+                        for (std::size_t i = 0; i < n; ++i) out.diameter_deg[base + i] = kMAngSiz / (moon_anomaly[i] / kMsMax);
+                    }
+                }
+
+                if ((fields & (MOON_FIELD_SUN_DISTANCE_KM | MOON_FIELD_SUN_DIAMETER_DEG)) != 0) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        double cos_anomaly = 0.0;
+                        detail::sin_cos_degrees(sun_anomaly[i], scratch[i], cos_anomaly);
+                        sun_anomaly[i] = (1.0 + kEccent * cos_anomaly) / (1.0 - kEccent * kEccent);
+                    }
+                    if ((fields & MOON_FIELD_SUN_DISTANCE_KM) != 0) {
+                        for (std::size_t i = 0; i < n; ++i) out.sun_distance_km[base + i] = kSunSmax / sun_anomaly[i];
+                    }
+                    if ((fields & MOON_FIELD_SUN_DIAMETER_DEG) != 0) {
+                        for (std::size_t i = 0; i < n; ++i) out.sun_diameter_deg[base + i] = sun_anomaly[i] * kSunAngSiz;
+                    }
+                }
+            }
+        }
+
         /// \brief Compute only phase fraction in [0..1) for given UTC timestamp.
         /// \param unix_utc_s Timestamp in Unix UTC seconds (can be fractional).
         /// \return Phase fraction in the \f$[0, 1)\f$ interval where 0=new moon, 0.5=full moon.
@@ -252,6 +428,21 @@ namespace astronomy {
             return is_within_window(unix_utc_s, instants.previous_last_quarter_unix_s, instants.next_last_quarter_unix_s, window_seconds);
         }
 
+        /// \brief Estimate the lunation index of the last mean new moon at or before a timestamp.
+        /// \param unix_utc_s Timestamp in Unix UTC seconds (can be fractional).
+        /// \return Lunation number k counted from the new moon of 1900-01-01 (may be off by one).
+        double lunation_index(double unix_utc_s) const noexcept {
+            return std::floor((julian_day_from_unix_seconds(unix_utc_s) - 2415020.75933) / kSynMonth);
+        }
+
+        /// \brief Compute a corrected phase instant of one lunation.
+        /// \param lunation_index Lunation number k as used by quarter_times_unix().
+        /// \param phase_fraction 0 (new), 0.25 (first quarter), 0.5 (full) or 0.75 (last quarter).
+        /// \return Instant as Unix UTC seconds.
+        double phase_instant_unix(double lunation_index, double phase_fraction) const noexcept {
+            return jd_to_unix_seconds(true_phase_jd(lunation_index, phase_fraction));
+        }
+
     private:
         static double julian_day_from_unix_seconds(double unix_utc_s) noexcept {
             return 2440587.5 + unix_utc_s / 86400.0;
@@ -290,6 +481,8 @@ namespace astronomy {
 
         static constexpr double kPi = 3.14159265358979323846;
 
+        static constexpr std::size_t kBatchBlock = 64; ///< Timestamps per compute_batch() block (stack scratch).
+
         static double deg2rad(double deg) noexcept { return deg * (kPi / 180.0); }
         static double rad2deg(double rad) noexcept { return rad * (180.0 / kPi); }
 
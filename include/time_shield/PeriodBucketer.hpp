@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_PERIOD_BUCKETER_HPP_INCLUDED
+#define _TIME_SHIELD_PERIOD_BUCKETER_HPP_INCLUDED
+
+/// \file PeriodBucketer.hpp
+/// \brief Floor bucketing of millisecond timestamps by a fixed period without hardware division.
+///
+/// start_of_period_ms() divides by a runtime period on every call. PeriodBucketer
+/// precomputes a multiply-high "magic" reciprocal of the period (the unsigned
+/// round-up method used by libdivide), so each timestamp costs one 64x64->128
+/// multiply, a few shifts and adds. Signed timestamps are biased into the
+/// unsigned range and corrected afterwards, so results match detail::floor_mod
+/// for every ts_ms_t value, including negative ones.
+
+#include "config.hpp"
+#include "types.hpp"
+#include "detail/floor_math.hpp"
+#include "detail/mul_hi.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace time_shield {
+
+    /// \ingroup time_conversions
+    /// \brief Maps millisecond timestamps to the start of their period.
+    ///
+    /// Buckets are `[offset + k * period, offset + (k + 1) * period)` for integer `k`.
+    /// Instances are immutable and may be shared between threads.
+    class PeriodBucketer {
+    public:
+        /// \brief Precompute the reciprocal of a period.
+        /// \param period_ms Positive bucket length in milliseconds.
+        /// \param offset_ms Bucket phase; a bucket starts at every `offset_ms + k * period_ms`.
+        /// \throws std::invalid_argument if period_ms is not positive.
+        explicit PeriodBucketer(ts_ms_t period_ms, ts_ms_t offset_ms = 0)
+            : m_period(period_ms)
+            , m_offset(0) {
+            if (period_ms <= 0) {
+                throw std::invalid_argument("PeriodBucketer period must be positive");
+            }
+            const uint64_t d = static_cast<uint64_t>(period_ms);
+            m_offset = detail::floor_mod<ts_ms_t>(offset_ms, period_ms);
+            m_bias_rem = (UINT64_C(1) << 63) % d;
+            m_bias_quot = (UINT64_C(1) << 63) / d;
+            const unsigned log2 = floor_log2(d);
+            if ((d & (d - 1)) == 0) {
+                m_algorithm = Algorithm::Shift;
+                m_shift = log2;
+                m_magic = 0;
+                return;
+            }
+            // m = floor(2^(64 + log2) / d); fits 64 bits because d > 2^log2.
+            uint64_t rem = 0;
+            const uint64_t proposed = divide_pow2(log2, d, rem);
+            const uint64_t error = d - rem;
+            m_shift = log2;
+            if (error < (UINT64_C(1) << log2)) {
+                m_algorithm = Algorithm::Multiply;
+                m_magic = proposed + 1;
+            } else {
+                // One more bit of precision; the extra bit is folded into the add step.
+                uint64_t magic = proposed + proposed;
+                const uint64_t twice_rem = rem + rem;
+                if (twice_rem >= d || twice_rem < rem) {
+                    magic += 1;
+                }
+                m_algorithm = Algorithm::MultiplyAdd;
+                m_magic = magic + 1;
+            }
+        }
+
+        /// \brief Bucket length in milliseconds.
+        ts_ms_t period_ms() const noexcept {
+            return m_period;
+        }
+
+        /// \brief Bucket phase reduced to `[0, period_ms)`.
+        ts_ms_t offset_ms() const noexcept {
+            return m_offset;
+        }
+
+        /// \brief Return `floor_mod(ts_ms - offset_ms, period_ms)`.
+        ts_ms_t remainder(ts_ms_t ts_ms) const noexcept {
+            return remainder_biased(to_biased(ts_ms, m_offset));
+        }
+
+        /// \brief Return the start of the bucket containing a timestamp.
+        ts_ms_t bucket(ts_ms_t ts_ms) const noexcept {
+            return subtract(ts_ms, remainder(ts_ms));
+        }
+
+        /// \brief Return the last millisecond of the bucket containing a timestamp.
+        ts_ms_t bucket_end(ts_ms_t ts_ms) const noexcept {
+            return subtract(bucket(ts_ms), 1 - m_period);
+        }
+
+        /// \brief Return the bucket number `floor((ts_ms - offset_ms) / period_ms)`.
+        int64_t index(ts_ms_t ts_ms) const noexcept {
+            const uint64_t biased = to_biased(ts_ms, m_offset);
+            const uint64_t quotient = divide(biased);
+            const uint64_t rem = biased - quotient * static_cast<uint64_t>(m_period);
+            return static_cast<int64_t>(quotient - m_bias_quot - (rem < m_bias_rem ? 1u : 0u));
+        }
+
+        /// \brief Write bucket starts for an array of timestamps.
+        /// \param ts_ms Input timestamps.
+        /// \param out Output bucket starts; may alias ts_ms.
+        /// \param count Number of elements.
+        void bucket(const ts_ms_t* ts_ms, ts_ms_t* out, std::size_t count) const noexcept {
+            switch (m_algorithm) {
+            case Algorithm::Shift:
+                bucket_loop<Algorithm::Shift>(ts_ms, out, count);
+                break;
+            case Algorithm::Multiply:
+                bucket_loop<Algorithm::Multiply>(ts_ms, out, count);
+                break;
+            case Algorithm::MultiplyAdd:
+                bucket_loop<Algorithm::MultiplyAdd>(ts_ms, out, count);
+                break;
+            }
+        }
+
+        /// \brief Write bucket numbers for an array of timestamps.
+        /// \param ts_ms Input timestamps.
+        /// \param out Output bucket numbers.
+        /// \param count Number of elements.
+        void index(const ts_ms_t* ts_ms, int64_t* out, std::size_t count) const noexcept {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = index(ts_ms[i]);
+            }
+        }
+
+    private:
+        enum class Algorithm : uint8_t {
+            Shift,          ///< Power-of-two period.
+            Multiply,       ///< Magic fits 64 bits: q = mulhi(n, m) >> s.
+            MultiplyAdd     ///< 65-bit magic: q = (((n - t) >> 1) + t) >> s with t = mulhi(n, m).
+        };
+
+        static unsigned floor_log2(uint64_t value) noexcept {
+            unsigned result = 0;
+            while (value >>= 1) {
+                ++result;
+            }
+            return result;
+        }
+
+        /// \brief Return floor(2^(64 + power) / d) with the remainder; requires 2^power < d.
+        static uint64_t divide_pow2(unsigned power, uint64_t d, uint64_t& rem) noexcept {
+            uint64_t quotient = 0;
+            rem = UINT64_C(1) << power;
+            for (int bit = 0; bit < 64; ++bit) {
+                const bool is_carry = (rem >> 63) != 0;
+                rem <<= 1;
+                quotient <<= 1;
+                if (is_carry || rem >= d) {
+                    rem -= d;
+                    quotient |= 1;
+                }
+            }
+            return quotient;
+        }
+
+        /// \brief Map `value - offset` onto unsigned preserving order (adds 2^63).
+        ///
+        /// Wraps for values less than `offset` above the ts_ms_t minimum.
+        static uint64_t to_biased(ts_ms_t value, ts_ms_t offset) noexcept {
+            return (static_cast<uint64_t>(value) ^ (UINT64_C(1) << 63)) - static_cast<uint64_t>(offset);
+        }
+
+        /// \brief Subtract with two's complement wrap-around instead of signed overflow.
+        static ts_ms_t subtract(ts_ms_t value, ts_ms_t rem) noexcept {
+            return static_cast<ts_ms_t>(static_cast<uint64_t>(value) - static_cast<uint64_t>(rem));
+        }
+
+        template<Algorithm A>
+        uint64_t divide_as(uint64_t n) const noexcept {
+            if (A == Algorithm::Shift) {
+                return n >> m_shift;
+            }
+            const uint64_t t = detail::mul_hi_u64(n, m_magic);
+            if (A == Algorithm::Multiply) {
+                return t >> m_shift;
+            }
+            return (((n - t) >> 1) + t) >> m_shift;
+        }
+
+        uint64_t divide(uint64_t n) const noexcept {
+            switch (m_algorithm) {
+            case Algorithm::Shift:
+                return divide_as<Algorithm::Shift>(n);
+            case Algorithm::Multiply:
+                return divide_as<Algorithm::Multiply>(n);
+            default:
+                return divide_as<Algorithm::MultiplyAdd>(n);
+            }
+        }
+
+        /// \brief Floor remainder of the signed value whose biased form is given.
+        ///
+        /// With n = x + 2^63 and 2^63 = k * d + c, x = (q - k) * d + (r - c), so the floor
+        /// remainder is r - c, wrapped into [0, d).
+        template<Algorithm A>
+        ts_ms_t remainder_biased_as(uint64_t biased) const noexcept {
+            const uint64_t d = static_cast<uint64_t>(m_period);
+            const uint64_t rem = biased - divide_as<A>(biased) * d;
+            return static_cast<ts_ms_t>(rem >= m_bias_rem ? rem - m_bias_rem : rem + d - m_bias_rem);
+        }
+
+        ts_ms_t remainder_biased(uint64_t biased) const noexcept {
+            switch (m_algorithm) {
+            case Algorithm::Shift:
+                return remainder_biased_as<Algorithm::Shift>(biased);
+            case Algorithm::Multiply:
+                return remainder_biased_as<Algorithm::Multiply>(biased);
+            default:
+                return remainder_biased_as<Algorithm::MultiplyAdd>(biased);
+            }
+        }
+
+        template<Algorithm A>
+        void bucket_loop(const ts_ms_t* ts_ms, ts_ms_t* out, std::size_t count) const noexcept {
+            for (std::size_t i = 0; i < count; ++i) {
+                const ts_ms_t value = ts_ms[i];
+                out[i] = subtract(value, remainder_biased_as<A>(to_biased(value, m_offset)));
+            }
+        }
+
+        ts_ms_t   m_period;
+        ts_ms_t   m_offset;
+        uint64_t  m_magic{0};
+        uint64_t  m_bias_rem{0};     ///< 2^63 mod period.
+        uint64_t  m_bias_quot{0};    ///< 2^63 / period.
+        unsigned  m_shift{0};
+        Algorithm m_algorithm{Algorithm::Shift};
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_PERIOD_BUCKETER_HPP_INCLUDED
@@ -12,8 +12,23 @@
 /// stored fire time. Cancelled timers are removed lazily from the
 /// internal queue, which can temporarily increase the queue size under frequent
 /// start/stop cycles.
+///
+/// Timers can also be aligned to the wall clock. Wall-clock targets are UTC
+/// instants obtained from a ZonedClock (local realtime or NTP-backed UTC) and
+/// are translated to steady deadlines when queued. Pending wall-clock targets
+/// are re-evaluated at least once per resync interval, so NTP offset updates
+/// and realtime clock steps move the steady deadline accordingly.
+///
+/// The worker thread waits for the next deadline with a configurable
+/// WaitPolicy. Hybrid and busy-spin policies reduce wake-up latency to a few
+/// microseconds at the cost of keeping the worker core busy.
 
 #include "config.hpp"
+#include "constants.hpp"
+#include "date_time_conversions.hpp"
+#include "types.hpp"
+#include "wait_strategy.hpp"
+#include "ZonedClock.hpp"
 
 #include <atomic>
 #include <cassert>
@@ -40,6 +55,13 @@ namespace time_shield {
         using TimerClock = std::chrono::steady_clock;
         using TimerCallback = std::function<void()>;
 
+        /// \brief Wall-clock alignment mode of a timer.
+        enum class WallClockMode : std::uint8_t {
+            Disabled,   ///< Timer uses steady interval scheduling.
+            Once,       ///< Timer fires once at a UTC instant.
+            Periodic    ///< Timer fires at every period boundary of the clock's local time.
+        };
+
         /// \brief Internal state shared between Timer and TimerScheduler.
         struct TimerState {
             TimerScheduler*            m_scheduler = nullptr;
@@ -52,6 +74,11 @@ namespace time_shield {
             std::size_t                m_id{0};
             std::atomic<std::uint64_t> m_generation{0};
             std::atomic<bool>          m_has_external_owner{false};
+            WallClockMode              m_wall_mode{WallClockMode::Disabled}; ///< Guarded by the scheduler mutex.
+            ZonedClock                 m_wall_clock;                         ///< Guarded by the scheduler mutex.
+            std::int64_t               m_wall_period_ms{0};                  ///< Guarded by the scheduler mutex.
+            std::int64_t               m_wall_phase_ms{0};                   ///< Guarded by the scheduler mutex.
+            std::atomic<std::int64_t>  m_wall_target_us{0};
         };
 
         inline TimerState*& current_timer_state() {
@@ -131,6 +158,18 @@ namespace time_shield {
         /// must not be used.
         void run();
 
+        /// \brief Sets the policy the worker thread uses to wait for the next deadline.
+        ///
+        /// WaitStrategy::Block waits on a condition variable. BlockThenSpin waits
+        /// until the spin window before the deadline and busy-spins for the rest.
+        /// BusySpin never blocks while timers are queued and should be used only
+        /// on a dedicated core. An empty queue always blocks until a timer is armed.
+        /// \param policy Wait policy applied from the next wait onward.
+        void set_wait_policy(const WaitPolicy& policy);
+
+        /// \brief Returns the worker wait policy.
+        WaitPolicy wait_policy() const;
+
         /// \brief Requests the worker thread to stop and waits for it to exit.
         void stop();
 
@@ -149,20 +188,52 @@ namespace time_shield {
         /// Method is intended for tests to verify resource cleanup.
         std::size_t active_timer_count_for_testing();
 
+        /// \brief Sets the maximum time a wall-clock target stays queued without re-evaluation.
+        ///
+        /// Smaller intervals react faster to NTP offset updates at the cost of
+        /// extra worker wake-ups. Non-positive values are clamped to one millisecond.
+        template<class Rep, class Period>
+        void set_wall_clock_resync_interval(std::chrono::duration<Rep, Period> interval) noexcept;
+
+        /// \brief Returns the wall-clock resync interval.
+        std::chrono::milliseconds wall_clock_resync_interval() const noexcept;
+
+        /// \brief Recomputes steady deadlines of all pending wall-clock timers.
+        ///
+        /// Call after a known change of the UTC source, such as a forced NTP
+        /// measurement or a realtime clock step, to apply it immediately instead
+        /// of waiting for the next resync interval.
+        void resync_wall_clock();
+
     private:
         friend class Timer;
 
         timer_state_ptr create_timer_state();
         void destroy_timer_state(const timer_state_ptr& state);
         void start_timer(const timer_state_ptr& state, clock::time_point when);
+        void start_wall_timer(const timer_state_ptr& state,
+                              detail::WallClockMode mode,
+                              const ZonedClock& wall_clock,
+                              ts_us_t target_utc_us,
+                              std::int64_t period_ms,
+                              std::int64_t phase_ms);
         void stop_timer(const timer_state_ptr& state);
 
         void worker_loop();
+        bool wait_for_fire_time_locked(std::unique_lock<std::mutex>& lock, clock::time_point fire_time);
+        void notify_worker_locked();
         void collect_due_timers_locked(std::vector<detail::DueTimer>& due, clock::time_point now);
         void execute_due_timers(std::vector<detail::DueTimer>& due);
         void finalize_timer(const detail::DueTimer& due_timer);
 
-        std::mutex                                                                 m_mutex;
+        clock::time_point wall_deadline_locked(const detail::TimerState& state,
+                                               clock::time_point now,
+                                               ts_us_t utc_now_us) const noexcept;
+        static ts_us_t next_wall_boundary_us(const detail::TimerState& state,
+                                             ts_us_t utc_now_us,
+                                             ts_us_t previous_target_us) noexcept;
+
+        mutable std::mutex                                                         m_mutex;
         std::condition_variable                                                    m_cv;
         std::thread                                                                m_thread;
         bool                                                                       m_is_worker_running{false};
@@ -170,6 +241,9 @@ namespace time_shield {
         std::priority_queue<detail::ScheduledTimer, std::vector<detail::ScheduledTimer>, detail::ScheduledComparator> m_queue;
         std::unordered_map<std::size_t, std::weak_ptr<detail::TimerState>>         m_timers;
         std::size_t                                                                m_next_id{1};
+        std::atomic<std::int64_t>                                                  m_wall_resync_ms{1000};
+        WaitPolicy                                                                 m_wait_policy;
+        std::atomic<std::uint64_t>                                                 m_wake_epoch{0};
     };
 
     /// \brief Timer that mimics the behavior of Qt timers.
@@ -229,6 +303,35 @@ namespace time_shield {
         /// \brief Sets the callback that should be invoked when the timer fires.
         void set_callback(Callback callback);
 
+        /// \brief Schedules a single activation at the specified UTC instant.
+        ///
+        /// The target is converted to a steady deadline through the UTC source
+        /// of \p wall_clock (local realtime or NTP-backed UTC) and re-evaluated
+        /// while pending. Targets in the past fire on the next processing pass.
+        /// The timer fires once regardless of the single-shot flag.
+        /// \param utc_ms Target UTC timestamp in milliseconds.
+        /// \param wall_clock Clock that supplies current UTC time.
+        void schedule_at_utc(ts_ms_t utc_ms, const ZonedClock& wall_clock = ZonedClock());
+
+        /// \brief Schedules activations at every period boundary of the clock's local time.
+        ///
+        /// Boundaries are computed with start_of_period_ms() over the local
+        /// timeline of \p wall_clock shifted by \p phase_ms, so a period of one
+        /// minute fires at `:00.000` and a period of one day with a phase of
+        /// 9.5 hours fires at 09:30 local time. Boundaries missed while the
+        /// callback runs are skipped instead of being replayed.
+        /// \param period_ms Period length in milliseconds.
+        /// \param wall_clock Clock that supplies current UTC time and the local zone.
+        /// \param phase_ms Offset of the boundaries from the period start in milliseconds.
+        /// \return False when \p period_ms is not positive.
+        bool schedule_every_period(ts_ms_t period_ms,
+                                   const ZonedClock& wall_clock = ZonedClock(),
+                                   ts_ms_t phase_ms = 0);
+
+        /// \brief Returns the pending wall-clock target in UTC milliseconds.
+        /// \return Target timestamp or ERROR_TIMESTAMP when the timer is not wall-clock aligned.
+        ts_ms_t next_fire_utc_ms() const noexcept;
+
         /// \brief Creates a single-shot timer that invokes the callback once.
         ///
         /// The helper keeps the timer alive until the callback finishes.
@@ -273,6 +376,17 @@ namespace time_shield {
         m_thread = std::thread(&TimerScheduler::worker_loop, this);
     }
 
+    inline void TimerScheduler::set_wait_policy(const WaitPolicy& policy) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wait_policy = policy;
+        notify_worker_locked();
+    }
+
+    inline WaitPolicy TimerScheduler::wait_policy() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_wait_policy;
+    }
+
     inline void TimerScheduler::stop() {
         std::vector<timer_state_ptr> orphan_states;
         std::thread                 worker_to_join;
@@ -281,7 +395,7 @@ namespace time_shield {
             std::unique_lock<std::mutex> lock(m_mutex);
             if (m_is_worker_running) {
                 m_stop_requested = true;
-                m_cv.notify_all();
+                notify_worker_locked();
                 worker_to_join = std::move(m_thread);
             } else {
                 m_stop_requested = false;
@@ -349,6 +463,39 @@ namespace time_shield {
         return count;
     }
 
+    template<class Rep, class Period>
+    void TimerScheduler::set_wall_clock_resync_interval(std::chrono::duration<Rep, Period> interval) noexcept {
+        auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(interval).count();
+        if (milliseconds <= 0) {
+            milliseconds = 1;
+        }
+        m_wall_resync_ms.store(static_cast<std::int64_t>(milliseconds), std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        notify_worker_locked();
+    }
+
+    inline std::chrono::milliseconds TimerScheduler::wall_clock_resync_interval() const noexcept {
+        return std::chrono::milliseconds(m_wall_resync_ms.load(std::memory_order_relaxed));
+    }
+
+    inline void TimerScheduler::resync_wall_clock() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto now = clock::now();
+        for (auto& entry : m_timers) {
+            auto state = entry.second.lock();
+            if (!state ||
+                state->m_wall_mode == detail::WallClockMode::Disabled ||
+                !state->m_is_active.load(std::memory_order_relaxed) ||
+                state->m_is_running.load(std::memory_order_acquire)) {
+                continue;
+            }
+            const ts_us_t utc_now_us = state->m_wall_clock.utc_time_us();
+            const auto generation = state->m_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+            m_queue.push(detail::ScheduledTimer{wall_deadline_locked(*state, now, utc_now_us), state->m_id, generation});
+        }
+        notify_worker_locked();
+    }
+
     inline timer_state_ptr TimerScheduler::create_timer_state() {
         auto state = std::make_shared<detail::TimerState>();
         state->m_scheduler = this;
@@ -380,10 +527,36 @@ namespace time_shield {
             return;
         }
         std::lock_guard<std::mutex> lock(m_mutex);
+        state->m_wall_mode = detail::WallClockMode::Disabled;
         state->m_is_active.store(true, std::memory_order_relaxed);
         const auto generation = state->m_generation.fetch_add(1, std::memory_order_relaxed) + 1;
         m_queue.push(detail::ScheduledTimer{when, state->m_id, generation});
-        m_cv.notify_all();
+        notify_worker_locked();
+    }
+
+    inline void TimerScheduler::start_wall_timer(const timer_state_ptr& state,
+                                                 detail::WallClockMode mode,
+                                                 const ZonedClock& wall_clock,
+                                                 ts_us_t target_utc_us,
+                                                 std::int64_t period_ms,
+                                                 std::int64_t phase_ms) {
+        if (!state) {
+            return;
+        }
+        const ts_us_t utc_now_us = wall_clock.utc_time_us();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        state->m_wall_mode = mode;
+        state->m_wall_clock = wall_clock;
+        state->m_wall_period_ms = period_ms;
+        state->m_wall_phase_ms = phase_ms;
+        if (mode == detail::WallClockMode::Periodic) {
+            target_utc_us = next_wall_boundary_us(*state, utc_now_us, utc_now_us);
+        }
+        state->m_wall_target_us.store(target_utc_us, std::memory_order_relaxed);
+        state->m_is_active.store(true, std::memory_order_relaxed);
+        const auto generation = state->m_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+        m_queue.push(detail::ScheduledTimer{wall_deadline_locked(*state, clock::now(), utc_now_us), state->m_id, generation});
+        notify_worker_locked();
     }
 
     inline void TimerScheduler::stop_timer(const timer_state_ptr& state) {
@@ -393,7 +566,7 @@ namespace time_shield {
         std::lock_guard<std::mutex> lock(m_mutex);
         state->m_is_active.store(false, std::memory_order_relaxed);
         state->m_generation.fetch_add(1, std::memory_order_relaxed);
-        m_cv.notify_all();
+        notify_worker_locked();
     }
 
     inline void TimerScheduler::worker_loop() {
@@ -406,22 +579,14 @@ namespace time_shield {
             }
 
             const auto next_fire_time = m_queue.top().m_fire_time;
-            const bool woke_by_condition = m_cv.wait_until(
-                lock,
-                next_fire_time,
-                [this, next_fire_time] {
-                    return m_stop_requested || m_queue.empty() || m_queue.top().m_fire_time < next_fire_time;
-                }
-            );
+            if (!wait_for_fire_time_locked(lock, next_fire_time)) {
+                continue;
+            }
 
             if (m_stop_requested) {
                 break;
             }
 
-            if (woke_by_condition) {
-                continue;
-            }
-
             const auto now = clock::now();
             collect_due_timers_locked(due, now);
 
@@ -432,6 +597,46 @@ namespace time_shield {
         }
     }
 
+    inline bool TimerScheduler::wait_for_fire_time_locked(std::unique_lock<std::mutex>& lock,
+                                                          clock::time_point fire_time) {
+        const WaitPolicy policy = m_wait_policy;
+        const auto spin_from = detail::spin_start_time(fire_time, policy);
+        if (clock::now() < spin_from) {
+            const bool woke_by_condition = m_cv.wait_until(
+                lock,
+                spin_from,
+                [this, fire_time] {
+                    return m_stop_requested || m_queue.empty() || m_queue.top().m_fire_time < fire_time;
+                }
+            );
+            if (woke_by_condition) {
+                return false;
+            }
+            if (policy.strategy == WaitStrategy::Block) {
+                return true;
+            }
+        }
+
+        // Spin without the lock; any queue change bumps the wake epoch and restarts the wait.
+        const std::uint64_t epoch = m_wake_epoch.load(std::memory_order_acquire);
+        lock.unlock();
+        bool is_interrupted = false;
+        while (clock::now() < fire_time) {
+            if (m_wake_epoch.load(std::memory_order_acquire) != epoch) {
+                is_interrupted = true;
+                break;
+            }
+            detail::cpu_relax();
+        }
+        lock.lock();
+        return !is_interrupted;
+    }
+
+    inline void TimerScheduler::notify_worker_locked() {
+        m_wake_epoch.fetch_add(1, std::memory_order_release);
+        m_cv.notify_all();
+    }
+
     inline void TimerScheduler::collect_due_timers_locked(std::vector<detail::DueTimer>& due, clock::time_point now) {
         while (!m_queue.empty()) {
             const auto& top = m_queue.top();
@@ -458,6 +663,16 @@ namespace time_shield {
                 continue;
             }
 
+            if (state->m_wall_mode != detail::WallClockMode::Disabled) {
+                const ts_us_t utc_now_us = state->m_wall_clock.utc_time_us();
+                if (utc_now_us < state->m_wall_target_us.load(std::memory_order_relaxed)) {
+                    m_queue.push(detail::ScheduledTimer{wall_deadline_locked(*state, now, utc_now_us),
+                                                        item.m_timer_id,
+                                                        item.m_generation});
+                    continue;
+                }
+            }
+
             state->m_is_running.store(true, std::memory_order_release);
             due.push_back(detail::DueTimer{item.m_fire_time, item.m_generation, std::move(state)});
         }
@@ -494,7 +709,9 @@ namespace time_shield {
             return;
         }
 
-        if (state->m_is_single_shot.load(std::memory_order_relaxed)) {
+        if (state->m_wall_mode == detail::WallClockMode::Once ||
+            (state->m_wall_mode == detail::WallClockMode::Disabled &&
+             state->m_is_single_shot.load(std::memory_order_relaxed))) {
             state->m_is_active.store(false, std::memory_order_relaxed);
             state->m_generation.fetch_add(1, std::memory_order_relaxed);
             return;
@@ -504,11 +721,67 @@ namespace time_shield {
             return;
         }
 
+        if (state->m_wall_mode == detail::WallClockMode::Periodic) {
+            lock.unlock();
+            const ts_us_t utc_now_us = state->m_wall_clock.utc_time_us();
+            lock.lock();
+            if (!state->m_is_active.load(std::memory_order_relaxed) ||
+                state->m_wall_mode != detail::WallClockMode::Periodic ||
+                state->m_generation.load(std::memory_order_relaxed) != due_timer.m_generation) {
+                return;
+            }
+            const ts_us_t previous_target_us = state->m_wall_target_us.load(std::memory_order_relaxed);
+            state->m_wall_target_us.store(next_wall_boundary_us(*state, utc_now_us, previous_target_us),
+                                          std::memory_order_relaxed);
+            const auto wall_generation = state->m_generation.fetch_add(1, std::memory_order_relaxed) + 1;
+            m_queue.push(detail::ScheduledTimer{wall_deadline_locked(*state, clock::now(), utc_now_us),
+                                                state->m_id,
+                                                wall_generation});
+            notify_worker_locked();
+            return;
+        }
+
         const auto interval_ms = state->m_interval_ms.load(std::memory_order_relaxed);
         const auto next_fire_time = due_timer.m_fire_time + std::chrono::milliseconds(interval_ms);
         const auto next_generation = state->m_generation.fetch_add(1, std::memory_order_relaxed) + 1;
         m_queue.push(detail::ScheduledTimer{next_fire_time, state->m_id, next_generation});
-        m_cv.notify_all();
+        notify_worker_locked();
+    }
+
+    inline TimerScheduler::clock::time_point TimerScheduler::wall_deadline_locked(
+            const detail::TimerState& state,
+            clock::time_point now,
+            ts_us_t utc_now_us) const noexcept {
+        const ts_us_t remaining_us = state.m_wall_target_us.load(std::memory_order_relaxed) - utc_now_us;
+        if (remaining_us <= 0) {
+            return now;
+        }
+        const ts_us_t resync_us = m_wall_resync_ms.load(std::memory_order_relaxed) * US_PER_MS;
+        return now + std::chrono::microseconds(remaining_us < resync_us ? remaining_us : resync_us);
+    }
+
+    inline ts_us_t TimerScheduler::next_wall_boundary_us(const detail::TimerState& state,
+                                                         ts_us_t utc_now_us,
+                                                         ts_us_t previous_target_us) noexcept {
+        const ZonedClock& wall_clock = state.m_wall_clock;
+        const ts_ms_t utc_now_ms = detail::floor_div<ts_us_t>(utc_now_us, US_PER_MS);
+        const ts_ms_t previous_ms = detail::floor_div<ts_us_t>(previous_target_us, US_PER_MS);
+        const ts_ms_t local_now_ms = utc_now_ms
+            + static_cast<ts_ms_t>(wall_clock.offset_at_utc_ms(utc_now_ms)) * MS_PER_SEC;
+        const ts_ms_t local_previous_ms = previous_ms
+            + static_cast<ts_ms_t>(wall_clock.offset_at_utc_ms(previous_ms)) * MS_PER_SEC;
+        const ts_ms_t local_base_ms = local_now_ms > local_previous_ms ? local_now_ms : local_previous_ms;
+
+        const ts_ms_t period_ms = state.m_wall_period_ms;
+        const ts_ms_t phase_ms = state.m_wall_phase_ms;
+        const ts_ms_t local_target_ms = start_of_period_ms(period_ms, local_base_ms - phase_ms) + phase_ms + period_ms;
+
+        // Two passes resolve the offset that applies at the target instant for named zones.
+        ts_ms_t utc_target_ms = local_target_ms
+            - static_cast<ts_ms_t>(wall_clock.offset_at_utc_ms(utc_now_ms)) * MS_PER_SEC;
+        utc_target_ms = local_target_ms
+            - static_cast<ts_ms_t>(wall_clock.offset_at_utc_ms(utc_target_ms)) * MS_PER_SEC;
+        return utc_target_ms * US_PER_MS;
     }
 
     // ---------------------------------------------------------------------
@@ -597,6 +870,32 @@ namespace time_shield {
         m_state->m_callback = std::move(callback);
     }
 
+    inline void Timer::schedule_at_utc(ts_ms_t utc_ms, const ZonedClock& wall_clock) {
+        m_scheduler.start_wall_timer(m_state, detail::WallClockMode::Once, wall_clock, utc_ms * US_PER_MS, 0, 0);
+    }
+
+    inline bool Timer::schedule_every_period(ts_ms_t period_ms, const ZonedClock& wall_clock, ts_ms_t phase_ms) {
+        if (period_ms <= 0) {
+            return false;
+        }
+        m_scheduler.start_wall_timer(m_state,
+                                     detail::WallClockMode::Periodic,
+                                     wall_clock,
+                                     0,
+                                     period_ms,
+                                     detail::floor_mod<ts_ms_t>(phase_ms, period_ms));
+        return true;
+    }
+
+    inline ts_ms_t Timer::next_fire_utc_ms() const noexcept {
+        std::lock_guard<std::mutex> lock(m_scheduler.m_mutex);
+        if (m_state->m_wall_mode == detail::WallClockMode::Disabled ||
+            !m_state->m_is_active.load(std::memory_order_relaxed)) {
+            return ERROR_TIMESTAMP;
+        }
+        return detail::floor_div<ts_us_t>(m_state->m_wall_target_us.load(std::memory_order_relaxed), US_PER_MS);
+    }
+
     template<class Rep, class Period>
     void Timer::single_shot(TimerScheduler& scheduler,
                             std::chrono::duration<Rep, Period> interval,
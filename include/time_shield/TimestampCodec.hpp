@@ -0,0 +1,406 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_TIMESTAMP_CODEC_HPP_INCLUDED
+#define _TIME_SHIELD_TIMESTAMP_CODEC_HPP_INCLUDED
+
+/// \file TimestampCodec.hpp
+/// \brief Block frame-of-reference codec for columns of millisecond timestamps.
+///
+/// Values are split into blocks of TIMESTAMP_CODEC_BLOCK. A block stores its
+/// first timestamp and the smallest difference between neighbours; every other
+/// difference is stored as its excess over that minimum, bit-packed at the
+/// width of the largest excess. Evenly spaced series pack to zero bits per
+/// value, and tick series with millisecond jitter to about 10-16 bits.
+/// Decoding a value is one unaligned load, a shift, a mask and a running sum,
+/// without branches or per-value lengths as in varint streams.
+///
+/// Block layout (integers little-endian):
+/// - u8 count (1..TIMESTAMP_CODEC_BLOCK);
+/// - u8 bit width (0..64);
+/// - i64 first timestamp;
+/// - i64 minimum difference (wrapping, so unsorted input also round-trips);
+/// - (count - 1) * width bits of packed excesses, padded to a byte.
+///
+/// Each block decodes on its own, so a TimestampBlockRef index gives random
+/// access by row or by timestamp.
+
+#include "config.hpp"
+#include "types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace time_shield {
+
+    constexpr std::size_t TIMESTAMP_CODEC_BLOCK = 128; ///< Values per encoded block.
+
+namespace detail {
+
+    constexpr std::size_t TIMESTAMP_CODEC_HEADER = 18; ///< Count, width, first value and minimum difference.
+
+    /// \brief Read a little-endian uint64 (compiles to one load on little-endian targets).
+    inline uint64_t load_u64_le(const uint8_t* data) noexcept {
+        return static_cast<uint64_t>(data[0]) |
+               (static_cast<uint64_t>(data[1]) << 8) |
+               (static_cast<uint64_t>(data[2]) << 16) |
+               (static_cast<uint64_t>(data[3]) << 24) |
+               (static_cast<uint64_t>(data[4]) << 32) |
+               (static_cast<uint64_t>(data[5]) << 40) |
+               (static_cast<uint64_t>(data[6]) << 48) |
+               (static_cast<uint64_t>(data[7]) << 56);
+    }
+
+    /// \brief Append a little-endian uint64.
+    inline void store_u64_le(std::vector<uint8_t>& out, uint64_t value) {
+        for (unsigned i = 0; i < 8; ++i) {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    /// \brief Read \p width bits at \p bit_pos, touching only the bytes that hold them.
+    inline uint64_t read_bits(const uint8_t* data, std::size_t bit_pos, unsigned width) noexcept {
+        const uint8_t* p = data + bit_pos / 8;
+        const unsigned shift = static_cast<unsigned>(bit_pos % 8);
+        const unsigned bytes = (shift + width + 7) / 8;
+        uint64_t low = 0;
+        for (unsigned i = 0; i < bytes && i < 8; ++i) {
+            low |= static_cast<uint64_t>(p[i]) << (8 * i);
+        }
+        uint64_t value = low >> shift;
+        if (bytes > 8) {
+            value |= static_cast<uint64_t>(p[8]) << (64 - shift);
+        }
+        return width == 64 ? value : value & ((UINT64_C(1) << width) - 1);
+    }
+
+    /// \brief Return the number of payload bytes of a block.
+    constexpr std::size_t timestamp_block_payload(std::size_t count, unsigned width) noexcept {
+        return ((count - 1) * width + 7) / 8;
+    }
+
+} // namespace detail
+
+    /// \brief Location of an encoded block.
+    struct TimestampBlockRef {
+        ts_ms_t     first;  ///< First timestamp of the block.
+        uint64_t    row;    ///< Row number of the first timestamp.
+        std::size_t offset; ///< Byte offset of the block in the encoded stream.
+    };
+
+    /// \brief Return the last block whose first timestamp is not after \p ts_ms.
+    ///
+    /// For sorted columns this is the block that holds \p ts_ms if it is present.
+    /// \return Position in \p index, or 0 when \p ts_ms precedes every block.
+    inline std::size_t find_timestamp_block(const std::vector<TimestampBlockRef>& index, ts_ms_t ts_ms) noexcept {
+        std::size_t lo = 0;
+        std::size_t hi = index.size();
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (index[mid].first <= ts_ms) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo == 0 ? 0 : lo - 1;
+    }
+
+    /// \brief Return the last block whose first row is not after \p row.
+    ///
+    /// This is the block that holds \p row when the row exists.
+    /// \return Position in \p index, or index.size() when \p index is empty.
+    inline std::size_t find_row_block(const std::vector<TimestampBlockRef>& index, uint64_t row) noexcept {
+        std::size_t lo = 0;
+        std::size_t hi = index.size();
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (index[mid].row <= row) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo == 0 ? index.size() : lo - 1;
+    }
+
+    /// \brief Streaming encoder of timestamp columns.
+    ///
+    /// Values are buffered until a block is full; finish() writes the last
+    /// partial block. Appending after finish() starts a new block, so blocks
+    /// in the middle of a stream may be short.
+    /// \code
+    /// TimestampColumnEncoder encoder;
+    /// encoder.append(ticks.data(), ticks.size());
+    /// encoder.finish();
+    /// file.write(encoder.bytes().data(), encoder.bytes().size());
+    /// \endcode
+    class TimestampColumnEncoder {
+    public:
+        TimestampColumnEncoder() {
+            m_pending.reserve(TIMESTAMP_CODEC_BLOCK);
+        }
+
+        /// \brief Append one timestamp.
+        void append(ts_ms_t value) {
+            m_pending.push_back(value);
+            if (m_pending.size() == TIMESTAMP_CODEC_BLOCK) {
+                flush_block(m_pending.data(), m_pending.size());
+                m_pending.clear();
+            }
+        }
+
+        /// \brief Append an array of timestamps.
+        void append(const ts_ms_t* values, std::size_t count) {
+            while (count > 0 && !m_pending.empty()) {
+                append(*values++);
+                --count;
+            }
+            for (; count >= TIMESTAMP_CODEC_BLOCK; count -= TIMESTAMP_CODEC_BLOCK) {
+                flush_block(values, TIMESTAMP_CODEC_BLOCK);
+                values += TIMESTAMP_CODEC_BLOCK;
+            }
+            m_pending.insert(m_pending.end(), values, values + count);
+        }
+
+        /// \brief Write the buffered values as a final, possibly short, block.
+        void finish() {
+            if (!m_pending.empty()) {
+                flush_block(m_pending.data(), m_pending.size());
+                m_pending.clear();
+            }
+        }
+
+        /// \brief Encoded bytes not yet taken by release_bytes().
+        const std::vector<uint8_t>& bytes() const noexcept {
+            return m_bytes;
+        }
+
+        /// \brief Take the encoded bytes; later blocks keep their offsets in the whole stream.
+        std::vector<uint8_t> release_bytes() {
+            std::vector<uint8_t> bytes;
+            bytes.swap(m_bytes);
+            m_released += bytes.size();
+            return bytes;
+        }
+
+        /// \brief Index of the blocks written so far.
+        const std::vector<TimestampBlockRef>& index() const noexcept {
+            return m_index;
+        }
+
+        /// \brief Number of appended timestamps, including buffered ones.
+        uint64_t size() const noexcept {
+            return m_rows + m_pending.size();
+        }
+
+    private:
+        void flush_block(const ts_ms_t* values, std::size_t count) {
+            uint64_t min_delta = 0;
+            uint64_t max_excess = 0;
+            if (count > 1) {
+                // Differences wrap in uint64 and are ordered as int64.
+                int64_t lowest = static_cast<int64_t>(static_cast<uint64_t>(values[1]) - static_cast<uint64_t>(values[0]));
+                for (std::size_t i = 2; i < count; ++i) {
+                    const int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]));
+                    lowest = delta < lowest ? delta : lowest;
+                }
+                min_delta = static_cast<uint64_t>(lowest);
+                for (std::size_t i = 1; i < count; ++i) {
+                    const uint64_t excess = static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]) - min_delta;
+                    max_excess |= excess;
+                }
+            }
+            unsigned width = 0;
+            while (width < 64 && (max_excess >> width) != 0) {
+                ++width;
+            }
+
+            const TimestampBlockRef ref = {values[0], m_rows, m_released + m_bytes.size()};
+            m_index.push_back(ref);
+            m_rows += count;
+
+            m_bytes.push_back(static_cast<uint8_t>(count));
+            m_bytes.push_back(static_cast<uint8_t>(width));
+            detail::store_u64_le(m_bytes, static_cast<uint64_t>(values[0]));
+            detail::store_u64_le(m_bytes, min_delta);
+            if (width == 0) {
+                return;
+            }
+            const std::size_t payload_begin = m_bytes.size();
+            m_bytes.resize(payload_begin + detail::timestamp_block_payload(count, width), 0);
+            uint8_t* payload = m_bytes.data() + payload_begin;
+            std::size_t bit_pos = 0;
+            for (std::size_t i = 1; i < count; ++i, bit_pos += width) {
+                const uint64_t excess = static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]) - min_delta;
+                const unsigned shift = static_cast<unsigned>(bit_pos % 8);
+                uint8_t* p = payload + bit_pos / 8;
+                p[0] = static_cast<uint8_t>(p[0] | static_cast<uint8_t>(excess << shift));
+                const unsigned used = 8 - shift;
+                for (unsigned k = 1; used + 8 * (k - 1) < width; ++k) {
+                    p[k] = static_cast<uint8_t>(excess >> (used + 8 * (k - 1)));
+                }
+            }
+        }
+
+        std::vector<ts_ms_t>            m_pending;      ///< Values of the open block.
+        std::vector<uint8_t>            m_bytes;        ///< Encoded blocks not yet released.
+        std::vector<TimestampBlockRef>  m_index;        ///< One entry per written block.
+        std::size_t                     m_released = 0; ///< Bytes handed out by release_bytes().
+        uint64_t                        m_rows = 0;     ///< Values in written blocks.
+    };
+
+    /// \brief Streaming decoder of timestamp columns.
+    ///
+    /// Works on a caller-owned byte range that must outlive the decoder.
+    /// \code
+    /// TimestampColumnDecoder decoder(bytes.data(), bytes.size());
+    /// std::vector<ts_ms_t> out(rows);
+    /// decoder.read(out.data(), out.size());
+    /// \endcode
+    class TimestampColumnDecoder {
+    public:
+        /// \brief Decode from the start of an encoded stream.
+        TimestampColumnDecoder(const uint8_t* data, std::size_t size) noexcept
+            : m_data(data)
+            , m_size(size) {}
+
+        /// \brief True when every value has been returned.
+        bool done() const noexcept {
+            return m_buffered == m_buffer_pos && m_pos >= m_size;
+        }
+
+        /// \brief Byte offset of the next block to decode.
+        std::size_t offset() const noexcept {
+            return m_pos;
+        }
+
+        /// \brief Continue decoding at an indexed block, dropping buffered values.
+        void seek(const TimestampBlockRef& block) noexcept {
+            m_pos = block.offset;
+            m_buffered = 0;
+            m_buffer_pos = 0;
+        }
+
+        /// \brief Decode the next whole block.
+        /// \param out Destination for at least TIMESTAMP_CODEC_BLOCK values.
+        /// \return Number of values written, 0 at the end of the stream.
+        /// \throws std::invalid_argument if the block is malformed or truncated.
+        std::size_t next_block(ts_ms_t* out) {
+            if (m_pos >= m_size) {
+                return 0;
+            }
+            const std::size_t count = block_count(m_data, m_size, m_pos);
+            decode_block(m_data + m_pos, m_size - m_pos, out);
+            m_pos += block_size(m_data + m_pos);
+            return count;
+        }
+
+        /// \brief Decode up to \p count values, continuing where the last call stopped.
+        /// \return Number of values written; less than \p count only at the end of the stream.
+        /// \throws std::invalid_argument if a block is malformed or truncated.
+        std::size_t read(ts_ms_t* out, std::size_t count) {
+            std::size_t written = 0;
+            while (written < count) {
+                if (m_buffer_pos < m_buffered) {
+                    const std::size_t take = std::min(count - written, m_buffered - m_buffer_pos);
+                    std::copy(m_buffer + m_buffer_pos, m_buffer + m_buffer_pos + take, out + written);
+                    m_buffer_pos += take;
+                    written += take;
+                    continue;
+                }
+                if (m_pos >= m_size) {
+                    break;
+                }
+                if (count - written >= TIMESTAMP_CODEC_BLOCK) {
+                    written += next_block(out + written);
+                } else {
+                    m_buffered = next_block(m_buffer);
+                    m_buffer_pos = 0;
+                }
+            }
+            return written;
+        }
+
+        /// \brief Build the block index of an encoded stream by reading block headers only.
+        /// \throws std::invalid_argument if a block is malformed or truncated.
+        static std::vector<TimestampBlockRef> build_index(const uint8_t* data, std::size_t size) {
+            std::vector<TimestampBlockRef> index;
+            uint64_t row = 0;
+            for (std::size_t pos = 0; pos < size; pos += block_size(data + pos)) {
+                const std::size_t count = block_count(data, size, pos);
+                const TimestampBlockRef ref = {static_cast<ts_ms_t>(detail::load_u64_le(data + pos + 2)), row, pos};
+                index.push_back(ref);
+                row += count;
+            }
+            return index;
+        }
+
+    private:
+        /// \brief Validate the block header at \p pos and return its value count.
+        static std::size_t block_count(const uint8_t* data, std::size_t size, std::size_t pos) {
+            if (size - pos < detail::TIMESTAMP_CODEC_HEADER) {
+                throw std::invalid_argument("TimestampColumnDecoder block is truncated");
+            }
+            const std::size_t count = data[pos];
+            const unsigned width = data[pos + 1];
+            if (count == 0 || count > TIMESTAMP_CODEC_BLOCK || width > 64) {
+                throw std::invalid_argument("TimestampColumnDecoder block header is invalid");
+            }
+            if (size - pos - detail::TIMESTAMP_CODEC_HEADER < detail::timestamp_block_payload(count, width)) {
+                throw std::invalid_argument("TimestampColumnDecoder block is truncated");
+            }
+            return count;
+        }
+
+        static std::size_t block_size(const uint8_t* block) noexcept {
+            return detail::TIMESTAMP_CODEC_HEADER + detail::timestamp_block_payload(block[0], block[1]);
+        }
+
+        /// \brief Decode a validated block; \p available counts the bytes from the block to the stream end.
+        static void decode_block(const uint8_t* block, std::size_t available, ts_ms_t* out) noexcept {
+            const std::size_t count = block[0];
+            const unsigned width = block[1];
+            uint64_t value = detail::load_u64_le(block + 2);
+            const uint64_t min_delta = detail::load_u64_le(block + 10);
+            const uint8_t* payload = block + detail::TIMESTAMP_CODEC_HEADER;
+            out[0] = static_cast<ts_ms_t>(value);
+            if (width == 0) {
+                for (std::size_t i = 1; i < count; ++i) {
+                    value += min_delta;
+                    out[i] = static_cast<ts_ms_t>(value);
+                }
+                return;
+            }
+            std::size_t i = 1;
+            std::size_t bit_pos = 0;
+            if (width <= 56) {
+                // One unaligned 8-byte load covers the value; stop while 8 bytes remain in the stream.
+                const uint64_t mask = (UINT64_C(1) << width) - 1;
+                const std::size_t readable = available - detail::TIMESTAMP_CODEC_HEADER;
+                const std::size_t fast_end = readable < 8 ? 1 : std::min(count, 2 + (readable - 8) * 8 / width);
+                for (; i < fast_end; ++i, bit_pos += width) {
+                    const uint64_t word = detail::load_u64_le(payload + bit_pos / 8);
+                    value += min_delta + ((word >> (bit_pos % 8)) & mask);
+                    out[i] = static_cast<ts_ms_t>(value);
+                }
+            }
+            for (; i < count; ++i, bit_pos += width) {
+                value += min_delta + detail::read_bits(payload, bit_pos, width);
+                out[i] = static_cast<ts_ms_t>(value);
+            }
+        }
+
+        const uint8_t*  m_data;                             ///< Encoded stream.
+        std::size_t     m_size;                             ///< Stream length in bytes.
+        std::size_t     m_pos = 0;                          ///< Offset of the next block.
+        ts_ms_t         m_buffer[TIMESTAMP_CODEC_BLOCK];    ///< Decoded block for partial reads.
+        std::size_t     m_buffered = 0;                     ///< Values in m_buffer.
+        std::size_t     m_buffer_pos = 0;                   ///< Next value to return from m_buffer.
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_TIMESTAMP_CODEC_HPP_INCLUDED
@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_TIMESTAMP_INDEX_HPP_INCLUDED
+#define _TIME_SHIELD_TIMESTAMP_INDEX_HPP_INCLUDED
+
+/// \file TimestampIndex.hpp
+/// \brief Bucket directory over a sorted timestamp array for calendar range queries.
+///
+/// The index stores, for every fixed-length UTC bucket (an hour by default)
+/// between the first and last timestamp, the position of the first element at
+/// or after the bucket start. A lookup divides once to find the bucket and
+/// binary-searches only the elements of that bucket. Calendar ranges (local
+/// days, ISO weeks, months, trading sessions) convert their two boundaries to
+/// UTC and do two lookups. Bucket iteration converts once per bucket, never
+/// per element.
+
+#include "config.hpp"
+#include "constants.hpp"
+#include "types.hpp"
+#include "BusinessCalendar.hpp"
+#include "iso_week_conversions.hpp"
+#include "time_zone_conversions.hpp"
+#include "unix_time_conversions.hpp"
+#include "detail/fast_date.hpp"
+#include "detail/floor_math.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace time_shield {
+
+    /// \brief Half-open range of array positions.
+    struct TimestampRange {
+        std::size_t begin;  ///< First position.
+        std::size_t end;    ///< One past the last position.
+
+        /// \brief Number of elements in the range.
+        std::size_t size() const noexcept {
+            return end - begin;
+        }
+
+        /// \brief True when the range has no elements.
+        bool empty() const noexcept {
+            return begin == end;
+        }
+    };
+
+    /// \ingroup time_conversions
+    /// \brief Read-only index over a caller-owned sorted array of UTC millisecond timestamps.
+    ///
+    /// The array must be sorted ascending (duplicates allowed) and must outlive
+    /// the index. Local calendar units are taken in a TimeZone supported by
+    /// zone_to_gmt_ms(); queries may run concurrently.
+    /// \code
+    /// TimestampIndex index(ticks.data(), ticks.size());
+    /// TimestampRange day = index.day(2024, 3, 31, CET);
+    /// for (std::size_t i = day.begin; i < day.end; ++i) { ... }
+    /// \endcode
+    class TimestampIndex {
+    public:
+        /// \brief Build the bucket directory.
+        /// \param data Sorted timestamps.
+        /// \param count Number of timestamps.
+        /// \param bucket_ms Directory bucket length; it is widened when the
+        /// array spans more than four buckets per element.
+        /// \throws std::invalid_argument if bucket_ms is not positive.
+        TimestampIndex(const ts_ms_t* data, std::size_t count, ts_ms_t bucket_ms = MS_PER_HOUR)
+            : m_data(data)
+            , m_count(count)
+            , m_bucket_ms(bucket_ms)
+            , m_origin(0) {
+            if (bucket_ms <= 0) {
+                throw std::invalid_argument("TimestampIndex bucket must be positive");
+            }
+            if (count == 0) {
+                return;
+            }
+            const uint64_t span = static_cast<uint64_t>(data[count - 1]) - static_cast<uint64_t>(data[0]);
+            const uint64_t max_buckets = 4 * static_cast<uint64_t>(count) + 64;
+            if (span / static_cast<uint64_t>(m_bucket_ms) >= max_buckets) {
+                m_bucket_ms = static_cast<ts_ms_t>(span / max_buckets + 1);
+            }
+            m_origin = data[0] - detail::floor_mod<ts_ms_t>(data[0], m_bucket_ms);
+            const std::size_t buckets = static_cast<std::size_t>(
+                    (static_cast<uint64_t>(data[count - 1]) - static_cast<uint64_t>(m_origin)) / static_cast<uint64_t>(m_bucket_ms)) + 1;
+            m_directory.resize(buckets + 1);
+            std::size_t pos = 0;
+            ts_ms_t boundary = m_origin;
+            for (std::size_t k = 0; k < buckets; ++k) {
+                if (k != 0) {
+                    boundary += m_bucket_ms;
+                }
+                while (pos < count && data[pos] < boundary) {
+                    ++pos;
+                }
+                m_directory[k] = pos;
+            }
+            m_directory[buckets] = count;
+        }
+
+        /// \brief Number of indexed timestamps.
+        std::size_t size() const noexcept {
+            return m_count;
+        }
+
+        /// \brief Directory bucket length in milliseconds.
+        ts_ms_t bucket_ms() const noexcept {
+            return m_bucket_ms;
+        }
+
+        /// \brief Number of directory entries.
+        std::size_t directory_size() const noexcept {
+            return m_directory.size();
+        }
+
+        /// \brief Position of the first timestamp not before \p ts_ms.
+        std::size_t lower_bound(ts_ms_t ts_ms) const noexcept {
+            if (m_count == 0 || ts_ms <= m_data[0]) {
+                return 0;
+            }
+            if (ts_ms > m_data[m_count - 1]) {
+                return m_count;
+            }
+            const std::size_t k = static_cast<std::size_t>(
+                    (static_cast<uint64_t>(ts_ms) - static_cast<uint64_t>(m_origin)) / static_cast<uint64_t>(m_bucket_ms));
+            return static_cast<std::size_t>(
+                    std::lower_bound(m_data + m_directory[k], m_data + m_directory[k + 1], ts_ms) - m_data);
+        }
+
+        /// \brief Timestamps in `[from_ms, to_ms)`.
+        TimestampRange range(ts_ms_t from_ms, ts_ms_t to_ms) const noexcept {
+            const std::size_t begin = lower_bound(from_ms);
+            const std::size_t end = to_ms <= from_ms ? begin : lower_bound(to_ms);
+            return TimestampRange{begin, end};
+        }
+
+        /// \brief Timestamps of a local calendar day given as a unix day number.
+        /// \throws std::invalid_argument if the zone is not supported.
+        TimestampRange unix_day(dse_t day, TimeZone zone = UTC) const {
+            return range(local_to_utc(day * MS_PER_DAY, zone), local_to_utc((day + 1) * MS_PER_DAY, zone));
+        }
+
+        /// \brief Timestamps of a local calendar day.
+        /// \throws std::invalid_argument if the zone is not supported.
+        TimestampRange day(year_t year, int month, int day, TimeZone zone = UTC) const {
+            return unix_day(date_to_unix_day(year, month, day), zone);
+        }
+
+        /// \brief Timestamps of a local ISO week (Monday to Sunday).
+        /// \throws std::invalid_argument if the week does not exist or the zone is not supported.
+        TimestampRange iso_week(year_t iso_year, int week, TimeZone zone = UTC) const {
+            const DateStruct monday = iso_week_date_to_date(create_iso_week_date_struct(iso_year, week, 1));
+            const dse_t first = date_to_unix_day(monday.year, monday.mon, monday.day);
+            return range(local_to_utc(first * MS_PER_DAY, zone),
+                         local_to_utc((first + DAYS_PER_WEEK) * MS_PER_DAY, zone));
+        }
+
+        /// \brief Timestamps of a local calendar month.
+        /// \throws std::invalid_argument if the zone is not supported.
+        TimestampRange month(year_t year, int month, TimeZone zone = UTC) const {
+            const dse_t first = date_to_unix_day(year, month, 1);
+            const dse_t next = month == 12 ? date_to_unix_day(year + 1, 1, 1) : date_to_unix_day(year, month + 1, 1);
+            return range(local_to_utc(first * MS_PER_DAY, zone), local_to_utc(next * MS_PER_DAY, zone));
+        }
+
+        /// \brief Timestamps inside the trading session of a calendar day.
+        /// \return An empty range when the day is not a business day.
+        TimestampRange session(const BusinessCalendar& calendar, dse_t day) const {
+            ts_ms_t open_ms = 0;
+            ts_ms_t close_ms = 0;
+            if (!calendar.session(day, open_ms, close_ms)) {
+                const std::size_t pos = lower_bound(day * MS_PER_DAY);
+                return TimestampRange{pos, pos};
+            }
+            return range(open_ms, close_ms);
+        }
+
+        /// \brief Call `fn(bucket_start_ms, rows)` for every non-empty UTC period bucket.
+        ///
+        /// Buckets are `[offset_ms + k * period_ms, offset_ms + (k + 1) * period_ms)`.
+        /// \throws std::invalid_argument if period_ms is not positive.
+        template<class Fn>
+        void for_each_period(ts_ms_t period_ms, ts_ms_t offset_ms, Fn fn) const {
+            if (period_ms <= 0) {
+                throw std::invalid_argument("TimestampIndex period must be positive");
+            }
+            for (std::size_t pos = 0; pos < m_count;) {
+                const ts_ms_t start = m_data[pos] - detail::floor_mod<ts_ms_t>(m_data[pos] - offset_ms, period_ms);
+                pos = emit(pos, start, start + period_ms, fn);
+            }
+        }
+
+        /// \brief Call `fn(day_start_ms, rows)` for every non-empty local day.
+        /// \throws std::invalid_argument if the zone is not supported.
+        template<class Fn>
+        void for_each_day(Fn fn, TimeZone zone = UTC) const {
+            for (std::size_t pos = 0; pos < m_count;) {
+                const dse_t day = local_day_of(m_data[pos], zone);
+                pos = emit(pos, local_to_utc(day * MS_PER_DAY, zone), local_to_utc((day + 1) * MS_PER_DAY, zone), fn);
+            }
+        }
+
+        /// \brief Call `fn(week_start_ms, rows)` for every non-empty local ISO week.
+        /// \throws std::invalid_argument if the zone is not supported.
+        template<class Fn>
+        void for_each_iso_week(Fn fn, TimeZone zone = UTC) const {
+            for (std::size_t pos = 0; pos < m_count;) {
+                // Unix day 0 is a Thursday, so Mondays are days 7k - 3.
+                const dse_t monday = detail::floor_div<dse_t>(local_day_of(m_data[pos], zone) + 3, DAYS_PER_WEEK) * DAYS_PER_WEEK - 3;
+                pos = emit(pos, local_to_utc(monday * MS_PER_DAY, zone),
+                           local_to_utc((monday + DAYS_PER_WEEK) * MS_PER_DAY, zone), fn);
+            }
+        }
+
+        /// \brief Call `fn(month_start_ms, rows)` for every non-empty local month.
+        /// \throws std::invalid_argument if the zone is not supported.
+        template<class Fn>
+        void for_each_month(Fn fn, TimeZone zone = UTC) const {
+            for (std::size_t pos = 0; pos < m_count;) {
+                const detail::FastDate date = detail::fast_date_from_days(local_day_of(m_data[pos], zone));
+                const dse_t first = date_to_unix_day(date.year, date.month, 1);
+                const dse_t next = date.month == 12 ? date_to_unix_day(date.year + 1, 1, 1)
+                                                    : date_to_unix_day(date.year, date.month + 1, 1);
+                pos = emit(pos, local_to_utc(first * MS_PER_DAY, zone), local_to_utc(next * MS_PER_DAY, zone), fn);
+            }
+        }
+
+    private:
+        static ts_ms_t local_to_utc(ts_ms_t local_ms, TimeZone zone) {
+            const ts_ms_t utc_ms = zone_to_gmt_ms(local_ms, zone);
+            if (utc_ms == ERROR_TIMESTAMP) {
+                throw std::invalid_argument("TimestampIndex zone is not supported");
+            }
+            return utc_ms;
+        }
+
+        static dse_t local_day_of(ts_ms_t utc_ms, TimeZone zone) {
+            const ts_ms_t local_ms = gmt_to_zone_ms(utc_ms, zone);
+            if (local_ms == ERROR_TIMESTAMP) {
+                throw std::invalid_argument("TimestampIndex zone is not supported");
+            }
+            return detail::floor_div<ts_ms_t>(local_ms, MS_PER_DAY);
+        }
+
+        /// \brief Report the bucket `[start_ms, end_ms)` that contains position \p pos and return its end position.
+        template<class Fn>
+        std::size_t emit(std::size_t pos, ts_ms_t start_ms, ts_ms_t end_ms, Fn& fn) const {
+            // Guarantees progress if a zone transition puts the element outside its computed bucket.
+            const std::size_t end = std::max(lower_bound(end_ms), pos + 1);
+            fn(start_ms, TimestampRange{pos, end});
+            return end;
+        }
+
+        const ts_ms_t*              m_data;         ///< Indexed array.
+        std::size_t                 m_count;        ///< Number of elements.
+        ts_ms_t                     m_bucket_ms;    ///< Directory bucket length.
+        ts_ms_t                     m_origin;       ///< Start of the first bucket.
+        std::vector<std::size_t>    m_directory;    ///< First position at or after each bucket start; back() is m_count.
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_TIMESTAMP_INDEX_HPP_INCLUDED
@@ -0,0 +1,463 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_TSC_CLOCK_HPP_INCLUDED
+#define _TIME_SHIELD_TSC_CLOCK_HPP_INCLUDED
+
+/// \file TscClock.hpp
+/// \brief Calibrated CPU counter clock with monotonic and UTC reads.
+///
+/// TscClock maps the invariant time-stamp counter (x86 `rdtsc`) or the ARMv8
+/// virtual counter (`CNTVCT_EL0`) to nanoseconds of std::chrono::steady_clock
+/// and to UTC. A read costs one counter read, a seqlock check and a
+/// multiply-shift, without a system call. The mapping is calibrated at
+/// construction and refined lazily once per recalibration interval. A new
+/// mapping takes over at a counter value slightly in the future and starts
+/// from the old mapping's value there, so monotonic reads stay continuous.
+/// Drift is removed by slewing the rate. A clock that fell behind by more than
+/// one millisecond (for example after suspend) is stepped forward; a clock
+/// that runs ahead is only slowed down, never stepped back.
+/// When the counter is not invariant or the kernel rejected it as a clock
+/// source, reads fall back to std::chrono::steady_clock and now_realtime_us().
+
+#include "config.hpp"
+#include "constants.hpp"
+#include "detail/mul_hi.hpp"
+#include "time_utils.hpp"
+#include "types.hpp"
+#include "wait_strategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if TIME_SHIELD_HAS_TSC_COUNTER
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   elif defined(__x86_64__) || defined(__i386__)
+#       include <cpuid.h>
+#       include <x86intrin.h>
+#   endif
+#endif
+
+namespace time_shield {
+
+    namespace detail {
+        constexpr std::int64_t TSC_MAX_SLEW_ERROR_NS  = 1000000; ///< A clock behind by more than 1 ms is stepped forward.
+        constexpr std::int64_t TSC_REMAP_LEAD_NS      = 50000;   ///< Delay before a new mapping takes over.
+        constexpr std::int64_t TSC_INITIAL_WINDOW_NS  = 5000000; ///< Initial calibration window.
+        constexpr int          TSC_REFERENCE_ATTEMPTS = 5;       ///< Samples taken per reference point.
+    } // namespace detail
+
+    /// \ingroup time_utils
+    /// \brief Clock backed by a calibrated invariant CPU counter.
+    ///
+    /// Reads are lock-free and safe from any thread. Monotonic values share the
+    /// epoch of std::chrono::steady_clock, so they can be mixed with
+    /// monotonic_us() and steady deadlines. UTC values follow CLOCK_REALTIME as
+    /// sampled at the last calibration.
+    class TscClock final {
+    public:
+        /// \brief Return the process-wide clock instance.
+        static TscClock& instance() noexcept {
+            static TscClock* p_instance = new TscClock();
+            return *p_instance;
+        }
+
+        /// \brief Construct and calibrate the clock.
+        ///
+        /// Calibration spins for a few milliseconds to estimate the counter frequency.
+        /// \param use_counter Use the CPU counter when it is suitable; false forces the fallback path.
+        explicit TscClock(bool use_counter = true) noexcept {
+            if (use_counter && has_invariant_counter()) {
+                m_is_available = calibrate_initial();
+            }
+        }
+
+        TscClock(const TscClock&) = delete;
+        TscClock& operator=(const TscClock&) = delete;
+
+        /// \brief Return true when the CPU counter runs at a constant rate across power states.
+        ///
+        /// On x86 the CPUID invariant TSC flag is required and, on Linux, the kernel
+        /// must use `tsc` as its clock source. ARMv8 generic timers are invariant by design.
+        static bool has_invariant_counter() noexcept {
+#       if TIME_SHIELD_HAS_TSC_COUNTER && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#           if defined(_MSC_VER)
+            int regs[4] = {0, 0, 0, 0};
+            __cpuid(regs, static_cast<int>(0x80000000u));
+            if (static_cast<unsigned>(regs[0]) < 0x80000007u) {
+                return false;
+            }
+            __cpuid(regs, static_cast<int>(0x80000007u));
+            const bool is_invariant = (static_cast<unsigned>(regs[3]) & (1u << 8)) != 0;
+#           else
+            unsigned eax = 0;
+            unsigned ebx = 0;
+            unsigned ecx = 0;
+            unsigned edx = 0;
+            if (__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007u) {
+                return false;
+            }
+            if (__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) == 0) {
+                return false;
+            }
+            const bool is_invariant = (edx & (1u << 8)) != 0;
+#           endif
+            return is_invariant && is_kernel_clock_source_tsc();
+#       elif TIME_SHIELD_HAS_TSC_COUNTER
+            return true;
+#       else
+            return false;
+#       endif
+        }
+
+        /// \brief Read the raw CPU counter.
+        /// \return Counter ticks, or zero when the platform has no supported counter.
+        static std::uint64_t read_counter() noexcept {
+#       if TIME_SHIELD_HAS_TSC_COUNTER && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+            return static_cast<std::uint64_t>(__rdtsc());
+#       elif TIME_SHIELD_HAS_TSC_COUNTER && defined(__aarch64__)
+            std::uint64_t value = 0;
+            __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+            return value;
+#       else
+            return 0;
+#       endif
+        }
+
+        /// \brief Return true when reads use the calibrated CPU counter.
+        bool is_available() const noexcept {
+            return m_is_available;
+        }
+
+        /// \brief Return the calibrated counter frequency in Hz, or zero on the fallback path.
+        double counter_frequency_hz() const noexcept {
+            const double ns_per_tick = m_ns_per_tick.load(std::memory_order_relaxed);
+            return ns_per_tick > 0.0 ? static_cast<double>(NS_PER_SEC) / ns_per_tick : 0.0;
+        }
+
+        /// \brief Set how often reads refresh the calibration.
+        ///
+        /// A zero interval disables automatic recalibration; recalibrate() still works.
+        /// Negative intervals are treated as zero.
+        template<class Rep, class Period>
+        void set_recalibration_interval(std::chrono::duration<Rep, Period> interval) noexcept {
+            std::int64_t interval_ns = static_cast<std::int64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count());
+            if (interval_ns < 0) {
+                interval_ns = 0;
+            }
+            m_interval_ns.store(interval_ns, std::memory_order_relaxed);
+            recalibrate();
+        }
+
+        /// \brief Return the automatic recalibration interval.
+        std::chrono::nanoseconds recalibration_interval() const noexcept {
+            return std::chrono::nanoseconds(m_interval_ns.load(std::memory_order_relaxed));
+        }
+
+        /// \brief Refresh the counter frequency and the UTC mapping.
+        ///
+        /// Concurrent callers return immediately while another thread recalibrates.
+        /// A call made before the previous mapping has taken over does nothing.
+        void recalibrate() noexcept {
+            if (!m_is_available) {
+                return;
+            }
+            bool expected = false;
+            if (!m_is_calibrating.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return;
+            }
+
+            const ReferencePoint reference = sample_reference();
+            if (reference.ticks > m_last_reference.ticks) {
+                const double ns_per_tick = static_cast<double>(reference.mono_ns - m_last_reference.mono_ns)
+                                         / static_cast<double>(reference.ticks - m_last_reference.ticks);
+                const Mapping current = load_mapping();
+                const std::uint64_t now_ticks = read_counter();
+                // Wait until the current mapping has taken over before replacing it.
+                if (is_sane_ns_per_tick(ns_per_tick) && now_ticks >= current.base_ticks) {
+                    // Readers that loaded the current mapping have read the counter
+                    // before the anchor, where both mappings give the same values.
+                    const std::uint64_t anchor_ticks = now_ticks + static_cast<std::uint64_t>(
+                        static_cast<double>(detail::TSC_REMAP_LEAD_NS) / ns_per_tick);
+                    const std::int64_t mapped_ns = map_ticks(current, anchor_ticks);
+                    const std::int64_t target_ns = reference.mono_ns + static_cast<std::int64_t>(
+                        static_cast<double>(anchor_ticks - reference.ticks) * ns_per_tick);
+                    const std::int64_t error_ns = mapped_ns - target_ns;
+
+                    Mapping next{};
+                    next.base_ticks = anchor_ticks;
+                    next.prev_base_ticks = current.base_ticks;
+                    next.prev_base_ns = current.base_ns;
+                    next.prev_mult = current.mult;
+                    if (error_ns < -detail::TSC_MAX_SLEW_ERROR_NS) {
+                        next.base_ns = target_ns;
+                        next.mult = to_mult(ns_per_tick);
+                    } else {
+                        // Slew over at least twice the error so the rate never drops below half.
+                        const std::int64_t horizon_ns = error_ns > slew_horizon_ns() / 2
+                                                      ? 2 * error_ns : slew_horizon_ns();
+                        next.base_ns = mapped_ns;
+                        next.mult = to_mult(ns_per_tick * static_cast<double>(horizon_ns - error_ns)
+                                                        / static_cast<double>(horizon_ns));
+                    }
+                    next.utc_offset_ns = reference.utc_ns - reference.mono_ns;
+                    next.next_recalibration_ticks = next_recalibration_ticks(reference.ticks, ns_per_tick);
+                    store_mapping(next);
+                    m_ns_per_tick.store(ns_per_tick, std::memory_order_relaxed);
+                    m_last_reference = reference;
+                }
+            }
+
+            m_is_calibrating.store(false, std::memory_order_release);
+        }
+
+        /// \brief Convert a value returned by read_counter() to monotonic nanoseconds.
+        ///
+        /// Uses the current mapping and does not trigger recalibration, so it is
+        /// suited for converting stamps collected earlier. Meaningful only when
+        /// is_available() is true.
+        std::int64_t counter_to_monotonic_ns(std::uint64_t ticks) const noexcept {
+            return map_ticks(load_mapping(), ticks);
+        }
+
+        /// \brief Return monotonic nanoseconds in the std::chrono::steady_clock epoch.
+        ///
+        /// Values do not decrease: a new mapping continues the previous one at
+        /// its anchor, and counter values read before the anchor keep using the
+        /// previous segment.
+        std::int64_t monotonic_ns() noexcept {
+            if (!m_is_available) {
+                return steady_ns();
+            }
+            const std::uint64_t ticks = read_counter();
+            const Mapping mapping = load_mapping();
+            if (ticks >= mapping.next_recalibration_ticks) {
+                recalibrate();
+            }
+            return map_ticks(mapping, ticks);
+        }
+
+        /// \brief Return monotonic microseconds in the std::chrono::steady_clock epoch.
+        ts_us_t monotonic_us() noexcept {
+            return static_cast<ts_us_t>(monotonic_ns() / NS_PER_US);
+        }
+
+        /// \brief Return current UTC time in nanoseconds.
+        std::int64_t utc_time_ns() noexcept {
+            if (!m_is_available) {
+                return static_cast<std::int64_t>(now_realtime_us()) * NS_PER_US;
+            }
+            const std::uint64_t ticks = read_counter();
+            const Mapping mapping = load_mapping();
+            if (ticks >= mapping.next_recalibration_ticks) {
+                recalibrate();
+            }
+            return map_ticks(mapping, ticks) + mapping.utc_offset_ns;
+        }
+
+        /// \brief Return current UTC time in microseconds.
+        ts_us_t utc_time_us() noexcept {
+            if (!m_is_available) {
+                return static_cast<ts_us_t>(now_realtime_us());
+            }
+            return static_cast<ts_us_t>(utc_time_ns() / NS_PER_US);
+        }
+
+        /// \brief Return current UTC time in milliseconds.
+        ts_ms_t utc_time_ms() noexcept {
+            return static_cast<ts_ms_t>(utc_time_us() / US_PER_MS);
+        }
+
+    private:
+        /// \brief Published counter-to-nanosecond mapping.
+        struct Mapping {
+            std::uint64_t base_ticks;               ///< Counter value at the anchor.
+            std::int64_t  base_ns;                  ///< Monotonic nanoseconds at the anchor.
+            std::uint64_t mult;                     ///< Nanoseconds per tick in 32.32 fixed point.
+            std::uint64_t prev_base_ticks;          ///< Anchor of the previous mapping, used before base_ticks.
+            std::int64_t  prev_base_ns;             ///< Monotonic nanoseconds at the previous anchor.
+            std::uint64_t prev_mult;                ///< Rate of the previous mapping.
+            std::int64_t  utc_offset_ns;            ///< UTC minus monotonic nanoseconds.
+            std::uint64_t next_recalibration_ticks; ///< Counter value that triggers recalibration.
+        };
+
+        /// \brief Simultaneous sample of the counter and reference clocks.
+        struct ReferencePoint {
+            std::uint64_t ticks;
+            std::int64_t  mono_ns;
+            std::int64_t  utc_ns;
+        };
+
+        static bool is_kernel_clock_source_tsc() noexcept {
+#       if defined(__linux__)
+            std::FILE* file = std::fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+            if (!file) {
+                return true;
+            }
+            char name[32] = {0};
+            const bool has_name = std::fgets(name, static_cast<int>(sizeof(name)), file) != nullptr;
+            std::fclose(file);
+            return !has_name || std::strncmp(name, "tsc", 3) == 0;
+#       else
+            return true;
+#       endif
+        }
+
+        static std::int64_t steady_ns() noexcept {
+            return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        static bool is_sane_ns_per_tick(double ns_per_tick) noexcept {
+            // Accept counters between 1 MHz and 100 GHz.
+            return ns_per_tick > 0.01 && ns_per_tick < 1000.0;
+        }
+
+        static std::uint64_t to_mult(double ns_per_tick) noexcept {
+            return static_cast<std::uint64_t>(ns_per_tick * 4294967296.0 + 0.5);
+        }
+
+        static std::int64_t scale(std::uint64_t delta, std::uint64_t mult) noexcept {
+            const std::uint64_t high = detail::mul_hi_u64(delta, mult);
+            const std::uint64_t low = delta * mult;
+            return static_cast<std::int64_t>((high << 32) | (low >> 32));
+        }
+
+        static std::int64_t map_segment(std::uint64_t base_ticks, std::int64_t base_ns,
+                                        std::uint64_t mult, std::uint64_t ticks) noexcept {
+            if (ticks >= base_ticks) {
+                return base_ns + scale(ticks - base_ticks, mult);
+            }
+            return base_ns - scale(base_ticks - ticks, mult);
+        }
+
+        /// \brief Map counter ticks, using the previous mapping before the anchor.
+        static std::int64_t map_ticks(const Mapping& mapping, std::uint64_t ticks) noexcept {
+            if (ticks >= mapping.base_ticks) {
+                return map_segment(mapping.base_ticks, mapping.base_ns, mapping.mult, ticks);
+            }
+            return map_segment(mapping.prev_base_ticks, mapping.prev_base_ns, mapping.prev_mult, ticks);
+        }
+
+        static ReferencePoint sample_reference() noexcept {
+            ReferencePoint best{0, 0, 0};
+            std::uint64_t best_span = ~static_cast<std::uint64_t>(0);
+            for (int i = 0; i < detail::TSC_REFERENCE_ATTEMPTS; ++i) {
+                const std::uint64_t before = read_counter();
+                const std::int64_t mono_ns = steady_ns();
+                const struct timespec realtime = get_timespec_impl();
+                const std::uint64_t after = read_counter();
+                const std::uint64_t span = after - before;
+                if (after >= before && span < best_span) {
+                    best_span = span;
+                    best.ticks = before + span / 2;
+                    best.mono_ns = mono_ns;
+                    best.utc_ns = static_cast<std::int64_t>(realtime.tv_sec) * NS_PER_SEC
+                                + static_cast<std::int64_t>(realtime.tv_nsec);
+                }
+            }
+            return best;
+        }
+
+        std::int64_t slew_horizon_ns() const noexcept {
+            const std::int64_t interval_ns = m_interval_ns.load(std::memory_order_relaxed);
+            return interval_ns > 10 * detail::TSC_MAX_SLEW_ERROR_NS ? interval_ns : 10 * detail::TSC_MAX_SLEW_ERROR_NS;
+        }
+
+        std::uint64_t next_recalibration_ticks(std::uint64_t ticks, double ns_per_tick) const noexcept {
+            const std::int64_t interval_ns = m_interval_ns.load(std::memory_order_relaxed);
+            if (interval_ns <= 0) {
+                return ~static_cast<std::uint64_t>(0);
+            }
+            return ticks + static_cast<std::uint64_t>(static_cast<double>(interval_ns) / ns_per_tick);
+        }
+
+        bool calibrate_initial() noexcept {
+            const ReferencePoint first = sample_reference();
+            spin_until(std::chrono::steady_clock::now() + std::chrono::nanoseconds(detail::TSC_INITIAL_WINDOW_NS));
+            const ReferencePoint second = sample_reference();
+            if (second.ticks <= first.ticks) {
+                return false;
+            }
+            const double ns_per_tick = static_cast<double>(second.mono_ns - first.mono_ns)
+                                     / static_cast<double>(second.ticks - first.ticks);
+            if (!is_sane_ns_per_tick(ns_per_tick)) {
+                return false;
+            }
+
+            Mapping mapping{};
+            mapping.base_ticks = second.ticks;
+            mapping.base_ns = second.mono_ns;
+            mapping.mult = to_mult(ns_per_tick);
+            mapping.prev_base_ticks = mapping.base_ticks;
+            mapping.prev_base_ns = mapping.base_ns;
+            mapping.prev_mult = mapping.mult;
+            mapping.utc_offset_ns = second.utc_ns - second.mono_ns;
+            mapping.next_recalibration_ticks = next_recalibration_ticks(second.ticks, ns_per_tick);
+            store_mapping(mapping);
+            m_ns_per_tick.store(ns_per_tick, std::memory_order_relaxed);
+            m_last_reference = second;
+            return true;
+        }
+
+        Mapping load_mapping() const noexcept {
+            Mapping mapping{};
+            for (;;) {
+                const std::uint32_t begin = m_sequence.load(std::memory_order_acquire);
+                if ((begin & 1u) != 0) {
+                    detail::cpu_relax();
+                    continue;
+                }
+                mapping.base_ticks = m_base_ticks.load(std::memory_order_relaxed);
+                mapping.base_ns = m_base_ns.load(std::memory_order_relaxed);
+                mapping.mult = m_mult.load(std::memory_order_relaxed);
+                mapping.prev_base_ticks = m_prev_base_ticks.load(std::memory_order_relaxed);
+                mapping.prev_base_ns = m_prev_base_ns.load(std::memory_order_relaxed);
+                mapping.prev_mult = m_prev_mult.load(std::memory_order_relaxed);
+                mapping.utc_offset_ns = m_utc_offset_ns.load(std::memory_order_relaxed);
+                mapping.next_recalibration_ticks = m_next_recalibration_ticks.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == begin) {
+                    return mapping;
+                }
+            }
+        }
+
+        void store_mapping(const Mapping& mapping) noexcept {
+            const std::uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+            m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_base_ticks.store(mapping.base_ticks, std::memory_order_relaxed);
+            m_base_ns.store(mapping.base_ns, std::memory_order_relaxed);
+            m_mult.store(mapping.mult, std::memory_order_relaxed);
+            m_prev_base_ticks.store(mapping.prev_base_ticks, std::memory_order_relaxed);
+            m_prev_base_ns.store(mapping.prev_base_ns, std::memory_order_relaxed);
+            m_prev_mult.store(mapping.prev_mult, std::memory_order_relaxed);
+            m_utc_offset_ns.store(mapping.utc_offset_ns, std::memory_order_relaxed);
+            m_next_recalibration_ticks.store(mapping.next_recalibration_ticks, std::memory_order_relaxed);
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        std::atomic<std::uint32_t> m_sequence{0};
+        std::atomic<std::uint64_t> m_base_ticks{0};
+        std::atomic<std::int64_t>  m_base_ns{0};
+        std::atomic<std::uint64_t> m_mult{0};
+        std::atomic<std::uint64_t> m_prev_base_ticks{0};
+        std::atomic<std::int64_t>  m_prev_base_ns{0};
+        std::atomic<std::uint64_t> m_prev_mult{0};
+        std::atomic<std::int64_t>  m_utc_offset_ns{0};
+        std::atomic<std::uint64_t> m_next_recalibration_ticks{~static_cast<std::uint64_t>(0)};
+        std::atomic<double>        m_ns_per_tick{0.0};
+        std::atomic<std::int64_t>  m_interval_ns{NS_PER_SEC};
+        std::atomic<bool>          m_is_calibrating{false};
+        ReferencePoint             m_last_reference{0, 0, 0}; ///< Guarded by m_is_calibrating.
+        bool                       m_is_available{false};
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_TSC_CLOCK_HPP_INCLUDED
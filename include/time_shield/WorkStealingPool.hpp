@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_WORK_STEALING_POOL_HPP_INCLUDED
+#define _TIME_SHIELD_WORK_STEALING_POOL_HPP_INCLUDED
+
+/// \file WorkStealingPool.hpp
+/// \brief Fork-join thread pool with range stealing for batch conversions.
+///
+/// parallel_for() splits the task indices into one contiguous range per
+/// participant (the workers plus the calling thread). Each participant takes
+/// tasks from the front of its own range; a participant that runs dry steals
+/// the back half of another range. A range is one 64-bit atomic word, so both
+/// operations are a single compare-exchange and tasks that are cheap on some
+/// inputs and expensive on others (e.g. DST zones, invalid strings) still
+/// spread evenly.
+
+#include "config.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace time_shield {
+
+    /// \ingroup time_utils
+    /// \brief Fork-join pool used by the parallel batch drivers.
+    ///
+    /// Any type with a `parallel_for(std::size_t task_count, Fn fn)` member
+    /// that calls `fn(task)` once for every task in `[0, task_count)` and
+    /// returns when all calls have finished can replace it in those drivers.
+    /// Calls to parallel_for() from several threads are serialized; a call
+    /// from inside a task of the same pool runs inline on the calling thread.
+    /// \code
+    /// WorkStealingPool pool(8);
+    /// pool.parallel_for(chunks, [&](std::size_t chunk) { convert(chunk); });
+    /// \endcode
+    class WorkStealingPool {
+    public:
+        /// \brief Start the workers.
+        /// \param threads Number of threads including the caller of parallel_for();
+        /// 0 uses std::thread::hardware_concurrency().
+        explicit WorkStealingPool(std::size_t threads = 0)
+            : m_slot_count(threads != 0 ? threads : default_concurrency())
+            , m_slots(new Slot[m_slot_count]) {
+            m_threads.reserve(m_slot_count - 1);
+            for (std::size_t i = 1; i < m_slot_count; ++i) {
+                m_threads.emplace_back(&WorkStealingPool::worker_loop, this, i);
+            }
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        /// \brief Stop and join the workers.
+        ~WorkStealingPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (std::size_t i = 0; i < m_threads.size(); ++i) {
+                m_threads[i].join();
+            }
+        }
+
+        /// \brief Process-wide pool sized to the hardware concurrency.
+        static WorkStealingPool& shared() {
+            static WorkStealingPool s_pool;
+            return s_pool;
+        }
+
+        /// \brief Number of threads that run tasks, including the caller.
+        std::size_t concurrency() const noexcept {
+            return m_slot_count;
+        }
+
+        /// \brief Call `fn(task)` for every task in `[0, task_count)` and wait for all of them.
+        ///
+        /// The calling thread runs tasks too. If a task throws, the remaining
+        /// tasks are skipped and the first exception is rethrown here. Called
+        /// from a task of this pool, it runs every task on the calling thread.
+        /// \throws std::invalid_argument if task_count does not fit in 32 bits.
+        template<class Fn>
+        void parallel_for(std::size_t task_count, Fn fn) {
+            if (task_count == 0) {
+                return;
+            }
+            if (task_count > UINT32_MAX) {
+                throw std::invalid_argument("WorkStealingPool task count exceeds 32 bits");
+            }
+            if (m_threads.empty() || task_count == 1 || is_running_tasks()) {
+                for (std::size_t task = 0; task < task_count; ++task) {
+                    fn(task);
+                }
+                return;
+            }
+
+            std::lock_guard<std::mutex> run_lock(m_run_mutex);
+            for (std::size_t i = 0; i < m_slot_count; ++i) {
+                const uint64_t begin = task_count * i / m_slot_count;
+                const uint64_t end = task_count * (i + 1) / m_slot_count;
+                m_slots[i].range.store(pack(begin, end), std::memory_order_relaxed);
+            }
+            m_invoke = &invoke<Fn>;
+            m_context = &fn;
+            m_failed.store(false, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_error = std::exception_ptr();
+                m_finished = 0;
+                ++m_generation;
+            }
+            m_wake.notify_all();
+
+            run_tasks(0);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this]() { return m_finished == m_threads.size(); });
+            if (m_error) {
+                std::rethrow_exception(m_error);
+            }
+        }
+
+    private:
+        /// \brief Task range of one participant, padded to a cache line.
+        struct Slot {
+            std::atomic<uint64_t> range{0}; ///< First task in the high half, end in the low half.
+            char pad[TIME_SHIELD_CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)]; ///< Keeps neighbouring ranges apart.
+        };
+
+        /// \brief Marks the calling thread as running tasks of a pool while alive.
+        struct ActiveScope {
+            explicit ActiveScope(const WorkStealingPool* active_pool) noexcept
+                : pool(active_pool)
+                , previous(current()) {
+                current() = this;
+            }
+
+            ~ActiveScope() {
+                current() = previous;
+            }
+
+            ActiveScope(const ActiveScope&) = delete;
+            ActiveScope& operator=(const ActiveScope&) = delete;
+
+            /// \brief Innermost scope of the calling thread.
+            static ActiveScope*& current() noexcept {
+                static TIME_SHIELD_THREAD_LOCAL ActiveScope* t_scope = nullptr;
+                return t_scope;
+            }
+
+            const WorkStealingPool* pool;
+            ActiveScope*            previous;
+        };
+
+        /// \brief True when the calling thread is inside a task of this pool.
+        bool is_running_tasks() const noexcept {
+            for (const ActiveScope* scope = ActiveScope::current(); scope != nullptr; scope = scope->previous) {
+                if (scope->pool == this) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static std::size_t default_concurrency() noexcept {
+            const unsigned hardware = std::thread::hardware_concurrency();
+            return hardware != 0 ? hardware : 1;
+        }
+
+        static uint64_t pack(uint64_t begin, uint64_t end) noexcept {
+            return (begin << 32) | end;
+        }
+
+        template<class Fn>
+        static void invoke(void* context, std::size_t task) {
+            (*static_cast<Fn*>(context))(task);
+        }
+
+        /// \brief Take the first task of slot \p index.
+        bool pop(std::size_t index, std::size_t& task) noexcept {
+            std::atomic<uint64_t>& range = m_slots[index].range;
+            uint64_t value = range.load(std::memory_order_relaxed);
+            for (;;) {
+                const uint64_t begin = value >> 32;
+                const uint64_t end = value & 0xFFFFFFFFULL;
+                if (begin >= end) {
+                    return false;
+                }
+                if (range.compare_exchange_weak(value, pack(begin + 1, end), std::memory_order_acq_rel)) {
+                    task = static_cast<std::size_t>(begin);
+                    return true;
+                }
+            }
+        }
+
+        /// \brief Move the back half of another slot's range into slot \p index and take its first task.
+        bool steal(std::size_t index, std::size_t& task) noexcept {
+            for (std::size_t k = 1; k < m_slot_count; ++k) {
+                const std::size_t victim = (index + k) % m_slot_count;
+                std::atomic<uint64_t>& range = m_slots[victim].range;
+                uint64_t value = range.load(std::memory_order_relaxed);
+                for (;;) {
+                    const uint64_t begin = value >> 32;
+                    const uint64_t end = value & 0xFFFFFFFFULL;
+                    if (begin >= end) {
+                        break;
+                    }
+                    const uint64_t split = end - (end - begin + 1) / 2;
+                    if (range.compare_exchange_weak(value, pack(begin, split), std::memory_order_acq_rel)) {
+                        // The own slot is empty here, so no other thread can change it concurrently.
+                        m_slots[index].range.store(pack(split + 1, end), std::memory_order_release);
+                        task = static_cast<std::size_t>(split);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void run_tasks(std::size_t index) {
+            const ActiveScope scope(this);
+            std::size_t task = 0;
+            while (pop(index, task) || steal(index, task)) {
+                if (m_failed.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+                try {
+                    m_invoke(m_context, task);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_error) {
+                        m_error = std::current_exception();
+                    }
+                    m_failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void worker_loop(std::size_t index) {
+            uint64_t seen = 0;
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [&]() { return m_stop || m_generation != seen; });
+                    if (m_stop) {
+                        return;
+                    }
+                    seen = m_generation;
+                }
+                run_tasks(index);
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    ++m_finished;
+                }
+                m_done.notify_one();
+            }
+        }
+
+        std::size_t                 m_slot_count;       ///< Participants including the caller.
+        std::unique_ptr<Slot[]>     m_slots;            ///< Task range per participant; slot 0 is the caller.
+        std::vector<std::thread>    m_threads;          ///< Workers for slots 1..m_slot_count-1.
+        std::mutex                  m_run_mutex;        ///< Serializes parallel_for() calls.
+        std::mutex                  m_mutex;            ///< Guards the fields below.
+        std::condition_variable     m_wake;             ///< Signals a new job or shutdown.
+        std::condition_variable     m_done;             ///< Signals a worker leaving the job.
+        uint64_t                    m_generation = 0;   ///< Job counter.
+        std::size_t                 m_finished = 0;     ///< Workers done with the current job.
+        bool                        m_stop = false;     ///< Shutdown flag.
+        std::exception_ptr          m_error;            ///< First exception of the current job.
+        std::atomic<bool>           m_failed{false};    ///< A task of the current job threw.
+        void (*m_invoke)(void*, std::size_t) = nullptr; ///< Type-erased task call.
+        void*                       m_context = nullptr; ///< Task functor of the current job.
+    };
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_WORK_STEALING_POOL_HPP_INCLUDED
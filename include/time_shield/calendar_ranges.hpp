@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_CALENDAR_RANGES_HPP_INCLUDED
+#define _TIME_SHIELD_CALENDAR_RANGES_HPP_INCLUDED
+
+/// \file calendar_ranges.hpp
+/// \brief Lazy ranges of calendar days, workdays, ISO weeks, months and years.
+///
+/// Stepping with start_of_next_day(), start_of_month() and similar helpers
+/// converts timestamp -> date -> timestamp on every call. The ranges here
+/// convert once at the start and then carry the date, the weekday and the
+/// local day number forward, so a step is a few integer operations (plus one
+/// zone_to_gmt_ms() call for zones other than UTC and GMT).
+/// \code
+/// for (const CalendarPeriod& month : months(from_ms, to_ms, CET)) {
+///     report(month.year, month.mon, month.start_ms, month.end_ms);
+/// }
+/// \endcode
+
+#include "config.hpp"
+#include "constants.hpp"
+#include "enums.hpp"
+#include "types.hpp"
+#include "date_time_conversions.hpp"
+#include "time_zone_conversions.hpp"
+#include "unix_time_conversions.hpp"
+#include "validation.hpp"
+#include "detail/fast_date.hpp"
+#include "detail/floor_math.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+namespace time_shield {
+
+    /// \ingroup time_structures
+    /// \brief One step of a calendar range.
+    struct CalendarPeriod {
+        ts_ms_t start_ms;   ///< UTC start of the period.
+        ts_ms_t end_ms;     ///< UTC start of the day after the period (exclusive end).
+        year_t  year;       ///< Local year of the first day.
+        int     mon;        ///< Local month of the first day (1-12).
+        int     day;        ///< Local day of month of the first day (1-31).
+    };
+
+namespace detail {
+
+    /// \brief Local date carried between range steps.
+    struct CalendarCursor {
+        dse_t   unix_day;   ///< Local day number.
+        year_t  year;       ///< Year.
+        int     mon;        ///< Month (1-12).
+        int     day;        ///< Day of month.
+        int     weekday;    ///< Weekday (SUN = 0).
+    };
+
+    /// \brief Advance a cursor by up to 28 days.
+    inline void calendar_cursor_add_days(CalendarCursor& cursor, int days) noexcept {
+        cursor.unix_day += days;
+        cursor.weekday = (cursor.weekday + days) % 7;
+        cursor.day += days;
+        const int month_days = num_days_in_month(cursor.year, cursor.mon);
+        if (cursor.day > month_days) {
+            cursor.day -= month_days;
+            if (++cursor.mon > 12) {
+                cursor.mon = 1;
+                ++cursor.year;
+            }
+        }
+    }
+
+} // namespace detail
+
+    /// \ingroup time_conversions
+    /// \brief Lazy range of consecutive calendar periods in a time zone.
+    ///
+    /// Yields every period that overlaps `[from_ms, to_ms)`, starting with the
+    /// period containing from_ms (for workdays, the first workday on or after
+    /// it). Periods are local calendar units whose bounds are given in UTC.
+    /// A workday period is one calendar day: Friday ends at the start of
+    /// Saturday, although the next period starts on Monday.
+    /// Use the days(), local_days(), workdays(), iso_weeks(), months() and
+    /// years() factories.
+    class CalendarRange {
+    public:
+        /// \brief Calendar unit of a range.
+        enum class Unit : uint8_t {
+            Day,        ///< Calendar days.
+            Workday,    ///< Monday to Friday.
+            IsoWeek,    ///< Weeks starting on Monday.
+            Month,      ///< Calendar months.
+            Year        ///< Calendar years.
+        };
+
+        /// \brief Input iterator over the periods of a range.
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = CalendarPeriod;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const CalendarPeriod*;
+            using reference = const CalendarPeriod&;
+
+            /// \brief Construct an end iterator.
+            iterator() noexcept
+                : m_period(CalendarPeriod{0, 0, 0, 0, 0})
+                , m_next(detail::CalendarCursor{0, 0, 0, 0, 0})
+                , m_to_ms(0)
+                , m_zone(UTC)
+                , m_unit(Unit::Day) {}
+
+            reference operator*() const noexcept {
+                return m_period;
+            }
+
+            pointer operator->() const noexcept {
+                return &m_period;
+            }
+
+            /// \brief Step to the next period.
+            iterator& operator++() {
+                m_period.start_ms = m_unit == Unit::Workday
+                        ? to_utc(m_next.unix_day * MS_PER_DAY, m_zone)
+                        : m_period.end_ms;
+                m_period.year = m_next.year;
+                m_period.mon = m_next.mon;
+                m_period.day = m_next.day;
+                const dse_t first_day = m_next.unix_day;
+                step(m_next, m_unit);
+                m_period.end_ms = to_utc(end_day(first_day, m_next, m_unit) * MS_PER_DAY, m_zone);
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            /// \brief Iterators are equal when both are exhausted or point at the same period.
+            bool operator==(const iterator& other) const noexcept {
+                return done() == other.done() && (done() || m_period.start_ms == other.m_period.start_ms);
+            }
+
+            bool operator!=(const iterator& other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            friend class CalendarRange;
+
+            bool done() const noexcept {
+                return m_period.start_ms >= m_to_ms;
+            }
+
+            static ts_ms_t to_utc(ts_ms_t local_ms, TimeZone zone) {
+                return (zone == UTC || zone == GMT) ? local_ms : zone_to_gmt_ms(local_ms, zone);
+            }
+
+            /// \brief Local day after the period; a workday ends before the weekend that follows it.
+            static dse_t end_day(dse_t first_day, const detail::CalendarCursor& next, Unit unit) noexcept {
+                return unit == Unit::Workday ? first_day + 1 : next.unix_day;
+            }
+
+            /// \brief Move a cursor from the first day of a period to the first day of the next one.
+            static void step(detail::CalendarCursor& cursor, Unit unit) noexcept {
+                switch (unit) {
+                case Unit::Day:
+                    detail::calendar_cursor_add_days(cursor, 1);
+                    break;
+                case Unit::Workday:
+                    detail::calendar_cursor_add_days(cursor, cursor.weekday == FRI ? 3 : (cursor.weekday == SAT ? 2 : 1));
+                    break;
+                case Unit::IsoWeek:
+                    detail::calendar_cursor_add_days(cursor, 7);
+                    break;
+                case Unit::Month: {
+                    const int month_days = num_days_in_month(cursor.year, cursor.mon);
+                    cursor.unix_day += month_days;
+                    cursor.weekday = (cursor.weekday + month_days) % 7;
+                    if (++cursor.mon > 12) {
+                        cursor.mon = 1;
+                        ++cursor.year;
+                    }
+                    break;
+                }
+                case Unit::Year: {
+                    const int year_days = is_leap_year_date(cursor.year) ? 366 : 365;
+                    cursor.unix_day += year_days;
+                    cursor.weekday = (cursor.weekday + year_days) % 7;
+                    ++cursor.year;
+                    break;
+                }
+                }
+            }
+
+            CalendarPeriod          m_period;   ///< Current period.
+            detail::CalendarCursor  m_next;     ///< First day of the next period.
+            ts_ms_t                 m_to_ms;    ///< Exclusive end of the range.
+            TimeZone                m_zone;     ///< Zone of the calendar.
+            Unit                    m_unit;     ///< Step unit.
+        };
+
+        using const_iterator = iterator;
+
+        /// \brief Construct a range of periods overlapping `[from_ms, to_ms)`.
+        /// \throws std::invalid_argument if the zone is not supported by zone_to_gmt_ms().
+        CalendarRange(Unit unit, ts_ms_t from_ms, ts_ms_t to_ms, TimeZone zone = UTC)
+            : m_unit(unit)
+            , m_from_ms(from_ms)
+            , m_to_ms(to_ms)
+            , m_zone(zone) {
+            if (zone != UTC && zone != GMT && gmt_to_zone_ms(from_ms, zone) == ERROR_TIMESTAMP) {
+                throw std::invalid_argument("CalendarRange zone is not supported");
+            }
+        }
+
+        /// \brief Iterator at the first period; converts from_ms to a date once.
+        iterator begin() const {
+            iterator it;
+            it.m_to_ms = m_to_ms;
+            it.m_zone = m_zone;
+            it.m_unit = m_unit;
+            if (m_from_ms >= m_to_ms) {
+                it.m_period.start_ms = m_to_ms;
+                return it;
+            }
+            const ts_ms_t local_ms = (m_zone == UTC || m_zone == GMT) ? m_from_ms : gmt_to_zone_ms(m_from_ms, m_zone);
+            const dse_t unix_day = detail::floor_div<ts_ms_t>(local_ms, MS_PER_DAY);
+            const detail::FastDate date = detail::fast_date_from_days(unix_day);
+            // Unix day 0 is a Thursday.
+            detail::CalendarCursor cursor{unix_day, date.year, date.month, date.day,
+                                          static_cast<int>(detail::floor_mod<dse_t>(unix_day + THU, DAYS_PER_WEEK))};
+            switch (m_unit) {
+            case Unit::Day:
+                break;
+            case Unit::Workday:
+                if (cursor.weekday == SAT || cursor.weekday == SUN) {
+                    detail::calendar_cursor_add_days(cursor, cursor.weekday == SAT ? 2 : 1);
+                }
+                break;
+            case Unit::IsoWeek: {
+                const int back = (cursor.weekday + 6) % 7;
+                const detail::FastDate monday = detail::fast_date_from_days(unix_day - back);
+                cursor = detail::CalendarCursor{unix_day - back, monday.year, monday.month, monday.day, MON};
+                break;
+            }
+            case Unit::Month:
+                cursor.unix_day -= cursor.day - 1;
+                cursor.weekday = static_cast<int>(detail::floor_mod<dse_t>(cursor.unix_day + THU, DAYS_PER_WEEK));
+                cursor.day = 1;
+                break;
+            case Unit::Year:
+                cursor.unix_day = date_to_unix_day(cursor.year, 1, 1);
+                cursor.weekday = static_cast<int>(detail::floor_mod<dse_t>(cursor.unix_day + THU, DAYS_PER_WEEK));
+                cursor.mon = 1;
+                cursor.day = 1;
+                break;
+            }
+            it.m_period = CalendarPeriod{iterator::to_utc(cursor.unix_day * MS_PER_DAY, m_zone), 0,
+                                         cursor.year, cursor.mon, cursor.day};
+            it.m_next = cursor;
+            iterator::step(it.m_next, m_unit);
+            it.m_period.end_ms = iterator::to_utc(iterator::end_day(cursor.unix_day, it.m_next, m_unit) * MS_PER_DAY, m_zone);
+            return it;
+        }
+
+        /// \brief Exhausted iterator.
+        iterator end() const noexcept {
+            return iterator();
+        }
+
+        /// \brief Calendar unit.
+        Unit unit() const noexcept {
+            return m_unit;
+        }
+
+        /// \brief Time zone of the calendar.
+        TimeZone zone() const noexcept {
+            return m_zone;
+        }
+
+    private:
+        Unit        m_unit;     ///< Step unit.
+        ts_ms_t     m_from_ms;  ///< Inclusive start of the range.
+        ts_ms_t     m_to_ms;    ///< Exclusive end of the range.
+        TimeZone    m_zone;     ///< Zone of the calendar.
+    };
+
+/// \ingroup time_conversions
+/// \{
+
+    /// \brief UTC calendar days overlapping `[from_ms, to_ms)`.
+    inline CalendarRange days(ts_ms_t from_ms, ts_ms_t to_ms) {
+        return CalendarRange(CalendarRange::Unit::Day, from_ms, to_ms);
+    }
+
+    /// \brief Local calendar days of a zone overlapping `[from_ms, to_ms)`; 23- and 25-hour days included.
+    /// \throws std::invalid_argument if the zone is not supported.
+    inline CalendarRange local_days(ts_ms_t from_ms, ts_ms_t to_ms, TimeZone zone) {
+        return CalendarRange(CalendarRange::Unit::Day, from_ms, to_ms, zone);
+    }
+
+    /// \brief Monday-to-Friday days overlapping `[from_ms, to_ms)`.
+    /// \throws std::invalid_argument if the zone is not supported.
+    inline CalendarRange workdays(ts_ms_t from_ms, ts_ms_t to_ms, TimeZone zone = UTC) {
+        return CalendarRange(CalendarRange::Unit::Workday, from_ms, to_ms, zone);
+    }
+
+    /// \brief ISO weeks (Monday to Sunday) overlapping `[from_ms, to_ms)`.
+    /// \throws std::invalid_argument if the zone is not supported.
+    inline CalendarRange iso_weeks(ts_ms_t from_ms, ts_ms_t to_ms, TimeZone zone = UTC) {
+        return CalendarRange(CalendarRange::Unit::IsoWeek, from_ms, to_ms, zone);
+    }
+
+    /// \brief Calendar months overlapping `[from_ms, to_ms)`.
+    /// \throws std::invalid_argument if the zone is not supported.
+    inline CalendarRange months(ts_ms_t from_ms, ts_ms_t to_ms, TimeZone zone = UTC) {
+        return CalendarRange(CalendarRange::Unit::Month, from_ms, to_ms, zone);
+    }
+
+    /// \brief Calendar years overlapping `[from_ms, to_ms)`.
+    /// \throws std::invalid_argument if the zone is not supported.
+    inline CalendarRange years(ts_ms_t from_ms, ts_ms_t to_ms, TimeZone zone = UTC) {
+        return CalendarRange(CalendarRange::Unit::Year, from_ms, to_ms, zone);
+    }
+
+/// \}
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_CALENDAR_RANGES_HPP_INCLUDED
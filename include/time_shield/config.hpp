@@ -30,6 +30,11 @@
 #   error "C++11 or newer is required to compile this library."
 #endif
 
+// C++20 is detected in addition to TIME_SHIELD_CPP17, which keeps meaning "C++17 or newer".
+#if defined(TIME_SHIELD_CPP17) && TIME_SHIELD_CXX_VERSION >= 202002L
+#   define TIME_SHIELD_CPP20
+#endif
+
 // Configure support for `constexpr` and `if constexpr` based on the C++ standard
 #ifdef TIME_SHIELD_CPP11
 #   define  TIME_SHIELD_IF_CONSTEXPR
@@ -46,6 +51,15 @@
 #endif
 #endif
 
+// Compile-time-only evaluation where available; falls back to `constexpr`
+#if defined(TIME_SHIELD_CPP20) && defined(__cpp_consteval)
+#   define TIME_SHIELD_HAS_CONSTEVAL    1
+#   define TIME_SHIELD_CONSTEVAL        consteval
+#else
+#   define TIME_SHIELD_HAS_CONSTEVAL    0
+#   define TIME_SHIELD_CONSTEVAL        constexpr
+#endif
+
 // Configure nodiscard attribute support while keeping compatibility with C++11 compilers
 #if defined(__has_cpp_attribute)
 #   if __has_cpp_attribute(nodiscard) && defined(TIME_SHIELD_CPP17)
@@ -103,6 +117,46 @@
 #else
 #   define TIME_SHIELD_HAS_WINSOCK 0
 #endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   define TIME_SHIELD_HAS_TSC_COUNTER 1
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+      (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+#   define TIME_SHIELD_HAS_TSC_COUNTER 1
+#else
+#   define TIME_SHIELD_HAS_TSC_COUNTER 0
+#endif
+
+#ifndef TIME_SHIELD_CACHE_LINE_SIZE
+#   define TIME_SHIELD_CACHE_LINE_SIZE 64
+#endif
+
+/// Vector instruction sets used by explicit SIMD kernels; define
+/// TIME_SHIELD_DISABLE_SIMD to build the portable loops only.
+#if !defined(TIME_SHIELD_DISABLE_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define TIME_SHIELD_HAS_SSE2 1
+#else
+#   define TIME_SHIELD_HAS_SSE2 0
+#endif
+
+#if TIME_SHIELD_HAS_SSE2 && (defined(__SSE4_1__) || defined(__AVX__))
+#   define TIME_SHIELD_HAS_SSE41 1
+#else
+#   define TIME_SHIELD_HAS_SSE41 0
+#endif
+
+#if TIME_SHIELD_HAS_SSE2 && defined(__AVX__)
+#   define TIME_SHIELD_HAS_AVX 1
+#else
+#   define TIME_SHIELD_HAS_AVX 0
+#endif
+
+#if !defined(TIME_SHIELD_DISABLE_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#   define TIME_SHIELD_HAS_NEON64 1
+#else
+#   define TIME_SHIELD_HAS_NEON64 0
+#endif
 ///@}
 
 /// \name Optional features
@@ -114,6 +168,26 @@
 #       define TIME_SHIELD_ENABLE_NTP_CLIENT 0
 #   endif
 #endif
+
+/// Enables TIME_SHIELD_TRACE_SCOPE probes; must be set identically in all translation units.
+#ifndef TIME_SHIELD_ENABLE_TRACING
+#   define TIME_SHIELD_ENABLE_TRACING 0
+#endif
+
+/// Enables compile-time calendar lookup tables; must be set identically in all translation units.
+#ifndef TIME_SHIELD_ENABLE_CALENDAR_TABLES
+#   define TIME_SHIELD_ENABLE_CALENDAR_TABLES 0
+#endif
+
+/// First year covered by the calendar lookup tables.
+#ifndef TIME_SHIELD_CALENDAR_TABLE_MIN_YEAR
+#   define TIME_SHIELD_CALENDAR_TABLE_MIN_YEAR 1970
+#endif
+
+/// Last year covered by the calendar lookup tables.
+#ifndef TIME_SHIELD_CALENDAR_TABLE_MAX_YEAR
+#   define TIME_SHIELD_CALENDAR_TABLE_MAX_YEAR 2100
+#endif
 ///@}
 
 #endif // _TIME_SHIELD_CONFIG_HPP_INCLUDED
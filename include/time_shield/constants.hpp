@@ -74,6 +74,7 @@ namespace time_shield {
 
     // Microseconds and milliseconds
     constexpr int64_t US_PER_SEC        = 1000000;  ///< Microseconds per second
+    constexpr int64_t US_PER_MS         = 1000;     ///< Microseconds per millisecond
     constexpr int64_t MS_PER_SEC        = 1000;     ///< Milliseconds per second
     constexpr int64_t MS_PER_1_SEC      = 1000;     ///< Milliseconds per 1 second
     constexpr int64_t MS_PER_5_SEC      = 5000;     ///< Milliseconds per 5 second
@@ -11,6 +11,8 @@
 #include "date_conversions.hpp"
 #include "date_struct.hpp"
 #include "date_time_struct.hpp"
+#include "detail/bit_ops.hpp"
+#include "detail/calendar_tables.hpp"
 #include "detail/fast_date.hpp"
 #include "detail/floor_math.hpp"
 #include "enums.hpp"
@@ -21,6 +23,7 @@
 #include "validation.hpp"
 
 #include <cmath>
+#include <cstddef>
 #include <ctime>
 #include <limits>
 #include <stdexcept>
@@ -572,6 +575,310 @@ namespace time_shield {
         return sec_to_ms(tm_to_timestamp(timeinfo));
     }
 
+    namespace detail {
+
+        /// \brief Rows per block of the batch date-to-timestamp kernels (stack scratch).
+        constexpr std::size_t TS_MS_BATCH_BLOCK = 256;
+
+        /// \brief The batch kernel converts years in [-2^22, 2^22) in 32-bit lanes.
+        constexpr unsigned TS_MS_BATCH_YEAR_BITS = 22;
+
+        /// \brief The batch kernel converts day, hour, min and sec in [-2^16, 2^16) in 32-bit lanes.
+        constexpr unsigned TS_MS_BATCH_FIELD_BITS = 16;
+
+        /// \brief Multiple of 400 years, at least 2^22, added so biased years are never negative.
+        constexpr uint32_t TS_MS_BATCH_YEAR_BIAS = 4194400;
+
+        /// \brief Days from 0000-03-01 of the biased calendar to the Unix epoch.
+        constexpr int64_t TS_MS_BATCH_DAY_OFFSET =
+            719468LL + 146097LL * static_cast<int64_t>(TS_MS_BATCH_YEAR_BIAS / 400U);
+
+        /// \brief Check that every row of a block fits the 32-bit lanes of date_time_block_to_ms().
+        inline bool date_time_block_is_narrow(
+                const int64_t* year,
+                const int* day,
+                const int* hour,
+                const int* min,
+                const int* sec,
+                std::size_t count) noexcept {
+            // Shifted range checks combined with | keep this loop branch-free;
+            // SSE2 has no 64-bit compare.
+            const uint64_t year_bias = 1ULL << TS_MS_BATCH_YEAR_BITS;
+            const uint32_t field_bias = 1U << TS_MS_BATCH_FIELD_BITS;
+            uint64_t wide_year = 0;
+            uint32_t wide_field = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                wide_year |= (static_cast<uint64_t>(year[i]) + year_bias) >> (TS_MS_BATCH_YEAR_BITS + 1);
+                wide_field |= ((static_cast<uint32_t>(day[i]) + field_bias)
+                             | (static_cast<uint32_t>(hour[i]) + field_bias)
+                             | (static_cast<uint32_t>(min[i]) + field_bias)
+                             | (static_cast<uint32_t>(sec[i]) + field_bias)) >> (TS_MS_BATCH_FIELD_BITS + 1);
+            }
+            return (wide_year | wide_field) == 0;
+        }
+
+        /// \brief Branch-free date-time to Unix milliseconds for a narrow block.
+        ///
+        /// Years are biased by a multiple of 400 so the day count is computed
+        /// with unsigned 32-bit division by constants, without the signed era
+        /// branch of fast_days_from_date(); the milliseconds are assembled in
+        /// 64-bit lanes. With \p Validate, invalid rows are written as
+        /// ERROR_TIMESTAMP and flagged in \p is_bad through masks. Rows must
+        /// pass date_time_block_is_narrow().
+        template<bool Validate>
+        inline void date_time_block_to_ms(
+                const int64_t* year,
+                const int* mon,
+                const int* day,
+                const int* hour,
+                const int* min,
+                const int* sec,
+                const int* ms,
+                ts_ms_t* out,
+                uint8_t* is_bad,
+                std::size_t count) noexcept {
+            for (std::size_t i = 0; i < count; ++i) {
+                const uint32_t y = static_cast<uint32_t>(static_cast<int32_t>(year[i])) + TS_MS_BATCH_YEAR_BIAS;
+                const uint32_t month = static_cast<uint32_t>(mon[i]);
+                const uint32_t jan_feb = (14U - month) / 12U;
+                const uint32_t m = month + 12U * jan_feb - 3U;
+                const uint32_t y_march = y - jan_feb;
+                const uint32_t days = 365U * y_march + y_march / 4U - y_march / 100U + y_march / 400U
+                                    + (153U * m + 2U) / 5U;
+                const int32_t sec_of_day = hour[i] * static_cast<int32_t>(SEC_PER_HOUR)
+                                         + min[i] * static_cast<int32_t>(SEC_PER_MIN) + sec[i];
+                const int64_t unix_day = static_cast<int64_t>(days) + static_cast<int64_t>(day[i] - 1)
+                                       - TS_MS_BATCH_DAY_OFFSET;
+                const int64_t value = unix_day * MS_PER_DAY
+                                    + static_cast<int64_t>(sec_of_day) * MS_PER_SEC
+                                    + static_cast<int64_t>(ms[i]);
+                if (!Validate) {
+                    out[i] = value;
+                    continue;
+                }
+                // y % 100 != 0 as "not a multiple of 25" via the modular inverse of 25;
+                // y % 400 == 0 as y % 16 == 0 given a multiple of 25.
+                const uint32_t is_leap = static_cast<uint32_t>((y & 3U) == 0U)
+                                       & (static_cast<uint32_t>(y * 0xC28F5C29U > 0x0A3D70A3U)
+                                        | static_cast<uint32_t>((y & 15U) == 0U));
+                const uint32_t is_feb = static_cast<uint32_t>(month == 2U);
+                const uint32_t long_month = ((month + (month >> 3)) & 1U) + 30U;
+                const uint32_t month_days = is_feb * (28U + is_leap) + (1U - is_feb) * long_month;
+                const uint32_t is_valid = static_cast<uint32_t>(month - 1U < 12U)
+                                        & static_cast<uint32_t>(static_cast<uint32_t>(day[i]) - 1U < month_days)
+                                        & static_cast<uint32_t>(static_cast<uint32_t>(hour[i]) < 24U)
+                                        & static_cast<uint32_t>(static_cast<uint32_t>(min[i]) < 60U)
+                                        & static_cast<uint32_t>(static_cast<uint32_t>(sec[i]) < 60U)
+                                        & static_cast<uint32_t>(static_cast<uint32_t>(ms[i]) < 1000U);
+                const int64_t keep = -static_cast<int64_t>(is_valid);
+                out[i] = (value & keep) | (ERROR_TIMESTAMP & ~keep);
+                is_bad[i] = static_cast<uint8_t>(is_valid ^ 1U);
+            }
+        }
+
+        /// \brief Scalar date-time to Unix milliseconds for rows outside the 32-bit lanes.
+        ///
+        /// Returns ERROR_TIMESTAMP and sets \p is_bad for years outside
+        /// [MIN_YEAR, MAX_YEAR], months outside 1-12, results that overflow and,
+        /// with \p validate, rows rejected by is_valid_date_time().
+        inline ts_ms_t date_time_row_to_ms(
+                int64_t year, int mon, int day, int hour, int min, int sec, int ms,
+                bool validate,
+                bool& is_bad) noexcept {
+            is_bad = true;
+            if (year < MIN_YEAR || year > MAX_YEAR || mon < 1 || mon > 12) {
+                return ERROR_TIMESTAMP;
+            }
+            if (validate && !(is_valid_date(year, mon, day) && is_valid_time(hour, min, sec, ms))) {
+                return ERROR_TIMESTAMP;
+            }
+            int64_t sec_value = fast_days_from_date(year, mon, day) * SEC_PER_DAY
+                + static_cast<int64_t>(hour) * SEC_PER_HOUR
+                + static_cast<int64_t>(min) * SEC_PER_MIN
+                + static_cast<int64_t>(sec);
+            int64_t ms_value = static_cast<int64_t>(ms);
+            sec_value += floor_div(ms_value, static_cast<int64_t>(MS_PER_SEC));
+            ms_value = floor_mod(ms_value, static_cast<int64_t>(MS_PER_SEC));
+            if ((sec_value > 0 &&
+                 sec_value > ((std::numeric_limits<int64_t>::max)() - ms_value) / MS_PER_SEC) ||
+                (sec_value < 0 &&
+                 sec_value < (std::numeric_limits<int64_t>::min)() / MS_PER_SEC)) {
+                return ERROR_TIMESTAMP;
+            }
+            is_bad = false;
+            return static_cast<ts_ms_t>(sec_value * MS_PER_SEC + ms_value);
+        }
+
+        /// \brief Convert column blocks of rows, write the bad-row bits and return the bad count.
+        ///
+        /// \p bad_rows receives one bit per row (bit i % 64 of word i / 64) and
+        /// may be null; it is written only when \p validate is set.
+        inline std::size_t columns_to_timestamp_ms(
+                const DateTimeColumns& in,
+                ts_ms_t* out,
+                std::size_t count,
+                bool validate,
+                uint64_t* bad_rows) noexcept {
+            static const int s_zeros[TS_MS_BATCH_BLOCK] = {};
+            uint8_t is_bad[TS_MS_BATCH_BLOCK];
+            std::size_t bad_count = 0;
+            for (std::size_t base = 0; base < count; base += TS_MS_BATCH_BLOCK) {
+                std::size_t n = count - base;
+                if (n > TS_MS_BATCH_BLOCK) n = TS_MS_BATCH_BLOCK;
+                const int64_t* year = in.year + base;
+                const int* mon = in.mon + base;
+                const int* day = in.day + base;
+                const int* hour = in.hour ? in.hour + base : s_zeros;
+                const int* min = in.min ? in.min + base : s_zeros;
+                const int* sec = in.sec ? in.sec + base : s_zeros;
+                const int* ms = in.ms ? in.ms + base : s_zeros;
+                if (date_time_block_is_narrow(year, day, hour, min, sec, n)) {
+                    if (validate) {
+                        date_time_block_to_ms<true>(year, mon, day, hour, min, sec, ms, out + base, is_bad, n);
+                    } else {
+                        date_time_block_to_ms<false>(year, mon, day, hour, min, sec, ms, out + base, is_bad, n);
+                        continue;
+                    }
+                } else {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        bool row_bad = false;
+                        out[base + i] = date_time_row_to_ms(
+                                year[i], mon[i], day[i], hour[i], min[i], sec[i], ms[i], validate, row_bad);
+                        is_bad[i] = static_cast<uint8_t>(row_bad);
+                    }
+                    if (!validate) {
+                        continue;
+                    }
+                }
+                // Pack eight 0/1 bytes per multiply: each byte lands in its own bit of the top byte.
+                for (std::size_t i = n; i < (n + 63) / 64 * 64; ++i) {
+                    is_bad[i] = 0;
+                }
+                for (std::size_t w = 0; w * 64 < n; ++w) {
+                    uint64_t bits = 0;
+                    for (std::size_t j = 0; j < 64; j += 8) {
+                        const uint8_t* bytes = is_bad + w * 64 + j;
+                        uint64_t packed = 0;
+                        for (unsigned k = 0; k < 8; ++k) {
+                            packed |= static_cast<uint64_t>(bytes[k]) << (8 * k);
+                        }
+                        bits |= ((packed * 0x0102040810204080ULL) >> 56) << j;
+                    }
+                    bad_count += popcount_u64(bits);
+                    if (bad_rows) {
+                        bad_rows[base / 64 + w] = bits;
+                    }
+                }
+            }
+            return bad_count;
+        }
+
+        /// \brief Transpose DateTimeStruct rows into columns block by block and convert them.
+        inline std::size_t structs_to_timestamp_ms(
+                const DateTimeStruct* in,
+                ts_ms_t* out,
+                std::size_t count,
+                bool validate,
+                uint64_t* bad_rows) noexcept {
+            int64_t year[TS_MS_BATCH_BLOCK];
+            int mon[TS_MS_BATCH_BLOCK];
+            int day[TS_MS_BATCH_BLOCK];
+            int hour[TS_MS_BATCH_BLOCK];
+            int min[TS_MS_BATCH_BLOCK];
+            int sec[TS_MS_BATCH_BLOCK];
+            int ms[TS_MS_BATCH_BLOCK];
+            DateTimeColumns columns;
+            columns.year = year;
+            columns.mon = mon;
+            columns.day = day;
+            columns.hour = hour;
+            columns.min = min;
+            columns.sec = sec;
+            columns.ms = ms;
+            std::size_t bad_count = 0;
+            for (std::size_t base = 0; base < count; base += TS_MS_BATCH_BLOCK) {
+                std::size_t n = count - base;
+                if (n > TS_MS_BATCH_BLOCK) n = TS_MS_BATCH_BLOCK;
+                for (std::size_t i = 0; i < n; ++i) {
+                    const DateTimeStruct& row = in[base + i];
+                    year[i] = row.year;
+                    mon[i] = row.mon;
+                    day[i] = row.day;
+                    hour[i] = row.hour;
+                    min[i] = row.min;
+                    sec[i] = row.sec;
+                    ms[i] = row.ms;
+                }
+                bad_count += columns_to_timestamp_ms(
+                        columns, out + base, n, validate, bad_rows ? bad_rows + base / 64 : nullptr);
+            }
+            return bad_count;
+        }
+
+    } // namespace detail
+
+    /// \ingroup time_structures
+    /// \brief Converts columns of date-time fields to timestamps in milliseconds.
+    ///
+    /// The unchecked counterpart of dt_to_timestamp_ms() for whole columns:
+    /// fields are taken in year/month/day order as given (no DD-MM-YYYY
+    /// reordering) and out-of-range time fields carry over like
+    /// to_timestamp_unchecked(). Rows are converted in blocks by a
+    /// branch-free kernel that auto-vectorizes; blocks with years beyond
+    /// ±2^22 fall back to the scalar formula. Invalid rows give
+    /// unspecified values; use the overload taking \p bad_rows to detect them.
+    /// \param in Input columns; hour, min, sec and ms may be null.
+    /// \param out Receives count timestamps in milliseconds.
+    /// \param count Number of rows.
+    inline void to_timestamp_ms_batch(
+            const DateTimeColumns& in,
+            ts_ms_t* out,
+            std::size_t count) noexcept {
+        detail::columns_to_timestamp_ms(in, out, count, false, nullptr);
+    }
+
+    /// \ingroup time_structures
+    /// \brief Converts columns of date-time fields to timestamps in milliseconds with validation.
+    ///
+    /// Rows rejected by is_valid_date_time() (including the millisecond
+    /// field) or whose result overflows are written as ERROR_TIMESTAMP and
+    /// have their bit set in \p bad_rows; the check runs as masks inside the
+    /// same branch-free kernel.
+    /// \param in Input columns; hour, min, sec and ms may be null.
+    /// \param out Receives count timestamps in milliseconds.
+    /// \param count Number of rows.
+    /// \param bad_rows Receives (count + 63) / 64 words, bit i % 64 of word i / 64
+    ///        set for invalid row i; may be null.
+    /// \return Number of invalid rows.
+    inline std::size_t to_timestamp_ms_batch(
+            const DateTimeColumns& in,
+            ts_ms_t* out,
+            std::size_t count,
+            uint64_t* bad_rows) noexcept {
+        return detail::columns_to_timestamp_ms(in, out, count, true, bad_rows);
+    }
+
+    /// \ingroup time_structures
+    /// \brief Converts an array of DateTimeStruct to timestamps in milliseconds.
+    /// \copydetails to_timestamp_ms_batch(const DateTimeColumns&, ts_ms_t*, std::size_t)
+    inline void to_timestamp_ms_batch(
+            const DateTimeStruct* in,
+            ts_ms_t* out,
+            std::size_t count) noexcept {
+        detail::structs_to_timestamp_ms(in, out, count, false, nullptr);
+    }
+
+    /// \ingroup time_structures
+    /// \brief Converts an array of DateTimeStruct to timestamps in milliseconds with validation.
+    /// \copydetails to_timestamp_ms_batch(const DateTimeColumns&, ts_ms_t*, std::size_t, uint64_t*)
+    inline std::size_t to_timestamp_ms_batch(
+            const DateTimeStruct* in,
+            ts_ms_t* out,
+            std::size_t count,
+            uint64_t* bad_rows) noexcept {
+        return detail::structs_to_timestamp_ms(in, out, count, true, bad_rows);
+    }
+
     /// \brief Converts a date and time to a floating-point timestamp.
     ///
     /// This function converts a given date and time to a floating-point timestamp,
@@ -773,6 +1080,11 @@ namespace time_shield {
     /// \return Timestamp at 00:00:00 of the first day of the year.
     template<class T = year_t>
     TIME_SHIELD_CONSTEXPR inline ts_t start_of_year_date(T year) {
+#       if TIME_SHIELD_ENABLE_CALENDAR_TABLES
+        if (detail::calendar_table_contains(year)) {
+            return static_cast<ts_t>(detail::calendar_table_entry(year).year_start_day) * SEC_PER_DAY;
+        }
+#       endif
         const ts_t year_ts = to_timestamp(year, 1, 1);
 
         return start_of_day(year_ts);
@@ -1059,6 +1371,11 @@ namespace time_shield {
     /// \return Day of the last Sunday of the given month and year
     template<class T1 = int, class T2 = year_t, class T3 = int>
     TIME_SHIELD_CONSTEXPR inline T1 last_sunday_month_day(T2 year, T3 month) {
+#       if TIME_SHIELD_ENABLE_CALENDAR_TABLES
+        if (detail::calendar_table_contains(year) && static_cast<int>(month) >= 1 && static_cast<int>(month) <= 12) {
+            return static_cast<T1>(detail::calendar_table_entry(year).last_sunday[static_cast<int>(month) - 1]);
+        }
+#       endif
         const T1 days = num_days_in_month(year, month);
         return days - day_of_week_date(year, month, days);
     }
@@ -1210,6 +1527,26 @@ namespace time_shield {
         return period <= 0 ? ERROR_TIMESTAMP : ts - detail::floor_mod(ts, period) + period - 1;
     }
 
+    /// \brief Get the timestamp of the start of the period in milliseconds.
+    /// \param p Positive period duration in milliseconds.
+    /// \param ts_ms Timestamp in milliseconds (default: current timestamp in milliseconds).
+    /// \return Timestamp of the start of the period in milliseconds, or ERROR_TIMESTAMP for invalid period values.
+    template<class T = int>
+    TIME_SHIELD_CONSTEXPR ts_ms_t start_of_period_ms(T p, ts_ms_t ts_ms = time_shield::ts_ms()) {
+        const ts_ms_t period = static_cast<ts_ms_t>(p);
+        return period <= 0 ? ERROR_TIMESTAMP : ts_ms - detail::floor_mod(ts_ms, period);
+    }
+
+    /// \brief Get the timestamp of the end of the period in milliseconds.
+    /// \param p Positive period duration in milliseconds.
+    /// \param ts_ms Timestamp in milliseconds (default: current timestamp in milliseconds).
+    /// \return Timestamp of the last millisecond of the period, or ERROR_TIMESTAMP for invalid period values.
+    template<class T = int>
+    TIME_SHIELD_CONSTEXPR ts_ms_t end_of_period_ms(T p, ts_ms_t ts_ms = time_shield::ts_ms()) {
+        const ts_ms_t period = static_cast<ts_ms_t>(p);
+        return period <= 0 ? ERROR_TIMESTAMP : ts_ms - detail::floor_mod(ts_ms, period) + period - 1;
+    }
+
 /// \}
 
 }; // namespace time_shield
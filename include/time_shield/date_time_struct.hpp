@@ -24,6 +24,20 @@ namespace time_shield {
         int     ms;     ///< Millisecond component of time (0-999)
     };
 
+    /// \ingroup time_structures
+    /// \brief Structure-of-arrays view of DateTimeStruct rows for batch conversions.
+    ///
+    /// year, mon and day are required; hour, min, sec and ms may be null and read as 0.
+    struct DateTimeColumns {
+        const int64_t* year = nullptr; ///< Year column.
+        const int*     mon  = nullptr; ///< Month column (1-12).
+        const int*     day  = nullptr; ///< Day column (1-31).
+        const int*     hour = nullptr; ///< Hour column (0-23), or null.
+        const int*     min  = nullptr; ///< Minute column (0-59), or null.
+        const int*     sec  = nullptr; ///< Second column (0-59), or null.
+        const int*     ms   = nullptr; ///< Millisecond column (0-999), or null.
+    };
+
     /// \ingroup time_structures
     /// \brief Creates a DateTimeStruct instance.
     /// \param year The year component of the date.
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_DETAIL_BIT_OPS_HPP_INCLUDED
+#define _TIME_SHIELD_DETAIL_BIT_OPS_HPP_INCLUDED
+
+/// \file bit_ops.hpp
+/// \brief Population count, bit scans and set-bit selection on 64-bit words.
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace time_shield {
+namespace detail {
+
+    /// \brief Return the number of set bits.
+    ///
+    /// Uses the POPCNT instruction when the target enables it; otherwise an
+    /// inline SWAR count, which is faster than the out-of-line libgcc fallback.
+    inline unsigned popcount_u64(std::uint64_t value) noexcept {
+#   if (defined(__GNUC__) || defined(__clang__)) && (defined(__POPCNT__) || !(defined(__x86_64__) || defined(__i386__)))
+        return static_cast<unsigned>(__builtin_popcountll(value));
+#   elif defined(_MSC_VER) && defined(_M_X64) && defined(__AVX__)
+        return static_cast<unsigned>(__popcnt64(value));
+#   else
+        value = value - ((value >> 1) & 0x5555555555555555ULL);
+        value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<unsigned>((value * 0x0101010101010101ULL) >> 56);
+#   endif
+    }
+
+    /// \brief Return the index of the lowest set bit of a non-zero value.
+    inline unsigned lowest_bit_u64(std::uint64_t value) noexcept {
+#   if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#   elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index = 0;
+        _BitScanForward64(&index, value);
+        return static_cast<unsigned>(index);
+#   else
+        unsigned index = 0;
+        while ((value & 1u) == 0) {
+            value >>= 1;
+            ++index;
+        }
+        return index;
+#   endif
+    }
+
+    /// \brief Return the index of the highest set bit of a non-zero value.
+    inline unsigned highest_bit_u64(std::uint64_t value) noexcept {
+#   if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#   elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return static_cast<unsigned>(index);
+#   else
+        unsigned index = 0;
+        while (value >>= 1) {
+            ++index;
+        }
+        return index;
+#   endif
+    }
+
+    /// \brief Return the index of the set bit with the given rank (0 = lowest).
+    ///
+    /// Broadword selection: per-byte bit counts are summed into byte prefixes with
+    /// one multiply, the target byte is found with a packed comparison and the bit
+    /// inside it by halving the byte three times. No data-dependent branches.
+    /// \note Requires rank < popcount_u64(value).
+    inline unsigned select_bit_u64(std::uint64_t value, unsigned rank) noexcept {
+        const std::uint64_t ones = 0x0101010101010101ULL;
+        const std::uint64_t highs = 0x8080808080808080ULL;
+        std::uint64_t counts = value - ((value >> 1) & 0x5555555555555555ULL);
+        counts = (counts & 0x3333333333333333ULL) + ((counts >> 2) & 0x3333333333333333ULL);
+        counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        const std::uint64_t prefix = counts * ones;     // Byte i: set bits in bytes 0..i.
+        const std::uint64_t before = ((rank * ones | highs) - prefix) & highs;
+        const unsigned shift = static_cast<unsigned>(((before >> 7) * ones) >> 56) * 8u;
+        rank -= static_cast<unsigned>(((prefix << 8) >> shift) & 0xFFu);
+        unsigned byte = static_cast<unsigned>((value >> shift) & 0xFFu);
+        unsigned base = shift;
+        for (unsigned width = 4; width >= 1; width /= 2) {
+            const unsigned low = byte & ((1u << width) - 1u);
+            // Nibble popcount from a packed 16-entry table.
+            const unsigned count = static_cast<unsigned>((0x4332322132212110ULL >> (low * 4u)) & 0xFu);
+            const bool is_upper = rank >= count;
+            rank -= is_upper ? count : 0u;
+            base += is_upper ? width : 0u;
+            byte = is_upper ? (byte >> width) : low;
+        }
+        return base;
+    }
+
+} // namespace detail
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_DETAIL_BIT_OPS_HPP_INCLUDED
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_DETAIL_CALENDAR_TABLES_HPP_INCLUDED
+#define _TIME_SHIELD_DETAIL_CALENDAR_TABLES_HPP_INCLUDED
+
+/// \file calendar_tables.hpp
+/// \brief Compile-time per-year calendar tables for a configurable year range.
+///
+/// Enabled by TIME_SHIELD_ENABLE_CALENDAR_TABLES. The table is a constexpr
+/// static member generated by pack expansion over the year range, so it is
+/// emitted as read-only data and never built at startup. Each entry holds the
+/// values that calendar helpers otherwise recompute on every call. Callers
+/// check calendar_table_contains() and fall back to arithmetic outside the
+/// range.
+
+#include "../config.hpp"
+
+#if TIME_SHIELD_ENABLE_CALENDAR_TABLES
+
+#include <cstddef>
+#include <cstdint>
+
+namespace time_shield {
+namespace detail {
+
+    static_assert(TIME_SHIELD_CALENDAR_TABLE_MIN_YEAR <= TIME_SHIELD_CALENDAR_TABLE_MAX_YEAR,
+                  "Calendar table year range is empty");
+    static_assert(TIME_SHIELD_CALENDAR_TABLE_MIN_YEAR >= 1 && TIME_SHIELD_CALENDAR_TABLE_MAX_YEAR <= 9999,
+                  "Calendar table years must lie within 1..9999");
+
+    /// \brief Precomputed calendar facts of one year.
+    struct CalendarYearEntry {
+        int32_t year_start_day;         ///< Unix day of January 1.
+        int32_t iso_year_start_day;     ///< Unix day of the Monday starting ISO week 1.
+        uint8_t is_leap;                ///< Non-zero for leap years.
+        uint8_t jan1_weekday;           ///< Weekday of January 1 (0 = Sunday).
+        uint8_t iso_weeks;              ///< Number of ISO weeks (52 or 53).
+        uint8_t first_workday[12];      ///< First Monday..Friday day of each month.
+        uint8_t last_workday[12];       ///< Last Monday..Friday day of each month.
+        uint8_t last_sunday[12];        ///< Day of the last Sunday of each month.
+    };
+
+    // C++11 constexpr generators: single-expression helpers only.
+
+    constexpr int64_t calendar_era(int64_t y) noexcept {
+        return (y >= 0 ? y : y - 399) / 400;
+    }
+
+    constexpr int64_t calendar_days_from_shifted(int64_t y, int64_t m, int64_t d) noexcept {
+        return calendar_era(y) * 146097
+            + (y - calendar_era(y) * 400) * 365
+            + (y - calendar_era(y) * 400) / 4
+            - (y - calendar_era(y) * 400) / 100
+            + (153 * m + 2) / 5 + d - 1
+            - 719468;
+    }
+
+    constexpr int64_t calendar_unix_day(int64_t year, int month, int day) noexcept {
+        return calendar_days_from_shifted(
+            year - (month <= 2 ? 1 : 0),
+            month <= 2 ? month + 9 : month - 3,
+            day);
+    }
+
+    constexpr int calendar_weekday(int64_t unix_day) noexcept {
+        return static_cast<int>(((unix_day + 4) % 7 + 7) % 7);
+    }
+
+    constexpr bool calendar_is_leap(int64_t year) noexcept {
+        return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    }
+
+    constexpr int calendar_days_in_month(int64_t year, int month) noexcept {
+        return month == 2 ? (calendar_is_leap(year) ? 29 : 28)
+            : (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+    }
+
+    constexpr int calendar_last_weekday(int64_t year, int month) noexcept {
+        return calendar_weekday(calendar_unix_day(year, month, calendar_days_in_month(year, month)));
+    }
+
+    constexpr uint8_t calendar_first_workday(int64_t year, int month) noexcept {
+        return static_cast<uint8_t>(
+            calendar_weekday(calendar_unix_day(year, month, 1)) == 6 ? 3
+            : calendar_weekday(calendar_unix_day(year, month, 1)) == 0 ? 2 : 1);
+    }
+
+    constexpr uint8_t calendar_last_workday(int64_t year, int month) noexcept {
+        return static_cast<uint8_t>(
+            calendar_days_in_month(year, month)
+            - (calendar_last_weekday(year, month) == 6 ? 1 : calendar_last_weekday(year, month) == 0 ? 2 : 0));
+    }
+
+    constexpr uint8_t calendar_last_sunday(int64_t year, int month) noexcept {
+        return static_cast<uint8_t>(calendar_days_in_month(year, month) - calendar_last_weekday(year, month));
+    }
+
+    constexpr int64_t calendar_iso_year_start(int64_t year) noexcept {
+        return calendar_unix_day(year, 1, 4) - (calendar_weekday(calendar_unix_day(year, 1, 4)) + 6) % 7;
+    }
+
+#   define TIME_SHIELD_CALENDAR_MONTHS(fn, year) \
+        { fn(year, 1), fn(year, 2), fn(year, 3), fn(year, 4), fn(year, 5), fn(year, 6), \
+          fn(year, 7), fn(year, 8), fn(year, 9), fn(year, 10), fn(year, 11), fn(year, 12) }
+
+    constexpr CalendarYearEntry make_calendar_year_entry(int64_t year) noexcept {
+        return CalendarYearEntry{
+            static_cast<int32_t>(calendar_unix_day(year, 1, 1)),
+            static_cast<int32_t>(calendar_iso_year_start(year)),
+            static_cast<uint8_t>(calendar_is_leap(year) ? 1 : 0),
+            static_cast<uint8_t>(calendar_weekday(calendar_unix_day(year, 1, 1))),
+            static_cast<uint8_t>((calendar_iso_year_start(year + 1) - calendar_iso_year_start(year)) / 7),
+            TIME_SHIELD_CALENDAR_MONTHS(calendar_first_workday, year),
+            TIME_SHIELD_CALENDAR_MONTHS(calendar_last_workday, year),
+            TIME_SHIELD_CALENDAR_MONTHS(calendar_last_sunday, year)
+        };
+    }
+
+#   undef TIME_SHIELD_CALENDAR_MONTHS
+
+    /// \brief Compile-time list of indices (std::index_sequence is C++14).
+    template<std::size_t... I>
+    struct CalendarIndices {};
+
+    template<class A, class B>
+    struct CalendarConcat;
+
+    template<std::size_t... A, std::size_t... B>
+    struct CalendarConcat<CalendarIndices<A...>, CalendarIndices<B...>> {
+        using type = CalendarIndices<A..., (sizeof...(A) + B)...>;
+    };
+
+    /// \brief Build CalendarIndices<0..N-1> with logarithmic instantiation depth.
+    template<std::size_t N>
+    struct MakeCalendarIndices {
+        using type = typename CalendarConcat<
+            typename MakeCalendarIndices<N / 2>::type,
+            typename MakeCalendarIndices<N - N / 2>::type>::type;
+    };
+
+    template<>
+    struct MakeCalendarIndices<0> {
+        using type = CalendarIndices<>;
+    };
+
+    template<>
+    struct MakeCalendarIndices<1> {
+        using type = CalendarIndices<0>;
+    };
+
+    constexpr int64_t CALENDAR_TABLE_MIN_YEAR = TIME_SHIELD_CALENDAR_TABLE_MIN_YEAR; ///< First year in the table.
+    constexpr int64_t CALENDAR_TABLE_MAX_YEAR = TIME_SHIELD_CALENDAR_TABLE_MAX_YEAR; ///< Last year in the table.
+    constexpr std::size_t CALENDAR_TABLE_SIZE =
+        static_cast<std::size_t>(CALENDAR_TABLE_MAX_YEAR - CALENDAR_TABLE_MIN_YEAR + 1);
+
+    template<class Indices>
+    struct CalendarTable;
+
+    /// \brief Table storage; a class template so the array has one definition across translation units.
+    template<std::size_t... I>
+    struct CalendarTable<CalendarIndices<I...>> {
+        static constexpr CalendarYearEntry years[sizeof...(I)] = {
+            make_calendar_year_entry(CALENDAR_TABLE_MIN_YEAR + static_cast<int64_t>(I))...
+        };
+    };
+
+    template<std::size_t... I>
+    constexpr CalendarYearEntry CalendarTable<CalendarIndices<I...>>::years[sizeof...(I)];
+
+    using CalendarTableData = CalendarTable<MakeCalendarIndices<CALENDAR_TABLE_SIZE>::type>;
+
+    /// \brief Check whether a year is covered by the table.
+    template<class T>
+    constexpr bool calendar_table_contains(T year) noexcept {
+        return static_cast<int64_t>(year) >= CALENDAR_TABLE_MIN_YEAR
+            && static_cast<int64_t>(year) <= CALENDAR_TABLE_MAX_YEAR;
+    }
+
+    /// \brief Return the entry of a covered year.
+    template<class T>
+    constexpr const CalendarYearEntry& calendar_table_entry(T year) noexcept {
+        return CalendarTableData::years[static_cast<std::size_t>(static_cast<int64_t>(year) - CALENDAR_TABLE_MIN_YEAR)];
+    }
+
+} // namespace detail
+} // namespace time_shield
+
+#endif // TIME_SHIELD_ENABLE_CALENDAR_TABLES
+
+#endif // _TIME_SHIELD_DETAIL_CALENDAR_TABLES_HPP_INCLUDED
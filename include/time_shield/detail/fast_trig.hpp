@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_DETAIL_FAST_TRIG_HPP_INCLUDED
+#define _TIME_SHIELD_DETAIL_FAST_TRIG_HPP_INCLUDED
+
+/// \file fast_trig.hpp
+/// \brief Branch-free angle reduction and polynomial sine/cosine in degrees.
+///
+/// The helpers use only floating-point arithmetic and integer operations on
+/// the bit patterns, without floating-point comparisons: under the default
+/// -ftrapping-math a compiler will not turn a comparison into a vector select,
+/// so loops calling these helpers are vectorized (two lanes with SSE2, four
+/// with AVX2) where the equivalent std::floor/std::sin loop is not.
+
+#include "simd_ops.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace time_shield {
+namespace detail {
+
+    /// \brief 1.5 * 2^52: adding it rounds any |value| < 2^51 to an integer.
+    constexpr double FAST_TRIG_ROUND_MAGIC = 6755399441055744.0;
+
+    /// \brief Round to the nearest integer (ties to even) for |value| < 2^51.
+    /// \param value Value to round.
+    /// \param low_bits Receives a word whose low bits are the rounded integer (two's complement).
+    /// \return Rounded value.
+    inline double round_nearest(double value, std::uint64_t& low_bits) noexcept {
+#   if defined(__FAST_MATH__)
+        // Fast-math may fold (value + magic) - magic back into value.
+        const double rounded = std::floor(value + 0.5);
+        low_bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(rounded));
+        return rounded;
+#   else
+        const double shifted = value + FAST_TRIG_ROUND_MAGIC;
+        low_bits = double_bits(shifted);
+        return shifted - FAST_TRIG_ROUND_MAGIC;
+#   endif
+    }
+
+    /// \brief Wrap an angle in degrees into [0, 360), like the scalar fmod-based reduction.
+    inline double wrap_degrees(double degrees) noexcept {
+        std::uint64_t turn_bits = 0;
+        const double turns = round_nearest(degrees * (1.0 / 360.0), turn_bits);
+        // Exact for |degrees| < 2^44; adding +0.0 turns -0.0 into +0.0.
+        const double wrapped = (degrees - 360.0 * turns) + 0.0;
+        return wrapped + double_from_bits(double_bits(360.0) & sign_mask(wrapped));
+    }
+
+    /// \brief Sine and cosine of an angle in degrees.
+    ///
+    /// The angle is reduced exactly to [-45, 45] degrees around the nearest
+    /// multiple of 90, and both functions are evaluated with the Cephes
+    /// minimax polynomials on [-pi/4, pi/4]. The absolute error is below
+    /// 1e-15 for |degrees| < 1e13.
+    inline void sin_cos_degrees(double degrees, double& sine, double& cosine) noexcept {
+        std::uint64_t quadrant = 0;
+        const double nearest = round_nearest(degrees * (1.0 / 90.0), quadrant);
+        // Exact: 90 * nearest is an integer and the difference is at most 45.
+        const double x = (degrees - 90.0 * nearest) * (3.14159265358979323846 / 180.0);
+        const double x2 = x * x;
+        const double s = x + x * x2 * (-1.66666666666666307295e-1 + x2 * (8.33333333332211858878e-3
+            + x2 * (-1.98412698295895385996e-4 + x2 * (2.75573136213857245213e-6
+            + x2 * (-2.50507477628578072866e-8 + x2 * 1.58962301576546568060e-10)))));
+        const double c = 1.0 - 0.5 * x2 + x2 * x2 * (4.16666666666665929218e-2 + x2 * (-1.38888888888730564116e-3
+            + x2 * (2.48015872888517045348e-5 + x2 * (-2.75573141792967388112e-7
+            + x2 * (2.08757008419747316778e-9 + x2 * -1.13585365213876817300e-11)))));
+        // Quadrants 1 and 3 swap the functions, 2 and 3 negate the sine, 1 and 2 the cosine.
+        // Masks instead of selects: SSE2 has no 64-bit integer comparison.
+        const std::uint64_t swap_mask = 0 - (quadrant & 1u);
+        const std::uint64_t swap_bits = (double_bits(s) ^ double_bits(c)) & swap_mask;
+        const std::uint64_t sin_abs = double_bits(s) ^ swap_bits;
+        const std::uint64_t cos_abs = double_bits(c) ^ swap_bits;
+        sine = double_from_bits(sin_abs ^ ((quadrant & 2u) << 62));
+        cosine = double_from_bits(cos_abs ^ (((quadrant + 1u) & 2u) << 62));
+    }
+
+} // namespace detail
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_DETAIL_FAST_TRIG_HPP_INCLUDED
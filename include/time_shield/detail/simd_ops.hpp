@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_DETAIL_SIMD_OPS_HPP_INCLUDED
+#define _TIME_SHIELD_DETAIL_SIMD_OPS_HPP_INCLUDED
+
+/// \file simd_ops.hpp
+/// \brief Bit-level double helpers and explicit SIMD floor/truncation over arrays.
+///
+/// Batch conversion loops are written for auto-vectorization: they avoid
+/// floating-point comparisons (which -ftrapping-math keeps as branches) and
+/// int64/double conversions (which need AVX-512 to vectorize). Rounding to an
+/// integer cannot be expressed that way below SSE4.1, so floor_values() and
+/// trunc_values() use intrinsics for the widest enabled instruction set.
+
+#include "../config.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if TIME_SHIELD_HAS_AVX || TIME_SHIELD_HAS_SSE41
+#   include <immintrin.h>
+#elif TIME_SHIELD_HAS_SSE2
+#   include <emmintrin.h>
+#elif TIME_SHIELD_HAS_NEON64
+#   include <arm_neon.h>
+#endif
+
+namespace time_shield {
+namespace detail {
+
+    /// \brief Return the bit pattern of a double.
+    inline std::uint64_t double_bits(double value) noexcept {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    /// \brief Return the double with the given bit pattern.
+    inline double double_from_bits(std::uint64_t bits) noexcept {
+        double value = 0.0;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /// \brief Return all ones when the sign bit of a double is set, otherwise zero.
+    inline std::uint64_t sign_mask(double value) noexcept {
+        return 0 - (double_bits(value) >> 63);
+    }
+
+    /// \brief Return all ones when a double is finite, otherwise zero.
+    inline std::uint64_t finite_mask(double value) noexcept {
+        const std::uint64_t exponent = (double_bits(value) >> 52) & 0x7FFu;
+        return 0 - ((exponent - 0x7FFu) >> 63);
+    }
+
+    /// \brief Select the bits of \p if_set where \p mask is set and of \p if_clear elsewhere.
+    inline double select_bits(std::uint64_t mask, double if_set, double if_clear) noexcept {
+        return double_from_bits((double_bits(if_set) & mask) | (double_bits(if_clear) & ~mask));
+    }
+
+    /// \brief Convert int64 to double, rounded like static_cast.
+    ///
+    /// The high and low halves are placed into the mantissas of 2^84 and 2^52,
+    /// both subtractions are exact and the final addition rounds once. Uses
+    /// only integer and floating-point arithmetic, so it vectorizes on SSE2.
+    /// Fast-math may reassociate the sum, so the plain cast is used there.
+    inline double int64_to_double(std::int64_t value) noexcept {
+#   if defined(__FAST_MATH__)
+        return static_cast<double>(value);
+#   else
+        const std::uint64_t bits = static_cast<std::uint64_t>(value);
+        const double high = double_from_bits(0x4530000000000000ULL | ((bits >> 32) ^ 0x80000000ULL))
+            - double_from_bits(0x4530000080000000ULL); // 2^84 + 2^63
+        const double low = double_from_bits(0x4330000000000000ULL | (bits & 0xFFFFFFFFULL))
+            - 4503599627370496.0; // 2^52
+        return high + low;
+#   endif
+    }
+
+    /// \brief Return true when any element has its sign bit set (negative, -0.0 or negative NaN).
+    inline bool any_sign_bit(const double* values, std::size_t count) noexcept {
+        std::uint64_t bits = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            bits |= double_bits(values[i]);
+        }
+        return (bits >> 63) != 0;
+    }
+
+    /// \brief Floor every element; values that are integral, infinite or NaN pass through.
+    inline void floor_values(const double* values, double* out, std::size_t count) noexcept {
+        std::size_t i = 0;
+#   if TIME_SHIELD_HAS_AVX
+        for (; i + 4 <= count; i += 4) {
+            _mm256_storeu_pd(out + i, _mm256_round_pd(_mm256_loadu_pd(values + i), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+        }
+#   elif TIME_SHIELD_HAS_SSE41
+        for (; i + 2 <= count; i += 2) {
+            _mm_storeu_pd(out + i, _mm_round_pd(_mm_loadu_pd(values + i), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+        }
+#   elif TIME_SHIELD_HAS_SSE2 && !defined(__FAST_MATH__)
+        // Truncate |x| < 2^52 with the 2^52 shift (round to nearest, then step back
+        // when it rounded up), step down negative non-integers, and keep larger
+        // magnitudes, infinities and NaN unchanged.
+        const __m128d shift = _mm_set1_pd(4503599627370496.0); // 2^52
+        const __m128d sign_bit = _mm_set1_pd(-0.0);
+        const __m128d one = _mm_set1_pd(1.0);
+        for (; i + 2 <= count; i += 2) {
+            const __m128d x = _mm_loadu_pd(values + i);
+            const __m128d magnitude = _mm_andnot_pd(sign_bit, x);
+            const __m128d rounded = _mm_sub_pd(_mm_add_pd(magnitude, shift), shift);
+            const __m128d whole = _mm_sub_pd(rounded, _mm_and_pd(_mm_cmpgt_pd(rounded, magnitude), one));
+            const __m128d truncated = _mm_or_pd(whole, _mm_and_pd(sign_bit, x));
+            const __m128d floored = _mm_sub_pd(truncated, _mm_and_pd(_mm_cmpgt_pd(truncated, x), one));
+            const __m128d is_small = _mm_cmplt_pd(magnitude, shift);
+            _mm_storeu_pd(out + i, _mm_or_pd(_mm_and_pd(is_small, floored), _mm_andnot_pd(is_small, x)));
+        }
+#   elif TIME_SHIELD_HAS_NEON64
+        for (; i + 2 <= count; i += 2) {
+            vst1q_f64(out + i, vrndmq_f64(vld1q_f64(values + i)));
+        }
+#   endif
+        for (; i < count; ++i) {
+            out[i] = std::floor(values[i]);
+        }
+    }
+
+    /// \brief Truncate every element toward zero; values that are integral, infinite or NaN pass through.
+    inline void trunc_values(const double* values, double* out, std::size_t count) noexcept {
+        std::size_t i = 0;
+#   if TIME_SHIELD_HAS_AVX
+        for (; i + 4 <= count; i += 4) {
+            _mm256_storeu_pd(out + i, _mm256_round_pd(_mm256_loadu_pd(values + i), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+        }
+#   elif TIME_SHIELD_HAS_SSE41
+        for (; i + 2 <= count; i += 2) {
+            _mm_storeu_pd(out + i, _mm_round_pd(_mm_loadu_pd(values + i), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+        }
+#   elif TIME_SHIELD_HAS_SSE2 && !defined(__FAST_MATH__)
+        const __m128d shift = _mm_set1_pd(4503599627370496.0);
+        const __m128d sign_bit = _mm_set1_pd(-0.0);
+        const __m128d one = _mm_set1_pd(1.0);
+        for (; i + 2 <= count; i += 2) {
+            const __m128d x = _mm_loadu_pd(values + i);
+            const __m128d magnitude = _mm_andnot_pd(sign_bit, x);
+            const __m128d rounded = _mm_sub_pd(_mm_add_pd(magnitude, shift), shift);
+            const __m128d whole = _mm_sub_pd(rounded, _mm_and_pd(_mm_cmpgt_pd(rounded, magnitude), one));
+            const __m128d truncated = _mm_or_pd(whole, _mm_and_pd(sign_bit, x));
+            const __m128d is_small = _mm_cmplt_pd(magnitude, shift);
+            _mm_storeu_pd(out + i, _mm_or_pd(_mm_and_pd(is_small, truncated), _mm_andnot_pd(is_small, x)));
+        }
+#   elif TIME_SHIELD_HAS_NEON64
+        for (; i + 2 <= count; i += 2) {
+            vst1q_f64(out + i, vrndq_f64(vld1q_f64(values + i)));
+        }
+#   endif
+        for (; i < count; ++i) {
+            out[i] = std::trunc(values[i]);
+        }
+    }
+
+} // namespace detail
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_DETAIL_SIMD_OPS_HPP_INCLUDED
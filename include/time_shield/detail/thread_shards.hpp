@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_DETAIL_THREAD_SHARDS_HPP_INCLUDED
+#define _TIME_SHIELD_DETAIL_THREAD_SHARDS_HPP_INCLUDED
+
+/// \file thread_shards.hpp
+/// \brief Per-thread shard selection and cache-line padded shard layout for sharded counters.
+
+#include "../config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace time_shield {
+namespace detail {
+
+    constexpr std::size_t SHARD_CELLS_PER_LINE = TIME_SHIELD_CACHE_LINE_SIZE / sizeof(std::uint64_t); ///< 64-bit cells per cache line.
+
+    /// \brief Return the shard of the calling thread among \p shard_count shards.
+    ///
+    /// Threads get consecutive slots on first use, so shards are filled round-robin.
+    inline std::size_t current_thread_shard(std::size_t shard_count) noexcept {
+        static std::atomic<std::size_t> s_next_thread{0};
+        static TIME_SHIELD_THREAD_LOCAL std::size_t t_thread_slot = 0;
+        if (t_thread_slot == 0) {
+            t_thread_slot = s_next_thread.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+        return (t_thread_slot - 1) % shard_count;
+    }
+
+    /// \brief Return the stride of a shard of \p used 64-bit cells, padded so shards start on separate cache lines.
+    constexpr std::size_t padded_shard_cells(std::size_t used) noexcept {
+        return (used + SHARD_CELLS_PER_LINE - 1) / SHARD_CELLS_PER_LINE * SHARD_CELLS_PER_LINE + SHARD_CELLS_PER_LINE;
+    }
+
+} // namespace detail
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_DETAIL_THREAD_SHARDS_HPP_INCLUDED
@@ -13,6 +13,8 @@
 #include "constants.hpp"
 #include "date_struct.hpp"
 #include "date_time_struct.hpp"
+#include "detail/calendar_tables.hpp"
+#include "detail/floor_math.hpp"
 #include "iso_week_struct.hpp"
 #include "time_conversions.hpp"
 #include "unix_time_conversions.hpp"
@@ -53,6 +55,28 @@ namespace time_shield {
     /// \return ISO week date representation.
     template<class Y = year_t, class M = Month, class D = int>
     inline IsoWeekDateStruct to_iso_week_date(Y year, M month, D day) {
+#       if TIME_SHIELD_ENABLE_CALENDAR_TABLES
+        // Neighbouring years must be covered because ISO years straddle January 1.
+        if (detail::calendar_table_contains(static_cast<int64_t>(year) - 1)
+                && detail::calendar_table_contains(static_cast<int64_t>(year) + 1)
+                && static_cast<int>(month) >= 1 && static_cast<int>(month) <= 12) {
+            const dse_t unix_day = date_to_unix_day(year, month, day);
+            const int weekday = static_cast<int>(detail::floor_mod<dse_t>(unix_day + 3, DAYS_PER_WEEK)) + 1;
+            year_t table_year = static_cast<year_t>(year);
+            dse_t start = detail::calendar_table_entry(table_year).iso_year_start_day;
+            if (unix_day < start) {
+                --table_year;
+                start = detail::calendar_table_entry(table_year).iso_year_start_day;
+            } else if (unix_day >= detail::calendar_table_entry(table_year + 1).iso_year_start_day) {
+                ++table_year;
+                start = detail::calendar_table_entry(table_year).iso_year_start_day;
+            }
+            return create_iso_week_date_struct(
+                table_year,
+                static_cast<int32_t>((unix_day - start) / DAYS_PER_WEEK + 1),
+                static_cast<int32_t>(weekday));
+        }
+#       endif
         const int iso_weekday = iso_weekday_of_date(year, month, day);
         const dse_t unix_day = date_to_unix_day(year, month, day);
         const dse_t thursday_day = unix_day + static_cast<dse_t>(4 - iso_weekday);
@@ -89,6 +113,11 @@ namespace time_shield {
     /// \param iso_year ISO week-numbering year.
     /// \return 52 or 53 depending on the ISO year length.
     inline int iso_weeks_in_year(year_t iso_year) {
+#       if TIME_SHIELD_ENABLE_CALENDAR_TABLES
+        if (detail::calendar_table_contains(iso_year)) {
+            return detail::calendar_table_entry(iso_year).iso_weeks;
+        }
+#       endif
         const IsoWeekDateStruct info = to_iso_week_date(iso_year, 12, 28);
         return static_cast<int>(info.week);
     }
@@ -19,8 +19,10 @@
 #include "types.hpp"
 #include "constants.hpp"
 #include "validation.hpp"
+#include "detail/simd_ops.hpp"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 
 namespace time_shield {
@@ -54,6 +56,79 @@ namespace time_shield {
             return static_cast<jdn_t>(jdn);
         }
 
+        /// \brief Largest |year| for which the batch JDN kernel computes in 32-bit lanes.
+        constexpr int64_t JDN_BATCH_MAX_YEAR = 4000000;
+
+        /// \brief Largest |month| and |day| for which the batch JDN kernel computes in 32-bit lanes.
+        constexpr int64_t JDN_BATCH_MAX_FIELD = 1 << 20;
+
+        /// \brief Elements per block of the batch JDN kernel.
+        constexpr std::size_t JDN_BATCH_BLOCK = 256;
+
+        /// \brief Whether the target has the signed 32-bit multiply the int32 JDN lanes need.
+        ///
+        /// SSE2 lacks it, and the emulated division is slower than the scalar int64 formula.
+        constexpr bool JDN_BATCH_INT32_LANES =
+            TIME_SHIELD_HAS_SSE41 || TIME_SHIELD_HAS_AVX || TIME_SHIELD_HAS_NEON64;
+
+        /// \brief Batch gregorian_dmy_to_jdn_unchecked() for any integer input types.
+        ///
+        /// Blocks whose fields fit the 32-bit range run the same formula in
+        /// int32 lanes, where division by a constant vectorizes (there is no
+        /// 64-bit multiply-high below AVX-512); other blocks and SSE2-only
+        /// targets use the scalar int64 formula. Both give identical results.
+        template<class Y, class M, class D>
+        inline void gregorian_to_jdn_values(
+                const Y* year,
+                const M* month,
+                const D* day,
+                jdn_t* out,
+                std::size_t count) noexcept {
+            for (std::size_t base = 0; base < count; base += JDN_BATCH_BLOCK) {
+                std::size_t n = count - base;
+                if (n > JDN_BATCH_BLOCK) n = JDN_BATCH_BLOCK;
+                bool is_narrow = JDN_BATCH_INT32_LANES;
+                if (is_narrow) {
+                    // Unsigned range checks combined with | keep this loop branch-free.
+                    const uint64_t year_bias = static_cast<uint64_t>(JDN_BATCH_MAX_YEAR);
+                    const uint64_t field_bias = static_cast<uint64_t>(JDN_BATCH_MAX_FIELD);
+                    uint64_t out_of_range = 0;
+                    for (std::size_t i = 0; i < n; ++i) {
+                        const uint64_t y = static_cast<uint64_t>(static_cast<int64_t>(year[base + i])) + year_bias;
+                        const uint64_t m = static_cast<uint64_t>(static_cast<int64_t>(month[base + i])) + field_bias;
+                        const uint64_t d = static_cast<uint64_t>(static_cast<int64_t>(day[base + i])) + field_bias;
+                        out_of_range |= static_cast<uint64_t>(y > 2 * year_bias)
+                                      | static_cast<uint64_t>(m > 2 * field_bias)
+                                      | static_cast<uint64_t>(d > 2 * field_bias);
+                    }
+                    is_narrow = out_of_range == 0;
+                }
+                if (!is_narrow) {
+                    for (std::size_t i = base; i < base + n; ++i) {
+                        out[i] = gregorian_dmy_to_jdn_unchecked(
+                                static_cast<int64_t>(day[i]),
+                                static_cast<int64_t>(month[i]),
+                                static_cast<int64_t>(year[i]));
+                    }
+                    continue;
+                }
+                for (std::size_t i = base; i < base + n; ++i) {
+                    const int32_t mon = static_cast<int32_t>(month[i]);
+                    const int32_t a = (14 - mon) / 12;
+                    const int32_t y = static_cast<int32_t>(year[i]) + 4800 - a;
+                    const int32_t m = mon + 12 * a - 3;
+                    const int32_t jdn = static_cast<int32_t>(day[i])
+                                      + (153 * m + 2) / 5
+                                      + 365 * y
+                                      + y / 4
+                                      - y / 100
+                                      + y / 400
+                                      - 32045;
+                    out[i] = static_cast<jdn_t>(static_cast<int64_t>(jdn));
+                }
+            }
+        }
+
         inline double day_fraction_from_hms(
                 int hour,
                 int minute,
@@ -181,6 +256,76 @@ namespace time_shield {
                 static_cast<int64_t>(year));
     }
 
+    /// \brief Convert an array of Unix timestamps (floating seconds) to Julian Dates.
+    /// \param ts Unix timestamps in floating seconds.
+    /// \param out Receives count Julian Date values; may alias ts.
+    /// \param count Number of values.
+    inline void fts_to_jd(const fts_t* ts, jd_t* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = fts_to_jd(ts[i]);
+        }
+    }
+
+    /// \brief Convert an array of Unix timestamps (seconds) to Julian Dates.
+    /// \param ts Unix timestamps in seconds.
+    /// \param out Receives count Julian Date values.
+    /// \param count Number of values.
+    inline void ts_to_jd(const ts_t* ts, jd_t* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = fts_to_jd(detail::int64_to_double(ts[i]));
+        }
+    }
+
+    /// \brief Convert an array of Unix timestamps (floating seconds) to Modified Julian Dates.
+    /// \param ts Unix timestamps in floating seconds.
+    /// \param out Receives count MJD values; may alias ts.
+    /// \param count Number of values.
+    inline void fts_to_mjd(const fts_t* ts, mjd_t* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = fts_to_mjd(ts[i]);
+        }
+    }
+
+    /// \brief Convert an array of Unix timestamps (seconds) to Modified Julian Dates.
+    /// \param ts Unix timestamps in seconds.
+    /// \param out Receives count MJD values.
+    /// \param count Number of values.
+    inline void ts_to_mjd(const ts_t* ts, mjd_t* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = fts_to_mjd(detail::int64_to_double(ts[i]));
+        }
+    }
+
+    /// \brief Convert arrays of Gregorian dates to Julian Day Numbers.
+    /// \param day Days of month.
+    /// \param month Months [1..12].
+    /// \param year Full years in the proleptic Gregorian calendar.
+    /// \param out Receives count Julian Day Numbers.
+    /// \param count Number of dates.
+    inline void gregorian_to_jdn(
+            const uint32_t* day,
+            const uint32_t* month,
+            const uint32_t* year,
+            jdn_t* out,
+            std::size_t count) noexcept {
+        detail::gregorian_to_jdn_values(year, month, day, out, count);
+    }
+
+    /// \brief Convert arrays of Gregorian dates to Julian Day Numbers using year-first order.
+    /// \param year Full years in the proleptic Gregorian calendar.
+    /// \param month Months [1..12].
+    /// \param day Days of month.
+    /// \param out Receives count Julian Day Numbers.
+    /// \param count Number of dates.
+    inline void gregorian_ymd_to_jdn(
+            const year_t* year,
+            const int* month,
+            const int* day,
+            jdn_t* out,
+            std::size_t count) noexcept {
+        detail::gregorian_to_jdn_values(year, month, day, out, count);
+    }
+
     /// \brief Try converting Gregorian date/time components to Julian Date (JD) using year-first order.
     /// \param year Full year in the proleptic Gregorian calendar.
     /// \param month Month [1..12].
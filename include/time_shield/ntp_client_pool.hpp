@@ -9,6 +9,7 @@
 
 #include "ntp_client.hpp"
 #include "time_utils.hpp"
+#include "tracing.hpp"
 
 #include <algorithm>
 #include <atomic>
@@ -397,6 +398,7 @@ namespace time_shield {
         /// \param servers_to_sample Number of servers to query in this measurement.
         /// \return True when pool offset updated.
         bool measure_n(std::size_t servers_to_sample) {
+            TIME_SHIELD_TRACE_SCOPE("NtpClientPool::measure_n");
             std::vector<std::size_t> picked;
             NtpPoolConfig cfg;
             {
@@ -22,7 +22,10 @@
 #include "types.hpp"
 #include "constants.hpp"
 #include "date_time_conversions.hpp"
+#include "detail/simd_ops.hpp"
 
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
@@ -82,6 +85,52 @@ namespace time_shield {
             return oa;
         }
 
+        /// \brief Elements per block of the batch OA date conversions (stack scratch).
+        constexpr std::size_t OADATE_BATCH_BLOCK = 256;
+
+        /// \brief Batch oadate_floor_value() with explicit SIMD rounding.
+        inline void oadate_floor_values(const oadate_t* values, oadate_t* out, std::size_t count) noexcept {
+            floor_values(values, out, count);
+        }
+
+        /// \brief Batch oadate_trunc_toward_zero() with explicit SIMD rounding.
+        inline void oadate_trunc_toward_zero_values(const oadate_t* values, oadate_t* out, std::size_t count) noexcept {
+            trunc_values(values, out, count);
+        }
+
+        /// \brief Batch linear_days_to_oadate() in place for at most OADATE_BATCH_BLOCK values.
+        ///
+        /// Blocks without negative values are already OA dates. Otherwise
+        /// negative finite lanes take the whole - fraction form; for integral
+        /// values it equals the input, so no fraction test is needed. The lane
+        /// choice uses bit masks so the loop vectorizes.
+        inline void linear_days_to_oadate_block(oadate_t* values, std::size_t count) noexcept {
+            if (!any_sign_bit(values, count)) {
+                return;
+            }
+            oadate_t whole_days[OADATE_BATCH_BLOCK];
+            oadate_floor_values(values, whole_days, count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const oadate_t days = values[i];
+                const oadate_t fraction = days - whole_days[i];
+                values[i] = select_bits(sign_mask(days) & finite_mask(days), whole_days[i] - fraction, days);
+            }
+        }
+
+        /// \brief Batch oadate_to_linear_days() in place for at most OADATE_BATCH_BLOCK values.
+        inline void oadate_to_linear_days_block(oadate_t* values, std::size_t count) noexcept {
+            if (!any_sign_bit(values, count)) {
+                return;
+            }
+            oadate_t whole_days[OADATE_BATCH_BLOCK];
+            oadate_trunc_toward_zero_values(values, whole_days, count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const oadate_t value = values[i];
+                const oadate_t fraction = std::abs(value - whole_days[i]);
+                values[i] = select_bits(sign_mask(value) & finite_mask(value), whole_days[i] + fraction, value);
+            }
+        }
+
     } // namespace detail
 
     /// \brief Convert Unix timestamp (seconds) to OA date.
@@ -140,6 +189,122 @@ namespace time_shield {
         return static_cast<ts_ms_t>(ms);
     }
     
+    /// \brief Convert an array of Unix timestamps (seconds) to OA dates.
+    /// \param ts Unix timestamps in seconds.
+    /// \param out Receives count OA date values.
+    /// \param count Number of values.
+    inline void ts_to_oadate(const ts_t* ts, oadate_t* out, std::size_t count) noexcept {
+        for (std::size_t base = 0; base < count; base += detail::OADATE_BATCH_BLOCK) {
+            std::size_t n = count - base;
+            if (n > detail::OADATE_BATCH_BLOCK) n = detail::OADATE_BATCH_BLOCK;
+            for (std::size_t i = base; i < base + n; ++i) {
+                out[i] = static_cast<oadate_t>(OLE_EPOCH)
+                    + detail::int64_to_double(ts[i]) / static_cast<oadate_t>(SEC_PER_DAY);
+            }
+            detail::linear_days_to_oadate_block(out + base, n);
+        }
+    }
+
+    /// \brief Convert an array of Unix timestamps (floating seconds) to OA dates.
+    /// \param ts Unix timestamps in floating seconds.
+    /// \param out Receives count OA date values; may alias ts.
+    /// \param count Number of values.
+    inline void fts_to_oadate(const fts_t* ts, oadate_t* out, std::size_t count) noexcept {
+        for (std::size_t base = 0; base < count; base += detail::OADATE_BATCH_BLOCK) {
+            std::size_t n = count - base;
+            if (n > detail::OADATE_BATCH_BLOCK) n = detail::OADATE_BATCH_BLOCK;
+            for (std::size_t i = base; i < base + n; ++i) {
+                out[i] = static_cast<oadate_t>(OLE_EPOCH)
+                    + static_cast<oadate_t>(ts[i]) / static_cast<oadate_t>(SEC_PER_DAY);
+            }
+            detail::linear_days_to_oadate_block(out + base, n);
+        }
+    }
+
+    /// \brief Convert an array of Unix timestamps (milliseconds) to OA dates.
+    /// \param ts_ms Unix timestamps in milliseconds.
+    /// \param out Receives count OA date values.
+    /// \param count Number of values.
+    inline void ts_ms_to_oadate(const ts_ms_t* ts_ms, oadate_t* out, std::size_t count) noexcept {
+        for (std::size_t base = 0; base < count; base += detail::OADATE_BATCH_BLOCK) {
+            std::size_t n = count - base;
+            if (n > detail::OADATE_BATCH_BLOCK) n = detail::OADATE_BATCH_BLOCK;
+            for (std::size_t i = base; i < base + n; ++i) {
+                out[i] = static_cast<oadate_t>(OLE_EPOCH)
+                    + detail::int64_to_double(ts_ms[i]) / static_cast<oadate_t>(MS_PER_DAY);
+            }
+            detail::linear_days_to_oadate_block(out + base, n);
+        }
+    }
+
+    /// \brief Convert an array of OA dates to Unix timestamps (seconds, truncated toward zero).
+    /// \param oa OA date values.
+    /// \param out Receives count Unix timestamps.
+    /// \param count Number of values.
+    inline void oadate_to_ts(const oadate_t* oa, ts_t* out, std::size_t count) noexcept {
+        oadate_t seconds[detail::OADATE_BATCH_BLOCK];
+        for (std::size_t base = 0; base < count; base += detail::OADATE_BATCH_BLOCK) {
+            std::size_t n = count - base;
+            if (n > detail::OADATE_BATCH_BLOCK) n = detail::OADATE_BATCH_BLOCK;
+            // Non-negative OA dates are linear days; convert them without scratch.
+            const oadate_t* linear_days = oa + base;
+            if (detail::any_sign_bit(linear_days, n)) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    seconds[i] = linear_days[i];
+                }
+                detail::oadate_to_linear_days_block(seconds, n);
+                linear_days = seconds;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                out[base + i] = static_cast<ts_t>((linear_days[i] - static_cast<oadate_t>(OLE_EPOCH))
+                    * static_cast<oadate_t>(SEC_PER_DAY));
+            }
+        }
+    }
+
+    /// \brief Convert an array of OA dates to Unix timestamps (floating seconds).
+    /// \param oa OA date values.
+    /// \param out Receives count Unix timestamps; may alias oa.
+    /// \param count Number of values.
+    inline void oadate_to_fts(const oadate_t* oa, fts_t* out, std::size_t count) noexcept {
+        for (std::size_t base = 0; base < count; base += detail::OADATE_BATCH_BLOCK) {
+            std::size_t n = count - base;
+            if (n > detail::OADATE_BATCH_BLOCK) n = detail::OADATE_BATCH_BLOCK;
+            for (std::size_t i = base; i < base + n; ++i) {
+                out[i] = oa[i];
+            }
+            detail::oadate_to_linear_days_block(out + base, n);
+            for (std::size_t i = base; i < base + n; ++i) {
+                out[i] = (out[i] - static_cast<oadate_t>(OLE_EPOCH)) * static_cast<oadate_t>(SEC_PER_DAY);
+            }
+        }
+    }
+
+    /// \brief Convert an array of OA dates to Unix timestamps (milliseconds, truncated toward zero).
+    /// \param oa OA date values.
+    /// \param out Receives count Unix timestamps in milliseconds.
+    /// \param count Number of values.
+    inline void oadate_to_ts_ms(const oadate_t* oa, ts_ms_t* out, std::size_t count) noexcept {
+        oadate_t ms[detail::OADATE_BATCH_BLOCK];
+        for (std::size_t base = 0; base < count; base += detail::OADATE_BATCH_BLOCK) {
+            std::size_t n = count - base;
+            if (n > detail::OADATE_BATCH_BLOCK) n = detail::OADATE_BATCH_BLOCK;
+            // Non-negative OA dates are linear days; convert them without scratch.
+            const oadate_t* linear_days = oa + base;
+            if (detail::any_sign_bit(linear_days, n)) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    ms[i] = linear_days[i];
+                }
+                detail::oadate_to_linear_days_block(ms, n);
+                linear_days = ms;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                out[base + i] = static_cast<ts_ms_t>((linear_days[i] - static_cast<oadate_t>(OLE_EPOCH))
+                    * static_cast<oadate_t>(MS_PER_DAY));
+            }
+        }
+    }
+
     /// \brief Build OA date from calendar components (Gregorian).
     /// \tparam T1 Year type.
     /// \tparam T2 Month/day/time components type.
@@ -0,0 +1,414 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_PACKED_DATE_TIME_HPP_INCLUDED
+#define _TIME_SHIELD_PACKED_DATE_TIME_HPP_INCLUDED
+
+/// \file packed_date_time.hpp
+/// \brief Compact date-time value types for large in-memory columns.
+///
+/// DateTimeStruct takes 40 bytes and DateTime 16. The types here store the
+/// same instants in 8 or 2 bytes:
+/// - PackedDayMs: Unix day (int32) and millisecond of day (uint32);
+/// - PackedDateTime64: calendar fields in one 64-bit word that sorts like the timestamp;
+/// - PackedDate16: Unix day as uint16 (1970-01-01 .. 2149-06-06).
+///
+/// Comparisons work on the packed form without decoding. Encoding and decoding
+/// are constexpr from C++14 (TIME_SHIELD_CONSTEXPR); accessors, comparisons and
+/// raw-word conversions are constexpr in C++11 as well. Encoders do not range
+/// check: test values with fits() first when the input may be out of range.
+
+#include "config.hpp"
+#include "types.hpp"
+#include "constants.hpp"
+#include "date_time_struct.hpp"
+#include "detail/fast_date.hpp"
+#include "detail/floor_math.hpp"
+
+#include <cstdint>
+
+namespace time_shield {
+
+namespace detail {
+
+    // PackedDateTime64 layout, low to high: millisecond in bits 0..9 (no shift),
+    // then the fields below at their shifts.
+    constexpr unsigned PACKED_DT_SEC_SHIFT   = 10; ///< Second field: bits 10..15.
+    constexpr unsigned PACKED_DT_MIN_SHIFT   = 16; ///< Minute field: bits 16..21.
+    constexpr unsigned PACKED_DT_HOUR_SHIFT  = 22; ///< Hour field: bits 22..26.
+    constexpr unsigned PACKED_DT_DAY_SHIFT   = 27; ///< Day field: bits 27..31.
+    constexpr unsigned PACKED_DT_MON_SHIFT   = 32; ///< Month field: bits 32..35.
+    constexpr unsigned PACKED_DT_YEAR_SHIFT  = 36; ///< Year field plus PACKED_DT_YEAR_BIAS: bits 36..63.
+    constexpr int64_t  PACKED_DT_YEAR_BIAS   = INT64_C(1) << 27;
+    constexpr ts_ms_t  PACKED_DT_MIN_TS_MS   = INT64_C(-4235564567260800000); ///< -134217728-01-01T00:00:00.000
+    constexpr ts_ms_t  PACKED_DT_MAX_TS_MS   = INT64_C(4235440232822399999);  ///< 134217727-12-31T23:59:59.999
+
+    /// \brief Compose a DateTimeStruct from a Unix day and a millisecond of day.
+    TIME_SHIELD_CONSTEXPR inline DateTimeStruct packed_to_date_time_struct(
+            int64_t unix_day,
+            int64_t ms_of_day) noexcept {
+        const FastDate date = fast_date_from_days_constexpr(unix_day);
+        const int sod = static_cast<int>(ms_of_day / MS_PER_SEC);
+        return DateTimeStruct{
+            date.year,
+            date.month,
+            date.day,
+            sod / static_cast<int>(SEC_PER_HOUR),
+            sod / static_cast<int>(SEC_PER_MIN) % static_cast<int>(MIN_PER_HOUR),
+            sod % static_cast<int>(SEC_PER_MIN),
+            static_cast<int>(ms_of_day % MS_PER_SEC)
+        };
+    }
+
+    /// \brief Return the millisecond of day of a DateTimeStruct time.
+    constexpr int64_t packed_ms_of_day(const DateTimeStruct& dt) noexcept {
+        return ((static_cast<int64_t>(dt.hour) * MIN_PER_HOUR + dt.min) * SEC_PER_MIN + dt.sec) * MS_PER_SEC + dt.ms;
+    }
+
+} // namespace detail
+
+    /// \ingroup time_structures
+    /// \brief Unix day and millisecond of day in 8 bytes.
+    ///
+    /// Covers timestamps whose day fits int32 (about +-5.8 million years).
+    /// Ordering is by day, then by millisecond of day, which is timestamp order.
+    class PackedDayMs {
+    public:
+        /// \brief Construct the Unix epoch.
+        constexpr PackedDayMs() noexcept
+            : m_day(0)
+            , m_ms_of_day(0) {}
+
+        /// \brief Construct from a Unix day and a millisecond of day in `[0, MS_PER_DAY)`.
+        constexpr PackedDayMs(int32_t day, uint32_t ms_of_day) noexcept
+            : m_day(day)
+            , m_ms_of_day(ms_of_day) {}
+
+        /// \brief Check whether a timestamp is representable.
+        static constexpr bool fits(ts_ms_t ts_ms) noexcept {
+            return ts_ms >= static_cast<ts_ms_t>(INT32_MIN) * MS_PER_DAY &&
+                   ts_ms < (static_cast<ts_ms_t>(INT32_MAX) + 1) * MS_PER_DAY;
+        }
+
+        /// \brief Encode a timestamp; requires fits(ts_ms).
+        static TIME_SHIELD_CONSTEXPR PackedDayMs from_ts_ms(ts_ms_t ts_ms) noexcept {
+            const int64_t day = detail::floor_div<int64_t>(ts_ms, MS_PER_DAY);
+            return PackedDayMs(static_cast<int32_t>(day), static_cast<uint32_t>(ts_ms - day * MS_PER_DAY));
+        }
+
+        /// \brief Encode valid date-time fields; the day number must fit int32.
+        static TIME_SHIELD_CONSTEXPR PackedDayMs from_date_time_struct(const DateTimeStruct& dt) noexcept {
+            return PackedDayMs(
+                static_cast<int32_t>(detail::fast_days_from_date_constexpr(dt.year, dt.mon, dt.day)),
+                static_cast<uint32_t>(detail::packed_ms_of_day(dt)));
+        }
+
+        /// \brief Rebuild from a raw() word.
+        static constexpr PackedDayMs from_raw(uint64_t raw) noexcept {
+            return PackedDayMs(
+                static_cast<int32_t>(static_cast<uint32_t>(raw >> 32) ^ UINT32_C(0x80000000)),
+                static_cast<uint32_t>(raw));
+        }
+
+        /// \brief Unix day (days since 1970-01-01).
+        constexpr int32_t day() const noexcept {
+            return m_day;
+        }
+
+        /// \brief Millisecond of the day.
+        constexpr uint32_t ms_of_day() const noexcept {
+            return m_ms_of_day;
+        }
+
+        /// \brief Decode to a timestamp in milliseconds.
+        constexpr ts_ms_t to_ts_ms() const noexcept {
+            return static_cast<ts_ms_t>(m_day) * MS_PER_DAY + static_cast<ts_ms_t>(m_ms_of_day);
+        }
+
+        /// \brief Decode to calendar fields.
+        TIME_SHIELD_CONSTEXPR DateTimeStruct to_date_time_struct() const noexcept {
+            return detail::packed_to_date_time_struct(m_day, m_ms_of_day);
+        }
+
+        /// \brief Return a 64-bit word that compares as unsigned like the value.
+        constexpr uint64_t raw() const noexcept {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(m_day) ^ UINT32_C(0x80000000)) << 32) | m_ms_of_day;
+        }
+
+        /// \brief Equal values.
+        constexpr bool operator==(const PackedDayMs& other) const noexcept {
+            return m_day == other.m_day && m_ms_of_day == other.m_ms_of_day;
+        }
+
+        /// \brief Different values.
+        constexpr bool operator!=(const PackedDayMs& other) const noexcept {
+            return !(*this == other);
+        }
+
+        /// \brief Earlier than.
+        constexpr bool operator<(const PackedDayMs& other) const noexcept {
+            return m_day < other.m_day || (m_day == other.m_day && m_ms_of_day < other.m_ms_of_day);
+        }
+
+        /// \brief Earlier than or equal to.
+        constexpr bool operator<=(const PackedDayMs& other) const noexcept {
+            return !(other < *this);
+        }
+
+        /// \brief Later than.
+        constexpr bool operator>(const PackedDayMs& other) const noexcept {
+            return other < *this;
+        }
+
+        /// \brief Later than or equal to.
+        constexpr bool operator>=(const PackedDayMs& other) const noexcept {
+            return !(*this < other);
+        }
+
+    private:
+        int32_t  m_day;         ///< Days since 1970-01-01.
+        uint32_t m_ms_of_day;   ///< Milliseconds since midnight.
+    };
+
+    /// \ingroup time_structures
+    /// \brief Calendar fields packed into one 64-bit word.
+    ///
+    /// From the most significant bit: biased year (28 bits, years -134217728
+    /// to 134217727), month (4), day (5), hour (5), minute (6), second (6) and
+    /// millisecond (10). Unsigned order of the word is chronological order, and
+    /// every field is read with a shift and a mask, so the type suits columns
+    /// that are filtered by calendar fields more often than converted.
+    class PackedDateTime64 {
+    public:
+        /// \brief Construct 1970-01-01T00:00:00.000.
+        constexpr PackedDateTime64() noexcept
+            : m_raw(from_fields_raw(1970, 1, 1, 0, 0, 0, 0)) {}
+
+        /// \brief Check whether a timestamp is representable.
+        static constexpr bool fits(ts_ms_t ts_ms) noexcept {
+            return ts_ms >= detail::PACKED_DT_MIN_TS_MS && ts_ms <= detail::PACKED_DT_MAX_TS_MS;
+        }
+
+        /// \brief Pack valid calendar fields; the year must be in `[-2^27, 2^27)`.
+        static constexpr PackedDateTime64 from_fields(
+                year_t year,
+                int mon,
+                int day,
+                int hour = 0,
+                int min = 0,
+                int sec = 0,
+                int ms = 0) noexcept {
+            return PackedDateTime64(from_fields_raw(year, mon, day, hour, min, sec, ms));
+        }
+
+        /// \brief Pack valid date-time fields; the year must be in `[-2^27, 2^27)`.
+        static constexpr PackedDateTime64 from_date_time_struct(const DateTimeStruct& dt) noexcept {
+            return from_fields(dt.year, dt.mon, dt.day, dt.hour, dt.min, dt.sec, dt.ms);
+        }
+
+        /// \brief Encode a timestamp; requires fits(ts_ms).
+        static TIME_SHIELD_CONSTEXPR PackedDateTime64 from_ts_ms(ts_ms_t ts_ms) noexcept {
+            const int64_t day = detail::floor_div<int64_t>(ts_ms, MS_PER_DAY);
+            return from_date_time_struct(detail::packed_to_date_time_struct(day, ts_ms - day * MS_PER_DAY));
+        }
+
+        /// \brief Rebuild from a raw() word.
+        static constexpr PackedDateTime64 from_raw(uint64_t raw) noexcept {
+            return PackedDateTime64(raw);
+        }
+
+        /// \brief Year.
+        constexpr year_t year() const noexcept {
+            return static_cast<year_t>(m_raw >> detail::PACKED_DT_YEAR_SHIFT) - detail::PACKED_DT_YEAR_BIAS;
+        }
+
+        /// \brief Month (1-12).
+        constexpr int mon() const noexcept {
+            return field(detail::PACKED_DT_MON_SHIFT, 0xF);
+        }
+
+        /// \brief Day of month (1-31).
+        constexpr int day() const noexcept {
+            return field(detail::PACKED_DT_DAY_SHIFT, 0x1F);
+        }
+
+        /// \brief Hour (0-23).
+        constexpr int hour() const noexcept {
+            return field(detail::PACKED_DT_HOUR_SHIFT, 0x1F);
+        }
+
+        /// \brief Minute (0-59).
+        constexpr int min() const noexcept {
+            return field(detail::PACKED_DT_MIN_SHIFT, 0x3F);
+        }
+
+        /// \brief Second (0-59).
+        constexpr int sec() const noexcept {
+            return field(detail::PACKED_DT_SEC_SHIFT, 0x3F);
+        }
+
+        /// \brief Millisecond (0-999).
+        constexpr int ms() const noexcept {
+            return field(0, 0x3FF);
+        }
+
+        /// \brief Millisecond of the day.
+        constexpr int64_t ms_of_day() const noexcept {
+            return ((static_cast<int64_t>(hour()) * MIN_PER_HOUR + min()) * SEC_PER_MIN + sec()) * MS_PER_SEC + ms();
+        }
+
+        /// \brief Decode to a timestamp in milliseconds.
+        TIME_SHIELD_CONSTEXPR ts_ms_t to_ts_ms() const noexcept {
+            return detail::fast_days_from_date_constexpr(year(), mon(), day()) * MS_PER_DAY + ms_of_day();
+        }
+
+        /// \brief Decode to calendar fields.
+        constexpr DateTimeStruct to_date_time_struct() const noexcept {
+            return DateTimeStruct{year(), mon(), day(), hour(), min(), sec(), ms()};
+        }
+
+        /// \brief Packed word; compares as unsigned like the value.
+        constexpr uint64_t raw() const noexcept {
+            return m_raw;
+        }
+
+        /// \brief Equal values.
+        constexpr bool operator==(const PackedDateTime64& other) const noexcept {
+            return m_raw == other.m_raw;
+        }
+
+        /// \brief Different values.
+        constexpr bool operator!=(const PackedDateTime64& other) const noexcept {
+            return m_raw != other.m_raw;
+        }
+
+        /// \brief Earlier than.
+        constexpr bool operator<(const PackedDateTime64& other) const noexcept {
+            return m_raw < other.m_raw;
+        }
+
+        /// \brief Earlier than or equal to.
+        constexpr bool operator<=(const PackedDateTime64& other) const noexcept {
+            return m_raw <= other.m_raw;
+        }
+
+        /// \brief Later than.
+        constexpr bool operator>(const PackedDateTime64& other) const noexcept {
+            return m_raw > other.m_raw;
+        }
+
+        /// \brief Later than or equal to.
+        constexpr bool operator>=(const PackedDateTime64& other) const noexcept {
+            return m_raw >= other.m_raw;
+        }
+
+    private:
+        explicit constexpr PackedDateTime64(uint64_t raw) noexcept
+            : m_raw(raw) {}
+
+        static constexpr uint64_t from_fields_raw(
+                year_t year,
+                int mon,
+                int day,
+                int hour,
+                int min,
+                int sec,
+                int ms) noexcept {
+            return (static_cast<uint64_t>(year + detail::PACKED_DT_YEAR_BIAS) << detail::PACKED_DT_YEAR_SHIFT) |
+                   (static_cast<uint64_t>(mon) << detail::PACKED_DT_MON_SHIFT) |
+                   (static_cast<uint64_t>(day) << detail::PACKED_DT_DAY_SHIFT) |
+                   (static_cast<uint64_t>(hour) << detail::PACKED_DT_HOUR_SHIFT) |
+                   (static_cast<uint64_t>(min) << detail::PACKED_DT_MIN_SHIFT) |
+                   (static_cast<uint64_t>(sec) << detail::PACKED_DT_SEC_SHIFT) |
+                   static_cast<uint64_t>(ms);
+        }
+
+        constexpr int field(unsigned shift, unsigned mask) const noexcept {
+            return static_cast<int>(static_cast<unsigned>(m_raw >> shift) & mask);
+        }
+
+        uint64_t m_raw; ///< Packed fields.
+    };
+
+    /// \ingroup time_structures
+    /// \brief Unix day in 2 bytes, covering 1970-01-01 to 2149-06-06.
+    class PackedDate16 {
+    public:
+        /// \brief Construct 1970-01-01.
+        constexpr PackedDate16() noexcept
+            : m_day(0) {}
+
+        /// \brief Construct from days since 1970-01-01.
+        explicit constexpr PackedDate16(uint16_t day) noexcept
+            : m_day(day) {}
+
+        /// \brief Check whether the date of a timestamp is representable.
+        static constexpr bool fits(ts_ms_t ts_ms) noexcept {
+            return ts_ms >= 0 && ts_ms < (INT64_C(0xFFFF) + 1) * MS_PER_DAY;
+        }
+
+        /// \brief Encode the date of a timestamp; requires fits(ts_ms).
+        static constexpr PackedDate16 from_ts_ms(ts_ms_t ts_ms) noexcept {
+            return PackedDate16(static_cast<uint16_t>(ts_ms / MS_PER_DAY));
+        }
+
+        /// \brief Encode the date of valid date-time fields, dropping the time of day.
+        static TIME_SHIELD_CONSTEXPR PackedDate16 from_date_time_struct(const DateTimeStruct& dt) noexcept {
+            return PackedDate16(static_cast<uint16_t>(detail::fast_days_from_date_constexpr(dt.year, dt.mon, dt.day)));
+        }
+
+        /// \brief Days since 1970-01-01.
+        constexpr uint16_t day() const noexcept {
+            return m_day;
+        }
+
+        /// \brief Decode to the timestamp of midnight UTC.
+        constexpr ts_ms_t to_ts_ms() const noexcept {
+            return static_cast<ts_ms_t>(m_day) * MS_PER_DAY;
+        }
+
+        /// \brief Decode to calendar fields at midnight.
+        TIME_SHIELD_CONSTEXPR DateTimeStruct to_date_time_struct() const noexcept {
+            return detail::packed_to_date_time_struct(m_day, 0);
+        }
+
+        /// \brief Equal values.
+        constexpr bool operator==(const PackedDate16& other) const noexcept {
+            return m_day == other.m_day;
+        }
+
+        /// \brief Different values.
+        constexpr bool operator!=(const PackedDate16& other) const noexcept {
+            return m_day != other.m_day;
+        }
+
+        /// \brief Earlier than.
+        constexpr bool operator<(const PackedDate16& other) const noexcept {
+            return m_day < other.m_day;
+        }
+
+        /// \brief Earlier than or equal to.
+        constexpr bool operator<=(const PackedDate16& other) const noexcept {
+            return m_day <= other.m_day;
+        }
+
+        /// \brief Later than.
+        constexpr bool operator>(const PackedDate16& other) const noexcept {
+            return m_day > other.m_day;
+        }
+
+        /// \brief Later than or equal to.
+        constexpr bool operator>=(const PackedDate16& other) const noexcept {
+            return m_day >= other.m_day;
+        }
+
+    private:
+        uint16_t m_day; ///< Days since 1970-01-01.
+    };
+
+    static_assert(sizeof(PackedDayMs) == 8, "PackedDayMs must be 8 bytes");
+    static_assert(sizeof(PackedDateTime64) == 8, "PackedDateTime64 must be 8 bytes");
+    static_assert(sizeof(PackedDate16) == 2, "PackedDate16 must be 2 bytes");
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_PACKED_DATE_TIME_HPP_INCLUDED
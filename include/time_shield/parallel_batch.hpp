@@ -0,0 +1,375 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_PARALLEL_BATCH_HPP_INCLUDED
+#define _TIME_SHIELD_PARALLEL_BATCH_HPP_INCLUDED
+
+/// \file parallel_batch.hpp
+/// \brief Chunked serial and parallel batch conversion, formatting and parsing of timestamp arrays.
+///
+/// Each batch is cut into chunks of about 256 KiB of input and output so a
+/// chunk stays in the per-core cache while it is converted. The parallel_*
+/// drivers hand chunks to a WorkStealingPool (or any executor with the same
+/// parallel_for() member). Small batches run serially on the caller.
+/// Formatted text is written into one buffer per chunk. The chunk buffers
+/// together are the whole output, so they can be written out (e.g. with
+/// writev) without being joined.
+
+#include "config.hpp"
+#include "constants.hpp"
+#include "types.hpp"
+#include "date_time_struct.hpp"
+#include "time_formatting.hpp"
+#include "time_parser.hpp"
+#include "time_zone_conversions.hpp"
+#include "WorkStealingPool.hpp"
+#include "detail/fast_date.hpp"
+#include "detail/floor_math.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace time_shield {
+
+namespace detail {
+
+    constexpr std::size_t PARALLEL_BATCH_CHUNK_BYTES = 256 * 1024;  ///< Target input plus output bytes per chunk.
+    constexpr std::size_t PARALLEL_BATCH_MIN_CHUNK   = 1024;        ///< Smallest automatic chunk in elements.
+    constexpr std::size_t ISO8601_UTC_MS_LENGTH      = 24;          ///< Length of "YYYY-MM-DDThh:mm:ss.sssZ".
+
+    /// \brief Elements per chunk: \p chunk_items if set, otherwise sized from the bytes touched per element.
+    inline std::size_t batch_chunk_items(std::size_t chunk_items, std::size_t bytes_per_item) noexcept {
+        if (chunk_items != 0) {
+            return chunk_items;
+        }
+        return std::max(PARALLEL_BATCH_MIN_CHUNK, PARALLEL_BATCH_CHUNK_BYTES / bytes_per_item);
+    }
+
+    /// \brief Call `fn(chunk, begin, end)` for every chunk, on the executor when there is more than one.
+    template<class Executor, class Fn>
+    void for_each_batch_chunk(Executor& executor, std::size_t count, std::size_t chunk_items, Fn fn) {
+        const std::size_t chunks = (count + chunk_items - 1) / chunk_items;
+        if (chunks <= 1) {
+            if (count != 0) {
+                fn(std::size_t(0), std::size_t(0), count);
+            }
+            return;
+        }
+        executor.parallel_for(chunks, [&](std::size_t chunk) {
+            const std::size_t begin = chunk * chunk_items;
+            fn(chunk, begin, std::min(count, begin + chunk_items));
+        });
+    }
+
+    inline void write_2digits(char* out, int value) noexcept {
+        out[0] = static_cast<char>('0' + value / 10);
+        out[1] = static_cast<char>('0' + value % 10);
+    }
+
+} // namespace detail
+
+    /// \ingroup time_formatting
+    /// \brief Formatted strings stored in one text buffer per chunk.
+    ///
+    /// Every element is followed by the separator, so the chunk buffers in
+    /// order are the complete output. Element access needs no copy.
+    class FormattedColumn {
+    public:
+        /// \brief Empty column.
+        FormattedColumn() noexcept
+            : m_size(0)
+            , m_chunk_items(1)
+            , m_separator('\n') {}
+
+        /// \brief Column of \p size elements cut into chunks of \p chunk_items.
+        /// Filled through chunk_buffer() and chunk_ends().
+        FormattedColumn(std::size_t size, std::size_t chunk_items, char separator = '\n')
+            : m_chunks(size == 0 ? 0 : (size + chunk_items - 1) / chunk_items)
+            , m_ends(size)
+            , m_size(size)
+            , m_chunk_items(chunk_items)
+            , m_separator(separator) {}
+
+        /// \brief Number of elements.
+        std::size_t size() const noexcept {
+            return m_size;
+        }
+
+        /// \brief Number of chunks.
+        std::size_t chunk_count() const noexcept {
+            return m_chunks.size();
+        }
+
+        /// \brief Elements per chunk (the last chunk may hold fewer).
+        std::size_t chunk_items() const noexcept {
+            return m_chunk_items;
+        }
+
+        /// \brief Separator written after every element.
+        char separator() const noexcept {
+            return m_separator;
+        }
+
+        /// \brief Text of one chunk.
+        const std::string& chunk(std::size_t index) const noexcept {
+            return m_chunks[index];
+        }
+
+        /// \brief Total text length over all chunks.
+        std::size_t text_length() const noexcept {
+            std::size_t length = 0;
+            for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+                length += m_chunks[i].size();
+            }
+            return length;
+        }
+
+        /// \brief Pointer to element \p index inside its chunk; \p length receives its length without the separator.
+        const char* element_data(std::size_t index, std::size_t& length) const noexcept {
+            const std::size_t chunk_index = index / m_chunk_items;
+            const std::size_t begin = index % m_chunk_items == 0 ? 0 : m_ends[index - 1] + 1;
+            length = m_ends[index] - begin;
+            return m_chunks[chunk_index].data() + begin;
+        }
+
+        /// \brief Copy of element \p index.
+        std::string element(std::size_t index) const {
+            std::size_t length = 0;
+            const char* data = element_data(index, length);
+            return std::string(data, length);
+        }
+
+        /// \brief All chunks in one string.
+        std::string join() const {
+            std::string out;
+            out.reserve(text_length());
+            for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+                out += m_chunks[i];
+            }
+            return out;
+        }
+
+        /// \brief Write all chunks to a stream without joining them.
+        void write(std::ostream& stream) const {
+            for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+                stream.write(m_chunks[i].data(), static_cast<std::streamsize>(m_chunks[i].size()));
+            }
+        }
+
+        /// \brief Writable text of one chunk, for batch writers.
+        std::string& chunk_buffer(std::size_t index) noexcept {
+            return m_chunks[index];
+        }
+
+        /// \brief Writable end offsets (within the chunk, before the separator) of the elements of one chunk.
+        std::size_t* chunk_ends(std::size_t index) noexcept {
+            return m_ends.data() + index * m_chunk_items;
+        }
+
+    private:
+        std::vector<std::string>    m_chunks;       ///< Text per chunk.
+        std::vector<std::size_t>    m_ends;         ///< End offset of every element within its chunk.
+        std::size_t                 m_size;         ///< Number of elements.
+        std::size_t                 m_chunk_items;  ///< Elements per chunk.
+        char                        m_separator;    ///< Separator after every element.
+    };
+
+/// \ingroup time_conversions
+/// \{
+
+    /// \brief Convert UTC millisecond timestamps to date-time fields.
+    inline void to_date_time_ms_batch(const ts_ms_t* ts_ms, DateTimeStruct* out, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            const int64_t day = detail::floor_div<int64_t>(ts_ms[i], MS_PER_DAY);
+            const int ms_of_day = static_cast<int>(ts_ms[i] - day * MS_PER_DAY);
+            const detail::FastDate date = detail::fast_date_from_days(day);
+            DateTimeStruct& dt = out[i];
+            dt.year = date.year;
+            dt.mon = date.month;
+            dt.day = date.day;
+            dt.hour = ms_of_day / static_cast<int>(MS_PER_HOUR);
+            dt.min = ms_of_day / static_cast<int>(MS_PER_MIN) % 60;
+            dt.sec = ms_of_day / static_cast<int>(MS_PER_SEC) % 60;
+            dt.ms = ms_of_day % static_cast<int>(MS_PER_SEC);
+        }
+    }
+
+    /// \brief Convert UTC millisecond timestamps to local time of a zone.
+    ///
+    /// The offset is looked up once per UTC hour and reused for the
+    /// following elements of the same hour, which holds because every
+    /// transition of the supported zones falls on a whole UTC hour.
+    /// Unsupported zones and ERROR_TIMESTAMP inputs give ERROR_TIMESTAMP.
+    inline void gmt_to_zone_ms_batch(const ts_ms_t* ts_ms, ts_ms_t* out, std::size_t count, TimeZone zone) noexcept {
+        int64_t cached_hour = 0;
+        ts_ms_t cached_offset = 0;
+        bool has_cache = false;
+        for (std::size_t i = 0; i < count; ++i) {
+            const ts_ms_t ts = ts_ms[i];
+            const int64_t hour = detail::floor_div<int64_t>(ts, MS_PER_HOUR);
+            if (!has_cache || hour != cached_hour) {
+                const ts_ms_t local = gmt_to_zone_ms(ts, zone);
+                if (local == ERROR_TIMESTAMP) {
+                    out[i] = ERROR_TIMESTAMP;
+                    has_cache = false;
+                    continue;
+                }
+                cached_hour = hour;
+                cached_offset = local - ts;
+                has_cache = true;
+            }
+            out[i] = ts + cached_offset;
+        }
+    }
+
+/// \}
+
+    /// \ingroup time_formatting
+    /// \brief Append `to_iso8601_utc_ms()` text of each timestamp to \p out, each followed by \p separator.
+    /// \param ends Receives the end offset in \p out of every element, before its separator.
+    inline void to_iso8601_utc_ms_batch(const ts_ms_t* ts_ms, std::size_t count,
+                                        std::string& out, std::size_t* ends, char separator = '\n') {
+        out.reserve(out.size() + count * (detail::ISO8601_UTC_MS_LENGTH + 1));
+        char text[detail::ISO8601_UTC_MS_LENGTH + 1] = {
+            '0', '0', '0', '0', '-', '0', '0', '-', '0', '0', 'T',
+            '0', '0', ':', '0', '0', ':', '0', '0', '.', '0', '0', '0', 'Z', separator
+        };
+        for (std::size_t i = 0; i < count; ++i) {
+            const int64_t day = detail::floor_div<int64_t>(ts_ms[i], MS_PER_DAY);
+            const detail::FastDate date = detail::fast_date_from_days(day);
+            if (date.year < 1000 || date.year > 9999) {
+                // Years outside four digits keep the unpadded snprintf layout.
+                out += to_iso8601_utc_ms(ts_ms[i]);
+            } else {
+                const int ms_of_day = static_cast<int>(ts_ms[i] - day * MS_PER_DAY);
+                const int year = static_cast<int>(date.year);
+                detail::write_2digits(text, year / 100);
+                detail::write_2digits(text + 2, year % 100);
+                detail::write_2digits(text + 5, date.month);
+                detail::write_2digits(text + 8, date.day);
+                detail::write_2digits(text + 11, ms_of_day / static_cast<int>(MS_PER_HOUR));
+                detail::write_2digits(text + 14, ms_of_day / static_cast<int>(MS_PER_MIN) % 60);
+                detail::write_2digits(text + 17, ms_of_day / static_cast<int>(MS_PER_SEC) % 60);
+                const int ms = ms_of_day % static_cast<int>(MS_PER_SEC);
+                text[20] = static_cast<char>('0' + ms / 100);
+                detail::write_2digits(text + 21, ms % 100);
+                out.append(text, detail::ISO8601_UTC_MS_LENGTH);
+            }
+            ends[i] = out.size();
+            out += separator;
+        }
+    }
+
+    /// \ingroup time_parsing
+    /// \brief Parse ISO 8601 strings into UTC millisecond timestamps.
+    /// \return Number of strings that failed to parse; their outputs are ERROR_TIMESTAMP.
+    inline std::size_t parse_iso8601_ms_batch(const std::string* text, ts_ms_t* out, std::size_t count) {
+        std::size_t failures = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!str_to_ts_ms(text[i].data(), text[i].size(), out[i])) {
+                out[i] = ERROR_TIMESTAMP;
+                ++failures;
+            }
+        }
+        return failures;
+    }
+
+/// \ingroup time_conversions
+/// \{
+
+    /// \brief Parallel to_date_time_ms_batch().
+    /// \param executor WorkStealingPool or any type with a compatible parallel_for().
+    /// \param chunk_items Elements per chunk; 0 picks a cache-sized chunk.
+    template<class Executor>
+    void parallel_to_date_time_ms(const ts_ms_t* ts_ms, DateTimeStruct* out, std::size_t count,
+                                  Executor& executor, std::size_t chunk_items = 0) {
+        detail::for_each_batch_chunk(executor, count,
+                                     detail::batch_chunk_items(chunk_items, sizeof(ts_ms_t) + sizeof(DateTimeStruct)),
+                                     [=](std::size_t, std::size_t begin, std::size_t end) {
+            to_date_time_ms_batch(ts_ms + begin, out + begin, end - begin);
+        });
+    }
+
+    /// \brief Parallel to_date_time_ms_batch() on WorkStealingPool::shared().
+    inline void parallel_to_date_time_ms(const ts_ms_t* ts_ms, DateTimeStruct* out, std::size_t count) {
+        parallel_to_date_time_ms(ts_ms, out, count, WorkStealingPool::shared());
+    }
+
+    /// \brief Parallel gmt_to_zone_ms_batch().
+    /// \param executor WorkStealingPool or any type with a compatible parallel_for().
+    /// \param chunk_items Elements per chunk; 0 picks a cache-sized chunk.
+    template<class Executor>
+    void parallel_gmt_to_zone_ms(const ts_ms_t* ts_ms, ts_ms_t* out, std::size_t count, TimeZone zone,
+                                 Executor& executor, std::size_t chunk_items = 0) {
+        detail::for_each_batch_chunk(executor, count, detail::batch_chunk_items(chunk_items, 2 * sizeof(ts_ms_t)),
+                                     [=](std::size_t, std::size_t begin, std::size_t end) {
+            gmt_to_zone_ms_batch(ts_ms + begin, out + begin, end - begin, zone);
+        });
+    }
+
+    /// \brief Parallel gmt_to_zone_ms_batch() on WorkStealingPool::shared().
+    inline void parallel_gmt_to_zone_ms(const ts_ms_t* ts_ms, ts_ms_t* out, std::size_t count, TimeZone zone) {
+        parallel_gmt_to_zone_ms(ts_ms, out, count, zone, WorkStealingPool::shared());
+    }
+
+/// \}
+
+    /// \ingroup time_formatting
+    /// \brief Format timestamps as `to_iso8601_utc_ms()` text into a chunked column in parallel.
+    /// \param executor WorkStealingPool or any type with a compatible parallel_for().
+    /// \param separator Character written after every element.
+    /// \param chunk_items Elements per chunk; 0 picks a cache-sized chunk.
+    template<class Executor>
+    FormattedColumn parallel_to_iso8601_utc_ms(const ts_ms_t* ts_ms, std::size_t count, Executor& executor,
+                                               char separator = '\n', std::size_t chunk_items = 0) {
+        const std::size_t items = detail::batch_chunk_items(
+                chunk_items, sizeof(ts_ms_t) + sizeof(std::size_t) + detail::ISO8601_UTC_MS_LENGTH + 1);
+        FormattedColumn column(count, items, separator);
+        FormattedColumn* const target = &column;
+        detail::for_each_batch_chunk(executor, count, items, [=](std::size_t chunk, std::size_t begin, std::size_t end) {
+            to_iso8601_utc_ms_batch(ts_ms + begin, end - begin, target->chunk_buffer(chunk),
+                                    target->chunk_ends(chunk), separator);
+        });
+        return column;
+    }
+
+    /// \ingroup time_formatting
+    /// \brief parallel_to_iso8601_utc_ms() on WorkStealingPool::shared().
+    inline FormattedColumn parallel_to_iso8601_utc_ms(const ts_ms_t* ts_ms, std::size_t count, char separator = '\n') {
+        return parallel_to_iso8601_utc_ms(ts_ms, count, WorkStealingPool::shared(), separator);
+    }
+
+    /// \ingroup time_parsing
+    /// \brief Parallel parse_iso8601_ms_batch().
+    /// \param executor WorkStealingPool or any type with a compatible parallel_for().
+    /// \param chunk_items Elements per chunk; 0 picks a cache-sized chunk.
+    /// \return Number of strings that failed to parse; their outputs are ERROR_TIMESTAMP.
+    template<class Executor>
+    std::size_t parallel_parse_iso8601_ms(const std::string* text, ts_ms_t* out, std::size_t count,
+                                          Executor& executor, std::size_t chunk_items = 0) {
+        std::atomic<std::size_t> failures(0);
+        std::atomic<std::size_t>* const total = &failures;
+        detail::for_each_batch_chunk(executor, count,
+                                     detail::batch_chunk_items(chunk_items, sizeof(std::string) + 32 + sizeof(ts_ms_t)),
+                                     [=](std::size_t, std::size_t begin, std::size_t end) {
+            const std::size_t chunk_failures = parse_iso8601_ms_batch(text + begin, out + begin, end - begin);
+            if (chunk_failures != 0) {
+                total->fetch_add(chunk_failures, std::memory_order_relaxed);
+            }
+        });
+        return failures.load(std::memory_order_relaxed);
+    }
+
+    /// \ingroup time_parsing
+    /// \brief parallel_parse_iso8601_ms() on WorkStealingPool::shared().
+    inline std::size_t parallel_parse_iso8601_ms(const std::string* text, ts_ms_t* out, std::size_t count) {
+        return parallel_parse_iso8601_ms(text, out, count, WorkStealingPool::shared());
+    }
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_PARALLEL_BATCH_HPP_INCLUDED
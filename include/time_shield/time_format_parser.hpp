@@ -13,6 +13,7 @@
 #include "enums.hpp"
 #include "iso_week_conversions.hpp"
 #include "time_zone_struct.hpp"
+#include "tracing.hpp"
 #include "validation.hpp"
 
 #include <cstddef>
@@ -983,6 +984,7 @@ namespace time_shield {
                 std::size_t format_length,
                 DateTimeStruct& out_dt,
                 TimeZoneStruct& out_tz) noexcept {
+            TIME_SHIELD_TRACE_SCOPE("try_parse_format_core");
             if (!data || !format) {
                 return false;
             }
@@ -15,6 +15,7 @@
 #include "iso_week_conversions.hpp"
 #include "time_zone_struct.hpp"
 #include "time_conversions.hpp"
+#include "tracing.hpp"
 
 #include <inttypes.h>
 
@@ -434,7 +435,6 @@ namespace time_shield {
         bool is_command = false;
         size_t repeat_count = 0;
         char last_char = format_str[0];
-        if (last_char != '%') result += last_char;
         for (size_t i = 0; i < format_str.size(); ++i) {
             const char& current_char = format_str[i];
             if (!is_command) {
@@ -510,6 +510,7 @@ namespace time_shield {
             const std::string& format_str,
             T timestamp,
             tz_t utc_offset = 0) {
+        TIME_SHIELD_TRACE_SCOPE("to_string_ms");
         std::string result;
         if (format_str.empty()) return result;
         const T local_timestamp = static_cast<T>(timestamp + sec_to_ms<T, tz_t>(utc_offset));
@@ -518,7 +519,6 @@ namespace time_shield {
         bool is_command = false;
         size_t repeat_count = 0;
         char last_char = format_str[0];
-        if (last_char != '%') result += last_char;
         for (size_t i = 0; i < format_str.size(); ++i) {
             const char& current_char = format_str[i];
             if (!is_command) {
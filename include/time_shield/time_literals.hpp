@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_TIME_LITERALS_HPP_INCLUDED
+#define _TIME_SHIELD_TIME_LITERALS_HPP_INCLUDED
+
+/// \file time_literals.hpp
+/// \brief User-defined literals that parse ISO 8601 timestamps at compile time (C++17 and newer).
+///
+/// `"2024-03-31T01:00:00Z"_ts_ms` is a constant expression, so timestamps in
+/// configuration tables and hot loops cost nothing at startup. Under C++20 the
+/// literals are consteval and a malformed string is a compile error; under
+/// C++17 this holds in constant-evaluated contexts, and a malformed literal
+/// evaluated at run time throws std::invalid_argument.
+/// \code
+/// using namespace time_shield::literals;
+/// constexpr ts_ms_t k_dst_switch = "2024-03-31T01:00:00Z"_ts_ms;
+/// constexpr ts_t k_session_open = "2024-01-02 09:30-05:00"_ts;
+/// \endcode
+/// Accepted forms match parse_iso8601() except for ISO week dates:
+/// `YYYY-MM-DD[(T| )hh:mm[:ss[.fff]]][Z|(+|-)hh:mm]` with '-', '/' or '.' as
+/// date separators.
+
+#include "config.hpp"
+
+#if defined(TIME_SHIELD_CPP17)
+
+#include "constants.hpp"
+#include "types.hpp"
+#include "time_parser.hpp"
+#include "validation.hpp"
+#include "detail/fast_date.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace time_shield {
+
+namespace detail {
+
+    /// \brief Parse an ISO 8601 date-time with an optional offset into UTC milliseconds.
+    /// \return True on success.
+    constexpr bool parse_iso8601_ms_constexpr(const char* input, std::size_t length, ts_ms_t& out) noexcept {
+        const char* p = input;
+        const char* const end = input + length;
+        skip_spaces(p, end);
+
+        year_t year = 0;
+        int mon = 0;
+        int day = 0;
+        if (!parse_4digits_year(p, end, year)) {
+            return false;
+        }
+        if (p >= end || (*p != '-' && *p != '/' && *p != '.')) {
+            return false;
+        }
+        ++p;
+        if (!parse_2digits(p, end, mon)) {
+            return false;
+        }
+        if (p >= end || (*p != '-' && *p != '/' && *p != '.')) {
+            return false;
+        }
+        ++p;
+        if (!parse_2digits(p, end, day) || !is_valid_date(year, mon, day)) {
+            return false;
+        }
+
+        int hour = 0;
+        int min = 0;
+        int sec = 0;
+        int ms = 0;
+        int64_t offset_ms = 0;
+        const char* q = p;
+        skip_spaces(q, end);
+        if (q != end) {
+            if (*p == 'T' || *p == 't') {
+                ++p;
+            } else if (is_ascii_space(*p)) {
+                skip_spaces(p, end);
+            } else {
+                return false;
+            }
+            if (!parse_2digits(p, end, hour) || p >= end || *p != ':') {
+                return false;
+            }
+            ++p;
+            if (!parse_2digits(p, end, min)) {
+                return false;
+            }
+            if (p < end && *p == ':') {
+                ++p;
+                if (!parse_2digits(p, end, sec)) {
+                    return false;
+                }
+                if (p < end && *p == '.') {
+                    ++p;
+                    if (!parse_fraction_to_ms(p, end, ms)) {
+                        return false;
+                    }
+                }
+            }
+            if (!is_valid_time(hour, min, sec, ms)) {
+                return false;
+            }
+
+            skip_spaces(p, end);
+            if (p < end && (*p == 'Z' || *p == 'z')) {
+                ++p;
+            } else if (p < end && (*p == '+' || *p == '-')) {
+                const bool is_positive = *p == '+';
+                ++p;
+                int tz_hour = 0;
+                int tz_min = 0;
+                if (!parse_2digits(p, end, tz_hour) || p >= end || *p != ':') {
+                    return false;
+                }
+                ++p;
+                if (!parse_2digits(p, end, tz_min) || !is_valid_time_zone(tz_hour, tz_min)) {
+                    return false;
+                }
+                offset_ms = tz_hour * MS_PER_HOUR + tz_min * MS_PER_MIN;
+                if (!is_positive) {
+                    offset_ms = -offset_ms;
+                }
+            }
+            skip_spaces(p, end);
+            if (p != end) {
+                return false;
+            }
+        }
+
+        out = fast_days_from_date_constexpr(year, mon, day) * MS_PER_DAY
+            + hour * MS_PER_HOUR + min * MS_PER_MIN + sec * MS_PER_SEC + ms - offset_ms;
+        return true;
+    }
+
+} // namespace detail
+
+    /// \ingroup time_parsing
+    /// \brief Compile-time timestamp literals.
+    inline namespace literals {
+
+        /// \brief UTC timestamp in milliseconds from an ISO 8601 literal.
+        /// \throws std::invalid_argument if the literal is malformed (a compile error when constant-evaluated).
+        TIME_SHIELD_CONSTEVAL ts_ms_t operator""_ts_ms(const char* str, std::size_t length) {
+            ts_ms_t ts_ms = 0;
+            return detail::parse_iso8601_ms_constexpr(str, length, ts_ms)
+                ? ts_ms
+                : throw std::invalid_argument("time_shield literal is not a valid ISO 8601 date-time");
+        }
+
+        /// \brief UTC timestamp in seconds from an ISO 8601 literal without a fractional part.
+        /// \throws std::invalid_argument if the literal is malformed or has milliseconds
+        /// (a compile error when constant-evaluated).
+        TIME_SHIELD_CONSTEVAL ts_t operator""_ts(const char* str, std::size_t length) {
+            ts_ms_t ts_ms = 0;
+            return detail::parse_iso8601_ms_constexpr(str, length, ts_ms) && ts_ms % MS_PER_SEC == 0
+                ? static_cast<ts_t>(ts_ms / MS_PER_SEC)
+                : throw std::invalid_argument("time_shield literal is not a whole-second ISO 8601 date-time");
+        }
+
+    } // inline namespace literals
+
+} // namespace time_shield
+
+#endif // defined(TIME_SHIELD_CPP17)
+
+#endif // _TIME_SHIELD_TIME_LITERALS_HPP_INCLUDED
@@ -25,6 +25,7 @@
 #include "time_conversions.hpp"
 #include "iso_week_conversions.hpp"
 #include "time_format_parser.hpp"
+#include "tracing.hpp"
 
 #include <algorithm>
 #include <locale>
@@ -1015,6 +1016,7 @@ namespace time_shield {
     /// \return True if parsing succeeds and dt is valid, false otherwise.
     inline bool parse_iso8601(const char* input, std::size_t length,
                               DateTimeStruct& dt, TimeZoneStruct& tz) noexcept {
+        TIME_SHIELD_TRACE_SCOPE("parse_iso8601");
         if (!input) {
             return false;
         }
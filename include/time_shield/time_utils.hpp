@@ -12,6 +12,7 @@
 #include "types.hpp"
 #include "constants.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <limits>       // For std::numeric_limits
 #include <ctime>        // For clock_t and timespec (POSIX)
@@ -48,32 +49,73 @@ namespace time_shield {
         return ts;
     }
     
-    /// \ingroup time_utils
-    /// \brief Get current real time in microseconds using a platform-specific method.
-    ///
-    /// On Windows this function combines `QueryPerformanceCounter`
-    /// (high-resolution monotonic clock) with `GetSystemTimeAsFileTime` to compute an accurate,
-    /// stable UTC timestamp. The base time is initialized only once per process (lazy init).
-    /// On Unix-like systems a realtime anchor is captured once and combined with a
-    /// high-resolution monotonic clock to compute stable timestamps.
-    ///
-    /// \return Current UTC timestamp in microseconds.
-    inline int64_t now_realtime_us() {
-#       if TIME_SHIELD_PLATFORM_WINDOWS
-        static std::once_flag init_flag;
-        static int64_t s_perf_freq = 0;
-        static int64_t s_anchor_perf = 0;
-        static int64_t s_anchor_realtime_us = 0;
+    namespace detail {
+
+        /// \brief Realtime anchor published to now_realtime_us() readers.
+        struct RealtimeAnchor {
+            int64_t realtime_us;         ///< Realtime clock at the anchor, in microseconds.
+            int64_t mono_ticks;          ///< Monotonic counter at the anchor.
+            int64_t next_reanchor_ticks; ///< Monotonic counter that triggers automatic re-anchoring.
+        };
+
+        /// \brief Seqlock-protected anchor state shared by all threads.
+        struct RealtimeAnchorState {
+            std::atomic<uint32_t> sequence{0};
+            std::atomic<int64_t>  realtime_us{0};
+            std::atomic<int64_t>  mono_ticks{0};
+            std::atomic<int64_t>  next_reanchor_ticks{(std::numeric_limits<int64_t>::max)()};
+            std::atomic<int64_t>  interval_us{0};
+            std::atomic<int64_t>  last_correction_us{0};
+            std::atomic<uint64_t> reanchor_count{0};
+            std::mutex            writer_mutex;
+            int64_t               ticks_per_sec{1};
+
+            /// \brief Read a consistent anchor snapshot.
+            RealtimeAnchor load() const noexcept {
+                RealtimeAnchor anchor;
+                uint32_t begin = 0;
+                do {
+                    begin = sequence.load(std::memory_order_acquire);
+                    anchor.realtime_us = realtime_us.load(std::memory_order_relaxed);
+                    anchor.mono_ticks = mono_ticks.load(std::memory_order_relaxed);
+                    anchor.next_reanchor_ticks = next_reanchor_ticks.load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                } while ((begin & 1u) != 0 || sequence.load(std::memory_order_relaxed) != begin);
+                return anchor;
+            }
+
+            /// \brief Publish a new anchor; the caller holds writer_mutex.
+            void store(const RealtimeAnchor& anchor) noexcept {
+                const uint32_t begin = sequence.load(std::memory_order_relaxed);
+                sequence.store(begin + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                realtime_us.store(anchor.realtime_us, std::memory_order_relaxed);
+                mono_ticks.store(anchor.mono_ticks, std::memory_order_relaxed);
+                next_reanchor_ticks.store(anchor.next_reanchor_ticks, std::memory_order_relaxed);
+                sequence.store(begin + 2, std::memory_order_release);
+            }
+        };
 
-        std::call_once(init_flag, []() {
-            LARGE_INTEGER freq = {};
+        /// \brief Read the monotonic counter used by now_realtime_us().
+        inline int64_t realtime_anchor_ticks() noexcept {
+#       if TIME_SHIELD_PLATFORM_WINDOWS
             LARGE_INTEGER counter = {};
-            ::QueryPerformanceFrequency(&freq);
             ::QueryPerformanceCounter(&counter);
+            return static_cast<int64_t>(counter.QuadPart);
+#       else
+            struct timespec mono_ts{};
+#           if defined(CLOCK_MONOTONIC_RAW)
+            clock_gettime(CLOCK_MONOTONIC_RAW, &mono_ts);
+#           else
+            clock_gettime(CLOCK_MONOTONIC, &mono_ts);
+#           endif
+            return static_cast<int64_t>(mono_ts.tv_sec) * 1000000000LL + mono_ts.tv_nsec;
+#       endif
+        }
 
-            s_perf_freq   = static_cast<int64_t>(freq.QuadPart);
-            s_anchor_perf = static_cast<int64_t>(counter.QuadPart);
-
+        /// \brief Read the realtime clock in microseconds without anchoring.
+        inline int64_t realtime_clock_us() noexcept {
+#       if TIME_SHIELD_PLATFORM_WINDOWS
             FILETIME ft;
             ::GetSystemTimeAsFileTime(&ft);
 
@@ -86,57 +128,165 @@ namespace time_shield {
 
             const int64_t filetime_100ns = static_cast<int64_t>(uli.QuadPart);
             // Convert 100ns since 1601 -> us since 1970
-            s_anchor_realtime_us = (filetime_100ns - k_epoch_diff_100ns) / 10;
-        });
+            return (filetime_100ns - k_epoch_diff_100ns) / 10;
+#       else
+            struct timespec realtime_ts{};
+            clock_gettime(CLOCK_REALTIME, &realtime_ts);
+            return static_cast<int64_t>(realtime_ts.tv_sec) * 1000000LL + realtime_ts.tv_nsec / 1000;
+#       endif
+        }
 
-        LARGE_INTEGER now = {};
-        ::QueryPerformanceCounter(&now);
+        /// \brief Convert elapsed monotonic ticks to microseconds.
+        inline int64_t realtime_anchor_elapsed_us(int64_t delta_ticks, int64_t ticks_per_sec) noexcept {
+#       if TIME_SHIELD_PLATFORM_WINDOWS
+            // Avoid overflow of (delta_ticks * 1000000)
+            const int64_t q = delta_ticks / ticks_per_sec;
+            const int64_t r = delta_ticks % ticks_per_sec;
+            return q * 1000000LL + (r * 1000000LL) / ticks_per_sec;
+#       else
+            (void)ticks_per_sec;
+            return delta_ticks / 1000;
+#       endif
+        }
 
-        const int64_t now_ticks   = static_cast<int64_t>(now.QuadPart);
-        const int64_t delta_ticks = now_ticks - s_anchor_perf;
+        /// \brief Capture a new anchor and publish it; the caller holds writer_mutex.
+        inline void publish_realtime_anchor(RealtimeAnchorState& state, bool is_initial) noexcept {
+            const int64_t mono_ticks = realtime_anchor_ticks();
+            const int64_t realtime_us = realtime_clock_us();
+            if (!is_initial) {
+                const RealtimeAnchor previous = state.load();
+                const int64_t anchored_us = previous.realtime_us
+                    + realtime_anchor_elapsed_us(mono_ticks - previous.mono_ticks, state.ticks_per_sec);
+                state.last_correction_us.store(realtime_us - anchored_us, std::memory_order_relaxed);
+                state.reanchor_count.fetch_add(1, std::memory_order_relaxed);
+            }
 
-        // Avoid overflow of (delta_ticks * 1000000)
-        const int64_t q = delta_ticks / s_perf_freq;
-        const int64_t r = delta_ticks % s_perf_freq;
+            RealtimeAnchor anchor;
+            anchor.realtime_us = realtime_us;
+            anchor.mono_ticks = mono_ticks;
+            anchor.next_reanchor_ticks = (std::numeric_limits<int64_t>::max)();
+            const int64_t interval_us = state.interval_us.load(std::memory_order_relaxed);
+            if (interval_us > 0) {
+                const int64_t interval_ticks = (interval_us / US_PER_SEC) * state.ticks_per_sec
+                    + (interval_us % US_PER_SEC) * state.ticks_per_sec / US_PER_SEC;
+                anchor.next_reanchor_ticks = mono_ticks + interval_ticks;
+            }
+            state.store(anchor);
+        }
 
-        const int64_t delta_us =
-            q * 1000000LL + (r * 1000000LL) / s_perf_freq;
+        /// \brief Return the process-wide anchor state, capturing the first anchor lazily.
+        ///
+        /// The state is never destroyed so late readers stay valid during static teardown.
+        inline RealtimeAnchorState& realtime_anchor_state() {
+            static RealtimeAnchorState* p_state = []() {
+                RealtimeAnchorState* p_new_state = new RealtimeAnchorState();
+#           if TIME_SHIELD_PLATFORM_WINDOWS
+                LARGE_INTEGER freq = {};
+                ::QueryPerformanceFrequency(&freq);
+                p_new_state->ticks_per_sec = static_cast<int64_t>(freq.QuadPart);
+#           else
+                p_new_state->ticks_per_sec = NS_PER_SEC;
+#           endif
+                publish_realtime_anchor(*p_new_state, true);
+                return p_new_state;
+            }();
+            return *p_state;
+        }
 
-        return s_anchor_realtime_us + delta_us;
-#       else
-        static std::once_flag init_flag;
-        static int64_t s_anchor_realtime_us = 0;
-        static int64_t s_anchor_mono_ns = 0;
+    } // namespace detail
 
-        std::call_once(init_flag, []() {
-            struct timespec realtime_ts{};
-            struct timespec mono_ts{};
+    /// \ingroup time_utils
+    /// \brief Get current real time in microseconds using a platform-specific method.
+    ///
+    /// Combines a realtime anchor with a high-resolution monotonic clock
+    /// (`QueryPerformanceCounter` on Windows, `CLOCK_MONOTONIC_RAW` on Unix-like
+    /// systems) to compute stable timestamps. The first anchor is captured lazily.
+    /// The anchor is not updated by NTP slewing or clock steps; call
+    /// reanchor_realtime() or set_realtime_reanchor_interval() to follow them.
+    /// New anchors are published through a seqlock, so reads never block.
+    ///
+    /// \return Current UTC timestamp in microseconds.
+    inline int64_t now_realtime_us() {
+        detail::RealtimeAnchorState& state = detail::realtime_anchor_state();
+        const int64_t mono_ticks = detail::realtime_anchor_ticks();
+        detail::RealtimeAnchor anchor = state.load();
+        if (mono_ticks >= anchor.next_reanchor_ticks) {
+            {
+                std::unique_lock<std::mutex> lock(state.writer_mutex, std::try_to_lock);
+                if (lock.owns_lock() && mono_ticks >= state.next_reanchor_ticks.load(std::memory_order_relaxed)) {
+                    detail::publish_realtime_anchor(state, false);
+                }
+            }
+            anchor = state.load();
+        }
+        return anchor.realtime_us
+             + detail::realtime_anchor_elapsed_us(mono_ticks - anchor.mono_ticks, state.ticks_per_sec);
+    }
 
-#           if defined(CLOCK_MONOTONIC_RAW)
-            clock_gettime(CLOCK_MONOTONIC_RAW, &mono_ts);
-#           else
-            clock_gettime(CLOCK_MONOTONIC, &mono_ts);
-#           endif
-            clock_gettime(CLOCK_REALTIME, &realtime_ts);
+    /// \ingroup time_utils
+    /// \brief Capture a new realtime anchor for now_realtime_us().
+    ///
+    /// Subsequent reads step to the current realtime clock, which may move
+    /// them backwards after the clock was set back.
+    inline void reanchor_realtime() {
+        detail::RealtimeAnchorState& state = detail::realtime_anchor_state();
+        std::lock_guard<std::mutex> lock(state.writer_mutex);
+        detail::publish_realtime_anchor(state, false);
+    }
 
-            s_anchor_realtime_us = static_cast<int64_t>(realtime_ts.tv_sec) * 1000000LL
-                                 + realtime_ts.tv_nsec / 1000;
-            s_anchor_mono_ns = static_cast<int64_t>(mono_ts.tv_sec) * 1000000000LL
-                             + mono_ts.tv_nsec;
-        });
+    /// \ingroup time_utils
+    /// \brief Set the automatic re-anchoring interval of now_realtime_us().
+    ///
+    /// Readers re-anchor lazily once the interval has elapsed since the last
+    /// anchor. A zero or negative interval disables automatic re-anchoring,
+    /// which is the default. Setting the interval also captures a new anchor.
+    /// \param interval Re-anchoring interval.
+    template<class Rep, class Period>
+    void set_realtime_reanchor_interval(std::chrono::duration<Rep, Period> interval) {
+        int64_t interval_us = static_cast<int64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(interval).count());
+        if (interval_us < 0) {
+            interval_us = 0;
+        }
+        detail::RealtimeAnchorState& state = detail::realtime_anchor_state();
+        std::lock_guard<std::mutex> lock(state.writer_mutex);
+        state.interval_us.store(interval_us, std::memory_order_relaxed);
+        detail::publish_realtime_anchor(state, false);
+    }
 
-        struct timespec mono_now_ts{};
-#       if defined(CLOCK_MONOTONIC_RAW)
-        clock_gettime(CLOCK_MONOTONIC_RAW, &mono_now_ts);
-#       else
-        clock_gettime(CLOCK_MONOTONIC, &mono_now_ts);
-#       endif
+    /// \ingroup time_utils
+    /// \brief Return the automatic re-anchoring interval of now_realtime_us().
+    /// \return Interval, or zero when automatic re-anchoring is disabled.
+    inline std::chrono::microseconds realtime_reanchor_interval() {
+        return std::chrono::microseconds(
+            detail::realtime_anchor_state().interval_us.load(std::memory_order_relaxed));
+    }
 
-        const int64_t mono_now_ns = static_cast<int64_t>(mono_now_ts.tv_sec) * 1000000000LL
-                                  + mono_now_ts.tv_nsec;
-        const int64_t delta_ns = mono_now_ns - s_anchor_mono_ns;
-        return s_anchor_realtime_us + delta_ns / 1000;
-#       endif
+    /// \ingroup time_utils
+    /// \brief Drift diagnostics of the now_realtime_us() anchor.
+    struct RealtimeAnchorDiagnostics {
+        int64_t  error_us;           ///< now_realtime_us() minus the realtime clock at the time of the call.
+        int64_t  anchor_age_us;      ///< Time elapsed since the current anchor was captured.
+        int64_t  last_correction_us; ///< Step applied by the most recent re-anchoring.
+        uint64_t reanchor_count;     ///< Number of re-anchorings since process start.
+    };
+
+    /// \ingroup time_utils
+    /// \brief Report how far now_realtime_us() has drifted from the realtime clock.
+    /// \return Current anchor diagnostics.
+    inline RealtimeAnchorDiagnostics realtime_anchor_diagnostics() {
+        detail::RealtimeAnchorState& state = detail::realtime_anchor_state();
+        const detail::RealtimeAnchor anchor = state.load();
+        const int64_t mono_ticks = detail::realtime_anchor_ticks();
+        const int64_t realtime_us = detail::realtime_clock_us();
+        const int64_t anchor_age_us = detail::realtime_anchor_elapsed_us(mono_ticks - anchor.mono_ticks,
+                                                                         state.ticks_per_sec);
+        RealtimeAnchorDiagnostics diagnostics;
+        diagnostics.error_us = anchor.realtime_us + anchor_age_us - realtime_us;
+        diagnostics.anchor_age_us = anchor_age_us;
+        diagnostics.last_correction_us = state.last_correction_us.load(std::memory_order_relaxed);
+        diagnostics.reanchor_count = state.reanchor_count.load(std::memory_order_relaxed);
+        return diagnostics;
     }
 
     /// \ingroup time_utils
@@ -341,6 +491,67 @@ namespace time_shield {
         return std::numeric_limits<double>::quiet_NaN();
     }
 
+    /// \ingroup time_utils
+    /// \brief Get the CPU time used by the calling thread.
+    /// \return Thread CPU time in seconds (user plus system), or NaN if not available.
+    /// \note Uses CLOCK_THREAD_CPUTIME_ID on POSIX systems and GetThreadTimes() on Windows.
+    inline double get_thread_cpu_time() noexcept {
+#   if TIME_SHIELD_PLATFORM_WINDOWS
+        FILETIME create_time{}, exit_time{}, kernel_time{}, user_time{};
+        if (GetThreadTimes(GetCurrentThread(), &create_time, &exit_time, &kernel_time, &user_time)) {
+            ULARGE_INTEGER user{};
+            user.LowPart = user_time.dwLowDateTime;
+            user.HighPart = user_time.dwHighDateTime;
+            ULARGE_INTEGER kernel{};
+            kernel.LowPart = kernel_time.dwLowDateTime;
+            kernel.HighPart = kernel_time.dwHighDateTime;
+            return static_cast<double>(user.QuadPart + kernel.QuadPart) / 10000000.0;
+        }
+#   elif TIME_SHIELD_PLATFORM_UNIX && defined(CLOCK_THREAD_CPUTIME_ID)
+        struct timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+            return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+        }
+#   endif
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /// \ingroup time_utils
+    /// \brief CPU time split into user and system parts.
+    struct CpuUsage {
+        double user_sec;    ///< Time spent in user mode, in seconds.
+        double system_sec;  ///< Time spent in kernel mode, in seconds.
+    };
+
+    /// \ingroup time_utils
+    /// \brief Get user and system CPU time of the calling thread.
+    /// \return Thread CPU usage in seconds; both fields are NaN if not available.
+    /// \note Uses getrusage(RUSAGE_THREAD) on Linux and GetThreadTimes() on Windows.
+    /// The result has microsecond resolution and costs a system call.
+    inline CpuUsage get_thread_cpu_usage() noexcept {
+#   if TIME_SHIELD_PLATFORM_WINDOWS
+        FILETIME create_time{}, exit_time{}, kernel_time{}, user_time{};
+        if (GetThreadTimes(GetCurrentThread(), &create_time, &exit_time, &kernel_time, &user_time)) {
+            ULARGE_INTEGER user{};
+            user.LowPart = user_time.dwLowDateTime;
+            user.HighPart = user_time.dwHighDateTime;
+            ULARGE_INTEGER kernel{};
+            kernel.LowPart = kernel_time.dwLowDateTime;
+            kernel.HighPart = kernel_time.dwHighDateTime;
+            return CpuUsage{static_cast<double>(user.QuadPart) / 10000000.0,
+                            static_cast<double>(kernel.QuadPart) / 10000000.0};
+        }
+#   elif TIME_SHIELD_PLATFORM_UNIX && defined(RUSAGE_THREAD)
+        struct rusage usage{};
+        if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+            return CpuUsage{
+                static_cast<double>(usage.ru_utime.tv_sec) + static_cast<double>(usage.ru_utime.tv_usec) / 1e6,
+                static_cast<double>(usage.ru_stime.tv_sec) + static_cast<double>(usage.ru_stime.tv_usec) / 1e6};
+        }
+#   endif
+        return CpuUsage{std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()};
+    }
+
 }; // namespace time_shield
 
 #endif // _TIME_SHIELD_TIME_UTILS_HPP_INCLUDED
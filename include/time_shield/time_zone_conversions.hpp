@@ -11,6 +11,7 @@
 #include "time_conversions.hpp"
 #include "time_zone_offset.hpp"
 #include "time_unit_conversions.hpp"
+#include "tracing.hpp"
 
 namespace time_shield {
 
@@ -361,6 +362,7 @@ namespace time_shield {
     /// \param zone Source time zone.
     /// \return Timestamp in seconds in GMT, or ERROR_TIMESTAMP for unsupported zones.
     inline ts_t zone_to_gmt(ts_t local, TimeZone zone) {
+        TIME_SHIELD_TRACE_SCOPE("zone_to_gmt");
         if(local == ERROR_TIMESTAMP) {
             return ERROR_TIMESTAMP;
         }
@@ -0,0 +1,360 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_TRACING_HPP_INCLUDED
+#define _TIME_SHIELD_TRACING_HPP_INCLUDED
+
+/// \file tracing.hpp
+/// \brief Compile-time gated scope probes with Chrome trace export.
+///
+/// `TIME_SHIELD_TRACE_SCOPE("name")` marks the rest of the enclosing scope as a
+/// traced span. When `TIME_SHIELD_ENABLE_TRACING` is 0 (the default) the macro
+/// expands to nothing. When it is 1, each probe reads the CPU counter on entry
+/// and exit and stores one complete event in a per-thread ring buffer; the
+/// owning thread is the only writer, so recording takes no locks. Rings keep
+/// the newest events. When a thread exits its ring goes to a free list and is
+/// handed to the next new thread, so memory is bounded by the peak number of
+/// tracing threads; events of a finished thread can be exported until then.
+/// If a ring cannot be allocated the event is dropped. trace::write_chrome_json()
+/// emits the Chrome trace event format, which Perfetto UI and chrome://tracing
+/// open directly.
+///
+/// \note The name passed to the probe must be a string literal or otherwise
+/// outlive the export.
+
+#include "config.hpp"
+
+#if TIME_SHIELD_ENABLE_TRACING
+
+#include "TscClock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifndef TIME_SHIELD_TRACE_RING_CAPACITY
+/// Ring slots per thread; must be a power of two. collect() returns at most
+/// CAPACITY - 1 events per thread because the next slot may be mid-write.
+#   define TIME_SHIELD_TRACE_RING_CAPACITY 4096
+#endif
+
+namespace time_shield {
+namespace trace {
+
+    /// \brief Exported trace event with timestamps in monotonic nanoseconds.
+    struct TraceEvent {
+        const char*   name;     ///< Probe name.
+        std::int64_t  begin_ns; ///< Scope entry, steady_clock epoch.
+        std::int64_t  end_ns;   ///< Scope exit, steady_clock epoch.
+        std::uint32_t thread;   ///< Sequential id of the recording thread.
+    };
+
+    namespace detail {
+
+        static_assert((TIME_SHIELD_TRACE_RING_CAPACITY & (TIME_SHIELD_TRACE_RING_CAPACITY - 1)) == 0,
+                      "TIME_SHIELD_TRACE_RING_CAPACITY must be a power of two");
+
+        /// \brief Return true when stamps come from the CPU counter instead of steady_clock.
+        inline bool uses_cpu_counter() noexcept {
+            static const bool s_is_counter = TscClock::instance().is_available();
+            return s_is_counter;
+        }
+
+        /// \brief Read a raw trace stamp.
+        inline std::uint64_t read_stamp() noexcept {
+            if (uses_cpu_counter()) {
+                return TscClock::read_counter();
+            }
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /// \brief Convert a raw trace stamp to monotonic nanoseconds.
+        inline std::int64_t stamp_to_ns(std::uint64_t stamp) noexcept {
+            if (uses_cpu_counter()) {
+                return TscClock::instance().counter_to_monotonic_ns(stamp);
+            }
+            return static_cast<std::int64_t>(stamp);
+        }
+
+        /// \brief Single-writer ring of complete events owned by one thread.
+        struct TraceRing {
+            struct Slot {
+                std::atomic<const char*>   name{nullptr};
+                std::atomic<std::uint64_t> begin{0};
+                std::atomic<std::uint64_t> end{0};
+            };
+
+            TraceRing() noexcept
+                : slots(new (std::nothrow) Slot[TIME_SHIELD_TRACE_RING_CAPACITY]) {}
+
+            void push(const char* name, std::uint64_t begin, std::uint64_t end) noexcept {
+                const std::uint64_t index = head.load(std::memory_order_relaxed);
+                Slot& slot = slots[static_cast<std::size_t>(index) & (TIME_SHIELD_TRACE_RING_CAPACITY - 1)];
+                slot.name.store(name, std::memory_order_relaxed);
+                slot.begin.store(begin, std::memory_order_relaxed);
+                slot.end.store(end, std::memory_order_relaxed);
+                head.store(index + 1, std::memory_order_release);
+            }
+
+            std::uint32_t              thread{0};   ///< Id of the owning thread; guarded by the registry mutex.
+            std::atomic<std::uint64_t> head{0};
+            std::atomic<std::uint64_t> cleared{0};
+            std::unique_ptr<Slot[]>    slots;
+        };
+
+        /// \brief Registry of all rings and of the rings released by finished threads.
+        struct TraceRegistry {
+            std::mutex              mutex;
+            std::vector<TraceRing*> rings;
+            std::vector<TraceRing*> free_rings;
+            std::uint32_t           last_thread{0};
+        };
+
+        /// \brief Return the process-wide registry; it is never destroyed.
+        inline TraceRegistry& registry() {
+            static TraceRegistry* p_registry = new TraceRegistry();
+            return *p_registry;
+        }
+
+        /// \brief Ring of the calling thread; null until acquired and after thread exit.
+        inline TraceRing*& cached_thread_ring() noexcept {
+            static TIME_SHIELD_THREAD_LOCAL TraceRing* t_ring = nullptr;
+            return t_ring;
+        }
+
+        /// \brief Set once the calling thread released its ring during thread exit.
+        inline bool& is_thread_exiting() noexcept {
+            static TIME_SHIELD_THREAD_LOCAL bool t_is_exiting = false;
+            return t_is_exiting;
+        }
+
+        /// \brief Take a free ring or allocate a new one.
+        /// \return Null when allocation or locking fails.
+        inline TraceRing* acquire_ring() noexcept {
+            try {
+                TraceRegistry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                TraceRing* ring = nullptr;
+                if (!reg.free_rings.empty()) {
+                    ring = reg.free_rings.back();
+                    reg.free_rings.pop_back();
+                    // The previous owner has exited; its events are not relabeled.
+                    ring->cleared.store(ring->head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                } else {
+                    std::unique_ptr<TraceRing> created(new (std::nothrow) TraceRing());
+                    if (!created || !created->slots) {
+                        return nullptr;
+                    }
+                    reg.rings.push_back(created.get());
+                    ring = created.release();
+                }
+                ring->thread = ++reg.last_thread;
+                return ring;
+            } catch (...) {
+                return nullptr;
+            }
+        }
+
+        /// \brief Return a ring to the free list when its thread exits.
+        struct ThreadRingOwner {
+            TraceRing* ring = nullptr;
+
+            ~ThreadRingOwner() {
+                is_thread_exiting() = true;
+                cached_thread_ring() = nullptr;
+                try {
+                    TraceRegistry& reg = registry();
+                    std::lock_guard<std::mutex> lock(reg.mutex);
+                    reg.free_rings.push_back(ring);
+                } catch (...) {
+                    // The ring stays registered but is not reused.
+                }
+            }
+        };
+
+        /// \brief Return the ring of the calling thread, acquiring it on first use.
+        /// \return Null when no ring is available; the event is then dropped.
+        inline TraceRing* thread_ring() noexcept {
+            TraceRing* ring = cached_thread_ring();
+            if (ring != nullptr || is_thread_exiting()) {
+                return ring;
+            }
+            ring = acquire_ring();
+            if (ring == nullptr) {
+                return nullptr;
+            }
+            // thread_local rather than TIME_SHIELD_THREAD_LOCAL: the owner needs a destructor.
+            static thread_local ThreadRingOwner t_owner;
+            t_owner.ring = ring;
+            cached_thread_ring() = ring;
+            return ring;
+        }
+
+        /// \brief Append a JSON string literal with minimal escaping.
+        inline void write_json_string(std::ostream& out, const char* text) {
+            out << '"';
+            for (const char* p = text; p != nullptr && *p != '\0'; ++p) {
+                const char c = *p;
+                if (c == '"' || c == '\\') {
+                    out << '\\' << c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    out << ' ';
+                } else {
+                    out << c;
+                }
+            }
+            out << '"';
+        }
+
+        /// \brief Append nanoseconds as fractional microseconds.
+        inline void write_us(std::ostream& out, std::int64_t ns) {
+            if (ns < 0) {
+                out << '-';
+                ns = -ns;
+            }
+            const std::int64_t fraction = ns % 1000;
+            out << ns / 1000 << '.' << static_cast<char>('0' + fraction / 100)
+                << static_cast<char>('0' + fraction / 10 % 10) << static_cast<char>('0' + fraction % 10);
+        }
+
+    } // namespace detail
+
+    /// \brief RAII probe recording one complete event.
+    class Scope {
+    public:
+        /// \brief Stamp scope entry.
+        explicit Scope(const char* name) noexcept
+            : m_name(name)
+            , m_begin(detail::read_stamp()) {}
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /// \brief Stamp scope exit and store the event.
+        ~Scope() {
+            const std::uint64_t end = detail::read_stamp();
+            detail::TraceRing* ring = detail::thread_ring();
+            if (ring != nullptr) {
+                ring->push(m_name, m_begin, end);
+            }
+        }
+
+    private:
+        const char*   m_name;
+        std::uint64_t m_begin;
+    };
+
+    /// \brief Return the retained events of all threads ordered by ring.
+    ///
+    /// Safe to call while other threads record; events overwritten during the
+    /// copy are skipped. At most TIME_SHIELD_TRACE_RING_CAPACITY - 1 events are
+    /// returned per ring. Events of a finished thread are returned until its
+    /// ring is reused.
+    inline std::vector<TraceEvent> collect() {
+        std::vector<TraceEvent> events;
+        detail::TraceRegistry& reg = detail::registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (std::size_t r = 0; r < reg.rings.size(); ++r) {
+            detail::TraceRing& ring = *reg.rings[r];
+            const std::uint64_t head = ring.head.load(std::memory_order_acquire);
+            std::uint64_t first = ring.cleared.load(std::memory_order_relaxed);
+            if (head - first > TIME_SHIELD_TRACE_RING_CAPACITY) {
+                first = head - TIME_SHIELD_TRACE_RING_CAPACITY;
+            }
+            const std::size_t ring_begin = events.size();
+            for (std::uint64_t i = first; i < head; ++i) {
+                const detail::TraceRing::Slot& slot =
+                    ring.slots[static_cast<std::size_t>(i) & (TIME_SHIELD_TRACE_RING_CAPACITY - 1)];
+                TraceEvent event;
+                event.name = slot.name.load(std::memory_order_relaxed);
+                event.begin_ns = detail::stamp_to_ns(slot.begin.load(std::memory_order_relaxed));
+                event.end_ns = detail::stamp_to_ns(slot.end.load(std::memory_order_relaxed));
+                event.thread = ring.thread;
+                events.push_back(event);
+            }
+            // Drop slots the writer may have reused while they were copied. push()
+            // writes slot head before publishing head + 1, so the slot of event
+            // head_after - CAPACITY may be half written as well.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const std::uint64_t head_after = ring.head.load(std::memory_order_relaxed);
+            if (head_after - first >= TIME_SHIELD_TRACE_RING_CAPACITY) {
+                const std::uint64_t overwritten = head_after - first - TIME_SHIELD_TRACE_RING_CAPACITY + 1;
+                const std::size_t drop = static_cast<std::size_t>(
+                    overwritten < head - first ? overwritten : head - first);
+                events.erase(events.begin() + static_cast<std::ptrdiff_t>(ring_begin),
+                             events.begin() + static_cast<std::ptrdiff_t>(ring_begin + drop));
+            }
+        }
+        return events;
+    }
+
+    /// \brief Forget all retained events.
+    ///
+    /// Events recorded concurrently may survive the call.
+    inline void clear() {
+        detail::TraceRegistry& reg = detail::registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (std::size_t r = 0; r < reg.rings.size(); ++r) {
+            reg.rings[r]->cleared.store(reg.rings[r]->head.load(std::memory_order_acquire),
+                                        std::memory_order_relaxed);
+        }
+    }
+
+    /// \brief Write retained events in Chrome trace event JSON format.
+    /// \param out Output stream.
+    inline void write_chrome_json(std::ostream& out) {
+        const std::vector<TraceEvent> events = collect();
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            const TraceEvent& event = events[i];
+            if (i != 0) {
+                out << ',';
+            }
+            out << "\n{\"name\":";
+            detail::write_json_string(out, event.name);
+            out << ",\"cat\":\"time_shield\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread << ",\"ts\":";
+            detail::write_us(out, event.begin_ns);
+            out << ",\"dur\":";
+            detail::write_us(out, event.end_ns - event.begin_ns);
+            out << '}';
+        }
+        out << "\n]}\n";
+    }
+
+    /// \brief Write retained events to a Chrome trace JSON file.
+    /// \param path Output file path.
+    /// \return True when the file was written.
+    inline bool write_chrome_json(const std::string& path) {
+        std::ofstream file(path.c_str(), std::ios::out | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        write_chrome_json(file);
+        return static_cast<bool>(file);
+    }
+
+} // namespace trace
+} // namespace time_shield
+
+#define TIME_SHIELD_TRACE_CONCAT_IMPL(a, b) a##b
+#define TIME_SHIELD_TRACE_CONCAT(a, b) TIME_SHIELD_TRACE_CONCAT_IMPL(a, b)
+/// \brief Trace the rest of the enclosing scope under the given name.
+#define TIME_SHIELD_TRACE_SCOPE(name) \
+    ::time_shield::trace::Scope TIME_SHIELD_TRACE_CONCAT(time_shield_trace_scope_, __LINE__)(name)
+
+#else // TIME_SHIELD_ENABLE_TRACING
+
+/// \brief Trace the rest of the enclosing scope; expands to nothing while tracing is disabled.
+#define TIME_SHIELD_TRACE_SCOPE(name)
+
+#endif // TIME_SHIELD_ENABLE_TRACING
+
+#endif // _TIME_SHIELD_TRACING_HPP_INCLUDED
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MIT
+#pragma once
+#ifndef _TIME_SHIELD_WAIT_STRATEGY_HPP_INCLUDED
+#define _TIME_SHIELD_WAIT_STRATEGY_HPP_INCLUDED
+
+/// \file wait_strategy.hpp
+/// \brief Wait strategies for precise deadline waits.
+///
+/// Blocking waits delegate to the operating system scheduler and typically
+/// wake up tens of microseconds after the deadline. Spinning waits keep the
+/// thread on the CPU and poll the clock with a pause instruction, which trades
+/// one busy core for sub-microsecond wake-up latency. The hybrid strategy
+/// blocks until a short window before the deadline and spins for the rest.
+
+#include "config.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   include <intrin.h>
+#endif
+
+namespace time_shield {
+
+    /// \brief Strategy used to wait for a deadline.
+    enum class WaitStrategy : std::uint8_t {
+        Block,          ///< Block in the operating system until the deadline.
+        BlockThenSpin,  ///< Block until the spin window and busy-spin for the remaining time.
+        BusySpin        ///< Busy-spin with a CPU pause instruction until the deadline.
+    };
+
+    /// \brief Wait strategy together with its spin window.
+    struct WaitPolicy {
+        WaitStrategy             strategy;    ///< Selected strategy.
+        std::chrono::nanoseconds spin_window; ///< Spin duration before the deadline for BlockThenSpin.
+
+        /// \brief Construct blocking policy.
+        WaitPolicy() noexcept
+            : strategy(WaitStrategy::Block)
+            , spin_window(std::chrono::nanoseconds::zero()) {}
+
+        /// \brief Construct policy with explicit strategy and spin window.
+        /// \param wait_strategy Selected strategy.
+        /// \param spin Spin window used by WaitStrategy::BlockThenSpin.
+        WaitPolicy(WaitStrategy wait_strategy, std::chrono::nanoseconds spin) noexcept
+            : strategy(wait_strategy)
+            , spin_window(spin < std::chrono::nanoseconds::zero() ? std::chrono::nanoseconds::zero() : spin) {}
+
+        /// \brief Return policy that only blocks.
+        static WaitPolicy block() noexcept {
+            return WaitPolicy();
+        }
+
+        /// \brief Return policy that blocks and spins during the last part of the wait.
+        /// \param spin Spin window before the deadline.
+        template<class Rep, class Period>
+        static WaitPolicy block_then_spin(std::chrono::duration<Rep, Period> spin) noexcept {
+            return WaitPolicy(WaitStrategy::BlockThenSpin,
+                              std::chrono::duration_cast<std::chrono::nanoseconds>(spin));
+        }
+
+        /// \brief Return policy that spins for the whole wait.
+        static WaitPolicy busy_spin() noexcept {
+            return WaitPolicy(WaitStrategy::BusySpin, std::chrono::nanoseconds::zero());
+        }
+    };
+
+    namespace detail {
+
+        /// \brief Hint the CPU that the caller is in a spin-wait loop.
+        inline void cpu_relax() noexcept {
+#       if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_pause();
+#       elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_ia32_pause();
+#       elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+            __asm__ __volatile__("yield" ::: "memory");
+#       else
+            std::this_thread::yield();
+#       endif
+        }
+
+        /// \brief Return the point where a policy switches from blocking to spinning.
+        template<class Clock, class Duration>
+        std::chrono::time_point<Clock, Duration> spin_start_time(
+                const std::chrono::time_point<Clock, Duration>& deadline,
+                const WaitPolicy& policy) noexcept {
+            using time_point = std::chrono::time_point<Clock, Duration>;
+            if (policy.strategy == WaitStrategy::BusySpin) {
+                return (time_point::min)();
+            }
+            if (policy.strategy == WaitStrategy::Block) {
+                return deadline;
+            }
+            const Duration window = std::chrono::duration_cast<Duration>(policy.spin_window);
+            if (deadline.time_since_epoch() < (Duration::min)() + window) {
+                return (time_point::min)();
+            }
+            return deadline - window;
+        }
+
+    } // namespace detail
+
+    /// \brief Spin until the deadline is reached.
+    /// \param deadline Absolute deadline.
+    template<class Clock, class Duration>
+    void spin_until(const std::chrono::time_point<Clock, Duration>& deadline) noexcept {
+        while (Clock::now() < deadline) {
+            detail::cpu_relax();
+        }
+    }
+
+    /// \brief Wait until the deadline using the provided policy.
+    ///
+    /// The function never returns before the deadline as observed by \p Clock.
+    /// \param deadline Absolute deadline.
+    /// \param policy Wait policy.
+    template<class Clock, class Duration>
+    void wait_until(const std::chrono::time_point<Clock, Duration>& deadline,
+                    const WaitPolicy& policy = WaitPolicy()) {
+        const auto spin_from = detail::spin_start_time(deadline, policy);
+        if (Clock::now() < spin_from) {
+            std::this_thread::sleep_until(spin_from);
+        }
+        spin_until(deadline);
+    }
+
+    /// \brief Wait for the timeout using the provided policy.
+    /// \param timeout Relative timeout measured by std::chrono::steady_clock.
+    /// \param policy Wait policy.
+    template<class Rep, class Period>
+    void wait_for(std::chrono::duration<Rep, Period> timeout, const WaitPolicy& policy = WaitPolicy()) {
+        const auto now = std::chrono::steady_clock::now();
+        if (timeout <= std::chrono::duration<Rep, Period>::zero()) {
+            return;
+        }
+        wait_until(now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout), policy);
+    }
+
+} // namespace time_shield
+
+#endif // _TIME_SHIELD_WAIT_STRATEGY_HPP_INCLUDED
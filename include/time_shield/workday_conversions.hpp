@@ -9,6 +9,7 @@
 #include "config.hpp"
 #include "date_conversions.hpp"
 #include "date_time_conversions.hpp"
+#include "detail/calendar_tables.hpp"
 #include "time_unit_conversions.hpp"
 #include "validation.hpp"
 
@@ -21,6 +22,11 @@ namespace time_shield {
     /// \param year Target year.
     /// \param month Target month (1-12).
     TIME_SHIELD_CONSTEXPR inline int first_workday_day(year_t year, int month) noexcept {
+#       if TIME_SHIELD_ENABLE_CALENDAR_TABLES
+        if (detail::calendar_table_contains(year) && month >= 1 && month <= 12) {
+            return detail::calendar_table_entry(year).first_workday[month - 1];
+        }
+#       endif
         const int days = num_days_in_month(year, month);
         if (days <= 0) {
             return 0;
@@ -37,6 +43,11 @@ namespace time_shield {
     /// \param year Target year.
     /// \param month Target month (1-12).
     TIME_SHIELD_CONSTEXPR inline int last_workday_day(year_t year, int month) noexcept {
+#       if TIME_SHIELD_ENABLE_CALENDAR_TABLES
+        if (detail::calendar_table_contains(year) && month >= 1 && month <= 12) {
+            return detail::calendar_table_entry(year).last_workday[month - 1];
+        }
+#       endif
         const int days = num_days_in_month(year, month);
         if (days <= 0) {
             return 0;
@@ -0,0 +1,260 @@
+#include <time_shield/BarAggregator.hpp>
+#include <time_shield/time_conversions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    using time_shield::Bar;
+    using time_shield::BarAggregator;
+    using time_shield::BarTimeframe;
+    using time_shield::ts_ms_t;
+
+    struct Tick {
+        ts_ms_t ts;
+        double  price;
+        double  volume;
+    };
+
+    bool bar_less(const Bar& a, const Bar& b) {
+        return a.timeframe != b.timeframe ? a.timeframe < b.timeframe : a.start_ms < b.start_ms;
+    }
+
+    /// \brief Aggregates ticks with per-tick bucket lookups, applying the same drop rule.
+    std::vector<Bar> reference_bars(const BarAggregator& aggregator,
+                                    const std::vector<Tick>& ticks,
+                                    ts_ms_t tolerance,
+                                    uint64_t& dropped) {
+        struct Acc {
+            Bar     bar;
+            ts_ms_t open_ts;
+            ts_ms_t close_ts;
+        };
+        std::map<std::pair<std::size_t, ts_ms_t>, Acc> bars;
+        ts_ms_t newest = ticks.empty() ? 0 : ticks[0].ts;
+        dropped = 0;
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            const Tick& tick = ticks[i];
+            newest = std::max(newest, tick.ts);
+            for (std::size_t tf = 0; tf < aggregator.timeframe_count(); ++tf) {
+                const std::pair<ts_ms_t, ts_ms_t> range = aggregator.bucket_bounds(tf, tick.ts);
+                assert(range.first <= tick.ts && tick.ts < range.second);
+                if (range.second <= newest - tolerance) {
+                    ++dropped;
+                    continue;
+                }
+                const std::pair<std::size_t, ts_ms_t> key(tf, range.first);
+                std::map<std::pair<std::size_t, ts_ms_t>, Acc>::iterator it = bars.find(key);
+                if (it == bars.end()) {
+                    Acc acc = {{tf, range.first, range.second, tick.price, tick.price, tick.price, tick.price,
+                                tick.volume, 1}, tick.ts, tick.ts};
+                    bars.insert(std::make_pair(key, acc));
+                    continue;
+                }
+                Acc& acc = it->second;
+                acc.bar.high = std::max(acc.bar.high, tick.price);
+                acc.bar.low = std::min(acc.bar.low, tick.price);
+                if (tick.ts >= acc.close_ts) {
+                    acc.bar.close = tick.price;
+                    acc.close_ts = tick.ts;
+                }
+                if (tick.ts < acc.open_ts) {
+                    acc.bar.open = tick.price;
+                    acc.open_ts = tick.ts;
+                }
+                acc.bar.volume += tick.volume;
+                ++acc.bar.tick_count;
+            }
+        }
+        std::vector<Bar> result;
+        for (std::map<std::pair<std::size_t, ts_ms_t>, Acc>::const_iterator it = bars.begin(); it != bars.end(); ++it) {
+            result.push_back(it->second.bar);
+        }
+        return result;
+    }
+
+    void assert_same_bars(std::vector<Bar> actual, const std::vector<Bar>& expected) {
+        std::sort(actual.begin(), actual.end(), bar_less);
+        assert(actual.size() == expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i) {
+            assert(actual[i].timeframe == expected[i].timeframe);
+            assert(actual[i].start_ms == expected[i].start_ms);
+            assert(actual[i].end_ms == expected[i].end_ms);
+            assert(actual[i].open == expected[i].open);
+            assert(actual[i].high == expected[i].high);
+            assert(actual[i].low == expected[i].low);
+            assert(actual[i].close == expected[i].close);
+            assert(actual[i].volume == expected[i].volume);
+            assert(actual[i].tick_count == expected[i].tick_count);
+        }
+    }
+
+    std::vector<BarTimeframe> test_timeframes() {
+        std::vector<BarTimeframe> timeframes;
+        timeframes.push_back(BarTimeframe("M1"));
+        timeframes.push_back(BarTimeframe("M15"));
+        timeframes.push_back(BarTimeframe("H1", time_shield::IST));
+        timeframes.push_back(BarTimeframe("H1", time_shield::ET));
+        timeframes.push_back(BarTimeframe("D1", time_shield::ET, 17 * time_shield::MS_PER_HOUR));
+        timeframes.push_back(BarTimeframe("D1", time_shield::CET));
+        return timeframes;
+    }
+
+    /// \brief Ticks with unique increasing timestamps across both 2024 US DST changes.
+    std::vector<Tick> make_ticks(std::mt19937_64& rng) {
+        std::vector<Tick> ticks;
+        const ts_ms_t windows[] = {
+            time_shield::to_timestamp_ms(2024, 3, 8),
+            time_shield::to_timestamp_ms(2024, 10, 31),
+        };
+        for (std::size_t w = 0; w < 2; ++w) {
+            ts_ms_t ts = windows[w];
+            for (int i = 0; i < 6000; ++i) {
+                ts += 1 + static_cast<ts_ms_t>(rng() % (3 * time_shield::MS_PER_MIN));
+                const double price = 100.0 + static_cast<double>(rng() % 1000) / 100.0;
+                const double volume = static_cast<double>(1 + rng() % 9);
+                Tick tick = {ts, price, volume};
+                ticks.push_back(tick);
+            }
+        }
+        return ticks;
+    }
+
+} // namespace
+
+int main() {
+    using namespace time_shield;
+
+    // Timeframe parsing and validation.
+    {
+        assert(BarTimeframe("M15").period_ms == 15 * MS_PER_MIN);
+        bool is_thrown = false;
+        try {
+            BarTimeframe bad("not a timeframe");
+            (void)bad;
+        } catch (const std::invalid_argument&) {
+            is_thrown = true;
+        }
+        assert(is_thrown);
+        is_thrown = false;
+        try {
+            BarAggregator bad(std::vector<BarTimeframe>(1, BarTimeframe(MS_PER_HOUR, UNKNOWN)));
+            (void)bad;
+        } catch (const std::invalid_argument&) {
+            is_thrown = true;
+        }
+        assert(is_thrown);
+    }
+
+    // New York FX day (17:00 ET) is 23 hours on the spring change and 25 hours on the fall change.
+    {
+        const std::vector<BarTimeframe> timeframes(1, BarTimeframe("D1", ET, 17 * MS_PER_HOUR));
+        const BarAggregator aggregator(timeframes);
+        const std::pair<ts_ms_t, ts_ms_t> spring = aggregator.bucket_bounds(0, to_timestamp_ms(2024, 3, 10, 12));
+        assert(spring.first == to_timestamp_ms(2024, 3, 9, 22));
+        assert(spring.second == to_timestamp_ms(2024, 3, 10, 21));
+        const std::pair<ts_ms_t, ts_ms_t> fall = aggregator.bucket_bounds(0, to_timestamp_ms(2024, 11, 3, 12));
+        assert(fall.first == to_timestamp_ms(2024, 11, 2, 21));
+        assert(fall.second == to_timestamp_ms(2024, 11, 3, 22));
+        const std::pair<ts_ms_t, ts_ms_t> plain = aggregator.bucket_bounds(0, to_timestamp_ms(2024, 7, 1, 20));
+        assert(plain.first == to_timestamp_ms(2024, 6, 30, 21));
+        assert(plain.second - plain.first == MS_PER_DAY);
+        // Fixed zones shift the phase: IST hours start at half past UTC hours.
+        // Buckets of every timeframe tile the time axis across the DST changes.
+        const BarAggregator all(test_timeframes());
+        const ts_ms_t windows[] = {to_timestamp_ms(2024, 3, 8), to_timestamp_ms(2024, 10, 31)};
+        for (std::size_t tf = 0; tf < all.timeframe_count(); ++tf) {
+            for (std::size_t w = 0; w < 2; ++w) {
+                std::pair<ts_ms_t, ts_ms_t> prev = all.bucket_bounds(tf, windows[w]);
+                for (ts_ms_t ts = windows[w]; ts < windows[w] + 5 * MS_PER_DAY; ts += MS_PER_MIN) {
+                    const std::pair<ts_ms_t, ts_ms_t> range = all.bucket_bounds(tf, ts);
+                    assert(range.first <= ts && ts < range.second);
+                    assert(range == prev || range.first == prev.second);
+                    prev = range;
+                }
+            }
+        }
+        const BarAggregator ist(std::vector<BarTimeframe>(1, BarTimeframe("H1", IST)));
+        assert(ist.bucket_bounds(0, to_timestamp_ms(2024, 1, 1, 10, 10)).first == to_timestamp_ms(2024, 1, 1, 9, 30));
+    }
+
+    // In-order stream: bars are emitted as soon as the next bucket starts.
+    {
+        std::mt19937_64 rng(0x243f6a8885a308d3ULL);
+        const std::vector<Tick> ticks = make_ticks(rng);
+        BarAggregator aggregator(test_timeframes());
+        std::vector<Bar> bars;
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            aggregator.push(ticks[i].ts, ticks[i].price, ticks[i].volume);
+            aggregator.drain(bars);
+            for (std::size_t b = 0; b < bars.size(); ++b) {
+                assert(bars[b].end_ms <= ticks[i].ts);
+            }
+        }
+        Bar current;
+        assert(aggregator.current_bar(0, current));
+        assert(current.close == ticks.back().price);
+        aggregator.flush();
+        aggregator.drain(bars);
+        assert(!aggregator.current_bar(0, current));
+        uint64_t dropped = 0;
+        assert_same_bars(bars, reference_bars(aggregator, ticks, 0, dropped));
+        assert(dropped == 0 && aggregator.dropped_tick_count() == 0);
+
+        // Batch push gives the same bars.
+        std::vector<ts_ms_t> ts;
+        std::vector<double> prices;
+        std::vector<double> volumes;
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            ts.push_back(ticks[i].ts);
+            prices.push_back(ticks[i].price);
+            volumes.push_back(ticks[i].volume);
+        }
+        BarAggregator batch(test_timeframes());
+        batch.push(ts.data(), prices.data(), volumes.data(), ts.size());
+        batch.flush();
+        std::vector<Bar> batch_bars;
+        batch.drain(batch_bars);
+        assert_same_bars(batch_bars, reference_bars(batch, ticks, 0, dropped));
+    }
+
+    // Out-of-order stream: ticks late by less than the tolerance are merged, later ones dropped.
+    {
+        std::mt19937_64 rng(0x13198a2e03707344ULL);
+        std::vector<Tick> ticks = make_ticks(rng);
+        for (std::size_t i = 0; i + 1 < ticks.size(); ++i) {
+            const std::size_t j = i + static_cast<std::size_t>(rng() % 12);
+            if (j < ticks.size()) {
+                std::swap(ticks[i], ticks[j]);
+            }
+        }
+        const ts_ms_t tolerance = 5 * MS_PER_MIN;
+        BarAggregator aggregator(test_timeframes(), tolerance);
+        std::vector<Bar> bars;
+        ts_ms_t newest = ticks[0].ts;
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            newest = std::max(newest, ticks[i].ts);
+            aggregator.push(ticks[i].ts, ticks[i].price, ticks[i].volume);
+            aggregator.drain(bars);
+            for (std::size_t b = 0; b < bars.size(); ++b) {
+                assert(bars[b].end_ms <= newest - tolerance);
+            }
+        }
+        aggregator.flush();
+        aggregator.drain(bars);
+        uint64_t dropped = 0;
+        assert_same_bars(bars, reference_bars(aggregator, ticks, tolerance, dropped));
+        assert(dropped == aggregator.dropped_tick_count());
+        assert(dropped > 0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include <time_shield/BusinessCalendar.hpp>
+#include <time_shield/time_conversions.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    using time_shield::BusinessCalendar;
+    using time_shield::dse_t;
+
+    /// \brief Business-day rule evaluated day by day.
+    struct NaiveCalendar {
+        dse_t first;
+        dse_t last;
+        std::set<dse_t> holidays;
+        std::set<dse_t> extra_days;
+
+        bool is_business(dse_t day) const {
+            if (day >= first && day <= last) {
+                if (holidays.count(day) != 0) {
+                    return false;
+                }
+                if (extra_days.count(day) != 0) {
+                    return true;
+                }
+            }
+            return !time_shield::is_weekend_unix_day(day);
+        }
+
+        int64_t between(dse_t from, dse_t to) const {
+            int64_t count = 0;
+            for (dse_t day = from; day < to; ++day) {
+                count += is_business(day) ? 1 : 0;
+            }
+            for (dse_t day = to; day < from; ++day) {
+                count -= is_business(day) ? 1 : 0;
+            }
+            return count;
+        }
+
+        dse_t add(dse_t day, int64_t count) const {
+            while (count > 0) {
+                ++day;
+                count -= is_business(day) ? 1 : 0;
+            }
+            while (count < 0) {
+                --day;
+                count += is_business(day) ? 1 : 0;
+            }
+            return day;
+        }
+    };
+
+    const char* const NYSE_2024 =
+        "# NYSE 2024 excerpt\n"
+        "zone ET\n"
+        "range 2024-01-01 2024-12-31\n"
+        "weekend SAT SUN\n"
+        "session 09:30 16:00\n"
+        "holiday 2024-01-01 New Year's Day\n"
+        "holiday 2024-01-15\n"
+        "holiday 2024-07-04   # Independence Day\n"
+        "holiday 2024-11-28\n"
+        "session 2024-07-03 09:30 13:00\n"
+        "session 2024-11-29 09:30 13:00\n"
+        "holiday 2024-12-25\n"
+        "\n";
+
+} // namespace
+
+int main() {
+    using namespace time_shield;
+
+    // Random holidays and weekend trading days against the day-by-day rule, including outside the range.
+    {
+        std::mt19937_64 rng(0x6a09e667f3bcc908ULL);
+        NaiveCalendar naive;
+        naive.first = date_to_unix_day(2020, 1, 1);
+        naive.last = date_to_unix_day(2025, 12, 31);
+        BusinessCalendar calendar(naive.first, naive.last);
+        assert(calendar.first_day() == naive.first && calendar.last_day() == naive.last);
+        for (int i = 0; i < 300; ++i) {
+            const dse_t day = naive.first + static_cast<dse_t>(rng() % 2192);
+            if (is_weekend_unix_day(day)) {
+                naive.extra_days.insert(day);
+                naive.holidays.erase(day);
+                calendar.set_business_day(day, true);
+            } else {
+                naive.holidays.insert(day);
+                naive.extra_days.erase(day);
+                calendar.set_business_day(day, false);
+            }
+        }
+        for (dse_t day = naive.first - 30; day <= naive.last + 30; ++day) {
+            assert(calendar.is_business_day(day) == naive.is_business(day));
+        }
+        for (int i = 0; i < 3000; ++i) {
+            const dse_t from = naive.first - 400 + static_cast<dse_t>(rng() % 3000);
+            const dse_t to = naive.first - 400 + static_cast<dse_t>(rng() % 3000);
+            assert(calendar.business_days_between(from, to) == naive.between(from, to));
+            const int64_t count = static_cast<int64_t>(rng() % 801) - 400;
+            assert(calendar.add_business_days(from, count) == naive.add(from, count));
+        }
+        const dse_t saturday = date_to_unix_day(2019, 12, 28);
+        assert(calendar.next_business_day(saturday) == naive.add(saturday, 1));
+        assert(calendar.prev_business_day(naive.last + 3) == naive.add(naive.last + 3, -1));
+        assert(calendar.roll_forward(saturday) == calendar.next_business_day(saturday));
+
+        bool is_thrown = false;
+        try {
+            calendar.set_business_day(naive.last + 1, true);
+        } catch (const std::out_of_range&) {
+            is_thrown = true;
+        }
+        assert(is_thrown);
+    }
+
+    // Custom weekend (Friday/Saturday) without a range.
+    {
+        BusinessCalendar calendar(0, -1, UTC,
+            static_cast<std::uint8_t>(BusinessCalendar::weekday_bit(FRI) | BusinessCalendar::weekday_bit(SAT)));
+        const dse_t friday = date_to_unix_day(2024, 3, 1);
+        assert(!calendar.is_business_day(friday));
+        assert(calendar.is_business_day(friday + 2));
+        assert(calendar.next_business_day(friday) == friday + 2);
+        assert(calendar.business_days_between(friday, friday + 14) == 10);
+        bool is_thrown = false;
+        try {
+            BusinessCalendar bad(0, 10, UTC, 0x7F);
+            (void)bad;
+        } catch (const std::invalid_argument&) {
+            is_thrown = true;
+        }
+        assert(is_thrown);
+    }
+
+    // Text file: holidays, half-days and session bounds in New York time across DST.
+    {
+        BusinessCalendar calendar;
+        std::istringstream text(NYSE_2024);
+        assert(calendar.load_text(text));
+        assert(calendar.zone() == ET);
+        assert(calendar.first_day() == date_to_unix_day(2024, 1, 1));
+        assert(!calendar.is_business_day(date_to_unix_day(2024, 7, 4)));
+        assert(calendar.is_business_day(date_to_unix_day(2024, 7, 5)));
+        assert(calendar.next_business_day(date_to_unix_day(2024, 7, 3)) == date_to_unix_day(2024, 7, 5));
+        assert(calendar.business_days_between(date_to_unix_day(2024, 1, 1), date_to_unix_day(2024, 2, 1)) == 21);
+
+        ts_ms_t open_ms = 0;
+        ts_ms_t close_ms = 0;
+        assert(calendar.session(date_to_unix_day(2024, 1, 2), open_ms, close_ms));
+        assert(open_ms == to_timestamp_ms(2024, 1, 2, 14, 30));
+        assert(close_ms == to_timestamp_ms(2024, 1, 2, 21));
+        assert(calendar.session(date_to_unix_day(2024, 7, 3), open_ms, close_ms));
+        assert(open_ms == to_timestamp_ms(2024, 7, 3, 13, 30));
+        assert(close_ms == to_timestamp_ms(2024, 7, 3, 17));
+        assert(!calendar.session(date_to_unix_day(2024, 12, 25), open_ms, close_ms));
+        assert(calendar.is_in_session(to_timestamp_ms(2024, 7, 3, 16, 59)));
+        assert(!calendar.is_in_session(to_timestamp_ms(2024, 7, 3, 17)));
+        assert(!calendar.is_in_session(to_timestamp_ms(2024, 7, 4, 15)));
+        assert(calendar.is_business_day_ms(to_timestamp_ms(2024, 7, 6, 2)));  // Friday evening in New York.
+
+        std::stringstream binary;
+        assert(calendar.save_binary(binary));
+        BusinessCalendar loaded;
+        assert(loaded.load_binary(binary));
+        assert(loaded.zone() == ET && loaded.first_day() == calendar.first_day() &&
+               loaded.last_day() == calendar.last_day());
+        for (dse_t day = calendar.first_day() - 10; day <= calendar.last_day() + 10; ++day) {
+            assert(loaded.is_business_day(day) == calendar.is_business_day(day));
+            assert(loaded.session_hours(day).open_ms == calendar.session_hours(day).open_ms);
+            assert(loaded.session_hours(day).close_ms == calendar.session_hours(day).close_ms);
+        }
+
+        // Malformed input leaves the calendar unchanged.
+        const char* const bad_inputs[] = {
+            "range 2024-01-01 2024-12-31\nholiday 2024-02-30\n",
+            "range 2024-01-01 2024-12-31\nsession 16:00 09:30\n",
+            "range 2024-01-01 2024-12-31\nholiday 2025-01-01\n",
+            "zone XYZ\nrange 2024-01-01 2024-12-31\n",
+            "holiday 2024-01-01\n",
+            "range 2024-01-01 2024-12-31\nunknown 1\n",
+            "range 2024-01-01 2024-12-31\nsession 2024-07-03 09:30 13:00\nsession 2024-07-03 09:30 14:00\n",
+        };
+        for (std::size_t i = 0; i < sizeof(bad_inputs) / sizeof(bad_inputs[0]); ++i) {
+            std::istringstream bad(bad_inputs[i]);
+            assert(!calendar.load_text(bad));
+        }
+        assert(calendar.zone() == ET && !calendar.is_business_day(date_to_unix_day(2024, 7, 4)));
+        std::string truncated = binary.str();
+        truncated.resize(truncated.size() - 1);
+        std::istringstream short_binary(truncated);
+        assert(!loaded.load_binary(short_binary));
+
+        // First days whose range or millisecond timestamps would overflow are rejected.
+        const uint64_t hostile_days[] = {UINT64_C(0x7FFFFFFFFFFFFFF0), UINT64_C(0x8000000000000000),
+                                         static_cast<uint64_t>(detail::BUSINESS_MAX_BINARY_FIRST_DAY + 1)};
+        for (std::size_t i = 0; i < sizeof(hostile_days) / sizeof(hostile_days[0]); ++i) {
+            std::string hostile = binary.str();
+            for (std::size_t b = 0; b < 8; ++b) {
+                hostile[12 + b] = static_cast<char>((hostile_days[i] >> (8 * b)) & 0xFFu);
+            }
+            std::istringstream hostile_binary(hostile);
+            assert(!loaded.load_binary(hostile_binary));
+        }
+        assert(loaded.first_day() == calendar.first_day());
+    }
+
+    // A duplicate session line is rejected, so every calendar loaded from text can be read back from binary.
+    {
+        const std::string text = std::string(NYSE_2024) + "session 2024-11-29 09:30 14:00\n";
+        std::istringstream duplicate(text);
+        BusinessCalendar calendar;
+        assert(!calendar.load_text(duplicate));
+        std::istringstream source(NYSE_2024);
+        assert(calendar.load_text(source));
+        std::stringstream binary;
+        assert(calendar.save_binary(binary));
+        BusinessCalendar loaded;
+        assert(loaded.load_binary(binary));
+        const dse_t half_day = date_to_unix_day(2024, 11, 29);
+        assert(loaded.session_hours(half_day).close_ms == calendar.session_hours(half_day).close_ms);
+        std::stringstream again;
+        assert(loaded.save_binary(again) && again.str() == binary.str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <time_shield/calendar_ranges.hpp>
+#include <time_shield/date_time_conversions.hpp>
+#include <time_shield/time_zone_conversions.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+    using namespace time_shield;
+
+    ts_ms_t local_to_utc(dse_t day, TimeZone zone) {
+        return zone == UTC ? day * MS_PER_DAY : zone_to_gmt_ms(day * MS_PER_DAY, zone);
+    }
+
+    bool is_period_start(dse_t day, CalendarRange::Unit unit) {
+        const DateTimeStruct date = to_date_time_ms<DateTimeStruct>(day * MS_PER_DAY);
+        const int weekday = static_cast<int>(day_of_week_date(date.year, date.mon, date.day));
+        switch (unit) {
+        case CalendarRange::Unit::Day:      return true;
+        case CalendarRange::Unit::Workday:  return weekday != SAT && weekday != SUN;
+        case CalendarRange::Unit::IsoWeek:  return weekday == MON;
+        case CalendarRange::Unit::Month:    return date.day == 1;
+        case CalendarRange::Unit::Year:     return date.day == 1 && date.mon == 1;
+        }
+        return false;
+    }
+
+    /// \brief Periods found by scanning local days one at a time.
+    std::vector<CalendarPeriod> reference(CalendarRange::Unit unit, ts_ms_t from_ms, ts_ms_t to_ms, TimeZone zone) {
+        std::vector<CalendarPeriod> out;
+        if (from_ms >= to_ms) {
+            return out;
+        }
+        const ts_ms_t local_ms = zone == UTC ? from_ms : gmt_to_zone_ms(from_ms, zone);
+        dse_t day = local_ms >= 0 ? local_ms / MS_PER_DAY : (local_ms + 1) / MS_PER_DAY - 1;
+        if (unit == CalendarRange::Unit::Workday) {
+            while (!is_period_start(day, unit)) ++day;
+        } else {
+            while (!is_period_start(day, unit)) --day;
+        }
+        while (local_to_utc(day, zone) < to_ms) {
+            const DateTimeStruct date = to_date_time_ms<DateTimeStruct>(day * MS_PER_DAY);
+            dse_t next = day + 1;
+            while (!is_period_start(next, unit)) ++next;
+            // A workday ends at the start of the following calendar day, not the next workday.
+            const dse_t end = unit == CalendarRange::Unit::Workday ? day + 1 : next;
+            out.push_back(CalendarPeriod{local_to_utc(day, zone), local_to_utc(end, zone),
+                                         date.year, date.mon, date.day});
+            day = next;
+        }
+        return out;
+    }
+
+    void check(CalendarRange::Unit unit, ts_ms_t from_ms, ts_ms_t to_ms, TimeZone zone) {
+        const std::vector<CalendarPeriod> expected = reference(unit, from_ms, to_ms, zone);
+        std::size_t i = 0;
+        for (const CalendarPeriod& period : CalendarRange(unit, from_ms, to_ms, zone)) {
+            assert(i < expected.size());
+            assert(period.start_ms == expected[i].start_ms && period.end_ms == expected[i].end_ms);
+            assert(period.year == expected[i].year && period.mon == expected[i].mon && period.day == expected[i].day);
+            ++i;
+        }
+        assert(i == expected.size());
+    }
+
+} // namespace
+
+/// \brief Checks the lazy calendar ranges against a day-by-day scan in UTC and DST zones.
+int main() {
+    const CalendarRange::Unit units[] = {
+        CalendarRange::Unit::Day, CalendarRange::Unit::Workday, CalendarRange::Unit::IsoWeek,
+        CalendarRange::Unit::Month, CalendarRange::Unit::Year
+    };
+    const TimeZone zones[] = {UTC, CET, ET, KST};
+
+    std::mt19937_64 rng(0x5bd1e9955bd1e995ULL);
+    for (int i = 0; i < 400; ++i) {
+        const CalendarRange::Unit unit = units[i % 5];
+        const TimeZone zone = zones[(i / 5) % 4];
+        // From 1900 to 2100; up to 3 years long, 60 years for the yearly range.
+        const ts_ms_t from = static_cast<ts_ms_t>(rng() % 6311433600000ULL) - 2208988800000LL;
+        const ts_ms_t length = unit == CalendarRange::Unit::Year ? 1893456000000LL : 94672800000LL;
+        const ts_ms_t to = from + static_cast<ts_ms_t>(rng() % static_cast<uint64_t>(length));
+        check(unit, from, to, zone);
+    }
+
+    // Boundaries, negative days and empty ranges.
+    for (std::size_t u = 0; u < 5; ++u) {
+        check(units[u], 0, 1, UTC);
+        check(units[u], -1, 0, UTC);
+        check(units[u], -MS_PER_DAY * 400, MS_PER_DAY * 400, UTC);
+        check(units[u], 5, 5, CET);
+        check(units[u], 10, 5, UTC);
+    }
+    assert(days(7, 7).begin() == days(7, 7).end());
+    assert(months(10, 5).begin() == months(10, 5).end());
+
+    // Central European DST days are 23 and 25 hours long.
+    {
+        const ts_ms_t from = to_timestamp_ms(2024, 3, 30);
+        std::vector<ts_ms_t> lengths;
+        for (const CalendarPeriod& day : local_days(from, from + 3 * MS_PER_DAY, CET)) {
+            lengths.push_back(day.end_ms - day.start_ms);
+        }
+        assert(lengths.size() == 4);
+        assert(lengths[1] == 23 * MS_PER_HOUR && lengths[2] == 24 * MS_PER_HOUR);
+        const ts_ms_t autumn = to_timestamp_ms(2024, 10, 27, 12);
+        const CalendarRange::iterator it = local_days(autumn, autumn + 1, CET).begin();
+        assert(it->day == 27 && it->end_ms - it->start_ms == 25 * MS_PER_HOUR);
+    }
+
+    // Workdays skip weekends; a range starting on Saturday begins on Monday.
+    {
+        std::vector<int> mdays;
+        for (const CalendarPeriod& day : workdays(to_timestamp_ms(2024, 6, 1), to_timestamp_ms(2024, 6, 11))) {
+            mdays.push_back(day.day);
+        }
+        const int expected[] = {3, 4, 5, 6, 7, 10};
+        assert(mdays.size() == 6);
+        for (std::size_t i = 0; i < mdays.size(); ++i) {
+            assert(mdays[i] == expected[i]);
+        }
+        // Friday covers one day; the weekend is not part of it.
+        CalendarRange::iterator friday = workdays(to_timestamp_ms(2024, 6, 7, 12), to_timestamp_ms(2024, 6, 11)).begin();
+        assert(friday->day == 7 && friday->end_ms == to_timestamp_ms(2024, 6, 8));
+        ++friday;
+        assert(friday->day == 10 && friday->start_ms == to_timestamp_ms(2024, 6, 10));
+        assert(friday->end_ms == to_timestamp_ms(2024, 6, 11));
+        assert(workdays(to_timestamp_ms(2024, 6, 1), to_timestamp_ms(2024, 6, 3)).begin() ==
+               workdays(to_timestamp_ms(2024, 6, 1), to_timestamp_ms(2024, 6, 3)).end());
+    }
+
+    // ISO weeks start on Monday; the first week of 2021 begins on 2021-01-04.
+    {
+        CalendarRange::iterator it = iso_weeks(to_timestamp_ms(2021, 1, 1), to_timestamp_ms(2021, 1, 5)).begin();
+        assert(it->year == 2020 && it->mon == 12 && it->day == 28);
+        CalendarRange::iterator previous = it++;
+        assert(previous->day == 28 && it->day == 4 && it->start_ms == to_timestamp_ms(2021, 1, 4));
+        assert(++it == iso_weeks(0, 1).end());
+    }
+
+    // Months and years report their first day.
+    {
+        const CalendarRange range = months(to_timestamp_ms(2023, 12, 15), to_timestamp_ms(2024, 3, 1));
+        std::vector<int> mons;
+        for (CalendarRange::iterator it = range.begin(); it != range.end(); ++it) {
+            assert(it->day == 1 && it->start_ms == to_timestamp_ms(it->year, it->mon, 1));
+            mons.push_back(it->mon);
+        }
+        assert(mons.size() == 3 && mons[0] == 12 && mons[1] == 1 && mons[2] == 2);
+        std::size_t count = 0;
+        for (const CalendarPeriod& year : years(to_timestamp_ms(1999, 6, 1), to_timestamp_ms(2001, 1, 1))) {
+            assert(year.end_ms - year.start_ms == (year.year == 2000 ? 366 : 365) * MS_PER_DAY);
+            ++count;
+        }
+        assert(count == 2);
+    }
+
+    bool thrown = false;
+    try {
+        months(0, 1, UNKNOWN);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#define TIME_SHIELD_ENABLE_CALENDAR_TABLES 1
+#include <time_shield/date_time_conversions.hpp>
+#include <time_shield/iso_week_conversions.hpp>
+#include <time_shield/validation.hpp>
+#include <time_shield/workday_conversions.hpp>
+
+#include <cassert>
+#include <cstdint>
+
+// The table is usable in constant expressions, so it exists before main().
+static_assert(time_shield::detail::calendar_table_entry(1970).year_start_day == 0, "1970-01-01 is Unix day 0");
+static_assert(time_shield::detail::calendar_table_entry(1970).jan1_weekday == 4, "1970-01-01 is a Thursday");
+static_assert(time_shield::detail::calendar_table_entry(2024).is_leap == 1, "2024 is a leap year");
+static_assert(time_shield::detail::calendar_table_entry(2100).is_leap == 0, "2100 is not a leap year");
+static_assert(time_shield::detail::calendar_table_entry(2020).iso_weeks == 53, "ISO 2020 has 53 weeks");
+static_assert(!time_shield::detail::calendar_table_contains(TIME_SHIELD_CALENDAR_TABLE_MAX_YEAR + 1),
+              "Years after the range use arithmetic");
+
+namespace {
+
+    using namespace time_shield;
+
+    /// \brief Reference ISO week date computed through the Thursday of the week.
+    IsoWeekDateStruct reference_iso_week_date(year_t year, int month, int day) {
+        const dse_t unix_day = date_to_unix_day(year, month, day);
+        const int weekday = iso_weekday_of_date(year, month, day);
+        const dse_t thursday = unix_day + (4 - weekday);
+        const year_t iso_year = to_date_time<DateTimeStruct>(unix_day_to_ts(thursday)).year;
+        const dse_t jan4 = date_to_unix_day(iso_year, 1, 4);
+        const dse_t first_thursday = jan4 + (4 - iso_weekday_of_date(iso_year, 1, 4));
+        return create_iso_week_date_struct(
+            iso_year, static_cast<int32_t>((thursday - first_thursday) / 7 + 1), static_cast<int32_t>(weekday));
+    }
+
+} // namespace
+
+/// \brief Checks table-backed calendar helpers against arithmetic references inside and outside the range.
+int main() {
+    for (year_t year = TIME_SHIELD_CALENDAR_TABLE_MIN_YEAR - 5; year <= TIME_SHIELD_CALENDAR_TABLE_MAX_YEAR + 5; ++year) {
+        assert(start_of_year_date(year) == to_timestamp(year, 1, 1));
+        const IsoWeekDateStruct dec28 = reference_iso_week_date(year, 12, 28);
+        assert(iso_weeks_in_year(year) == dec28.week);
+
+        for (int month = 1; month <= 12; ++month) {
+            const int days = num_days_in_month(year, month);
+            int first = 0;
+            int last = 0;
+            int last_sunday = 0;
+            for (int day = 1; day <= days; ++day) {
+                if (is_workday(year, month, day)) {
+                    first = first == 0 ? day : first;
+                    last = day;
+                }
+                if (day_of_week_date(year, month, day) == SUN) {
+                    last_sunday = day;
+                }
+                const IsoWeekDateStruct iso = to_iso_week_date(year, month, day);
+                const IsoWeekDateStruct expected = reference_iso_week_date(year, month, day);
+                assert(iso.year == expected.year && iso.week == expected.week && iso.weekday == expected.weekday);
+            }
+            assert(first_workday_day(year, month) == first);
+            assert(last_workday_day(year, month) == last);
+            assert(last_sunday_month_day(year, month) == last_sunday);
+        }
+        assert(first_workday_day(year, 0) == 0);
+        assert(last_workday_day(year, 13) == 0);
+    }
+    return 0;
+}
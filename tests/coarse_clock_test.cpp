@@ -0,0 +1,98 @@
+#include <time_shield/config.hpp>
+
+#if TIME_SHIELD_ENABLE_NTP_CLIENT
+#   define TIME_SHIELD_TEST_FAKE_NTP
+#endif
+#include <time_shield/CoarseClock.hpp>
+#include <time_shield/time_utils.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+    /// \brief Prints average cost of one read for the supplied function.
+    template<class F>
+    void bench_read(const char* label, F read) {
+        const int iterations = 1000000;
+        std::int64_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink += static_cast<std::int64_t>(read());
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const double ns_per_read = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+        std::cout << label << ": " << ns_per_read << " ns/read" << (sink == 0 ? " " : "") << '\n';
+    }
+
+} // namespace
+
+/// \brief Checks kernel coarse reads and the background ticker.
+int main() {
+    using namespace time_shield;
+
+    // Kernel coarse clocks stay within a few scheduler ticks of the precise clocks.
+    assert(std::llabs(CoarseClock::kernel_realtime_ms() - ts_ms()) <= 20);
+    assert(std::llabs(CoarseClock::kernel_monotonic_ms() - monotonic_ms()) <= 20);
+
+    CoarseClock clock;
+    assert(!clock.running());
+    assert(!clock.use_ntp());
+    assert(std::llabs(clock.utc_ms() - ts_ms()) <= 20);
+    assert(std::llabs(static_cast<std::int64_t>(clock.utc_sec()) - static_cast<std::int64_t>(ts())) <= 1);
+
+    // Ticker publishes fresh values and never moves monotonic time backwards.
+    assert(clock.start(std::chrono::milliseconds(2)));
+    assert(!clock.start());
+    assert(clock.running());
+    assert(clock.resolution() == std::chrono::milliseconds(2));
+    ts_ms_t previous = clock.monotonic_ms();
+    const ts_ms_t first_utc = clock.utc_ms();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    while (std::chrono::steady_clock::now() < deadline) {
+        const ts_ms_t current = clock.monotonic_ms();
+        assert(current >= previous);
+        previous = current;
+        assert(std::llabs(clock.utc_ms() - ts_ms()) <= 50);
+    }
+    assert(clock.utc_ms() > first_utc);
+    assert(std::llabs(clock.monotonic_ms() - monotonic_ms()) <= 50);
+    bench_read("CoarseClock::utc_ms (ticker)", [&clock]() { return clock.utc_ms(); });
+    clock.stop();
+    assert(!clock.running());
+    clock.stop();
+    bench_read("CoarseClock::utc_ms (kernel)", [&clock]() { return clock.utc_ms(); });
+    bench_read("ts_ms", []() { return ts_ms(); });
+
+#if TIME_SHIELD_ENABLE_NTP_CLIENT
+    // NTP offset is added to both reading paths.
+    assert(ntp::init(std::chrono::milliseconds(10), true));
+    const auto ntp_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (ntp::offset_us() < 1000 && std::chrono::steady_clock::now() < ntp_deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    clock.set_use_ntp(true);
+    assert(clock.use_ntp());
+    const ts_ms_t offset_ms = static_cast<ts_ms_t>(ntp::offset_us() / US_PER_MS);
+    assert(offset_ms >= 1);
+    assert(std::llabs(clock.utc_ms() - (ts_ms() + offset_ms)) <= 50);
+    assert(clock.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    assert(std::llabs(clock.utc_ms() - (ts_ms() + ntp::offset_us() / US_PER_MS)) <= 50);
+    clock.stop();
+    clock.set_use_ntp(false);
+    ntp::shutdown();
+#endif
+
+    // The shared instance is immortal and can keep its ticker running.
+    CoarseClock& shared = CoarseClock::instance();
+    assert(&shared == &CoarseClock::instance());
+    assert(shared.start());
+    assert(shared.running());
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <time_shield/CpuProfiler.hpp>
+#include <time_shield/CpuTickTimer.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /// \brief Burns CPU on the calling thread until its own CPU time has advanced by the given duration.
+    ///
+    /// Measuring thread CPU time instead of wall time keeps the amount of work
+    /// fixed when the test shares the machine with other processes.
+    double spin_for(std::chrono::milliseconds duration) {
+        const double target_sec = std::chrono::duration<double>(duration).count();
+        const double start = time_shield::get_thread_cpu_time();
+        const auto deadline = std::chrono::steady_clock::now() + duration;
+        volatile double sink = 0.0;
+        for (;;) {
+            for (int i = 0; i < 1000; ++i) {
+                sink = sink + std::sqrt(static_cast<double>(i));
+            }
+            const double now = time_shield::get_thread_cpu_time();
+            if (std::isnan(now) ? std::chrono::steady_clock::now() >= deadline : now - start >= target_sec) {
+                return sink;
+            }
+        }
+    }
+
+} // namespace
+
+/// \brief Checks per-thread CPU clocks and multi-thread CPU profiling.
+int main() {
+    using namespace time_shield;
+
+    const double thread_start = get_thread_cpu_time();
+    assert(!std::isnan(thread_start));
+    spin_for(std::chrono::milliseconds(20));
+    assert(get_thread_cpu_time() - thread_start > 0.005);
+
+    // A thread clock ignores work done by other threads, the process clock does not.
+    CpuTickTimer thread_timer(true, CpuClockScope::Thread);
+    CpuTickTimer process_timer(true, CpuClockScope::Process);
+    assert(thread_timer.scope() == CpuClockScope::Thread);
+    assert(process_timer.scope() == CpuClockScope::Process);
+    std::thread busy([]() { spin_for(std::chrono::milliseconds(80)); });
+    busy.join();
+    thread_timer.stop();
+    process_timer.stop();
+    std::cout << "thread CPU: " << thread_timer.elapsed() << " s, process CPU: " << process_timer.elapsed() << " s\n";
+    assert(thread_timer.elapsed() < 0.03);
+    assert(process_timer.elapsed() > 0.04);
+
+    const CpuUsage usage = get_thread_cpu_usage();
+#if defined(RUSAGE_THREAD) || TIME_SHIELD_PLATFORM_WINDOWS
+    assert(usage.user_sec >= 0.0 && usage.system_sec >= 0.0);
+    assert(usage.user_sec + usage.system_sec > 0.005);
+#else
+    (void)usage;
+#endif
+
+    // Stages recorded from many threads are aggregated into one report.
+    enum { STAGE_COMPUTE, STAGE_WAIT, STAGE_COUNT };
+    CpuProfiler profiler({"compute", "wait"}, true, 4);
+    assert(profiler.stage_count() == STAGE_COUNT);
+    assert(profiler.stage_name(STAGE_WAIT) == "wait");
+    assert(profiler.is_usage_split());
+
+    const int thread_count = 6;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&profiler]() {
+            {
+                ScopedCpuProfile sample(profiler, STAGE_COMPUTE);
+                spin_for(std::chrono::milliseconds(30));
+            }
+            {
+                ScopedCpuProfile sample(profiler, STAGE_WAIT);
+                std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            }
+            ScopedCpuProfile dismissed(profiler, STAGE_WAIT);
+            dismissed.dismiss();
+        });
+    }
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+    profiler.record(STAGE_COUNT, 1, 1);
+
+    const std::vector<CpuStageReport> report = profiler.report();
+    assert(report.size() == STAGE_COUNT);
+    const CpuStageReport& compute = report[STAGE_COMPUTE];
+    const CpuStageReport& wait = report[STAGE_WAIT];
+    for (std::size_t i = 0; i < report.size(); ++i) {
+        std::cout << report[i].name << ": samples " << report[i].sample_count
+                  << ", cpu " << report[i].cpu_sec << " s (user " << report[i].user_sec
+                  << ", system " << report[i].system_sec << "), wall " << report[i].wall_sec
+                  << " s, utilization " << report[i].cpu_utilization() << '\n';
+    }
+    assert(compute.name == "compute");
+    assert(compute.cpu_utilization() > wait.cpu_utilization());
+    assert(compute.sample_count == static_cast<std::uint64_t>(thread_count));
+    assert(wait.sample_count == static_cast<std::uint64_t>(thread_count));
+    assert(compute.wall_sec >= 0.03 * thread_count * 0.99);
+    assert(compute.cpu_sec > 0.0);
+    assert(compute.max_cpu_sec <= compute.cpu_sec && compute.max_cpu_sec > 0.0);
+    assert(wait.wall_sec >= 0.03 * thread_count * 0.99);
+    assert(wait.cpu_utilization() < 0.2);
+    assert(std::fabs(compute.average_cpu_sec() - compute.cpu_sec / thread_count) < 1e-9);
+#if defined(RUSAGE_THREAD) || TIME_SHIELD_PLATFORM_WINDOWS
+    assert(compute.user_sec + compute.system_sec > 0.0);
+#endif
+
+    profiler.reset();
+    const std::vector<CpuStageReport> cleared = profiler.report();
+    assert(cleared[STAGE_COMPUTE].sample_count == 0);
+    assert(cleared[STAGE_COMPUTE].cpu_sec == 0.0);
+    assert(std::isnan(cleared[STAGE_COMPUTE].average_cpu_sec()));
+    assert(std::isnan(cleared[STAGE_WAIT].cpu_utilization()));
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include <time_shield/date_time_conversions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    bool is_bit_set(const std::vector<uint64_t>& mask, std::size_t i) {
+        return ((mask[i / 64] >> (i % 64)) & 1U) != 0;
+    }
+
+} // namespace
+
+/// \brief Checks to_timestamp_ms_batch() against dt_to_timestamp_ms() for columns and structs.
+int main() {
+    using namespace time_shield;
+
+    std::mt19937_64 rng(0x452821e638d01377ULL);
+    const std::size_t count = 2051; // Several blocks and a partial one.
+
+    // Valid rows from -9999 to 9999, including leap days and pre-epoch times.
+    std::vector<DateTimeStruct> rows;
+    for (std::size_t i = 0; i < count; ++i) {
+        const int64_t year = -9999 + static_cast<int64_t>(rng() % 19999);
+        const int mon = 1 + static_cast<int>(rng() % 12);
+        const int day = 1 + static_cast<int>(rng() % static_cast<uint64_t>(num_days_in_month(year, mon)));
+        rows.push_back(create_date_time_struct(
+                year, mon, day,
+                static_cast<int>(rng() % 24),
+                static_cast<int>(rng() % 60),
+                static_cast<int>(rng() % 60),
+                static_cast<int>(rng() % 1000)));
+    }
+    rows[0] = create_date_time_struct(1970, 1, 1);
+    rows[1] = create_date_time_struct(1969, 12, 31, 23, 59, 59, 999);
+    rows[2] = create_date_time_struct(2000, 2, 29, 12);
+    rows[3] = create_date_time_struct(-4, 2, 29);
+    rows[4] = create_date_time_struct(0, 3, 1);
+    rows[5] = create_date_time_struct(-1, 1, 1);
+
+    std::vector<int64_t> year(count);
+    std::vector<int> mon(count);
+    std::vector<int> day(count);
+    std::vector<int> hour(count);
+    std::vector<int> min(count);
+    std::vector<int> sec(count);
+    std::vector<int> ms(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        year[i] = rows[i].year;
+        mon[i] = rows[i].mon;
+        day[i] = rows[i].day;
+        hour[i] = rows[i].hour;
+        min[i] = rows[i].min;
+        sec[i] = rows[i].sec;
+        ms[i] = rows[i].ms;
+    }
+    DateTimeColumns columns;
+    columns.year = year.data();
+    columns.mon = mon.data();
+    columns.day = day.data();
+    columns.hour = hour.data();
+    columns.min = min.data();
+    columns.sec = sec.data();
+    columns.ms = ms.data();
+
+    std::vector<ts_ms_t> expected(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        expected[i] = dt_to_timestamp_ms(rows[i]);
+    }
+    assert(expected[0] == 0 && expected[1] == -1);
+
+    std::vector<ts_ms_t> out(count, 0);
+    to_timestamp_ms_batch(columns, out.data(), count);
+    assert(out == expected);
+
+    std::fill(out.begin(), out.end(), 0);
+    to_timestamp_ms_batch(rows.data(), out.data(), count);
+    assert(out == expected);
+
+    std::vector<uint64_t> mask((count + 63) / 64, ~0ULL);
+    assert(to_timestamp_ms_batch(columns, out.data(), count, mask.data()) == 0);
+    assert(out == expected);
+    for (std::size_t w = 0; w < mask.size(); ++w) {
+        assert(mask[w] == 0);
+    }
+    assert(to_timestamp_ms_batch(rows.data(), out.data(), count, nullptr) == 0);
+    assert(out == expected);
+
+    // Optional time columns read as midnight.
+    DateTimeColumns dates_only;
+    dates_only.year = year.data();
+    dates_only.mon = mon.data();
+    dates_only.day = day.data();
+    to_timestamp_ms_batch(dates_only, out.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        assert(out[i] == to_timestamp_ms(year[i], mon[i], day[i]));
+    }
+
+    // Invalid rows are flagged and written as ERROR_TIMESTAMP; the rest are untouched.
+    std::vector<DateTimeStruct> mixed(rows);
+    mixed[7].mon = 13;
+    mixed[300].day = 0;
+    mixed[301] = create_date_time_struct(2023, 2, 29);
+    mixed[302] = create_date_time_struct(2024, 4, 31);
+    mixed[700].hour = 24;
+    mixed[701].min = -1;
+    mixed[702].sec = 60;
+    mixed[1500].ms = 1000;
+    mixed[2050].mon = 0;
+    std::vector<std::size_t> bad_indices;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!is_valid_date_time(mixed[i])) {
+            bad_indices.push_back(i);
+        }
+    }
+    assert(bad_indices.size() == 9);
+    std::fill(mask.begin(), mask.end(), 0);
+    assert(to_timestamp_ms_batch(mixed.data(), out.data(), count, mask.data()) == bad_indices.size());
+    for (std::size_t i = 0, b = 0; i < count; ++i) {
+        const bool is_bad = b < bad_indices.size() && bad_indices[b] == i;
+        if (is_bad) {
+            ++b;
+            assert(is_bit_set(mask, i) && out[i] == ERROR_TIMESTAMP);
+        } else {
+            assert(!is_bit_set(mask, i) && out[i] == expected[i]);
+        }
+    }
+    assert((mask.back() >> (count % 64)) == 0);
+
+    // Blocks with years beyond the 32-bit lanes take the scalar path.
+    std::vector<DateTimeStruct> wide(rows.begin(), rows.begin() + 300);
+    wide[10] = create_date_time_struct(250000000, 6, 15, 1, 2, 3, 4);
+    wide[11] = create_date_time_struct(-250000000, 6, 15);
+    wide[12] = create_date_time_struct(MAX_YEAR, 1, 1);
+    wide[13] = create_date_time_struct(250000000, 2, 30);
+    std::vector<ts_ms_t> wide_out(wide.size());
+    std::vector<uint64_t> wide_mask((wide.size() + 63) / 64);
+    assert(to_timestamp_ms_batch(wide.data(), wide_out.data(), wide.size(), wide_mask.data()) == 2);
+    assert(wide_out[10] == dt_to_timestamp_ms(wide[10]));
+    assert(wide_out[11] == dt_to_timestamp_ms(wide[11]));
+    assert(wide_out[12] == ERROR_TIMESTAMP && is_bit_set(wide_mask, 12));
+    assert(wide_out[13] == ERROR_TIMESTAMP && is_bit_set(wide_mask, 13));
+    for (std::size_t i = 0; i < wide.size(); ++i) {
+        if (i < 10 || i > 13) {
+            assert(wide_out[i] == expected[i] && !is_bit_set(wide_mask, i));
+        }
+    }
+    to_timestamp_ms_batch(wide.data(), wide_out.data(), wide.size());
+    assert(wide_out[10] == dt_to_timestamp_ms(wide[10]) && wide_out[299] == expected[299]);
+
+    to_timestamp_ms_batch(rows.data(), out.data(), 0);
+    return 0;
+}
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <string>
+#include <type_traits>
 
 /// \brief Tests for DateTime wrapper utilities.
 int main() {
@@ -204,5 +205,48 @@ int main() {
         expect(start_day.utc_offset() == dt.utc_offset(), "UTC boundary helpers should preserve stored offset");
     }
 
+    {
+        static_assert(std::is_trivially_copyable<DateTime>::value, "DateTime should stay trivially copyable");
+        static_assert(sizeof(DateTime) <= 2 * sizeof(ts_ms_t), "DateTime should hold only the instant and offset");
+
+        const ts_ms_t samples[] = {
+            0, -1, -86400001, 1704067199999, 951782400000, -62135596800000, 4102444800123};
+        const tz_t offsets[] = {0, 19800, -36000};
+        for (std::size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i) {
+            for (std::size_t j = 0; j < sizeof(offsets) / sizeof(offsets[0]); ++j) {
+                const DateTime dt = DateTime::from_unix_ms(samples[i], offsets[j]);
+                const DateTimeStruct local = dt.to_date_time_struct_local();
+                const DateTimeStruct utc = dt.to_date_time_struct_utc();
+                expect(dt.hour() == local.hour && dt.minute() == local.min
+                       && dt.second() == local.sec && dt.millisecond() == local.ms,
+                       "Local time getters should match local structure");
+                expect(dt.utc_hour() == utc.hour && dt.utc_minute() == utc.min
+                       && dt.utc_second() == utc.sec && dt.utc_millisecond() == utc.ms,
+                       "UTC time getters should match UTC structure");
+
+                const DateTimeView view = dt.view();
+                expect(!view.is_utc() && view.date_time() == dt, "Local view should keep source value");
+                expect(view.year() == dt.year() && view.month() == dt.month() && view.day() == dt.day(),
+                       "Local view date fields should match DateTime getters");
+                expect(view.hour() == dt.hour() && view.minute() == dt.minute()
+                       && view.second() == dt.second() && view.millisecond() == dt.millisecond(),
+                       "Local view time fields should match DateTime getters");
+                expect(view.weekday() == dt.weekday() && view.iso_weekday() == dt.iso_weekday(),
+                       "Local view weekday should match DateTime getters");
+                expect(view.iso_week_date().week == dt.iso_week_date().week, "Local view ISO week should match");
+                expect(view.is_workday() == is_workday(local.year, local.mon, local.day),
+                       "Local view workday flag should match calendar helper");
+
+                const DateTimeView utc_view = dt.utc_view();
+                expect(utc_view.is_utc(), "UTC view should report UTC fields");
+                expect(utc_view.year() == dt.utc_year() && utc_view.month() == dt.utc_month()
+                       && utc_view.day() == dt.utc_day() && utc_view.hour() == dt.utc_hour()
+                       && utc_view.millisecond() == dt.utc_millisecond(),
+                       "UTC view fields should match UTC getters");
+                expect(utc_view.weekday() == dt.utc_weekday(), "UTC view weekday should match");
+            }
+        }
+    }
+
     return all_ok ? 0 : 1;
 }
@@ -0,0 +1,188 @@
+#include <time_shield/julian_conversions.hpp>
+#include <time_shield/ole_automation_conversions.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Equal values, or both NaN.
+    bool same_value(double a, double b) {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    }
+
+} // namespace
+
+/// \brief Checks the batch Julian/MJD/JDN/OA date kernels against the scalar functions and round trips.
+int main() {
+    using namespace time_shield;
+
+    std::mt19937_64 rng(0x13198a2e03707344ULL);
+    const std::size_t count = 3001; // Not a multiple of the vector width or block size.
+
+    // Explicit SIMD floor/trunc against the scalar OA helpers.
+    {
+        std::vector<double> values;
+        const double specials[] = {
+            0.0, -0.0, 0.5, -0.5, 1.0, -1.0, -1e-300, 1e-300, 2.5, -2.5, 4503599627370495.5,
+            -4503599627370495.5, 4503599627370496.0, 9007199254740993.0, -1e300,
+            std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::quiet_NaN(),
+        };
+        values.assign(specials, specials + sizeof(specials) / sizeof(specials[0]));
+        while (values.size() < count) {
+            values.push_back((static_cast<double>(rng() >> 11) / 9007199254740992.0 - 0.5) * 200000.0);
+        }
+        std::vector<double> floored(values.size());
+        std::vector<double> truncated(values.size());
+        detail::oadate_floor_values(values.data(), floored.data(), values.size());
+        detail::oadate_trunc_toward_zero_values(values.data(), truncated.data(), values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            assert(same_value(floored[i], std::floor(values[i])));
+            assert(same_value(truncated[i], std::trunc(values[i])));
+            if (std::isfinite(values[i])) {
+                assert(floored[i] == detail::oadate_floor_value(values[i]));
+                assert(truncated[i] == detail::oadate_trunc_toward_zero(values[i]));
+            }
+        }
+    }
+
+    // Exact int64 to double conversion.
+    {
+        const int64_t specials[] = {
+            0, 1, -1, (std::numeric_limits<int64_t>::max)(), (std::numeric_limits<int64_t>::min)(),
+            9007199254740993LL, -9007199254740993LL, 4294967295LL, -4294967296LL,
+        };
+        for (std::size_t i = 0; i < sizeof(specials) / sizeof(specials[0]); ++i) {
+            assert(detail::int64_to_double(specials[i]) == static_cast<double>(specials[i]));
+        }
+        for (int i = 0; i < 10000; ++i) {
+            const int64_t value = static_cast<int64_t>(rng());
+            assert(detail::int64_to_double(value) == static_cast<double>(value));
+            assert(detail::int64_to_double(value >> 20) == static_cast<double>(value >> 20));
+        }
+    }
+
+    // Timestamps from 1600 to 2400, both sides of the OA base date.
+    std::vector<ts_t> ts(count);
+    std::vector<ts_ms_t> ts_ms(count);
+    std::vector<fts_t> fts(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ts[i] = -11676096000LL + static_cast<ts_t>(rng() % 25245000000ULL);
+        ts_ms[i] = ts[i] * 1000 + static_cast<ts_ms_t>(rng() % 1000);
+        fts[i] = static_cast<fts_t>(ts_ms[i]) / 1000.0;
+    }
+    ts[0] = 0;
+    ts[1] = -2209161600LL;        // 1899-12-30, OA 0.0
+    ts[2] = -2209161600LL - 3600; // 1899-12-29 23:00, OA -1.958
+    fts[3] = std::numeric_limits<double>::infinity();
+    fts[4] = -std::numeric_limits<double>::infinity();
+
+    // Julian dates and MJD.
+    {
+        std::vector<jd_t> jd(count);
+        fts_to_jd(fts.data(), jd.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(same_value(jd[i], fts_to_jd(fts[i])));
+        }
+        ts_to_jd(ts.data(), jd.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(jd[i] == ts_to_jd(ts[i]));
+        }
+        fts_to_mjd(fts.data(), jd.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(same_value(jd[i], fts_to_mjd(fts[i])));
+        }
+        ts_to_mjd(ts.data(), jd.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(jd[i] == ts_to_mjd(ts[i]));
+        }
+        std::vector<fts_t> in_place(fts);
+        fts_to_jd(in_place.data(), in_place.data(), count);
+        assert(in_place[7] == fts_to_jd(fts[7]));
+    }
+
+    // Julian Day Numbers, including blocks that need the 64-bit fallback.
+    {
+        std::vector<year_t> years(count);
+        std::vector<int> months(count);
+        std::vector<int> days(count);
+        std::vector<uint32_t> years_u(count);
+        std::vector<uint32_t> months_u(count);
+        std::vector<uint32_t> days_u(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            years[i] = -6000 + static_cast<year_t>(rng() % 12000);
+            months[i] = 1 + static_cast<int>(rng() % 12);
+            days[i] = 1 + static_cast<int>(rng() % 28);
+            years_u[i] = static_cast<uint32_t>(rng() % 10000);
+            months_u[i] = static_cast<uint32_t>(months[i]);
+            days_u[i] = static_cast<uint32_t>(days[i]);
+        }
+        years[2000] = 123456789012LL;
+        years_u[2500] = 4000000000u;
+        std::vector<jdn_t> jdn(count);
+        gregorian_ymd_to_jdn(years.data(), months.data(), days.data(), jdn.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(jdn[i] == detail::gregorian_dmy_to_jdn_unchecked(days[i], months[i], years[i]));
+        }
+        gregorian_to_jdn(days_u.data(), months_u.data(), years_u.data(), jdn.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(jdn[i] == gregorian_to_jdn(days_u[i], months_u[i], years_u[i]));
+        }
+        const year_t y2000 = 2000;
+        const int jan = 1;
+        const int first = 1;
+        jdn_t single = 0;
+        gregorian_ymd_to_jdn(&y2000, &jan, &first, &single, 1);
+        assert(single == 2451545ULL);
+    }
+
+    // OA dates: batch equals scalar, and round trips back to the timestamps.
+    {
+        std::vector<oadate_t> oa(count);
+        std::vector<ts_t> ts_back(count);
+        ts_to_oadate(ts.data(), oa.data(), count);
+        oadate_to_ts(oa.data(), ts_back.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(oa[i] == ts_to_oadate(ts[i]));
+            assert(ts_back[i] == oadate_to_ts(oa[i]));
+            assert(std::llabs(ts_back[i] - ts[i]) <= 1);
+        }
+        assert(oa[1] == 0.0 && oa[2] < -1.0 && oa[2] > -2.0);
+
+        std::vector<ts_ms_t> ms_back(count);
+        ts_ms_to_oadate(ts_ms.data(), oa.data(), count);
+        oadate_to_ts_ms(oa.data(), ms_back.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(oa[i] == ts_ms_to_oadate(ts_ms[i]));
+            assert(ms_back[i] == oadate_to_ts_ms(oa[i]));
+            assert(std::llabs(ms_back[i] - ts_ms[i]) <= 1);
+        }
+
+        std::vector<fts_t> fts_back(count);
+        fts_to_oadate(fts.data(), oa.data(), count);
+        oadate_to_fts(oa.data(), fts_back.data(), count);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(same_value(oa[i], fts_to_oadate(fts[i])));
+            assert(same_value(fts_back[i], oadate_to_fts(oa[i])));
+            if (std::isfinite(fts[i])) {
+                assert(std::fabs(fts_back[i] - fts[i]) < 1e-4);
+            }
+        }
+
+        // Excel semantics for negative serials in a batch.
+        const oadate_t serials[] = {-1.25, -1.75, -0.25, 0.25};
+        ts_t seconds[4];
+        oadate_to_ts(serials, seconds, 4);
+        assert(seconds[0] == to_timestamp(1899, 12, 29, 6));
+        assert(seconds[1] == to_timestamp(1899, 12, 29, 18));
+        assert(seconds[2] == seconds[3]);
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <time_shield/LatencyHistogram.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/// \brief Checks bucket layout, percentiles, merging and concurrent recording.
+int main() {
+    using namespace time_shield;
+
+    // Buckets are contiguous and keep the documented relative precision.
+    assert(LatencySnapshot::bucket_index(-5) == 0);
+    assert(LatencySnapshot::bucket_index(127) == 127);
+    assert(LatencySnapshot::bucket_index(128) == 128);
+    assert(LatencySnapshot::bucket_index(LatencySnapshot::max_trackable_ns()) == LatencySnapshot::BUCKET_COUNT - 1);
+    assert(LatencySnapshot::bucket_index(LatencySnapshot::max_trackable_ns() + 1000) == LatencySnapshot::BUCKET_COUNT - 1);
+    for (std::size_t i = 1; i < LatencySnapshot::BUCKET_COUNT; ++i) {
+        const std::int64_t lowest = LatencySnapshot::bucket_lowest_ns(i);
+        assert(lowest == LatencySnapshot::bucket_highest_ns(i - 1) + 1);
+        assert(LatencySnapshot::bucket_index(lowest) == i);
+        assert(LatencySnapshot::bucket_index(LatencySnapshot::bucket_highest_ns(i)) == i);
+        const std::int64_t width = LatencySnapshot::bucket_highest_ns(i) - lowest + 1;
+        assert(width * 64 <= lowest || lowest < 128);
+    }
+    assert(LatencySnapshot::bucket_highest_ns(LatencySnapshot::BUCKET_COUNT - 1) == LatencySnapshot::max_trackable_ns());
+
+    // Percentiles of a uniform distribution stay within bucket precision.
+    LatencySnapshot uniform;
+    for (std::int64_t v = 1; v <= 100000; ++v) {
+        uniform.add(v * 10);
+    }
+    assert(uniform.count() == 100000);
+    const std::int64_t p50 = uniform.percentile_ns(50.0);
+    const std::int64_t p99 = uniform.percentile_ns(99.0);
+    assert(p50 >= 500000 && p50 <= 500000 + 500000 / 64);
+    assert(p99 >= 990000 && p99 <= 990000 + 990000 / 64);
+    assert(uniform.percentile_ns(100.0) == uniform.max_ns());
+    assert(uniform.min_ns() == 10);
+    assert(uniform.max_ns() >= 1000000);
+    assert(uniform.mean_ns() > 500004.0 && uniform.mean_ns() < 500006.0);
+    assert(LatencySnapshot().percentile_ns(99.0) == 0);
+
+    // Snapshots merge additively.
+    LatencySnapshot slow;
+    slow.add(5000000, 100000);
+    slow.merge(uniform);
+    assert(slow.count() == 200000);
+    assert(slow.percentile_ns(25.0) <= 500000 + 500000 / 64);
+    assert(slow.percentile_ns(75.0) >= 5000000);
+
+    // Concurrent recording from many threads loses no values.
+    LatencyHistogram histogram(4);
+    assert(histogram.shard_count() == 4);
+    const int thread_count = 8;
+    const int per_thread = 50000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&histogram, t, per_thread]() {
+            for (int i = 0; i < per_thread; ++i) {
+                histogram.record(static_cast<std::int64_t>(t * 1000 + i % 1000));
+            }
+        });
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+    const LatencySnapshot concurrent = histogram.snapshot();
+    assert(concurrent.count() == static_cast<std::uint64_t>(thread_count) * per_thread);
+    assert(concurrent.min_ns() == 0);
+    assert(concurrent.max_ns() >= 7999);
+    histogram.record(std::chrono::microseconds(3));
+    assert(histogram.snapshot().bucket_count(LatencySnapshot::bucket_index(3000)) >= 1);
+    histogram.reset();
+    assert(histogram.snapshot().count() == 0);
+
+    // Scoped timers record on destruction unless dismissed.
+    {
+        ScopedLatencyTimer scoped(histogram);
+        assert(scoped.timer().is_running());
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    {
+        ScopedLatencyTimer dismissed(histogram);
+        dismissed.dismiss();
+    }
+    const LatencySnapshot scoped_snapshot = histogram.snapshot();
+    assert(scoped_snapshot.count() == 1);
+    assert(scoped_snapshot.min_ns() >= 1900000);
+
+    // Recording cost, single thread.
+    LatencyHistogram bench(8);
+    const int iterations = 2000000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        bench.record(static_cast<std::int64_t>(i & 0xFFFFF));
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "LatencyHistogram::record: "
+              << static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations
+              << " ns/op, p99 of recorded values: " << bench.snapshot().percentile_ns(99.0) << " ns\n";
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <time_shield/LunationTable.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/// \brief Checks that LunationTable answers exactly like MoonPhase inside and outside its range.
+int main() {
+    using namespace time_shield;
+
+    const astronomy::MoonPhase calculator{};
+    const double from = 946684800.0;   // 2000-01-01
+    const double to = 2524608000.0;    // 2050-01-01
+    const astronomy::LunationTable table(from, to);
+    assert(table.contains(from) && table.contains(to));
+    assert(table.first_unix_s() < from && table.end_unix_s() > to);
+    assert(table.lunation_count() > 600 && table.lunation_count() < 630);
+
+    std::vector<double> samples;
+    std::mt19937_64 rng(0x452821e638d01377ULL);
+    for (int i = 0; i < 20000; ++i) {
+        const uint64_t bits = rng();
+        samples.push_back(from - 40.0 * 86400.0 + static_cast<double>(bits >> 11) / 9007199254740992.0
+                          * (to - from + 80.0 * 86400.0));
+    }
+    // Timestamps right around new moons, where the lunation boundary is decided.
+    for (double ts = from; ts < to; ts += 86400.0 * 97.0) {
+        const double new_moon = calculator.quarter_times_unix(ts)[4];
+        const double offsets[] = {-65000.0, -3600.0, -1.0, 0.0, 1.0, 3600.0, 65000.0};
+        for (std::size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); ++i) {
+            samples.push_back(new_moon + offsets[i]);
+        }
+    }
+    // Far outside the range: answered by the calculator.
+    samples.push_back(-631152000.0);
+    samples.push_back(4102444800.0);
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const double ts = samples[i];
+        const astronomy::MoonPhase::quarters_unix_s_t expected = calculator.quarter_times_unix(ts);
+        const astronomy::LunationTable::quarters_unix_s_t actual = table.quarter_times_unix(ts);
+        for (std::size_t q = 0; q < 8; ++q) {
+            assert(actual[q] == expected[q]);
+        }
+        const double window = 86400.0;
+        assert(table.is_new_moon_window(ts, window) == calculator.is_new_moon_window(ts, window));
+        assert(table.is_first_quarter_window(ts, window) == calculator.is_first_quarter_window(ts, window));
+        assert(table.is_full_moon_window(ts, window) == calculator.is_full_moon_window(ts, window));
+        assert(table.is_last_quarter_window(ts, window) == calculator.is_last_quarter_window(ts, window));
+        const astronomy::MoonQuarterInstants instants = table.quarter_instants_unix(ts);
+        assert(instants.previous_full_unix_s == expected[2] && instants.next_new_unix_s == expected[4]);
+    }
+
+    // Batch flags over an hourly bar series match the scalar predicates.
+    std::vector<double> bars;
+    for (double ts = 1704067200.0; ts < 1704067200.0 + 90.0 * 86400.0; ts += 3600.0) {
+        bars.push_back(ts);
+    }
+    bars.push_back(-631152000.0);
+    std::vector<std::uint8_t> flags(bars.size());
+    table.window_flags(bars.data(), flags.data(), bars.size(), 43200.0);
+    std::size_t flagged = 0;
+    for (std::size_t i = 0; i < bars.size(); ++i) {
+        const double ts = bars[i];
+        assert(((flags[i] & astronomy::MOON_NEW_WINDOW) != 0) == calculator.is_new_moon_window(ts, 43200.0));
+        assert(((flags[i] & astronomy::MOON_FIRST_QUARTER_WINDOW) != 0) == calculator.is_first_quarter_window(ts, 43200.0));
+        assert(((flags[i] & astronomy::MOON_FULL_WINDOW) != 0) == calculator.is_full_moon_window(ts, 43200.0));
+        assert(((flags[i] & astronomy::MOON_LAST_QUARTER_WINDOW) != 0) == calculator.is_last_quarter_window(ts, 43200.0));
+        flagged += flags[i] != 0 ? 1u : 0u;
+    }
+    assert(flagged > 0);
+
+    bool is_thrown = false;
+    try {
+        astronomy::LunationTable bad(to, from);
+        (void)bad;
+    } catch (const std::invalid_argument&) {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+    return 0;
+}
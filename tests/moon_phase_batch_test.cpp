@@ -0,0 +1,98 @@
+#include <time_shield/MoonPhase.hpp>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /// \brief Distance between two phase fractions on the unit circle.
+    double phase_distance(double a, double b) {
+        const double d = std::abs(a - b);
+        return d < 0.5 ? d : 1.0 - d;
+    }
+
+} // namespace
+
+/// \brief Compares MoonPhase::compute_batch() with the scalar compute() and checks field selection.
+int main() {
+    using namespace time_shield;
+
+    // Polynomial sine/cosine against libm, including large and negative angles.
+    for (double deg = -4.0e6; deg < 4.0e6; deg += 977.123456789) {
+        double s = 0.0;
+        double c = 0.0;
+        detail::sin_cos_degrees(deg, s, c);
+        const double rad = std::fmod(deg, 360.0) * (3.14159265358979323846 / 180.0);
+        assert(std::abs(s - std::sin(rad)) < 1e-14);
+        assert(std::abs(c - std::cos(rad)) < 1e-14);
+    }
+    for (int q = -8; q <= 8; ++q) {
+        double s = 0.0;
+        double c = 0.0;
+        detail::sin_cos_degrees(45.0 * q, s, c);
+        const double rad = 45.0 * q * (3.14159265358979323846 / 180.0);
+        assert(std::abs(s - std::sin(rad)) < 1e-15 && std::abs(c - std::cos(rad)) < 1e-15);
+        const double wrapped = detail::wrap_degrees(45.0 * q);
+        assert(wrapped >= 0.0 && wrapped < 360.0);
+    }
+    assert(detail::wrap_degrees(-0.0) == 0.0 && detail::wrap_degrees(-90.0) == 270.0);
+    assert(detail::wrap_degrees(725.5) == 5.5 && detail::wrap_degrees(-1e6) == std::fmod(-1e6, 360.0) + 360.0);
+
+    const astronomy::MoonPhase calculator{};
+    std::vector<double> timestamps;
+    std::mt19937_64 rng(0x243f6a8885a308d3ULL);
+    for (int i = 0; i < 5003; ++i) {
+        const uint64_t bits = rng();
+        // 1800..2200
+        timestamps.push_back(-5364662400.0 + static_cast<double>(bits >> 11) / 9007199254740992.0 * 12623040000.0);
+    }
+    const std::size_t count = timestamps.size();
+
+    std::vector<std::vector<double> > columns(11, std::vector<double>(count, -1.0));
+    astronomy::MoonPhaseColumns out;
+    out.phase = columns[0].data();
+    out.illumination = columns[1].data();
+    out.age_days = columns[2].data();
+    out.distance_km = columns[3].data();
+    out.diameter_deg = columns[4].data();
+    out.age_deg = columns[5].data();
+    out.phase_angle_rad = columns[6].data();
+    out.phase_sin = columns[7].data();
+    out.phase_cos = columns[8].data();
+    out.sun_distance_km = columns[9].data();
+    out.sun_diameter_deg = columns[10].data();
+    calculator.compute_batch(timestamps.data(), count, astronomy::MOON_FIELD_ALL, out);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const astronomy::MoonPhaseResult expected = calculator.compute(timestamps[i]);
+        assert(phase_distance(out.phase[i], expected.phase) < 1e-10);
+        assert(out.phase[i] >= 0.0 && out.phase[i] < 1.0);
+        assert(std::abs(out.illumination[i] - expected.illumination) < 1e-10);
+        assert(phase_distance(out.age_days[i] / 29.53058868, expected.age_days / 29.53058868) < 1e-10);
+        assert(std::abs(out.distance_km[i] - expected.distance_km) < 1e-4);
+        assert(std::abs(out.diameter_deg[i] - expected.diameter_deg) < 1e-12);
+        assert(phase_distance(out.age_deg[i] / 360.0, expected.age_deg / 360.0) < 1e-10);
+        assert(std::abs(out.phase_sin[i] - expected.phase_sin) < 1e-9);
+        assert(std::abs(out.phase_cos[i] - expected.phase_cos) < 1e-9);
+        assert(std::abs(out.sun_distance_km[i] - expected.sun_distance_km) < 1e-3);
+        assert(std::abs(out.sun_diameter_deg[i] - expected.sun_diameter_deg) < 1e-12);
+    }
+
+    // Only the selected columns are written; unselected ones may be null.
+    std::vector<double> phase(count, -1.0);
+    std::vector<double> illumination(count, -1.0);
+    astronomy::MoonPhaseColumns partial;
+    partial.phase = phase.data();
+    partial.illumination = illumination.data();
+    calculator.compute_batch(timestamps.data(), count, astronomy::MOON_FIELD_PHASE, partial);
+    for (std::size_t i = 0; i < count; ++i) {
+        assert(phase[i] == columns[0][i]);
+        assert(illumination[i] == -1.0);
+    }
+    calculator.compute_batch(timestamps.data(), 0, astronomy::MOON_FIELD_ALL, partial);
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <time_shield/packed_date_time.hpp>
+#include <time_shield/date_time_conversions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    bool same_fields(const time_shield::DateTimeStruct& a, const time_shield::DateTimeStruct& b) {
+        return a.year == b.year && a.mon == b.mon && a.day == b.day &&
+               a.hour == b.hour && a.min == b.min && a.sec == b.sec && a.ms == b.ms;
+    }
+
+    // Accessors, comparisons and field packing are constexpr in C++11.
+    static_assert(time_shield::PackedDate16(5) < time_shield::PackedDate16(6), "PackedDate16 order");
+    static_assert(time_shield::PackedDayMs(-1, 86399999) < time_shield::PackedDayMs(0, 0), "PackedDayMs order");
+    static_assert(time_shield::PackedDayMs::from_raw(time_shield::PackedDayMs(-7, 5).raw()).day() == -7, "PackedDayMs raw");
+    static_assert(time_shield::PackedDateTime64::from_fields(-1, 12, 31, 23, 59, 59, 999) <
+                  time_shield::PackedDateTime64::from_fields(0, 1, 1), "PackedDateTime64 order");
+    static_assert(time_shield::PackedDateTime64::from_fields(2024, 2, 29, 13).hour() == 13, "PackedDateTime64 hour");
+    static_assert(time_shield::PackedDate16::from_ts_ms(86400000).to_ts_ms() == 86400000, "PackedDate16 round trip");
+
+#if !defined(TIME_SHIELD_CPP11)
+    static_assert(time_shield::PackedDateTime64::from_ts_ms(1709211600123).to_ts_ms() == 1709211600123,
+                  "PackedDateTime64 constexpr round trip");
+    static_assert(time_shield::PackedDayMs::from_ts_ms(-1).to_date_time_struct().year == 1969,
+                  "PackedDayMs constexpr decode");
+    static_assert(time_shield::PackedDate16::from_date_time_struct(
+                          time_shield::DateTimeStruct{2149, 6, 6, 0, 0, 0, 0}).day() == 65535,
+                  "PackedDate16 constexpr encode");
+#endif
+
+} // namespace
+
+/// \brief Checks encode/decode round trips and packed ordering of the compact date-time types.
+int main() {
+    using namespace time_shield;
+
+    std::mt19937_64 rng(0xa4093822299f31d0ULL);
+    std::vector<ts_ms_t> values;
+    values.push_back(0);
+    values.push_back(-1);
+    values.push_back(MS_PER_DAY - 1);
+    values.push_back(951782400000LL);   // 2000-02-29
+    values.push_back(-62135596800000LL); // 0001-01-01
+    values.push_back(detail::PACKED_DT_MIN_TS_MS);
+    values.push_back(detail::PACKED_DT_MAX_TS_MS);
+    for (int i = 0; i < 20000; ++i) {
+        // Years -10000..10000, then a wider band near the PackedDateTime64 limits.
+        const ts_ms_t span = (i & 1) ? 631152000000000LL : 4000000000000000000LL;
+        values.push_back(static_cast<ts_ms_t>(rng() % static_cast<uint64_t>(2 * span)) - span);
+    }
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const ts_ms_t ts = values[i];
+        const DateTimeStruct expected = to_date_time_ms<DateTimeStruct>(ts);
+
+        assert(PackedDateTime64::fits(ts));
+        const PackedDateTime64 packed = PackedDateTime64::from_ts_ms(ts);
+        assert(packed.to_ts_ms() == ts);
+        assert(same_fields(packed.to_date_time_struct(), expected));
+        assert(PackedDateTime64::from_date_time_struct(expected) == packed);
+        assert(PackedDateTime64::from_raw(packed.raw()) == packed);
+
+        if (PackedDayMs::fits(ts)) {
+            const PackedDayMs day_ms = PackedDayMs::from_ts_ms(ts);
+            assert(day_ms.to_ts_ms() == ts);
+            assert(day_ms.ms_of_day() < static_cast<uint32_t>(MS_PER_DAY));
+            assert(same_fields(day_ms.to_date_time_struct(), expected));
+            assert(PackedDayMs::from_date_time_struct(expected) == day_ms);
+            assert(PackedDayMs::from_raw(day_ms.raw()) == day_ms);
+        }
+    }
+    assert(!PackedDateTime64::fits(detail::PACKED_DT_MIN_TS_MS - 1));
+    assert(!PackedDateTime64::fits(detail::PACKED_DT_MAX_TS_MS + 1));
+    assert(PackedDayMs::fits(-185542587187200000LL) && !PackedDayMs::fits(-185542587187200001LL));
+
+    // Packed comparisons agree with timestamp order.
+    for (std::size_t i = 1; i < values.size(); ++i) {
+        const ts_ms_t a = values[i - 1];
+        const ts_ms_t b = values[i];
+        const PackedDateTime64 pa = PackedDateTime64::from_ts_ms(a);
+        const PackedDateTime64 pb = PackedDateTime64::from_ts_ms(b);
+        assert((pa < pb) == (a < b) && (pa <= pb) == (a <= b) && (pa > pb) == (a > b) && (pa >= pb) == (a >= b));
+        assert((pa.raw() < pb.raw()) == (a < b));
+        if (PackedDayMs::fits(a) && PackedDayMs::fits(b)) {
+            const PackedDayMs da = PackedDayMs::from_ts_ms(a);
+            const PackedDayMs db = PackedDayMs::from_ts_ms(b);
+            assert((da < db) == (a < b) && (da == db) == (a == b) && (da >= db) == (a >= b));
+            assert((da.raw() < db.raw()) == (a < b));
+        }
+    }
+
+    // Sorting packed values sorts the instants.
+    {
+        std::vector<PackedDateTime64> packed;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            packed.push_back(PackedDateTime64::from_ts_ms(values[i]));
+        }
+        std::sort(packed.begin(), packed.end());
+        std::vector<ts_ms_t> sorted(values);
+        std::sort(sorted.begin(), sorted.end());
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            assert(packed[i].to_ts_ms() == sorted[i]);
+        }
+    }
+
+    // Every 16-bit date.
+    for (uint32_t day = 0; day <= 0xFFFF; ++day) {
+        const PackedDate16 date(static_cast<uint16_t>(day));
+        const ts_ms_t midnight = static_cast<ts_ms_t>(day) * MS_PER_DAY;
+        assert(PackedDate16::fits(midnight + MS_PER_DAY - 1));
+        assert(PackedDate16::from_ts_ms(midnight + MS_PER_DAY - 1) == date);
+        assert(date.to_ts_ms() == midnight);
+        const DateTimeStruct dt = date.to_date_time_struct();
+        assert(same_fields(dt, to_date_time_ms<DateTimeStruct>(midnight)));
+        assert(PackedDate16::from_date_time_struct(create_date_time_struct(dt.year, dt.mon, dt.day, 23, 59)) == date);
+        if (day > 0) {
+            assert(PackedDate16(static_cast<uint16_t>(day - 1)) < date);
+        }
+    }
+    assert(!PackedDate16::fits(-1) && !PackedDate16::fits(65536 * MS_PER_DAY));
+    assert(PackedDate16(65535).to_date_time_struct().year == 2149);
+
+    const PackedDateTime64 epoch;
+    assert(epoch.to_ts_ms() == 0 && epoch.year() == 1970 && epoch.mon() == 1 && epoch.day() == 1);
+    assert(PackedDayMs().to_ts_ms() == 0 && PackedDate16().to_ts_ms() == 0);
+    return 0;
+}
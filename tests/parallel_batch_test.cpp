@@ -0,0 +1,205 @@
+#include <time_shield/parallel_batch.hpp>
+#include <time_shield/date_time_conversions.hpp>
+#include <time_shield/time_formatting.hpp>
+#include <time_shield/time_parser.hpp>
+#include <time_shield/time_zone_conversions.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using namespace time_shield;
+
+    /// \brief Executor that runs the tasks in reverse order on the calling thread.
+    struct ReverseExecutor {
+        std::size_t calls = 0;
+
+        template<class Fn>
+        void parallel_for(std::size_t task_count, Fn fn) {
+            ++calls;
+            for (std::size_t task = task_count; task > 0; --task) {
+                fn(task - 1);
+            }
+        }
+    };
+
+    bool same_fields(const DateTimeStruct& a, const DateTimeStruct& b) {
+        return a.year == b.year && a.mon == b.mon && a.day == b.day &&
+               a.hour == b.hour && a.min == b.min && a.sec == b.sec && a.ms == b.ms;
+    }
+
+    template<class Executor>
+    void check_drivers(const std::vector<ts_ms_t>& input, Executor& executor, std::size_t chunk_items) {
+        const std::size_t count = input.size();
+
+        std::vector<DateTimeStruct> fields(count);
+        parallel_to_date_time_ms(input.data(), fields.data(), count, executor, chunk_items);
+        for (std::size_t i = 0; i < count; ++i) {
+            assert(same_fields(fields[i], to_date_time_ms<DateTimeStruct>(input[i])));
+        }
+
+        const TimeZone zones[] = {UTC, CET, EET, WET, ET, CT, KZT, TRT, BYT, JST, IST, UNKNOWN};
+        std::vector<ts_ms_t> local(count);
+        for (TimeZone zone : zones) {
+            parallel_gmt_to_zone_ms(input.data(), local.data(), count, zone, executor, chunk_items);
+            for (std::size_t i = 0; i < count; ++i) {
+                assert(local[i] == gmt_to_zone_ms(input[i], zone));
+            }
+        }
+
+        const FormattedColumn column = parallel_to_iso8601_utc_ms(input.data(), count, executor, '\n', chunk_items);
+        assert(column.size() == count);
+        std::string expected;
+        std::vector<std::string> text(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            text[i] = to_iso8601_utc_ms(input[i]);
+            assert(column.element(i) == text[i]);
+            expected += text[i];
+            expected += '\n';
+        }
+        assert(column.join() == expected);
+        assert(column.text_length() == expected.size());
+
+        // Years outside four digits do not parse back; they count as failures.
+        std::vector<ts_ms_t> parsed(count);
+        std::size_t failures = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            ts_ms_t value = 0;
+            if (str_to_ts_ms(text[i].data(), text[i].size(), value)) {
+                assert(value == input[i]);
+            } else {
+                ++failures;
+            }
+        }
+        assert(parallel_parse_iso8601_ms(text.data(), parsed.data(), count, executor, chunk_items) == failures);
+        for (std::size_t i = 0; i < count; ++i) {
+            ts_ms_t value = 0;
+            assert(parsed[i] == (str_to_ts_ms(text[i].data(), text[i].size(), value) ? input[i] : ERROR_TIMESTAMP));
+        }
+    }
+
+} // namespace
+
+/// \brief Checks the parallel batch drivers against the per-element conversions for several pools and executors.
+int main() {
+    std::mt19937_64 rng(0x9e3779b97f4a7c15ULL);
+
+    // Random timestamps over years 1000..9999 plus a few outside four-digit years.
+    std::vector<ts_ms_t> input(5003);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<ts_ms_t>(rng() % 283996800000000ULL) - 30610224000000LL;
+    }
+    input[0] = 0;
+    input[1] = -1;
+    input[2] = -62167219200000LL;      // 0000-01-01
+    input[3] = 253402300800000LL;      // 10000-01-01
+    input[4] = -30610224000001LL;      // 0999-12-31T23:59:59.999
+
+    // Sorted 47-minute steps across DST transitions exercise the per-hour offset cache.
+    std::vector<ts_ms_t> sorted(4099);
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        sorted[i] = 1711756800000LL + static_cast<ts_ms_t>(i) * 47 * MS_PER_MIN + static_cast<ts_ms_t>(i % 997);
+    }
+    std::sort(input.begin() + 5, input.begin() + 2000);
+
+    const std::size_t pool_sizes[] = {1, 3, 4};
+    const std::size_t chunk_sizes[] = {0, 1, 7, 256};
+    for (std::size_t threads : pool_sizes) {
+        WorkStealingPool pool(threads);
+        assert(pool.concurrency() == threads);
+        for (std::size_t chunk_items : chunk_sizes) {
+            check_drivers(input, pool, chunk_items);
+            check_drivers(sorted, pool, chunk_items);
+        }
+    }
+
+    ReverseExecutor reverse;
+    check_drivers(input, reverse, 100);
+    assert(reverse.calls != 0);
+    check_drivers(sorted, WorkStealingPool::shared(), 0);
+
+    // Every task runs exactly once, including with many more tasks than threads.
+    {
+        WorkStealingPool pool(4);
+        for (std::size_t tasks = 0; tasks < 300; tasks += 37) {
+            std::vector<std::atomic<int>> hits(tasks);
+            for (std::size_t i = 0; i < tasks; ++i) {
+                hits[i].store(0);
+            }
+            pool.parallel_for(tasks, [&](std::size_t task) { hits[task].fetch_add(1); });
+            for (std::size_t i = 0; i < tasks; ++i) {
+                assert(hits[i].load() == 1);
+            }
+        }
+    }
+
+    // A task that calls parallel_for() on its own pool runs the inner job inline.
+    {
+        WorkStealingPool pool(3);
+        std::atomic<std::size_t> total(0);
+        pool.parallel_for(8, [&](std::size_t outer) {
+            const std::thread::id thread = std::this_thread::get_id();
+            pool.parallel_for(16, [&, outer](std::size_t inner) {
+                assert(std::this_thread::get_id() == thread);
+                total.fetch_add(outer * 16 + inner);
+            });
+        });
+        assert(total.load() == 128 * 127 / 2);
+    }
+
+    // The first exception of a job reaches the caller and the pool stays usable.
+    {
+        WorkStealingPool pool(3);
+        bool thrown = false;
+        try {
+            pool.parallel_for(64, [](std::size_t task) {
+                if (task == 17) {
+                    throw std::runtime_error("task failed");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        std::atomic<std::size_t> total(0);
+        pool.parallel_for(64, [&](std::size_t task) { total.fetch_add(task); });
+        assert(total.load() == 64 * 63 / 2);
+    }
+
+    // Empty input, failed parses and stream output.
+    {
+        WorkStealingPool pool(2);
+        parallel_to_date_time_ms(input.data(), static_cast<DateTimeStruct*>(nullptr), 0, pool);
+        const FormattedColumn empty = parallel_to_iso8601_utc_ms(input.data(), 0, pool);
+        assert(empty.size() == 0 && empty.chunk_count() == 0 && empty.join().empty());
+
+        std::vector<std::string> text(10, "2024-03-31T01:00:00Z");
+        text[3] = "not a date";
+        text[8] = "";
+        std::vector<ts_ms_t> parsed(text.size());
+        assert(parallel_parse_iso8601_ms(text.data(), parsed.data(), text.size(), pool, 2) == 2);
+        assert(parsed[3] == ERROR_TIMESTAMP && parsed[8] == ERROR_TIMESTAMP);
+        assert(parsed[0] == 1711846800000LL && parsed[9] == 1711846800000LL);
+
+        const FormattedColumn column = parallel_to_iso8601_utc_ms(sorted.data(), 10, pool, ',', 3);
+        assert(column.chunk_count() == 4);
+        std::ostringstream stream;
+        column.write(stream);
+        assert(stream.str() == column.join());
+        std::size_t length = 0;
+        const char* data = column.element_data(4, length);
+        assert(std::string(data, length) == to_iso8601_utc_ms(sorted[4]));
+        assert(data[length] == ',');
+    }
+    return 0;
+}
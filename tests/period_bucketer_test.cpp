@@ -0,0 +1,105 @@
+#include <time_shield/PeriodBucketer.hpp>
+#include <time_shield/date_time_conversions.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+    using time_shield::ts_ms_t;
+
+    /// \brief Checks one bucketer against floor_mod on edge and random timestamps.
+    void check_period(ts_ms_t period, std::mt19937_64& rng) {
+        const time_shield::PeriodBucketer bucketer(period);
+        assert(bucketer.period_ms() == period);
+        std::vector<ts_ms_t> values;
+        const ts_ms_t min_value = (std::numeric_limits<ts_ms_t>::min)();
+        const ts_ms_t max_value = (std::numeric_limits<ts_ms_t>::max)();
+        const ts_ms_t edges[] = {0, 1, -1, period, -period, period - 1, 1 - period, period + 1, -period - 1,
+                                 max_value, max_value - 1, min_value + period, min_value + period + 1};
+        values.insert(values.end(), edges, edges + sizeof(edges) / sizeof(edges[0]));
+        for (int i = 0; i < 2000; ++i) {
+            const uint64_t bits = rng();
+            // Mix full-range values with realistic millisecond timestamps around the epoch.
+            values.push_back(i % 2 == 0 ? static_cast<ts_ms_t>(bits)
+                                        : static_cast<ts_ms_t>(bits % 8000000000000ULL) - 4000000000000LL);
+        }
+        std::vector<ts_ms_t> starts(values.size());
+        bucketer.bucket(values.data(), starts.data(), values.size());
+        std::vector<int64_t> indices(values.size());
+        bucketer.index(values.data(), indices.data(), values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const ts_ms_t value = values[i];
+            const ts_ms_t rem = time_shield::detail::floor_mod(value, period);
+            assert(bucketer.remainder(value) == rem);
+            assert(bucketer.bucket(value) == value - rem);
+            assert(starts[i] == value - rem);
+            const int64_t quotient = value / period - (value % period < 0 ? 1 : 0);
+            assert(bucketer.index(value) == quotient);
+            assert(indices[i] == quotient);
+            if (value < max_value - period) {
+                assert(bucketer.bucket_end(value) == value - rem + period - 1);
+            }
+        }
+    }
+
+} // namespace
+
+/// \brief Checks PeriodBucketer against floor_mod for power-of-two, small and large periods.
+int main() {
+    using namespace time_shield;
+
+    std::mt19937_64 rng(12345);
+    const ts_ms_t periods[] = {1, 2, 3, 7, 10, 60, 1000, 1024, 5000, 60000, 900000, 3600000, 86400000,
+                               604800000, 2592000000LL, 31556952000LL, 1000000007LL, (1LL << 40) + 1,
+                               (std::numeric_limits<ts_ms_t>::max)()};
+    for (std::size_t i = 0; i < sizeof(periods) / sizeof(periods[0]); ++i) {
+        check_period(periods[i], rng);
+    }
+    for (int i = 0; i < 300; ++i) {
+        const uint64_t bits = rng();
+        const int width = static_cast<int>(bits % 62) + 1;
+        check_period(static_cast<ts_ms_t>((rng() >> (63 - width)) | 1), rng);
+    }
+
+    // start_of_period_ms agrees for ordinary timestamps.
+    const PeriodBucketer minute(MS_PER_MIN);
+    const ts_ms_t samples[] = {1700000012345LL, -1LL, -60000LL, -60001LL, 0};
+    for (std::size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i) {
+        assert(minute.bucket(samples[i]) == start_of_period_ms(MS_PER_MIN, samples[i]));
+        assert(minute.bucket_end(samples[i]) == end_of_period_ms(MS_PER_MIN, samples[i]));
+    }
+
+    // Offsets shift bucket boundaries and are reduced into [0, period).
+    const PeriodBucketer shifted(15 * MS_PER_MIN, -5 * MS_PER_MIN);
+    assert(shifted.offset_ms() == 10 * MS_PER_MIN);
+    assert(shifted.bucket(10 * MS_PER_MIN) == 10 * MS_PER_MIN);
+    assert(shifted.bucket(10 * MS_PER_MIN - 1) == -5 * MS_PER_MIN);
+    assert(shifted.bucket(-1) == -5 * MS_PER_MIN);
+    assert(shifted.index(10 * MS_PER_MIN) == 0);
+    assert(shifted.index(-1) == -1);
+
+    // In-place batch bucketing.
+    std::vector<ts_ms_t> in_place(3);
+    in_place[0] = 1999;
+    in_place[1] = -1;
+    in_place[2] = 2000;
+    const PeriodBucketer second(MS_PER_SEC);
+    second.bucket(in_place.data(), in_place.data(), in_place.size());
+    assert(in_place[0] == 1000 && in_place[1] == -1000 && in_place[2] == 2000);
+
+    bool is_thrown = false;
+    try {
+        PeriodBucketer invalid(0);
+        (void)invalid;
+    } catch (const std::invalid_argument&) {
+        is_thrown = true;
+    }
+    assert(is_thrown);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <time_shield/time_utils.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /// \brief Prints average cost of one now_realtime_us() call.
+    void bench_read(const char* label) {
+        const int iterations = 1000000;
+        std::int64_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink += time_shield::now_realtime_us();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const double ns_per_read = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+        std::cout << label << ": " << ns_per_read << " ns/read" << (sink == 0 ? " " : "") << '\n';
+    }
+
+} // namespace
+
+/// \brief Checks re-anchoring and drift diagnostics of now_realtime_us().
+int main() {
+    using namespace time_shield;
+
+    // Automatic re-anchoring is disabled by default.
+    assert(realtime_reanchor_interval().count() == 0);
+    const std::int64_t first = now_realtime_us();
+    assert(std::llabs(first - ts_us()) < 5000);
+
+    RealtimeAnchorDiagnostics diagnostics = realtime_anchor_diagnostics();
+    assert(std::llabs(diagnostics.error_us) < 5000);
+    assert(diagnostics.anchor_age_us >= 0);
+    assert(diagnostics.reanchor_count == 0);
+    std::cout << "anchor error us: " << diagnostics.error_us
+              << ", age us: " << diagnostics.anchor_age_us << '\n';
+    bench_read("now_realtime_us (fixed anchor)");
+
+    // Explicit re-anchoring captures a fresh anchor.
+    reanchor_realtime();
+    diagnostics = realtime_anchor_diagnostics();
+    assert(diagnostics.reanchor_count == 1);
+    assert(diagnostics.anchor_age_us < 1000000);
+    assert(std::llabs(diagnostics.last_correction_us) < 5000);
+    assert(std::llabs(diagnostics.error_us) < 1000);
+
+    // Readers re-anchor lazily once the interval elapses.
+    set_realtime_reanchor_interval(std::chrono::milliseconds(10));
+    assert(realtime_reanchor_interval() == std::chrono::milliseconds(10));
+    const std::uint64_t count_before = realtime_anchor_diagnostics().reanchor_count;
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    assert(std::llabs(now_realtime_us() - ts_us()) < 5000);
+    diagnostics = realtime_anchor_diagnostics();
+    assert(diagnostics.reanchor_count > count_before);
+    assert(diagnostics.anchor_age_us < 10000 + 5000);
+
+    // Concurrent readers race with writers without torn anchors.
+    std::atomic<bool> is_done{false};
+    std::thread writer([&is_done]() {
+        while (!is_done.load()) {
+            reanchor_realtime();
+            std::this_thread::yield();
+        }
+    });
+    std::vector<std::thread> readers;
+    std::atomic<int> bad_reads{0};
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&bad_reads]() {
+            for (int i = 0; i < 100000; ++i) {
+                const std::int64_t value = now_realtime_us();
+                if (std::llabs(value - ts_us()) >= 50000) {
+                    bad_reads.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (std::size_t i = 0; i < readers.size(); ++i) {
+        readers[i].join();
+    }
+    is_done.store(true);
+    writer.join();
+    assert(bad_reads.load() == 0);
+
+    bench_read("now_realtime_us (10 ms re-anchor)");
+    set_realtime_reanchor_interval(std::chrono::milliseconds(0));
+    assert(realtime_reanchor_interval().count() == 0);
+    const std::uint64_t count_disabled = realtime_anchor_diagnostics().reanchor_count;
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    (void)now_realtime_us();
+    assert(realtime_anchor_diagnostics().reanchor_count == count_disabled);
+    return 0;
+}
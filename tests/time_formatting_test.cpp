@@ -17,5 +17,12 @@ int main() {
     assert(to_string("%G-%V-%u", to_timestamp(2025, 12, 16)) == "2025-51-2");
     assert(to_string("%g-W%V", to_timestamp(2025, 12, 16)) == "25-W51");
 
+    // A leading literal character is printed once.
+    assert(to_string("T%hh", ts_t(3600)) == "T01");
+    assert(to_string("<%F>", to_timestamp(2024, 3, 31, 23), SEC_PER_HOUR) == "<2024-04-01>");
+    assert(to_string_ms("T%hh:%mm:%ss", ts_ms_t(3723004)) == "T01:02:03");
+    assert(to_string_ms("x", ts_ms_t(0)) == "x");
+    assert(to_string_ms("%%%YYYY", ts_ms_t(0)) == "%1970");
+
     return 0;
 }
@@ -0,0 +1,151 @@
+#include <time_shield/time_literals.hpp>
+#include <time_shield/FormatString.hpp>
+#include <time_shield/time_formatting.hpp>
+#include <time_shield/time_parser.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#if defined(TIME_SHIELD_CPP17)
+
+namespace {
+
+    using namespace time_shield::literals;
+
+    // Literals are constant expressions.
+    static_assert("2024-03-31T01:00:00Z"_ts_ms == 1711846800000LL, "UTC literal");
+    static_assert("2024-03-31T03:00:00+02:00"_ts_ms == 1711846800000LL, "offset literal");
+    static_assert("2024-03-30 20:00-05:00"_ts_ms == 1711846800000LL, "space separator and hh:mm");
+    static_assert("1969-12-31T23:59:59.999Z"_ts_ms == -1, "pre-epoch literal");
+    static_assert("2000-02-29"_ts_ms == 951782400000LL, "date-only literal");
+    static_assert("2024.01.02T03:04:05.6"_ts_ms == 1704164645600LL, "dotted date and fraction");
+    static_assert("2024-01-01T00:00:00Z"_ts == 1704067200, "seconds literal");
+
+    constexpr time_shield::FormatString k_iso_format("%YYYY-%MM-%DD %hh:%mm:%ss.%sss");
+    static_assert(k_iso_format.token_count() == 13, "tokens are built at compile time");
+    static_assert("%Y%%"_fmt.token_count() == 2, "percent escape is a literal");
+
+    /// \brief Patterns covering the fast numeric tokens and the shared specifier table.
+    const char* const k_patterns[] = {
+        "%YYYY-%MM-%DD %hh:%mm:%ss.%sss",
+        "%Y-%m-%d %H:%M:%S",
+        "%HH%SS %SSS",
+        "%a %A %b %B %C %e %F %g %G %I %k %l %p %P %r %R %T %u %V %y %z %Z",
+        "[%c] %D %YY %YYYYYY %MMM %WWW %www %w %j %s %%",
+    };
+
+    bool parse_matches(const char* str, std::size_t length, time_shield::ts_ms_t expected) {
+        time_shield::ts_ms_t value = 0;
+        return time_shield::str_to_ts_ms(str, length, value) && value == expected;
+    }
+
+} // namespace
+
+/// \brief Checks compile-time timestamp literals and compiled format patterns against the runtime parser and formatter.
+int main() {
+    using namespace time_shield;
+
+    // Literal parsing agrees with the runtime parser.
+    {
+        const char* const inputs[] = {
+            "2024-03-31T01:00:00Z", "2024-03-31T03:00:00+02:00", "2024-03-30 20:00-05:00",
+            "1969-12-31T23:59:59.999Z", "2000-02-29", "2024.01.02T03:04:05.6", " 2024/06/07T08:09:10.12z "
+        };
+        for (const char* input : inputs) {
+            const std::string str(input);
+            ts_ms_t value = 0;
+            assert(detail::parse_iso8601_ms_constexpr(str.data(), str.size(), value));
+            assert(parse_matches(str.data(), str.size(), value));
+        }
+        const char* const invalid[] = {
+            "", "2024-02-30", "2024-13-01", "2024-01-01T24:00", "2024-01-01T10", "2024-01-01T10:00:00.1234",
+            "2024-01-01T10:00+01", "2024-01-01T10:00:00Q", "2024-01-01X10:00", "24-01-01", "2024-01-01T10:00.5"
+        };
+        for (const char* input : invalid) {
+            const std::string str(input);
+            ts_ms_t value = 0;
+            assert(!detail::parse_iso8601_ms_constexpr(str.data(), str.size(), value));
+        }
+    }
+
+    // Compiled patterns print the same as the std::string overloads.
+    {
+        const FormatString formats[] = {
+            FormatString("%YYYY-%MM-%DD %hh:%mm:%ss.%sss"),
+            FormatString("%Y-%m-%d %H:%M:%S"),
+            FormatString("%HH%SS %SSS"),
+            FormatString("%a %A %b %B %C %e %F %g %G %I %k %l %p %P %r %R %T %u %V %y %z %Z"),
+            FormatString("[%c] %D %YY %YYYYYY %MMM %WWW %www %w %j %s %%"),
+        };
+        std::mt19937_64 rng(0x3c6ef372fe94f82bULL);
+        for (int i = 0; i < 4000; ++i) {
+            // Years 0..9999, plus years 10000..29999 that take the generic %YYYY path.
+            const ts_ms_t ts_ms = (i % 4 == 0)
+                ? 253402300800000LL + static_cast<ts_ms_t>(rng() % 631152000000000ULL)
+                : static_cast<ts_ms_t>(rng() % 315569520000000ULL) - 62167219200000LL;
+            const tz_t offset = static_cast<tz_t>(static_cast<int64_t>(rng() % 93601) - 43200);
+            const std::size_t k = static_cast<std::size_t>(i) % 5;
+            const std::string pattern = k_patterns[k];
+            const FormatString& format = formats[k];
+            assert(to_string_ms(pattern, ts_ms, offset) == to_string_ms(format, ts_ms, offset));
+            const ts_t ts = static_cast<ts_t>(ts_ms / 1000);
+            assert(to_string(pattern, ts, offset) == to_string(format, ts, offset));
+        }
+        assert(to_string_ms("%YYYY-%MM-%DD %hh:%mm:%ss.%sss"_fmt, "2024-03-31T01:02:03.045Z"_ts_ms) ==
+               "2024-03-31 01:02:03.45");
+        assert(to_string("<%F>"_fmt, "2024-03-31T23:00:00Z"_ts, 3600) == "<2024-04-01>");
+        assert(to_string(std::string("<%F>"), "2024-03-31T23:00:00Z"_ts, 3600) == "<2024-04-01>");
+        assert(to_string_ms(std::string("T%hh"), "2024-03-31T01:02:03Z"_ts_ms) == "T01");
+    }
+
+#if !TIME_SHIELD_HAS_CONSTEVAL
+    // Without consteval, invalid input evaluated at run time throws.
+    {
+        const char* const bad_patterns[] = {"%q", "%YYY", "abc%", "%W", "%mmm"};
+        for (const char* pattern : bad_patterns) {
+            bool thrown = false;
+            try {
+                const FormatString format(pattern);
+                (void)format;
+            } catch (const std::invalid_argument&) {
+                thrown = true;
+            }
+            assert(thrown);
+        }
+        std::string many;
+        for (int i = 0; i < 33; ++i) {
+            many += "x%Y";
+        }
+        bool thrown = false;
+        try {
+            const FormatString format(many.c_str());
+            (void)format;
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+        thrown = false;
+        try {
+            const ts_ms_t value = operator""_ts_ms("2024-02-30", 10);
+            (void)value;
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+#endif
+    return 0;
+}
+
+#else
+
+/// \brief Compile-time literals need C++17.
+int main() {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include <time_shield/TimerScheduler.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief Checks wall-clock aligned scheduling of TimerScheduler timers.
+int main() {
+    using namespace time_shield;
+
+    // Millisecond period helpers follow floor semantics for pre-epoch values.
+    assert(start_of_period_ms(MS_PER_MIN, static_cast<ts_ms_t>(125000)) == 120000);
+    assert(end_of_period_ms(MS_PER_MIN, static_cast<ts_ms_t>(125000)) == 179999);
+    assert(start_of_period_ms(MS_PER_MIN, static_cast<ts_ms_t>(-1)) == -60000);
+    assert(end_of_period_ms(MS_PER_MIN, static_cast<ts_ms_t>(-1)) == -1);
+    assert(start_of_period_ms(0, static_cast<ts_ms_t>(125000)) == ERROR_TIMESTAMP);
+    assert(end_of_period_ms(-5, static_cast<ts_ms_t>(125000)) == ERROR_TIMESTAMP);
+
+    TimerScheduler scheduler;
+    scheduler.set_wall_clock_resync_interval(std::chrono::milliseconds(20));
+    assert(scheduler.wall_clock_resync_interval() == std::chrono::milliseconds(20));
+
+    // One-shot activation at a UTC instant driven by process().
+    Timer at_timer(scheduler);
+    std::atomic<int> at_counter{0};
+    std::atomic<std::int64_t> at_fired_us{0};
+    at_timer.set_callback([&at_counter, &at_fired_us]() {
+        at_fired_us.store(now_realtime_us());
+        at_counter.fetch_add(1);
+    });
+    const ts_ms_t at_target_ms = static_cast<ts_ms_t>(now_realtime_us() / US_PER_MS) + 150;
+    at_timer.schedule_at_utc(at_target_ms);
+    assert(at_timer.is_active());
+    assert(at_timer.next_fire_utc_ms() == at_target_ms);
+    const auto at_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (at_counter.load() == 0 && std::chrono::steady_clock::now() < at_deadline) {
+        scheduler.process();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    assert(at_counter.load() == 1);
+    assert(at_fired_us.load() >= at_target_ms * US_PER_MS);
+    assert(!at_timer.is_active());
+    assert(at_timer.next_fire_utc_ms() == ERROR_TIMESTAMP);
+
+    // Past targets fire on the next processing pass.
+    at_timer.schedule_at_utc(at_target_ms - 1000);
+    scheduler.process();
+    assert(at_counter.load() == 2);
+
+    // Periodic boundaries are aligned to the wall-clock period.
+    Timer period_timer(scheduler);
+    assert(!period_timer.schedule_every_period(0));
+    assert(!period_timer.is_active());
+
+    std::mutex fired_mutex;
+    std::vector<std::int64_t> fired_us;
+    period_timer.set_callback([&fired_mutex, &fired_us]() {
+        std::lock_guard<std::mutex> lock(fired_mutex);
+        fired_us.push_back(now_realtime_us());
+    });
+    const ts_ms_t period_ms = 100;
+    assert(period_timer.schedule_every_period(period_ms));
+    const ts_ms_t first_target_ms = period_timer.next_fire_utc_ms();
+    assert(first_target_ms % period_ms == 0);
+    assert(first_target_ms * US_PER_MS > now_realtime_us() - US_PER_SEC);
+
+    scheduler.run();
+    const auto period_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(fired_mutex);
+            if (fired_us.size() >= 4) {
+                break;
+            }
+        }
+        if (std::chrono::steady_clock::now() >= period_deadline) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    period_timer.stop_and_wait();
+    scheduler.stop();
+    {
+        std::lock_guard<std::mutex> lock(fired_mutex);
+        assert(fired_us.size() >= 4);
+        std::int64_t previous_bucket = -1;
+        for (std::size_t i = 0; i < fired_us.size(); ++i) {
+            const std::int64_t bucket = fired_us[i] / (period_ms * US_PER_MS);
+            assert(bucket > previous_bucket);
+            previous_bucket = bucket;
+        }
+    }
+
+    // Local-time alignment with a fixed offset and a phase shift.
+    Timer local_timer(scheduler);
+    const ZonedClock plus_three(static_cast<tz_t>(3 * SEC_PER_HOUR));
+    assert(local_timer.schedule_every_period(MS_PER_DAY, plus_three, 9 * MS_PER_HOUR + 30 * MS_PER_MIN));
+    const ts_ms_t local_target_ms = local_timer.next_fire_utc_ms() + 3 * MS_PER_HOUR;
+    assert(local_target_ms % MS_PER_DAY == 9 * MS_PER_HOUR + 30 * MS_PER_MIN);
+    assert(local_timer.next_fire_utc_ms() * US_PER_MS > now_realtime_us());
+    assert(local_timer.next_fire_utc_ms() * US_PER_MS <= now_realtime_us() + MS_PER_DAY * US_PER_MS);
+    scheduler.resync_wall_clock();
+    assert(local_timer.is_active());
+    assert(local_timer.next_fire_utc_ms() + 3 * MS_PER_HOUR == local_target_ms);
+
+    // Steady scheduling clears wall-clock alignment.
+    local_timer.start(std::chrono::seconds(10));
+    assert(local_timer.next_fire_utc_ms() == ERROR_TIMESTAMP);
+    local_timer.stop();
+
+    return 0;
+}
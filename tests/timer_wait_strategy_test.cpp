@@ -0,0 +1,119 @@
+#include <time_shield/DeadlineTimer.hpp>
+#include <time_shield/TimerScheduler.hpp>
+#include <time_shield/wait_strategy.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace {
+
+    using steady = std::chrono::steady_clock;
+
+    /// \brief Checks that scheduler timers never fire early under one wait policy.
+    void check_scheduler(const time_shield::WaitPolicy& policy, int samples) {
+        using namespace time_shield;
+
+        TimerScheduler scheduler;
+        scheduler.set_wait_policy(policy);
+        assert(scheduler.wait_policy().strategy == policy.strategy);
+        assert(scheduler.wait_policy().spin_window == policy.spin_window);
+        scheduler.run();
+
+        Timer timer(scheduler);
+        timer.set_single_shot(true);
+        std::atomic<std::int64_t> fired_ns{0};
+        timer.set_callback([&fired_ns]() {
+            fired_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                steady::now().time_since_epoch()).count());
+        });
+
+        for (int i = 0; i < samples; ++i) {
+            fired_ns.store(0);
+            const auto armed_at = steady::now();
+            timer.start(std::chrono::milliseconds(2));
+            const auto expected_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                (armed_at + std::chrono::milliseconds(2)).time_since_epoch()).count();
+            const auto deadline = steady::now() + std::chrono::seconds(2);
+            while (fired_ns.load() == 0 && steady::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            const std::int64_t value = fired_ns.load();
+            assert(value != 0);
+            assert(value >= expected_ns);
+            (void)value;
+            (void)expected_ns;
+            timer.stop_and_wait();
+        }
+        scheduler.stop();
+    }
+
+    /// \brief Checks that DeadlineTimer::wait never returns early under one wait policy.
+    void check_deadline(const time_shield::WaitPolicy& policy, int samples) {
+        using namespace time_shield;
+
+        for (int i = 0; i < samples; ++i) {
+            DeadlineTimer deadline_timer(std::chrono::microseconds(500));
+            const bool waited = deadline_timer.wait(policy);
+            assert(waited);
+            assert(deadline_timer.has_expired(steady::now()));
+            (void)waited;
+        }
+    }
+
+} // namespace
+
+/// \brief Checks that wait strategies never wake before the deadline.
+/// Lateness distributions are measured in benchmarks/timer_scheduler_benchmark.cpp.
+int main() {
+    using namespace time_shield;
+
+    const WaitPolicy block = WaitPolicy::block();
+    const WaitPolicy hybrid = WaitPolicy::block_then_spin(std::chrono::microseconds(200));
+    const WaitPolicy spin = WaitPolicy::busy_spin();
+    assert(block.strategy == WaitStrategy::Block);
+    assert(hybrid.strategy == WaitStrategy::BlockThenSpin);
+    assert(hybrid.spin_window == std::chrono::microseconds(200));
+    assert(spin.strategy == WaitStrategy::BusySpin);
+    assert(WaitPolicy(WaitStrategy::BlockThenSpin, std::chrono::nanoseconds(-5)).spin_window.count() == 0);
+
+    // Waits never return early and ignore inactive or infinite deadlines.
+    const auto target = steady::now() + std::chrono::milliseconds(1);
+    wait_until(target, hybrid);
+    assert(steady::now() >= target);
+    wait_for(std::chrono::milliseconds(-1), spin);
+    DeadlineTimer inactive;
+    assert(!inactive.wait(spin));
+    DeadlineTimer forever;
+    forever.set_forever();
+    assert(!forever.wait(block));
+
+    // Policies can be switched while the worker waits for a distant timer.
+    TimerScheduler scheduler;
+    Timer distant(scheduler);
+    std::atomic<int> distant_counter{0};
+    distant.set_callback([&distant_counter]() { distant_counter.fetch_add(1); });
+    scheduler.run();
+    distant.start(std::chrono::milliseconds(30));
+    scheduler.set_wait_policy(spin);
+    scheduler.set_wait_policy(hybrid);
+    const auto distant_deadline = steady::now() + std::chrono::seconds(2);
+    while (distant_counter.load() == 0 && steady::now() < distant_deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    distant.stop_and_wait();
+    scheduler.stop();
+    assert(distant_counter.load() >= 1);
+
+    const int samples = 20;
+    check_scheduler(block, samples);
+    check_scheduler(hybrid, samples);
+    check_scheduler(spin, samples);
+    check_deadline(block, samples);
+    check_deadline(hybrid, samples);
+    check_deadline(spin, samples);
+    return 0;
+}
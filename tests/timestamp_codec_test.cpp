@@ -0,0 +1,175 @@
+#include <time_shield/TimestampCodec.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+    std::vector<uint8_t> encode(const std::vector<time_shield::ts_ms_t>& values) {
+        time_shield::TimestampColumnEncoder encoder;
+        encoder.append(values.data(), values.size());
+        encoder.finish();
+        return encoder.bytes();
+    }
+
+    /// \brief Encode, decode in uneven chunks, and check values and the index.
+    void check_round_trip(const std::vector<time_shield::ts_ms_t>& values) {
+        using namespace time_shield;
+        const std::vector<uint8_t> bytes = encode(values);
+
+        std::vector<ts_ms_t> decoded(values.size() + 1, -1);
+        TimestampColumnDecoder decoder(bytes.data(), bytes.size());
+        std::size_t total = 0;
+        const std::size_t chunks[] = {1, 7, 200, 128, 3, 1000};
+        for (std::size_t k = 0; total < values.size(); ++k) {
+            total += decoder.read(decoded.data() + total, chunks[k % 6]);
+        }
+        assert(total == values.size());
+        assert(decoder.done());
+        assert(decoder.read(decoded.data(), 1) == 0);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            assert(decoded[i] == values[i]);
+        }
+
+        // The index from the headers matches the encoder's and gives random access.
+        TimestampColumnEncoder encoder;
+        encoder.append(values.data(), values.size());
+        encoder.finish();
+        const std::vector<TimestampBlockRef> index = TimestampColumnDecoder::build_index(bytes.data(), bytes.size());
+        assert(index.size() == encoder.index().size());
+        assert(index.size() == (values.size() + TIMESTAMP_CODEC_BLOCK - 1) / TIMESTAMP_CODEC_BLOCK);
+        for (std::size_t b = 0; b < index.size(); ++b) {
+            assert(index[b].first == encoder.index()[b].first);
+            assert(index[b].row == encoder.index()[b].row);
+            assert(index[b].offset == encoder.index()[b].offset);
+        }
+        for (std::size_t row = 0; row < values.size(); row += 97) {
+            const std::size_t b = find_row_block(index, row);
+            assert(b < index.size());
+            decoder.seek(index[b]);
+            ts_ms_t block[TIMESTAMP_CODEC_BLOCK];
+            const std::size_t count = decoder.next_block(block);
+            assert(row >= index[b].row && row < index[b].row + count);
+            assert(block[row - index[b].row] == values[row]);
+        }
+        assert(values.empty() ? find_row_block(index, 0) == 0 : find_row_block(index, values.size()) == index.size() - 1);
+    }
+
+} // namespace
+
+/// \brief Checks the timestamp column codec on regular, jittered, unsorted and extreme series.
+int main() {
+    using namespace time_shield;
+
+    std::mt19937_64 rng(0x452821e638d01377ULL);
+    const std::size_t lengths[] = {0, 1, 2, 127, 128, 129, 1000, 5003};
+
+    for (std::size_t li = 0; li < sizeof(lengths) / sizeof(lengths[0]); ++li) {
+        const std::size_t n = lengths[li];
+        std::vector<ts_ms_t> regular(n);
+        std::vector<ts_ms_t> ticks(n);
+        std::vector<ts_ms_t> noise(n);
+        ts_ms_t t = 1700000000000LL;
+        for (std::size_t i = 0; i < n; ++i) {
+            regular[i] = -86400000LL + static_cast<ts_ms_t>(i) * 60000;
+            t += static_cast<ts_ms_t>(rng() % 1500);
+            ticks[i] = t;
+            noise[i] = static_cast<ts_ms_t>(rng());
+        }
+        check_round_trip(regular);
+        check_round_trip(ticks);
+        check_round_trip(noise);
+        if (n > 2) {
+            noise[0] = (std::numeric_limits<ts_ms_t>::min)();
+            noise[1] = (std::numeric_limits<ts_ms_t>::max)();
+            check_round_trip(noise);
+        }
+    }
+
+    // Every bit width, one block each.
+    for (unsigned width = 0; width <= 64; ++width) {
+        std::vector<ts_ms_t> values(300);
+        uint64_t acc = 5;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            const uint64_t excess = width == 0 ? 0 : rng() >> (64 - width);
+            acc += 3 + excess;
+            values[i] = static_cast<ts_ms_t>(acc);
+        }
+        check_round_trip(values);
+    }
+
+    // Sizes: a regular series costs only block headers, jittered ticks about 11 bits a value.
+    {
+        std::vector<ts_ms_t> regular(12800);
+        std::vector<ts_ms_t> ticks(12800);
+        ts_ms_t t = 1700000000000LL;
+        for (std::size_t i = 0; i < regular.size(); ++i) {
+            regular[i] = static_cast<ts_ms_t>(i) * 1000;
+            t += static_cast<ts_ms_t>(rng() % 1024);
+            ticks[i] = t;
+        }
+        assert(encode(regular).size() == 100 * detail::TIMESTAMP_CODEC_HEADER);
+        assert(encode(ticks).size() <= 100 * (detail::TIMESTAMP_CODEC_HEADER + 127 * 10 / 8 + 1));
+    }
+
+    // Streaming appends and released bytes produce the same stream and offsets.
+    {
+        std::vector<ts_ms_t> values(1000);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] = 1600000000000LL + static_cast<ts_ms_t>(i * i);
+        }
+        TimestampColumnEncoder encoder;
+        std::vector<uint8_t> stream;
+        std::size_t pos = 0;
+        for (std::size_t step = 1; pos < values.size(); ++step) {
+            const std::size_t take = std::min(step * 13 % 300, values.size() - pos);
+            if (take == 1) {
+                encoder.append(values[pos]);
+            } else {
+                encoder.append(values.data() + pos, take);
+            }
+            pos += take;
+            const std::vector<uint8_t> part = encoder.release_bytes();
+            stream.insert(stream.end(), part.begin(), part.end());
+        }
+        assert(encoder.size() == values.size());
+        encoder.finish();
+        const std::vector<uint8_t> tail = encoder.release_bytes();
+        stream.insert(stream.end(), tail.begin(), tail.end());
+        assert(stream == encode(values));
+        assert(encoder.index().back().offset + detail::TIMESTAMP_CODEC_HEADER <= stream.size());
+
+        // Timestamp lookup on a sorted column.
+        const std::vector<TimestampBlockRef>& index = encoder.index();
+        assert(find_timestamp_block(index, values[0] - 1) == 0);
+        assert(find_timestamp_block(index, values[300]) == 300 / TIMESTAMP_CODEC_BLOCK);
+        assert(find_timestamp_block(index, values.back()) == index.size() - 1);
+
+        // Truncated and corrupted streams are rejected.
+        bool thrown = false;
+        try {
+            TimestampColumnDecoder decoder(stream.data(), stream.size() - 1);
+            std::vector<ts_ms_t> out(values.size());
+            decoder.read(out.data(), out.size());
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+        std::vector<uint8_t> corrupted(stream);
+        corrupted[index[2].offset + 1] = 65;
+        thrown = false;
+        try {
+            TimestampColumnDecoder::build_index(corrupted.data(), corrupted.size());
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <time_shield/TimestampIndex.hpp>
+#include <time_shield/date_time_conversions.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+    time_shield::dse_t local_day(time_shield::ts_ms_t ts_ms, time_shield::TimeZone zone) {
+        return time_shield::detail::floor_div<time_shield::ts_ms_t>(time_shield::gmt_to_zone_ms(ts_ms, zone), time_shield::MS_PER_DAY);
+    }
+
+    /// \brief Positions [begin, end) of the elements matching a predicate in a sorted array where matches are contiguous.
+    template<class Pred>
+    time_shield::TimestampRange brute_range(const std::vector<time_shield::ts_ms_t>& data, Pred pred, time_shield::ts_ms_t from) {
+        std::size_t begin = static_cast<std::size_t>(std::lower_bound(data.begin(), data.end(), from) - data.begin());
+        std::size_t end = begin;
+        while (end < data.size() && pred(data[end])) {
+            ++end;
+        }
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            assert(pred(data[i]) == (i >= begin && i < end));
+        }
+        return time_shield::TimestampRange{begin, end};
+    }
+
+    struct BucketCheck {
+        std::vector<time_shield::TimestampRange>* ranges;
+        std::vector<time_shield::ts_ms_t>* starts;
+        void operator()(time_shield::ts_ms_t start, time_shield::TimestampRange rows) const {
+            starts->push_back(start);
+            ranges->push_back(rows);
+        }
+    };
+
+} // namespace
+
+/// \brief Checks TimestampIndex lookups and calendar ranges against brute-force scans.
+int main() {
+    using namespace time_shield;
+
+    // Ticks over 2023-12-20 .. 2025-01-10 with gaps up to 40 minutes and duplicates.
+    std::mt19937_64 rng(0xbe5466cf34e90c6cULL);
+    std::vector<ts_ms_t> data;
+    ts_ms_t t = to_timestamp_ms(2023, 12, 20);
+    const ts_ms_t stop = to_timestamp_ms(2025, 1, 10);
+    while (t < stop) {
+        data.push_back(t);
+        t += (rng() % 8 == 0) ? 0 : static_cast<ts_ms_t>(rng() % 2400000);
+    }
+
+    const ts_ms_t buckets[] = {MS_PER_HOUR, MS_PER_DAY, 1};
+    for (std::size_t b = 0; b < 3; ++b) {
+        const TimestampIndex index(data.data(), data.size(), buckets[b]);
+        assert(index.size() == data.size());
+        assert(index.directory_size() <= 4 * data.size() + 66);
+        for (int i = 0; i < 20000; ++i) {
+            const ts_ms_t probe = (i % 3 == 0)
+                ? data[rng() % data.size()]
+                : data.front() - MS_PER_DAY + static_cast<ts_ms_t>(rng() % static_cast<uint64_t>(data.back() - data.front() + 2 * MS_PER_DAY));
+            const std::size_t expected = static_cast<std::size_t>(std::lower_bound(data.begin(), data.end(), probe) - data.begin());
+            assert(index.lower_bound(probe) == expected);
+        }
+        const TimestampRange r = index.range(data[10], data[500]);
+        assert(r.begin <= 10 && r.end <= 500 && data[r.end] == data[500] && !r.empty());
+        assert(index.range(data[500], data[10]).empty());
+    }
+
+    const TimestampIndex index(data.data(), data.size());
+
+    // Calendar ranges, including the CET spring-forward day.
+    {
+        const TimestampRange dst = index.day(2024, 3, 31, CET);
+        const dse_t target = date_to_unix_day(2024, 3, 31);
+        struct DayPred {
+            dse_t day;
+            bool operator()(ts_ms_t ts) const { return local_day(ts, CET) == day; }
+        } day_pred{target};
+        const TimestampRange expected = brute_range(data, day_pred, zone_to_gmt_ms(target * MS_PER_DAY, CET));
+        assert(dst.begin == expected.begin && dst.end == expected.end);
+        assert(index.unix_day(target, CET).begin == dst.begin);
+        const TimestampRange utc_day = index.day(2024, 3, 31);
+        assert(data[utc_day.begin] >= to_timestamp_ms(2024, 3, 31) && data[utc_day.end] >= to_timestamp_ms(2024, 4, 1));
+        assert(data[utc_day.end - 1] < to_timestamp_ms(2024, 4, 1));
+    }
+    {
+        // ISO week 2024-W01 starts on Monday 2024-01-01; 2025-W01 starts on 2024-12-30.
+        const TimestampRange week = index.iso_week(2025, 1, ET);
+        struct WeekPred {
+            bool operator()(ts_ms_t ts) const {
+                const IsoWeekDateStruct iso = to_iso_week_date(ms_to_sec<ts_t>(gmt_to_zone_ms(ts, ET)));
+                return iso.year == 2025 && iso.week == 1;
+            }
+        } week_pred;
+        const TimestampRange expected = brute_range(data, week_pred, zone_to_gmt_ms(to_timestamp_ms(2024, 12, 30), ET));
+        assert(week.begin == expected.begin && week.end == expected.end);
+        bool thrown = false;
+        try {
+            index.iso_week(2024, 53);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    {
+        const TimestampRange march = index.month(2024, 3, CET);
+        const TimestampRange december = index.month(2024, 12, CET);
+        struct MonthPred {
+            int month;
+            bool operator()(ts_ms_t ts) const {
+                const DateTimeStruct dt = to_date_time_ms<DateTimeStruct>(gmt_to_zone_ms(ts, CET));
+                return dt.year == 2024 && dt.mon == month;
+            }
+        };
+        const TimestampRange expected_march = brute_range(data, MonthPred{3}, zone_to_gmt_ms(to_timestamp_ms(2024, 3, 1), CET));
+        const TimestampRange expected_december = brute_range(data, MonthPred{12}, zone_to_gmt_ms(to_timestamp_ms(2024, 12, 1), CET));
+        assert(march.begin == expected_march.begin && march.end == expected_march.end);
+        assert(december.begin == expected_december.begin && december.end == expected_december.end);
+    }
+    {
+        BusinessCalendar calendar(date_to_unix_day(2024, 1, 1), date_to_unix_day(2024, 12, 31), CET);
+        calendar.set_default_session(SessionHours{9 * MS_PER_HOUR, 17 * MS_PER_HOUR + 30 * MS_PER_MIN});
+        const dse_t monday = date_to_unix_day(2024, 4, 1);
+        calendar.set_business_day(monday, false);
+        const dse_t tuesday = monday + 1;
+        const TimestampRange session = index.session(calendar, tuesday);
+        assert(!session.empty());
+        ts_ms_t tuesday_open = 0;
+        ts_ms_t tuesday_close = 0;
+        assert(calendar.session(tuesday, tuesday_open, tuesday_close));
+        for (std::size_t i = session.begin > 50 ? session.begin - 50 : 0; i < session.end + 50; ++i) {
+            const bool is_inside = i >= session.begin && i < session.end;
+            assert((data[i] >= tuesday_open && data[i] < tuesday_close) == is_inside);
+            assert(!is_inside || calendar.is_in_session(data[i]));
+        }
+        assert(index.session(calendar, monday).empty());
+        assert(index.session(calendar, date_to_unix_day(2024, 4, 6)).empty());
+
+        // From a timestamp to the next session open.
+        ts_ms_t open_ms = 0;
+        ts_ms_t close_ms = 0;
+        assert(calendar.session(calendar.next_business_day(monday), open_ms, close_ms));
+        const TimestampRange gap = index.range(zone_to_gmt_ms(to_timestamp_ms(2024, 3, 31, 1), CET), open_ms);
+        assert(gap.end == session.begin);
+    }
+    {
+        bool thrown = false;
+        try {
+            index.day(2024, 1, 1, UNKNOWN);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    // Bucket iteration covers the array in order, one call per non-empty bucket.
+    {
+        std::vector<TimestampRange> ranges;
+        std::vector<ts_ms_t> starts;
+        const BucketCheck check = {&ranges, &starts};
+
+        index.for_each_day(check, CET);
+        std::size_t pos = 0;
+        for (std::size_t k = 0; k < ranges.size(); ++k) {
+            assert(ranges[k].begin == pos && !ranges[k].empty());
+            const dse_t day = local_day(data[pos], CET);
+            assert(starts[k] == zone_to_gmt_ms(day * MS_PER_DAY, CET));
+            assert(local_day(data[ranges[k].end - 1], CET) == day);
+            assert(k == 0 || local_day(data[pos - 1], CET) < day);
+            pos = ranges[k].end;
+        }
+        assert(pos == data.size());
+
+        ranges.clear();
+        starts.clear();
+        index.for_each_iso_week(check, CET);
+        pos = 0;
+        for (std::size_t k = 0; k < ranges.size(); ++k) {
+            assert(ranges[k].begin == pos);
+            const IsoWeekDateStruct first = to_iso_week_date(ms_to_sec<ts_t>(gmt_to_zone_ms(data[pos], CET)));
+            const IsoWeekDateStruct last = to_iso_week_date(ms_to_sec<ts_t>(gmt_to_zone_ms(data[ranges[k].end - 1], CET)));
+            assert(first.year == last.year && first.week == last.week);
+            const DateTimeStruct start = to_date_time_ms<DateTimeStruct>(gmt_to_zone_ms(starts[k], CET));
+            assert(start.hour == 0 && day_of_week_date(start.year, start.mon, start.day) == MON);
+            pos = ranges[k].end;
+        }
+        assert(pos == data.size());
+
+        ranges.clear();
+        starts.clear();
+        index.for_each_month(check, CET);
+        assert(ranges.size() == 14);
+        assert(starts[3] == zone_to_gmt_ms(to_timestamp_ms(2024, 3, 1), CET));
+        assert(ranges[3].begin == index.month(2024, 3, CET).begin && ranges[3].end == index.month(2024, 3, CET).end);
+
+        ranges.clear();
+        starts.clear();
+        index.for_each_period(MS_PER_HOUR, 30 * MS_PER_MIN, check);
+        pos = 0;
+        for (std::size_t k = 0; k < ranges.size(); ++k) {
+            assert(ranges[k].begin == pos);
+            assert(starts[k] % MS_PER_HOUR == 30 * MS_PER_MIN);
+            assert(data[pos] >= starts[k] && data[ranges[k].end - 1] < starts[k] + MS_PER_HOUR);
+            pos = ranges[k].end;
+        }
+        assert(pos == data.size());
+    }
+
+    // Empty arrays, a single element and a span that forces a wider bucket.
+    {
+        const TimestampIndex empty(nullptr, 0);
+        assert(empty.lower_bound(0) == 0 && empty.range(-5, 5).empty());
+        std::vector<TimestampRange> ranges;
+        std::vector<ts_ms_t> starts;
+        empty.for_each_day(BucketCheck{&ranges, &starts});
+        assert(ranges.empty());
+
+        const ts_ms_t wide[] = {-4000000000000000000LL, -1, 0, 0, 7, 4000000000000000000LL};
+        const TimestampIndex sparse(wide, 6);
+        assert(sparse.directory_size() <= 4 * 6 + 66);
+        assert(sparse.lower_bound(-2) == 1 && sparse.lower_bound(0) == 2 && sparse.lower_bound(1) == 4);
+        assert(sparse.lower_bound(8) == 5 && sparse.lower_bound(4000000000000000001LL) == 6);
+
+        bool thrown = false;
+        try {
+            TimestampIndex bad(wide, 6, 0);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    return 0;
+}
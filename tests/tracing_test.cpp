@@ -0,0 +1,115 @@
+#define TIME_SHIELD_ENABLE_TRACING 1
+#define TIME_SHIELD_TRACE_RING_CAPACITY 64
+#include <time_shield/time_format_parser.hpp>
+#include <time_shield/time_formatting.hpp>
+#include <time_shield/time_parser.hpp>
+#include <time_shield/time_zone_conversions.hpp>
+#include <time_shield/tracing.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    std::size_t count_named(const std::vector<time_shield::trace::TraceEvent>& events, const std::string& name) {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            if (name == events[i].name) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+} // namespace
+
+/// \brief Checks library probes, ring wrap-around and Chrome trace export.
+int main() {
+    using namespace time_shield;
+
+    trace::clear();
+    DateTimeStruct dt;
+    TimeZoneStruct tz;
+    assert(parse_iso8601("2024-03-31T01:00:00Z", dt, tz));
+    assert(try_parse_format("31.03.2024", "%d.%m.%Y", dt, tz));
+    const std::string text = to_string_ms("%Y-%m-%d", static_cast<ts_ms_t>(1711846800000LL));
+    assert(text == "2024-03-31");
+    (void)zone_to_gmt(static_cast<ts_t>(1711846800), CET);
+    {
+        TIME_SHIELD_TRACE_SCOPE("outer \"quoted\"");
+        TIME_SHIELD_TRACE_SCOPE("inner");
+    }
+
+    std::vector<trace::TraceEvent> events = trace::collect();
+    assert(count_named(events, "parse_iso8601") == 1);
+    assert(count_named(events, "try_parse_format_core") == 1);
+    assert(count_named(events, "to_string_ms") == 1);
+    assert(count_named(events, "zone_to_gmt") == 1);
+    assert(count_named(events, "inner") == 1);
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        assert(events[i].end_ns >= events[i].begin_ns);
+        assert(events[i].thread == events[0].thread);
+    }
+    // Inner scopes close first and lie within the outer span.
+    const trace::TraceEvent& inner = events[events.size() - 2];
+    const trace::TraceEvent& outer = events[events.size() - 1];
+    assert(std::string(inner.name) == "inner");
+    assert(inner.begin_ns >= outer.begin_ns && inner.end_ns <= outer.end_ns);
+
+    std::ostringstream json;
+    trace::write_chrome_json(json);
+    const std::string output = json.str();
+    assert(output.find("\"traceEvents\":[") != std::string::npos);
+    assert(output.find("\"name\":\"parse_iso8601\",\"cat\":\"time_shield\",\"ph\":\"X\"") != std::string::npos);
+    assert(output.find("outer \\\"quoted\\\"") != std::string::npos);
+
+    // Each thread writes its own ring and keeps the newest events. The threads
+    // wait for each other so none of them exits and frees its ring early.
+    trace::clear();
+    assert(trace::collect().empty());
+    std::atomic<int> started(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&started]() {
+            {
+                TIME_SHIELD_TRACE_SCOPE("worker");
+            }
+            started.fetch_add(1);
+            while (started.load() < 3) {
+                std::this_thread::yield();
+            }
+            for (int i = 1; i < 200; ++i) {
+                TIME_SHIELD_TRACE_SCOPE("worker");
+            }
+        });
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+    events = trace::collect();
+    // The slot after the newest event may be mid-write, so one slot per ring is not returned.
+    assert(events.size() == 3 * (TIME_SHIELD_TRACE_RING_CAPACITY - 1));
+    assert(count_named(events, "worker") == events.size());
+    assert(events.front().thread != events.back().thread);
+
+    // Rings of finished threads are reused by new threads instead of leaking.
+    const std::size_t ring_count = trace::detail::registry().rings.size();
+    for (int t = 0; t < 10; ++t) {
+        std::thread worker([]() {
+            TIME_SHIELD_TRACE_SCOPE("sequential");
+        });
+        worker.join();
+    }
+    assert(trace::detail::registry().rings.size() == ring_count);
+    events = trace::collect();
+    // A reused ring drops the events of its previous thread.
+    assert(count_named(events, "sequential") == 1);
+    assert(count_named(events, "worker") == 2 * (TIME_SHIELD_TRACE_RING_CAPACITY - 1));
+    trace::clear();
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <time_shield/TscClock.hpp>
+#include <time_shield/time_utils.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    std::int64_t steady_ns() {
+        return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /// \brief Prints average cost of one read for the supplied function.
+    template<class F>
+    void bench_read(const char* label, F read) {
+        const int iterations = 1000000;
+        std::int64_t sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            sink += static_cast<std::int64_t>(read());
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const double ns_per_read = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+        std::cout << label << ": " << ns_per_read << " ns/read" << (sink == 0 ? " " : "") << '\n';
+    }
+
+} // namespace
+
+/// \brief Checks calibrated counter reads against the reference clocks.
+int main() {
+    using namespace time_shield;
+
+    TscClock& clock = TscClock::instance();
+    assert(&clock == &TscClock::instance());
+    std::cout << "TscClock available: " << (clock.is_available() ? "yes" : "no")
+              << ", frequency Hz: " << clock.counter_frequency_hz() << '\n';
+    if (clock.is_available()) {
+        assert(clock.counter_frequency_hz() > 1.0e6);
+    } else {
+        assert(clock.counter_frequency_hz() == 0.0);
+    }
+
+    // Monotonic reads never go backwards and track steady_clock.
+    std::int64_t previous = clock.monotonic_ns();
+    for (int i = 0; i < 100000; ++i) {
+        const std::int64_t current = clock.monotonic_ns();
+        assert(current >= previous);
+        previous = current;
+    }
+    assert(std::llabs(clock.monotonic_ns() - steady_ns()) < 2 * NS_PER_MS);
+    assert(std::llabs(clock.monotonic_us() - monotonic_us()) < 2 * US_PER_MS);
+
+    // UTC reads stay close to the library realtime clock.
+    assert(std::llabs(clock.utc_time_us() - now_realtime_us()) < 50 * US_PER_MS);
+    assert(std::llabs(clock.utc_time_ms() - ts_ms()) < 50);
+    assert(clock.utc_time_ns() / NS_PER_US - clock.utc_time_us() <= 0);
+
+    // Elapsed time over a sleep matches steady_clock.
+    const std::int64_t mono_before = clock.monotonic_ns();
+    const std::int64_t steady_before = steady_ns();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    const std::int64_t mono_elapsed = clock.monotonic_ns() - mono_before;
+    const std::int64_t steady_elapsed = steady_ns() - steady_before;
+    assert(std::llabs(mono_elapsed - steady_elapsed) < NS_PER_MS);
+
+    // Recalibration keeps monotonic reads continuous.
+    clock.set_recalibration_interval(std::chrono::milliseconds(5));
+    assert(clock.recalibration_interval() == std::chrono::milliseconds(5));
+    previous = clock.monotonic_ns();
+    const auto recalibration_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(40);
+    while (std::chrono::steady_clock::now() < recalibration_deadline) {
+        const std::int64_t current = clock.monotonic_ns();
+        assert(current >= previous);
+        previous = current;
+    }
+    clock.recalibrate();
+    assert(std::llabs(clock.monotonic_ns() - steady_ns()) < NS_PER_MS);
+    clock.set_recalibration_interval(std::chrono::seconds(1));
+
+    // A recalibration keeps the values of counter readings taken before it.
+    if (clock.is_available()) {
+        for (int i = 0; i < 20; ++i) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            const std::uint64_t ticks = TscClock::read_counter();
+            const std::int64_t before = clock.counter_to_monotonic_ns(ticks);
+            clock.recalibrate();
+            assert(clock.counter_to_monotonic_ns(ticks) == before);
+            assert(clock.counter_to_monotonic_ns(TscClock::read_counter()) >= before);
+        }
+    }
+
+    // Concurrent readers never see values go backwards, even while recalibrating.
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&clock]() {
+            std::int64_t last = clock.monotonic_ns();
+            for (int i = 0; i < 50000; ++i) {
+                const std::int64_t current = clock.monotonic_ns();
+                assert(current >= last);
+                last = current;
+                if (i % 10000 == 0) {
+                    clock.recalibrate();
+                }
+            }
+        });
+    }
+    for (std::size_t i = 0; i < readers.size(); ++i) {
+        readers[i].join();
+    }
+
+    // Forced fallback uses the existing clocks.
+    TscClock fallback(false);
+    assert(!fallback.is_available());
+    assert(fallback.counter_frequency_hz() == 0.0);
+    assert(std::llabs(fallback.monotonic_ns() - steady_ns()) < NS_PER_MS);
+    assert(std::llabs(fallback.utc_time_us() - now_realtime_us()) < 50 * US_PER_MS);
+    fallback.recalibrate();
+
+    bench_read("TscClock::monotonic_ns", [&clock]() { return clock.monotonic_ns(); });
+    bench_read("TscClock::utc_time_us", [&clock]() { return clock.utc_time_us(); });
+    bench_read("steady_clock::now", []() { return steady_ns(); });
+    bench_read("now_realtime_us", []() { return now_realtime_us(); });
+    return 0;
+}